@@ -34,6 +34,7 @@
 #include <liblangutil/Exceptions.h>
 
 #include <libsolutil/JSON.h>
+#include <libsolutil/Profiler.h>
 #include <libsolutil/StringUtils.h>
 
 #include <fmt/format.h>
@@ -804,6 +805,9 @@ std::map<u256, u256> const& Assembly::optimiseInternal(
 			BlockDeduplicator::applyTagReplacement(codeSection.items, subTagReplacements, subId);
 	}
 
+	// Started after the sub-assemblies, which have probes of their own.
+	util::Profiler::Probe probe{"evmasmOptimizer", "Assembly::optimise", m_name};
+
 	std::map<u256, u256> tagReplacements;
 	// Iterate until no new optimisation possibilities are found.
 	for (unsigned count = 1; count > 0;)
@@ -813,6 +817,7 @@ std::map<u256, u256> const& Assembly::optimiseInternal(
 		// TODO: verify this for EOF.
 		if (_settings.runInliner && !m_eofVersion.has_value())
 		{
+			util::Profiler::Probe inlinerProbe{"evmasmOptimizer", "Inliner"};
 			solAssert(m_codeSections.size() == 1);
 			Inliner{
 				m_codeSections.front().items,
@@ -825,6 +830,7 @@ std::map<u256, u256> const& Assembly::optimiseInternal(
 		// TODO: verify this for EOF.
 		if (_settings.runJumpdestRemover && !m_eofVersion.has_value())
 		{
+			util::Profiler::Probe jumpdestRemoverProbe{"evmasmOptimizer", "JumpdestRemover"};
 			for (auto& codeSection: m_codeSections)
 			{
 				JumpdestRemover jumpdestOpt{codeSection.items};
@@ -836,6 +842,7 @@ std::map<u256, u256> const& Assembly::optimiseInternal(
 		// TODO: verify this for EOF.
 		if (_settings.runPeephole && !m_eofVersion.has_value())
 		{
+			util::Profiler::Probe peepholeProbe{"evmasmOptimizer", "PeepholeOptimiser"};
 			for (auto& codeSection: m_codeSections)
 			{
 				PeepholeOptimiser peepOpt{codeSection.items, m_evmVersion};
@@ -850,6 +857,8 @@ std::map<u256, u256> const& Assembly::optimiseInternal(
 		// This only modifies PushTags, we have to run again to actually remove code.
 		// TODO: implement for EOF.
 		if (_settings.runDeduplicate && !m_eofVersion.has_value())
+		{
+			util::Profiler::Probe deduplicatorProbe{"evmasmOptimizer", "BlockDeduplicator"};
 			for (auto& section: m_codeSections)
 			{
 				BlockDeduplicator deduplicator{section.items};
@@ -874,6 +883,7 @@ std::map<u256, u256> const& Assembly::optimiseInternal(
 					count++;
 				}
 			}
+		}
 
 		// TODO: investigate for EOF
 		if (_settings.runCSE && !m_eofVersion.has_value())
@@ -881,6 +891,7 @@ std::map<u256, u256> const& Assembly::optimiseInternal(
 			// Control flow graph optimization has been here before but is disabled because it
 			// assumes we only jump to tags that are pushed. This is not the case anymore with
 			// function types that can be stored in storage.
+			util::Profiler::Probe cseProbe{"evmasmOptimizer", "CommonSubexpressionEliminator"};
 			AssemblyItems optimisedItems;
 
 			solAssert(m_codeSections.size() == 1);
@@ -932,12 +943,15 @@ std::map<u256, u256> const& Assembly::optimiseInternal(
 
 	// TODO: investigate for EOF
 	if (_settings.runConstantOptimiser && !m_eofVersion.has_value())
+	{
+		util::Profiler::Probe constantOptimiserProbe{"evmasmOptimizer", "ConstantOptimiser"};
 		ConstantOptimisationMethod::optimiseConstants(
 			isCreation(),
 			isCreation() ? 1 : _settings.expectedExecutionsPerDeployment,
 			_settings.evmVersion,
 			*this
 		);
+	}
 
 	m_tagReplacements = std::move(tagReplacements);
 	return *m_tagReplacements;
@@ -1121,6 +1135,8 @@ LinkerObject const& Assembly::assemble() const
 	// Otherwise ensure the object is actually clear.
 	solRequire(m_assembledObject.linkReferences.empty(), AssemblyException, "Unexpected link references.");
 
+	util::Profiler::Probe probe{"assembly", "Assembly::assemble", m_name};
+
 	bool const eof = m_eofVersion.has_value();
 	solRequire(!eof || m_eofVersion == 1, AssemblyException, "Invalid EOF version.");
 
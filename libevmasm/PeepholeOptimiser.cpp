@@ -25,6 +25,8 @@
 #include <libevmasm/AssemblyItem.h>
 #include <libevmasm/SemanticInformation.h>
 
+#include <algorithm>
+
 using namespace solidity;
 using namespace solidity::evmasm;
 
@@ -52,6 +54,10 @@ struct FunctionParameterCount<R(Args...)>
 template <class Method>
 struct SimplePeepholeOptimizerMethod
 {
+	static constexpr size_t windowSize()
+	{
+		return FunctionParameterCount<decltype(Method::applySimple)>::value - 1;
+	}
 	template <size_t... Indices>
 	static bool applyRule(
 		AssemblyItems::const_iterator _in,
@@ -63,7 +69,7 @@ struct SimplePeepholeOptimizerMethod
 	}
 	static bool apply(OptimiserState& _state)
 	{
-		static constexpr size_t WindowSize = FunctionParameterCount<decltype(Method::applySimple)>::value - 1;
+		static constexpr size_t WindowSize = windowSize();
 		if (
 			_state.i + WindowSize <= _state.items.size() &&
 			applyRule(_state.items.begin() + static_cast<ptrdiff_t>(_state.i), _state.out, std::make_index_sequence<WindowSize>{})
@@ -200,10 +206,11 @@ struct DoubleSwap: SimplePeepholeOptimizerMethod<DoubleSwap>
 
 struct DoublePush
 {
+	static constexpr size_t windowSize() { return 2; }
+
 	static bool apply(OptimiserState& _state)
 	{
-		size_t windowSize = 2;
-		if (_state.i + windowSize > _state.items.size())
+		if (_state.i + windowSize() > _state.items.size())
 			return false;
 
 		auto push1 = _state.items.begin() + static_cast<ptrdiff_t>(_state.i);
@@ -219,7 +226,7 @@ struct DoublePush
 		{
 			*_state.out = *push1;
 			*_state.out = {Instruction::DUP1, push2->debugData()};
-			_state.i += windowSize;
+			_state.i += windowSize();
 			return true;
 		}
 		else
@@ -566,6 +573,9 @@ struct TruthyAnd: SimplePeepholeOptimizerMethod<TruthyAnd>
 /// Removes everything after a JUMP (or similar) until the next JUMPDEST.
 struct UnreachableCode
 {
+	/// Whether the method applies only depends on the first two items, even though it may remove more.
+	static constexpr size_t windowSize() { return 2; }
+
 	static bool apply(OptimiserState& _state)
 	{
 		auto it = _state.items.begin() + static_cast<ptrdiff_t>(_state.i);
@@ -702,56 +712,169 @@ void applyMethods(OptimiserState& _state, Method, OtherMethods... _other)
 		applyMethods(_state, _other...);
 }
 
-size_t numberOfPops(AssemblyItems const& _items)
+template <typename... Methods>
+struct PeepholeOptimisationMethods
+{
+	/// Number of items a method may look at to decide whether it applies.
+	static constexpr size_t maxWindowSize = std::max({Methods::windowSize()...});
+
+	static void apply(OptimiserState& _state)
+	{
+		applyMethods(_state, Methods{}...);
+	}
+};
+
+using AllMethods = PeepholeOptimisationMethods<
+	PushPop,
+	OpPop,
+	OpStop,
+	OpReturnRevert,
+	DoublePush,
+	DoubleSwap,
+	CommutativeSwap,
+	SwapComparison,
+	DupSwap,
+	IsZeroIsZeroJumpI,
+	IsZeroIsZeroRJumpI, // EOF specific
+	EqIsZeroJumpI,
+	EqIsZeroRJumpI,     // EOF specific
+	DoubleJump,
+	DoubleRJump,        // EOF specific
+	JumpToNext,
+	RJumpToNext,        // EOF specific
+	UnreachableCode,
+	DeduplicateNextTagSize3,
+	DeduplicateNextTagSize2,
+	DeduplicateNextTagSize1,
+	TagConjunctions,
+	TruthyAnd,
+	Identity
+>;
+
+/// Replacement of the items in the range [begin, end) by a method other than the identity.
+struct Rewrite
+{
+	size_t begin;
+	size_t end;
+	AssemblyItems replacement;
+};
+
+/// Metrics by which the result of a pass is compared to its input.
+struct Cost
+{
+	ptrdiff_t items = 0;
+	ptrdiff_t bytes = 0;
+	ptrdiff_t pops = 0;
+};
+
+template <typename Iterator>
+void addCost(Cost& _cost, Iterator _begin, Iterator _end, langutil::EVMVersion _evmVersion, int _sign)
 {
-	return static_cast<size_t>(std::count(_items.begin(), _items.end(), Instruction::POP));
+	// Avoid referencing immutables too early by using approx. counting in bytesRequired()
+	auto const approx = evmasm::Precision::Approximate;
+	for (auto it = _begin; it != _end; ++it)
+	{
+		_cost.items += _sign;
+		_cost.bytes += _sign * static_cast<ptrdiff_t>(it->bytesRequired(3, _evmVersion, approx));
+		if (*it == Instruction::POP)
+			_cost.pops += _sign;
+	}
 }
 
 }
 
+PeepholeOptimiser::PeepholeOptimiser(AssemblyItems& _items, langutil::EVMVersion const _evmVersion):
+	m_items(_items),
+	m_evmVersion(_evmVersion),
+	m_changedRanges{{0, _items.size()}}
+{
+}
+
 bool PeepholeOptimiser::optimise()
 {
-	// Avoid referencing immutables too early by using approx. counting in bytesRequired()
-	auto const approx = evmasm::Precision::Approximate;
-	OptimiserState state {m_items, 0, back_inserter(m_optimisedItems), m_evmVersion};
-	while (state.i < m_items.size())
-		applyMethods(
-			state,
-			PushPop(),
-			OpPop(),
-			OpStop(),
-			OpReturnRevert(),
-			DoublePush(),
-			DoubleSwap(),
-			CommutativeSwap(),
-			SwapComparison(),
-			DupSwap(),
-			IsZeroIsZeroJumpI(),
-			IsZeroIsZeroRJumpI(), // EOF specific
-			EqIsZeroJumpI(),
-			EqIsZeroRJumpI(),     // EOF specific
-			DoubleJump(),
-			DoubleRJump(),        // EOF specific
-			JumpToNext(),
-			RJumpToNext(),        // EOF specific
-			UnreachableCode(),
-			DeduplicateNextTagSize3(),
-			DeduplicateNextTagSize2(),
-			DeduplicateNextTagSize1(),
-			TagConjunctions(),
-			TruthyAnd(),
-			Identity()
+	size_t constexpr windowSize = AllMethods::maxWindowSize;
+
+	// A pass applies the first matching method at the current position and continues after the
+	// items it consumed. Positions whose window does not touch any range changed by the previous
+	// pass see the same items as in that pass, where only the identity matched, so they are skipped.
+	std::vector<Rewrite> rewrites;
+	auto changedRange = m_changedRanges.begin();
+	size_t i = 0;
+	while (i < m_items.size())
+	{
+		while (changedRange != m_changedRanges.end() && changedRange->second <= i)
+			++changedRange;
+		if (changedRange == m_changedRanges.end())
+			break;
+		if (i + windowSize <= changedRange->first)
+			i = changedRange->first - windowSize + 1;
+
+		Rewrite rewrite{i, i, {}};
+		OptimiserState state{m_items, i, back_inserter(rewrite.replacement), m_evmVersion};
+		AllMethods::apply(state);
+		// All methods except the identity consume at least two items.
+		if (state.i > i + 1)
+		{
+			rewrite.end = state.i;
+			assertThrow(
+				rewrite.replacement.size() <= rewrite.end - rewrite.begin,
+				OptimizerException,
+				"Peephole optimizer method produced more items than it consumed."
+			);
+			rewrites.emplace_back(std::move(rewrite));
+		}
+		i = state.i;
+	}
+
+	Cost difference;
+	for (Rewrite const& rewrite: rewrites)
+	{
+		addCost(difference, rewrite.replacement.begin(), rewrite.replacement.end(), m_evmVersion, 1);
+		addCost(
+			difference,
+			m_items.begin() + static_cast<ptrdiff_t>(rewrite.begin),
+			m_items.begin() + static_cast<ptrdiff_t>(rewrite.end),
+			m_evmVersion,
+			-1
 		);
-	if (m_optimisedItems.size() < m_items.size() || (
-		m_optimisedItems.size() == m_items.size() && (
-			evmasm::bytesRequired(m_optimisedItems, 3, m_evmVersion, approx) < evmasm::bytesRequired(m_items, 3, m_evmVersion, approx) ||
-			numberOfPops(m_optimisedItems) > numberOfPops(m_items)
-		)
+	}
+	if (!(
+		difference.items < 0 ||
+		(difference.items == 0 && (difference.bytes < 0 || difference.pops > 0))
 	))
+		return false;
+
+	// Splice the replacements into the items in place. Since no replacement is longer than the items
+	// it replaces, items are only moved towards the front. Items between rewrites are not moved at all
+	// until a rewrite shrinks the code, but all items after such a rewrite are moved once.
+	std::vector<std::pair<size_t, size_t>> changedRanges;
+	size_t read = 0;
+	size_t write = 0;
+	auto const moveItems = [&](size_t _end) {
+		if (write != read)
+			std::move(
+				m_items.begin() + static_cast<ptrdiff_t>(read),
+				m_items.begin() + static_cast<ptrdiff_t>(_end),
+				m_items.begin() + static_cast<ptrdiff_t>(write)
+			);
+		write += _end - read;
+		read = _end;
+	};
+	for (Rewrite& rewrite: rewrites)
 	{
-		m_items = std::move(m_optimisedItems);
-		return true;
+		moveItems(rewrite.begin);
+		std::move(
+			rewrite.replacement.begin(),
+			rewrite.replacement.end(),
+			m_items.begin() + static_cast<ptrdiff_t>(write)
+		);
+		changedRanges.emplace_back(write, write + rewrite.replacement.size());
+		write += rewrite.replacement.size();
+		read = rewrite.end;
 	}
-	else
-		return false;
+	moveItems(m_items.size());
+	m_items.erase(m_items.begin() + static_cast<ptrdiff_t>(write), m_items.end());
+
+	m_changedRanges = std::move(changedRanges);
+	return true;
 }
@@ -24,6 +24,7 @@
 #include <vector>
 #include <cstddef>
 #include <iterator>
+#include <utility>
 
 #include <liblangutil/EVMVersion.h>
 
@@ -40,22 +41,26 @@ public:
 	virtual bool apply(AssemblyItems::const_iterator _in, std::back_insert_iterator<AssemblyItems> _out);
 };
 
+/**
+ * Applies local rewrites to a list of assembly items in passes.
+ * Each pass only re-examines the windows around the items rewritten by the previous pass,
+ * so the items must not be modified by anything else between the calls to @a optimise().
+ */
 class PeepholeOptimiser
 {
 public:
-	explicit PeepholeOptimiser(AssemblyItems& _items, langutil::EVMVersion const _evmVersion):
-	m_items(_items),
-	m_evmVersion(_evmVersion)
-	{
-	}
+	explicit PeepholeOptimiser(AssemblyItems& _items, langutil::EVMVersion const _evmVersion);
 	virtual ~PeepholeOptimiser() = default;
 
+	/// Performs a single pass over the items.
+	/// @returns true if the pass made the code smaller (or otherwise better) and the items were modified.
 	bool optimise();
 
 private:
 	AssemblyItems& m_items;
-	AssemblyItems m_optimisedItems;
 	langutil::EVMVersion const m_evmVersion;
+	/// Sorted ranges [begin, end) of items produced by the rewrites of the last accepted pass.
+	std::vector<std::pair<size_t, size_t>> m_changedRanges;
 };
 
 }
@@ -29,6 +29,16 @@
 using namespace solidity;
 using namespace solidity::langutil;
 
+namespace
+{
+
+/// IDs of the messages reported once the number of errors, warnings or infos exceeds its limit.
+ErrorId constexpr c_tooManyErrors = 4013_error;
+ErrorId constexpr c_tooManyWarnings = 4591_error;
+ErrorId constexpr c_tooManyInfos = 2833_error;
+
+}
+
 ErrorReporter& ErrorReporter::operator=(ErrorReporter const& _errorReporter)
 {
 	if (&_errorReporter == this)
@@ -77,6 +87,46 @@ void ErrorReporter::error(ErrorId _errorId, Error::Type _type, SourceLocation co
 	m_errorList.push_back(std::make_shared<Error>(_errorId, _type, _description, _location, _secondaryLocation));
 }
 
+bool ErrorReporter::merge(ErrorList const& _errorList)
+{
+	unsigned errorCount = 0;
+	unsigned warningCount = 0;
+	unsigned infoCount = 0;
+	for (auto const& error: _errorList)
+		if (error->type() == Error::Type::Warning)
+			warningCount++;
+		else if (error->type() == Error::Type::Info)
+			infoCount++;
+		else
+			errorCount++;
+
+	if (
+		warningCount >= c_maxWarningsAllowed ||
+		infoCount >= c_maxInfosAllowed ||
+		m_errorCount + errorCount >= c_maxErrorsAllowed
+	)
+		return false;
+
+	replay(_errorList);
+	return true;
+}
+
+void ErrorReporter::replay(ErrorList const& _errorList)
+{
+	for (auto const& error: _errorList)
+		if (error->errorId() == c_tooManyErrors)
+		{
+			// The other reporter got more errors than allowed, so we have at least as many.
+			m_errorList.push_back(error);
+			BOOST_THROW_EXCEPTION(FatalError());
+		}
+		else if (error->errorId() == c_tooManyWarnings || error->errorId() == c_tooManyInfos)
+			// We reach the same limit on our own, no later than the other reporter.
+			continue;
+		else if (!checkForExcessiveErrors(error->type()))
+			m_errorList.push_back(error);
+}
+
 bool ErrorReporter::hasExcessiveErrors() const
 {
 	return m_errorCount > c_maxErrorsAllowed;
@@ -99,7 +149,7 @@ bool ErrorReporter::checkForExcessiveErrors(Error::Type _type)
 		m_warningCount++;
 
 		if (m_warningCount == c_maxWarningsAllowed)
-			m_errorList.push_back(std::make_shared<Error>(4591_error, Error::Type::Warning, "There are more than 256 warnings. Ignoring the rest."));
+			m_errorList.push_back(std::make_shared<Error>(c_tooManyWarnings, Error::Type::Warning, "There are more than 256 warnings. Ignoring the rest."));
 
 		if (m_warningCount >= c_maxWarningsAllowed)
 			return true;
@@ -109,7 +159,7 @@ bool ErrorReporter::checkForExcessiveErrors(Error::Type _type)
 		m_infoCount++;
 
 		if (m_infoCount == c_maxInfosAllowed)
-			m_errorList.push_back(std::make_shared<Error>(2833_error, Error::Type::Info, "There are more than 256 infos. Ignoring the rest."));
+			m_errorList.push_back(std::make_shared<Error>(c_tooManyInfos, Error::Type::Info, "There are more than 256 infos. Ignoring the rest."));
 
 		if (m_infoCount >= c_maxInfosAllowed)
 			return true;
@@ -120,7 +170,7 @@ bool ErrorReporter::checkForExcessiveErrors(Error::Type _type)
 
 		if (m_errorCount > c_maxErrorsAllowed)
 		{
-			m_errorList.push_back(std::make_shared<Error>(4013_error, Error::Type::Warning, "There are more than 256 errors. Aborting."));
+			m_errorList.push_back(std::make_shared<Error>(c_tooManyErrors, Error::Type::Warning, "There are more than 256 errors. Aborting."));
 			BOOST_THROW_EXCEPTION(FatalError());
 		}
 	}
@@ -53,6 +53,17 @@ public:
 		m_errorList += _errorList;
 	}
 
+	/// Reports the messages in @a _errorList, collected by another reporter, as if they had been
+	/// reported here, i.e. subject to the limits on the number of messages.
+	/// If the other reporter aborted because of too many errors, so does this one, by throwing FatalError.
+	void replay(ErrorList const& _errorList);
+
+	/// Same as @a replay, but only if the result does not depend on the point at which a limit
+	/// was reached.
+	/// @returns false without reporting anything if the other reporter reached a limit or if
+	/// reporting the errors here would reach the limit on errors.
+	bool merge(ErrorList const& _errorList);
+
 	void warning(ErrorId _error, std::string const& _description);
 
 	void warning(ErrorId _error, SourceLocation const& _location, std::string const& _description);
@@ -0,0 +1,85 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsmtutil/CancellationToken.h>
+
+#include <atomic>
+
+using namespace solidity::smtutil;
+
+namespace
+{
+
+thread_local CancellationToken* t_currentToken = nullptr;
+std::atomic<std::uint64_t> g_nextTokenID{0};
+
+}
+
+CancellationToken::Scope::Scope(CancellationToken& _token):
+	m_previous(t_currentToken)
+{
+	t_currentToken = &_token;
+}
+
+CancellationToken::Scope::~Scope()
+{
+	t_currentToken = m_previous;
+}
+
+CancellationToken::CancellationToken():
+	m_id(g_nextTokenID++)
+{
+}
+
+CancellationToken* CancellationToken::current()
+{
+	return t_currentToken;
+}
+
+void CancellationToken::cancel()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	if (m_cancelled)
+		return;
+	m_cancelled = true;
+	// Callbacks run under the lock, so that removeCallback() waits for them.
+	for (auto const& [id, callback]: m_callbacks)
+		callback();
+}
+
+bool CancellationToken::cancelled() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_cancelled;
+}
+
+size_t CancellationToken::addCallback(std::function<void()> _callback)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	if (m_cancelled)
+		_callback();
+	size_t const id = m_nextCallbackID++;
+	m_callbacks.emplace(id, std::move(_callback));
+	return id;
+}
+
+void CancellationToken::removeCallback(size_t _id)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_callbacks.erase(_id);
+}
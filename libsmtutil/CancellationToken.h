@@ -0,0 +1,82 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+
+namespace solidity::smtutil
+{
+
+/**
+ * Allows aborting solver queries that are running in other threads.
+ *
+ * A token is made current for the queries started by a thread through a @a Scope.
+ * Whatever runs a query can register a callback with the current token that aborts it,
+ * for example by terminating the solver process.
+ */
+class CancellationToken
+{
+public:
+	/// Makes a token current for the calling thread for the lifetime of the scope.
+	class Scope
+	{
+	public:
+		explicit Scope(CancellationToken& _token);
+		~Scope();
+
+		Scope(Scope const&) = delete;
+		Scope& operator=(Scope const&) = delete;
+
+	private:
+		CancellationToken* m_previous;
+	};
+
+	CancellationToken();
+
+	CancellationToken(CancellationToken const&) = delete;
+	CancellationToken& operator=(CancellationToken const&) = delete;
+
+	/// @returns the token of the innermost active scope of the calling thread or nullptr.
+	static CancellationToken* current();
+
+	/// Invokes all registered callbacks. Callbacks registered afterwards are invoked right away.
+	void cancel();
+	bool cancelled() const;
+
+	/// Registers @a _callback to be invoked on cancellation. The callback must not use the token.
+	/// @returns an ID to be passed to @a removeCallback().
+	size_t addCallback(std::function<void()> _callback);
+	/// Removes a callback. Once this returns, the callback is neither running nor invoked anymore.
+	void removeCallback(size_t _id);
+
+	/// @returns a number identifying this token among all tokens ever created by the process.
+	std::uint64_t id() const { return m_id; }
+
+private:
+	std::uint64_t const m_id;
+	mutable std::mutex m_mutex;
+	bool m_cancelled = false;
+	size_t m_nextCallbackID = 0;
+	std::map<size_t, std::function<void()>> m_callbacks;
+};
+
+}
@@ -18,8 +18,14 @@
 
 #include <libsmtutil/SMTPortfolio.h>
 
+#include <libsmtutil/CancellationToken.h>
 #include <libsmtutil/SMTLib2Interface.h>
 
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <optional>
+
 using namespace solidity;
 using namespace solidity::util;
 using namespace solidity::frontend;
@@ -27,10 +33,18 @@ using namespace solidity::smtutil;
 
 SMTPortfolio::SMTPortfolio(
 	std::vector<std::unique_ptr<BMCSolverInterface>> _solvers,
-	std::optional<unsigned> _queryTimeout
+	std::optional<unsigned> _queryTimeout,
+	bool _race,
+	std::chrono::milliseconds _crossCheckTime
 ):
-	BMCSolverInterface(_queryTimeout), m_solvers(std::move(_solvers))
-{}
+	BMCSolverInterface(_queryTimeout),
+	m_solvers(std::move(_solvers)),
+	m_statistics(m_solvers.size()),
+	m_crossCheckTime(_crossCheckTime)
+{
+	if (_race && m_solvers.size() > 1)
+		m_threadPool = std::make_unique<ThreadPool>(m_solvers.size());
+}
 
 
 void SMTPortfolio::reset()
@@ -93,33 +107,147 @@ void SMTPortfolio::addAssertion(Expression const& _expr)
  *   when it is told that this is a hard query to solve.
  *
  *   If all solvers return ERROR, the result is ERROR.
+ *
+ * In racing mode, solvers that had to be cancelled are only taken into account if they still
+ * answered the query, and a solver throwing an exception counts as ERROR unless no solver answered.
 */
 std::pair<CheckResult, std::vector<std::string>> SMTPortfolio::check(std::vector<Expression> const& _expressionsToEvaluate)
 {
-	CheckResult lastResult = CheckResult::ERROR;
-	std::vector<std::string> finalValues;
-	for (auto const& s: m_solvers)
+	if (m_threadPool)
+		return race(_expressionsToEvaluate);
+
+	std::pair<CheckResult, std::vector<std::string>> combined{CheckResult::ERROR, {}};
+	bool answered = false;
+	for (size_t i = 0; i < m_solvers.size(); ++i)
 	{
-		CheckResult result;
-		std::vector<std::string> values;
-		tie(result, values) = s->check(_expressionsToEvaluate);
-		if (solverAnswered(result))
+		auto answer = m_solvers[i]->check(_expressionsToEvaluate);
+		m_statistics[i].queries++;
+		if (!answered && solverAnswered(answer.first))
 		{
-			if (!solverAnswered(lastResult))
+			m_statistics[i].firstAnswers++;
+			answered = true;
+		}
+		if (!combine(combined, std::move(answer)))
+			break;
+	}
+	return combined;
+}
+
+std::pair<CheckResult, std::vector<std::string>> SMTPortfolio::race(std::vector<Expression> const& _expressionsToEvaluate)
+{
+	using Answer = std::pair<CheckResult, std::vector<std::string>>;
+	size_t const solverCount = m_solvers.size();
+
+	std::mutex mutex;
+	std::condition_variable finishedCondition;
+	std::vector<std::optional<Answer>> answers(solverCount);
+	std::vector<std::exception_ptr> errors(solverCount);
+	size_t finished = 0;
+	std::optional<size_t> first;
+
+	std::vector<std::unique_ptr<CancellationToken>> tokens;
+	for (size_t i = 0; i < solverCount; ++i)
+		tokens.emplace_back(std::make_unique<CancellationToken>());
+
+	std::vector<std::future<void>> futures;
+	for (size_t i = 0; i < solverCount; ++i)
+		futures.emplace_back(m_threadPool->submit([&, i]() {
+			CancellationToken::Scope scope(*tokens[i]);
+			Answer answer{CheckResult::ERROR, {}};
+			std::exception_ptr error;
+			try
 			{
-				lastResult = result;
-				finalValues = std::move(values);
+				answer = m_solvers[i]->check(_expressionsToEvaluate);
 			}
-			else if (lastResult != result)
+			catch (...)
 			{
-				lastResult = CheckResult::CONFLICTING;
-				break;
+				error = std::current_exception();
+			}
+
+			std::lock_guard<std::mutex> lock(mutex);
+			if (!error && solverAnswered(answer.first) && !first)
+				first = i;
+			answers[i] = std::move(answer);
+			errors[i] = error;
+			++finished;
+			finishedCondition.notify_all();
+		}));
+
+	std::vector<bool> decided(solverCount);
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		finishedCondition.wait(lock, [&]() { return first.has_value() || finished == solverCount; });
+		if (m_crossCheckTime.count() > 0)
+			finishedCondition.wait_for(lock, m_crossCheckTime, [&]() { return finished == solverCount; });
+		for (size_t i = 0; i < solverCount; ++i)
+			decided[i] = answers[i].has_value();
+	}
+
+	for (size_t i = 0; i < solverCount; ++i)
+		if (!decided[i])
+			tokens[i]->cancel();
+	// The solvers must not be used concurrently with the next operation of the portfolio.
+	for (auto& future: futures)
+		future.get();
+	// A solver may have answered before it noticed the cancellation.
+	for (size_t i = 0; i < solverCount; ++i)
+		if (!decided[i] && !errors[i] && solverAnswered(answers[i]->first))
+			decided[i] = true;
+
+	Answer combined{CheckResult::ERROR, {}};
+	std::exception_ptr error;
+	for (size_t i = 0; i < solverCount; ++i)
+	{
+		m_statistics[i].queries++;
+		if (first == i)
+			m_statistics[i].firstAnswers++;
+		if (!decided[i])
+			m_statistics[i].cancellations++;
+	}
+	for (size_t i = 0; i < solverCount; ++i)
+		if (decided[i])
+		{
+			if (errors[i])
+			{
+				if (!error)
+					error = errors[i];
 			}
+			else if (!combine(combined, std::move(*answers[i])))
+				break;
 		}
-		else if (result == CheckResult::UNKNOWN && lastResult == CheckResult::ERROR)
+	if (error && !first)
+		std::rethrow_exception(error);
+	return combined;
+}
+
+bool SMTPortfolio::combine(
+	std::pair<CheckResult, std::vector<std::string>>& _combined,
+	std::pair<CheckResult, std::vector<std::string>> _answer
+)
+{
+	auto& [lastResult, finalValues] = _combined;
+	auto& [result, values] = _answer;
+	if (solverAnswered(result))
+	{
+		if (!solverAnswered(lastResult))
+		{
 			lastResult = result;
+			finalValues = std::move(values);
+		}
+		else if (lastResult != result)
+		{
+			lastResult = CheckResult::CONFLICTING;
+			return false;
+		}
 	}
-	return std::make_pair(lastResult, finalValues);
+	else if (result == CheckResult::UNKNOWN && lastResult == CheckResult::ERROR)
+		lastResult = result;
+	return true;
+}
+
+void SMTPortfolio::resetStatistics()
+{
+	m_statistics.assign(m_solvers.size(), {});
 }
 
 std::vector<std::string> SMTPortfolio::unhandledQueries()
@@ -22,8 +22,11 @@
 #include <libsmtutil/BMCSolverInterface.h>
 #include <libsolidity/interface/ReadFile.h>
 #include <libsolutil/FixedHash.h>
+#include <libsolutil/ThreadPool.h>
 
+#include <chrono>
 #include <map>
+#include <memory>
 #include <vector>
 
 namespace solidity::smtutil
@@ -34,6 +37,10 @@ namespace solidity::smtutil
  * propagating the functionalities to all solvers.
  * It also checks whether different solvers give conflicting answers
  * to SMT queries.
+ *
+ * In racing mode, the solvers are queried concurrently and the first one to answer
+ * determines the result. The other solvers are cancelled, optionally only after giving them
+ * some time to confirm or contradict the answer.
  */
 class SMTPortfolio: public BMCSolverInterface
 {
@@ -42,7 +49,25 @@ public:
 	SMTPortfolio(SMTPortfolio const&) = delete;
 	SMTPortfolio& operator=(SMTPortfolio const&) = delete;
 
-	SMTPortfolio(std::vector<std::unique_ptr<BMCSolverInterface>> solvers, std::optional<unsigned> _queryTimeout);
+	/// How one solver fared on the queries of the portfolio.
+	struct SolverStatistics
+	{
+		size_t queries = 0;
+		/// Number of queries for which this solver gave the first conclusive answer.
+		size_t firstAnswers = 0;
+		/// Number of queries for which this solver was cancelled before answering in racing mode.
+		size_t cancellations = 0;
+	};
+
+	/// @param _race whether to query the solvers concurrently instead of one after the other.
+	/// @param _crossCheckTime how long the remaining solvers may take to confirm the first answer
+	/// in racing mode before they are cancelled.
+	SMTPortfolio(
+		std::vector<std::unique_ptr<BMCSolverInterface>> solvers,
+		std::optional<unsigned> _queryTimeout,
+		bool _race = false,
+		std::chrono::milliseconds _crossCheckTime = {}
+	);
 
 	void reset() override;
 
@@ -60,10 +85,27 @@ public:
 
 	std::string dumpQuery(std::vector<Expression> const& _expressionsToEvaluate);
 
+	/// @returns the statistics of each solver, in the order of the solvers given to the constructor.
+	std::vector<SolverStatistics> const& statistics() const { return m_statistics; }
+	void resetStatistics();
+
 private:
 	static bool solverAnswered(CheckResult result);
+	/// Merges the answer of one more solver into the combined answer, see check().
+	/// @returns false if the combined answer cannot change anymore.
+	static bool combine(
+		std::pair<CheckResult, std::vector<std::string>>& _combined,
+		std::pair<CheckResult, std::vector<std::string>> _answer
+	);
+
+	std::pair<CheckResult, std::vector<std::string>> race(std::vector<Expression> const& _expressionsToEvaluate);
 
 	std::vector<std::unique_ptr<BMCSolverInterface>> m_solvers;
+	std::vector<SolverStatistics> m_statistics;
+
+	/// Only present in racing mode.
+	std::unique_ptr<util::ThreadPool> m_threadPool;
+	std::chrono::milliseconds m_crossCheckTime;
 
 	std::vector<Expression> m_assertions;
 };
@@ -35,6 +35,7 @@
 using namespace solidity;
 using namespace solidity::util;
 
+using solidity::frontend::ParsedSourceCache;
 using solidity::frontend::ReadCallback;
 using solidity::frontend::StandardCompiler;
 
@@ -45,6 +46,9 @@ namespace
 // this may potentially change the pointer that was passed to the caller from solidity_alloc().
 static std::list<std::string> solidityAllocations;
 
+/// Parsed sources kept across compilations, if enabled via solidity_set_parsed_source_cache().
+static std::shared_ptr<ParsedSourceCache> parsedSourceCache;
+
 /// Find the equivalent to @p _data in the list of allocations of solidity_alloc(),
 /// removes it from the list and returns its value.
 ///
@@ -108,6 +112,7 @@ ReadCallback::Callback wrapReadCallback(CStyleReadFileCallback _readCallback, vo
 std::string compile(std::string _input, CStyleReadFileCallback _readCallback, void* _readContext)
 {
 	StandardCompiler compiler(wrapReadCallback(_readCallback, _readContext));
+	compiler.setParsedSourceCache(parsedSourceCache);
 	return compiler.compile(std::move(_input));
 }
 
@@ -155,5 +160,22 @@ extern void solidity_reset() noexcept
 	// can be freed here.
 	yul::YulStringRepository::reset();
 	solidityAllocations.clear();
+	// The parsed source cache is kept on purpose. It does not refer to anything freed above.
+}
+
+extern void solidity_set_parsed_source_cache(size_t _memoryBudget) noexcept
+{
+	try
+	{
+		if (_memoryBudget == 0)
+			parsedSourceCache.reset();
+		else if (!parsedSourceCache || parsedSourceCache->memoryBudget() != _memoryBudget)
+			parsedSourceCache = std::make_shared<ParsedSourceCache>(_memoryBudget);
+	}
+	catch (...)
+	{
+		// Only std::bad_alloc() is possible here. Compiling without the cache is still fine.
+		parsedSourceCache.reset();
+	}
 }
 }
@@ -96,6 +96,13 @@ char* solidity_compile(char const* _input, CStyleReadFileCallback _readCallback,
 /// is invalid after calling this!
 void solidity_reset() SOLC_NOEXCEPT;
 
+/// Enables a cache of parsed sources that is kept across calls to solidity_compile() and
+/// solidity_reset(), so that sources that did not change are not parsed again.
+///
+/// @param _memoryBudget Approximate upper bound of the memory used by the cache in bytes.
+///                      Zero disables the cache and frees its memory.
+void solidity_set_parsed_source_cache(size_t _memoryBudget) SOLC_NOEXCEPT;
+
 #ifdef __cplusplus
 }
 #endif
@@ -330,6 +330,15 @@ ContractDefinitionAnnotation& ContractDefinition::annotation() const
 	return initAnnotation<ContractDefinitionAnnotation>();
 }
 
+void ContractDefinition::resetAnalysis() const
+{
+	ASTNode::resetAnalysis();
+	// The interface caches contain types and depend on the inheritance hierarchy.
+	m_interfaceFunctionList[false].reset();
+	m_interfaceFunctionList[true].reset();
+	m_interfaceEvents.reset();
+}
+
 ContractDefinition const* ContractDefinition::superContract(ContractDefinition const& _mostDerivedContract) const
 {
 	auto const& hierarchy = _mostDerivedContract.annotation().linearizedBaseContracts;
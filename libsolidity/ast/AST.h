@@ -79,6 +79,13 @@ public:
 
 	/// @returns an identifier of this AST node that is unique for a single compilation run.
 	int64_t id() const { return int64_t(m_id); }
+	/// Adds @a _offset to the identifier of this node. Only used to relocate trees that are
+	/// reused in another compilation run or were parsed separately.
+	void shiftID(int64_t _offset) { m_id = static_cast<size_t>(id() + _offset); }
+
+	/// Removes everything analysis attached to this node (but not to its children),
+	/// so that it can be analysed again in another compilation run.
+	virtual void resetAnalysis() const { m_annotation.reset(); }
 
 	virtual void accept(ASTVisitor& _visitor) = 0;
 	virtual void accept(ASTConstVisitor& _visitor) const = 0;
@@ -127,7 +134,7 @@ public:
 	virtual bool experimentalSolidityOnly() const { return false; }
 
 protected:
-	size_t const m_id = 0;
+	size_t m_id = 0;
 
 	template <class T>
 	T& initAnnotation() const
@@ -581,6 +588,7 @@ public:
 	Type const* type() const override;
 
 	ContractDefinitionAnnotation& annotation() const override;
+	void resetAnalysis() const override;
 
 	ContractKind contractKind() const { return m_contractKind; }
 
@@ -1587,6 +1595,9 @@ public:
 
 	yul::Dialect const& dialect() const { return m_dialect; }
 	yul::AST const& operations() const { return *m_operations; }
+	/// Replaces the operations by an equivalent copy. Only used to move the names of trees that are
+	/// reused in another compilation run into its Yul string repository, see ParsedSourceCache.
+	void replaceOperations(std::shared_ptr<yul::AST> _operations) { m_operations = std::move(_operations); }
 	ASTPointer<std::vector<ASTPointer<ASTString>>> const& flags() const { return m_flags; }
 
 	InlineAssemblyAnnotation& annotation() const override;
@@ -37,6 +37,7 @@
 
 #include <boost/algorithm/string/join.hpp>
 
+#include <sstream>
 #include <utility>
 #include <vector>
 #include <algorithm>
@@ -51,8 +52,8 @@ using namespace solidity;
 namespace
 {
 
-template<typename V, template<typename> typename C>
-void addIfSet(std::vector<std::pair<std::string, Json>>& _attributes, std::string const& _name, C<V> const& _value)
+template<typename Attributes, typename V, template<typename> typename C>
+void addIfSet(Attributes& _attributes, std::string const& _name, C<V> const& _value)
 {
 	if constexpr (std::is_same_v<C<V>, solidity::util::SetOnce<V>>)
 	{
@@ -83,31 +84,49 @@ ASTJsonExporter::ASTJsonExporter(CompilerStack::State _stackState, std::map<std:
 void ASTJsonExporter::setJsonNode(
 	ASTNode const& _node,
 	std::string const& _nodeName,
-	std::initializer_list<std::pair<std::string, Json>>&& _attributes
+	std::initializer_list<std::pair<std::string, MemberValue>>&& _attributes
 )
 {
 	ASTJsonExporter::setJsonNode(
 		_node,
 		_nodeName,
-		std::vector<std::pair<std::string, Json>>(std::move(_attributes))
+		Members(std::move(_attributes))
 	);
 }
 
 void ASTJsonExporter::setJsonNode(
 	ASTNode const& _node,
 	std::string const& _nodeType,
-	std::vector<std::pair<std::string, Json>>&& _attributes
+	Members&& _attributes
 )
 {
-	m_currentValue = Json::object();
-	m_currentValue["id"] = nodeId(_node);
-	m_currentValue["src"] = sourceLocationToString(_node.location());
+	m_currentMembers.clear();
+	m_currentMembers.reserve(_attributes.size() + 4);
+	m_currentMembers.emplace_back("id", nodeId(_node));
+	m_currentMembers.emplace_back("src", sourceLocationToString(_node.location()));
 	if (auto const* documented = dynamic_cast<Documented const*>(&_node))
 		if (documented->documentation())
-			m_currentValue["documentation"] = *documented->documentation();
-	m_currentValue["nodeType"] = _nodeType;
+			m_currentMembers.emplace_back("documentation", *documented->documentation());
+	m_currentMembers.emplace_back("nodeType", _nodeType);
 	for (auto& e: _attributes)
-		m_currentValue[e.first] = std::move(e.second);
+		m_currentMembers.emplace_back(std::move(e));
+
+	// Members are sorted by name like in a JSON object, and later ones replace earlier ones of the same name.
+	auto const byName = [](auto const& _a, auto const& _b) { return _a.first < _b.first; };
+	std::stable_sort(m_currentMembers.begin(), m_currentMembers.end(), byName);
+	auto const sameName = [](auto const& _a, auto const& _b) { return _a.first == _b.first; };
+	m_currentMembers.erase(
+		m_currentMembers.begin(),
+		std::unique(m_currentMembers.rbegin(), m_currentMembers.rend(), sameName).base()
+	);
+	// Null members are left out, like util::removeNullMembers() does.
+	auto const isNull = [](auto const& _member) {
+		return std::holds_alternative<Json>(_member.second) && std::get<Json>(_member.second).is_null();
+	};
+	m_currentMembers.erase(
+		std::remove_if(m_currentMembers.begin(), m_currentMembers.end(), isNull),
+		m_currentMembers.end()
+	);
 }
 
 std::optional<size_t> ASTJsonExporter::sourceIndexFromLocation(SourceLocation const& _location) const
@@ -164,11 +183,11 @@ Json ASTJsonExporter::typePointerToJson(std::optional<FuncCallArguments> const&
 }
 
 void ASTJsonExporter::appendExpressionAttributes(
-	std::vector<std::pair<std::string, Json>>& _attributes,
+	Members& _attributes,
 	ExpressionAnnotation const& _annotation
 )
 {
-	std::vector<std::pair<std::string, Json>> exprAttributes = {
+	Members exprAttributes = {
 		std::make_pair("typeDescriptions", typePointerToJson(_annotation.type)),
 		std::make_pair("argumentTypes", typePointerToJson(_annotation.arguments))
 	};
@@ -201,20 +220,108 @@ Json ASTJsonExporter::inlineAssemblyIdentifierToJson(std::pair<yul::Identifier c
 
 void ASTJsonExporter::print(std::ostream& _stream, ASTNode const& _node, util::JsonFormat const& _format)
 {
-	_stream << util::jsonPrint(toJson(_node), _format);
+	// Print into a buffer first, so that an exception does not leave a truncated AST on @a _stream.
+	std::ostringstream printed;
+	util::JsonStreamWriter writer(printed, _format);
+	print(writer, _node);
+	_stream << printed.str();
+}
+
+void ASTJsonExporter::print(util::JsonStreamWriter& _writer, ASTNode const& _node)
+{
+	writeNode(_writer, _node);
 }
 
 Json ASTJsonExporter::toJson(ASTNode const& _node)
+{
+	Members const members = nodeMembers(_node);
+	// Parameters of events are marked as indexed or not.
+	ScopedSaveAndRestore inEvent(m_inEvent, m_inEvent || dynamic_cast<EventDefinition const*>(&_node));
+	Json json = Json::object();
+	for (auto const& [name, value]: members)
+		json[name] = memberToJson(value);
+	return json;
+}
+
+ASTJsonExporter::Members ASTJsonExporter::nodeMembers(ASTNode const& _node)
 {
 	_node.accept(*this);
-	return util::removeNullMembers(std::move(m_currentValue));
+	return std::move(m_currentMembers);
+}
+
+Json ASTJsonExporter::memberToJson(MemberValue const& _value)
+{
+	return std::visit(util::GenericVisitor{
+		[](Json const& _json) { return util::removeNullMembers(_json); },
+		[&](ASTNode const* _node) { return toJson(*_node); },
+		[&](ChildNodes const& _nodes) {
+			Json array = Json::array();
+			for (ASTNode const* node: _nodes)
+				array.emplace_back(node ? toJson(*node) : Json());
+			return array;
+		}
+	}, _value);
+}
+
+void ASTJsonExporter::writeNode(util::JsonStreamWriter& _writer, ASTNode const& _node)
+{
+	Members const members = nodeMembers(_node);
+	ScopedSaveAndRestore inEvent(m_inEvent, m_inEvent || dynamic_cast<EventDefinition const*>(&_node));
+	_writer.beginObject();
+	for (auto const& [name, value]: members)
+	{
+		_writer.key(name);
+		writeMember(_writer, value);
+	}
+	_writer.endObject();
+}
+
+void ASTJsonExporter::writeMember(util::JsonStreamWriter& _writer, MemberValue const& _value)
+{
+	std::visit(util::GenericVisitor{
+		[&](Json const& _json) { writeValue(_writer, _json); },
+		[&](ASTNode const* _node) { writeNode(_writer, *_node); },
+		[&](ChildNodes const& _nodes) {
+			_writer.beginArray();
+			for (ASTNode const* node: _nodes)
+				if (node)
+					writeNode(_writer, *node);
+				else
+					_writer.value(Json());
+			_writer.endArray();
+		}
+	}, _value);
+}
+
+void ASTJsonExporter::writeValue(util::JsonStreamWriter& _writer, Json const& _value)
+{
+	if (_value.is_object())
+	{
+		_writer.beginObject();
+		for (auto const& [key, member]: _value.items())
+			if (!member.is_null())
+			{
+				_writer.key(key);
+				writeValue(_writer, member);
+			}
+		_writer.endObject();
+	}
+	else if (_value.is_array())
+	{
+		_writer.beginArray();
+		for (Json const& element: _value)
+			writeValue(_writer, element);
+		_writer.endArray();
+	}
+	else
+		_writer.value(_value);
 }
 
 bool ASTJsonExporter::visit(SourceUnit const& _node)
 {
-	std::vector<std::pair<std::string, Json>> attributes = {
+	Members attributes = {
 		std::make_pair("license", _node.licenseString() ? Json(*_node.licenseString()) : Json()),
-		std::make_pair("nodes", toJson(_node.nodes())),
+		std::make_pair("nodes", children(_node.nodes())),
 	};
 
 	if (_node.experimentalSolidity())
@@ -253,7 +360,7 @@ bool ASTJsonExporter::visit(PragmaDirective const& _node)
 
 bool ASTJsonExporter::visit(ImportDirective const& _node)
 {
-	std::vector<std::pair<std::string, Json>> attributes = {
+	Members attributes = {
 		std::make_pair("file", _node.path()),
 		std::make_pair("sourceUnit", idOrNull(_node.annotation().sourceUnit)),
 		std::make_pair("scope", idOrNull(_node.scope()))
@@ -281,18 +388,18 @@ bool ASTJsonExporter::visit(ImportDirective const& _node)
 
 bool ASTJsonExporter::visit(ContractDefinition const& _node)
 {
-	std::vector<std::pair<std::string, Json>> attributes = {
+	Members attributes = {
 		std::make_pair("name", _node.name()),
 		std::make_pair("nameLocation", sourceLocationToString(_node.nameLocation())),
-		std::make_pair("documentation", _node.documentation() ? toJson(*_node.documentation()) : Json()),
+		std::make_pair("documentation", child(_node.documentation())),
 		std::make_pair("contractKind", contractKind(_node.contractKind())),
 		std::make_pair("abstract", _node.abstract()),
-		std::make_pair("baseContracts", toJson(_node.baseContracts())),
+		std::make_pair("baseContracts", children(_node.baseContracts())),
 		std::make_pair("contractDependencies", getContainerIds(_node.annotation().contractDependencies | ranges::views::keys)),
 		// Do not require call graph because the AST is also created for incorrect sources.
 		std::make_pair("usedEvents", getContainerIds(_node.interfaceEvents(false))),
 		std::make_pair("usedErrors", getContainerIds(_node.interfaceErrors(false))),
-		std::make_pair("nodes", toJson(_node.subNodes())),
+		std::make_pair("nodes", children(_node.subNodes())),
 		std::make_pair("scope", idOrNull(_node.scope()))
 	};
 	addIfSet(attributes, "canonicalName", _node.annotation().canonicalName);
@@ -332,16 +439,16 @@ bool ASTJsonExporter::visit(IdentifierPath const& _node)
 bool ASTJsonExporter::visit(InheritanceSpecifier const& _node)
 {
 	setJsonNode(_node, "InheritanceSpecifier", {
-		std::make_pair("baseName", toJson(_node.name())),
-		std::make_pair("arguments", _node.arguments() ? toJson(*_node.arguments()) : Json())
+		std::make_pair("baseName", child(_node.name())),
+		std::make_pair("arguments", children(_node.arguments()))
 	});
 	return false;
 }
 
 bool ASTJsonExporter::visit(UsingForDirective const& _node)
 {
-	std::vector<std::pair<std::string, Json>> attributes = {
-		std::make_pair("typeName", _node.typeName() ? toJson(*_node.typeName()) : Json())
+	Members attributes = {
+		std::make_pair("typeName", child(_node.typeName()))
 	};
 
 	if (_node.usesBraces())
@@ -366,7 +473,7 @@ bool ASTJsonExporter::visit(UsingForDirective const& _node)
 		auto const& functionAndOperators = _node.functionsAndOperators();
 		solAssert(_node.functionsAndOperators().size() == 1);
 		solAssert(!functionAndOperators.front().second.has_value());
-		attributes.emplace_back("libraryName", toJson(*(functionAndOperators.front().first)));
+		attributes.emplace_back("libraryName", child(*(functionAndOperators.front().first)));
 	}
 	attributes.emplace_back("global", _node.global());
 
@@ -377,12 +484,12 @@ bool ASTJsonExporter::visit(UsingForDirective const& _node)
 
 bool ASTJsonExporter::visit(StructDefinition const& _node)
 {
-	std::vector<std::pair<std::string, Json>> attributes = {
+	Members attributes = {
 		std::make_pair("name", _node.name()),
 		std::make_pair("nameLocation", sourceLocationToString(_node.nameLocation())),
-		std::make_pair("documentation", _node.documentation() ? toJson(*_node.documentation()) : Json()),
+		std::make_pair("documentation", child(_node.documentation())),
 		std::make_pair("visibility", Declaration::visibilityToString(_node.visibility())),
-		std::make_pair("members", toJson(_node.members())),
+		std::make_pair("members", children(_node.members())),
 		std::make_pair("scope", idOrNull(_node.scope()))
 	};
 
@@ -395,11 +502,11 @@ bool ASTJsonExporter::visit(StructDefinition const& _node)
 
 bool ASTJsonExporter::visit(EnumDefinition const& _node)
 {
-	std::vector<std::pair<std::string, Json>> attributes = {
+	Members attributes = {
 		std::make_pair("name", _node.name()),
 		std::make_pair("nameLocation", sourceLocationToString(_node.nameLocation())),
-		std::make_pair("documentation", _node.documentation() ? toJson(*_node.documentation()) : Json()),
-		std::make_pair("members", toJson(_node.members()))
+		std::make_pair("documentation", child(_node.documentation())),
+		std::make_pair("members", children(_node.members()))
 	};
 
 	addIfSet(attributes,"canonicalName", _node.annotation().canonicalName);
@@ -421,10 +528,10 @@ bool ASTJsonExporter::visit(EnumValue const& _node)
 bool ASTJsonExporter::visit(UserDefinedValueTypeDefinition const& _node)
 {
 	solAssert(_node.underlyingType(), "");
-	std::vector<std::pair<std::string, Json>> attributes = {
+	Members attributes = {
 		std::make_pair("name", _node.name()),
 		std::make_pair("nameLocation", sourceLocationToString(_node.nameLocation())),
-		std::make_pair("underlyingType", toJson(*_node.underlyingType()))
+		std::make_pair("underlyingType", child(*_node.underlyingType()))
 	};
 	addIfSet(attributes, "canonicalName", _node.annotation().canonicalName);
 
@@ -436,7 +543,7 @@ bool ASTJsonExporter::visit(UserDefinedValueTypeDefinition const& _node)
 bool ASTJsonExporter::visit(ParameterList const& _node)
 {
 	setJsonNode(_node, "ParameterList", {
-		std::make_pair("parameters", toJson(_node.parameters()))
+		std::make_pair("parameters", children(_node.parameters()))
 	});
 	return false;
 }
@@ -444,25 +551,25 @@ bool ASTJsonExporter::visit(ParameterList const& _node)
 bool ASTJsonExporter::visit(OverrideSpecifier const& _node)
 {
 	setJsonNode(_node, "OverrideSpecifier", {
-		std::make_pair("overrides", toJson(_node.overrides()))
+		std::make_pair("overrides", children(_node.overrides()))
 	});
 	return false;
 }
 
 bool ASTJsonExporter::visit(FunctionDefinition const& _node)
 {
-	std::vector<std::pair<std::string, Json>> attributes = {
+	Members attributes = {
 		std::make_pair("name", _node.name()),
 		std::make_pair("nameLocation", sourceLocationToString(_node.nameLocation())),
-		std::make_pair("documentation", _node.documentation() ? toJson(*_node.documentation()) : Json()),
+		std::make_pair("documentation", child(_node.documentation())),
 		std::make_pair("kind", _node.isFree() ? "freeFunction" : TokenTraits::toString(_node.kind())),
 		std::make_pair("stateMutability", stateMutabilityToString(_node.stateMutability())),
 		std::make_pair("virtual", _node.markedVirtual()),
-		std::make_pair("overrides", _node.overrides() ? toJson(*_node.overrides()) : Json()),
-		std::make_pair("parameters", toJson(_node.parameterList())),
-		std::make_pair("returnParameters", toJson(*_node.returnParameterList())),
-		std::make_pair("modifiers", toJson(_node.modifiers())),
-		std::make_pair("body", _node.isImplemented() ? toJson(_node.body()) : Json()),
+		std::make_pair("overrides", child(_node.overrides())),
+		std::make_pair("parameters", child(_node.parameterList())),
+		std::make_pair("returnParameters", child(*_node.returnParameterList())),
+		std::make_pair("modifiers", children(_node.modifiers())),
+		std::make_pair("body", child(_node.isImplemented() ? &_node.body() : nullptr)),
 		std::make_pair("implemented", _node.isImplemented()),
 		std::make_pair("scope", idOrNull(_node.scope()))
 	};
@@ -490,24 +597,24 @@ bool ASTJsonExporter::visit(FunctionDefinition const& _node)
 
 bool ASTJsonExporter::visit(VariableDeclaration const& _node)
 {
-	std::vector<std::pair<std::string, Json>> attributes = {
+	Members attributes = {
 		std::make_pair("name", _node.name()),
 		std::make_pair("nameLocation", sourceLocationToString(_node.nameLocation())),
-		std::make_pair("typeName", toJson(_node.typeName())),
+		std::make_pair("typeName", child(_node.typeName())),
 		std::make_pair("constant", _node.isConstant()),
 		std::make_pair("mutability", VariableDeclaration::mutabilityToString(_node.mutability())),
 		std::make_pair("stateVariable", _node.isStateVariable()),
 		std::make_pair("storageLocation", location(_node.referenceLocation())),
-		std::make_pair("overrides", _node.overrides() ? toJson(*_node.overrides()) : Json()),
+		std::make_pair("overrides", child(_node.overrides())),
 		std::make_pair("visibility", Declaration::visibilityToString(_node.visibility())),
-		std::make_pair("value", _node.value() ? toJson(*_node.value()) : Json()),
+		std::make_pair("value", child(_node.value())),
 		std::make_pair("scope", idOrNull(_node.scope())),
 		std::make_pair("typeDescriptions", typePointerToJson(_node.annotation().type, true))
 	};
 	if (_node.isStateVariable() && _node.isPublic())
 		attributes.emplace_back("functionSelector", _node.externalIdentifierHex());
 	if (_node.isStateVariable() && _node.documentation())
-		attributes.emplace_back("documentation", toJson(*_node.documentation()));
+		attributes.emplace_back("documentation", child(*_node.documentation()));
 	if (m_inEvent)
 		attributes.emplace_back("indexed", _node.isIndexed());
 	if (!_node.annotation().baseFunctions.empty())
@@ -518,15 +625,15 @@ bool ASTJsonExporter::visit(VariableDeclaration const& _node)
 
 bool ASTJsonExporter::visit(ModifierDefinition const& _node)
 {
-	std::vector<std::pair<std::string, Json>> attributes = {
+	Members attributes = {
 		std::make_pair("name", _node.name()),
 		std::make_pair("nameLocation", sourceLocationToString(_node.nameLocation())),
-		std::make_pair("documentation", _node.documentation() ? toJson(*_node.documentation()) : Json()),
+		std::make_pair("documentation", child(_node.documentation())),
 		std::make_pair("visibility", Declaration::visibilityToString(_node.visibility())),
-		std::make_pair("parameters", toJson(_node.parameterList())),
+		std::make_pair("parameters", child(_node.parameterList())),
 		std::make_pair("virtual", _node.markedVirtual()),
-		std::make_pair("overrides", _node.overrides() ? toJson(*_node.overrides()) : Json()),
-		std::make_pair("body", _node.isImplemented() ? toJson(_node.body()) : Json())
+		std::make_pair("overrides", child(_node.overrides())),
+		std::make_pair("body", child(_node.isImplemented() ? &_node.body() : nullptr))
 	};
 	if (!_node.annotation().baseFunctions.empty())
 		attributes.emplace_back(std::make_pair("baseModifiers", getContainerIds(_node.annotation().baseFunctions, true)));
@@ -536,9 +643,9 @@ bool ASTJsonExporter::visit(ModifierDefinition const& _node)
 
 bool ASTJsonExporter::visit(ModifierInvocation const& _node)
 {
-	std::vector<std::pair<std::string, Json>> attributes{
-		std::make_pair("modifierName", toJson(_node.name())),
-		std::make_pair("arguments", _node.arguments() ? toJson(*_node.arguments()) : Json())
+	Members attributes{
+		std::make_pair("modifierName", child(_node.name())),
+		std::make_pair("arguments", children(_node.arguments()))
 	};
 	if (Declaration const* declaration = _node.name().annotation().referencedDeclaration)
 	{
@@ -553,12 +660,11 @@ bool ASTJsonExporter::visit(ModifierInvocation const& _node)
 
 bool ASTJsonExporter::visit(EventDefinition const& _node)
 {
-	m_inEvent = true;
-	std::vector<std::pair<std::string, Json>> _attributes = {
+	Members _attributes = {
 		std::make_pair("name", _node.name()),
 		std::make_pair("nameLocation", sourceLocationToString(_node.nameLocation())),
-		std::make_pair("documentation", _node.documentation() ? toJson(*_node.documentation()) : Json()),
-		std::make_pair("parameters", toJson(_node.parameterList())),
+		std::make_pair("documentation", child(_node.documentation())),
+		std::make_pair("parameters", child(_node.parameterList())),
 		std::make_pair("anonymous", _node.isAnonymous())
 	};
 	if (m_stackState >= CompilerStack::State::AnalysisSuccessful)
@@ -574,11 +680,11 @@ bool ASTJsonExporter::visit(EventDefinition const& _node)
 
 bool ASTJsonExporter::visit(ErrorDefinition const& _node)
 {
-	std::vector<std::pair<std::string, Json>> _attributes = {
+	Members _attributes = {
 		std::make_pair("name", _node.name()),
 		std::make_pair("nameLocation", sourceLocationToString(_node.nameLocation())),
-		std::make_pair("documentation", _node.documentation() ? toJson(*_node.documentation()) : Json()),
-		std::make_pair("parameters", toJson(_node.parameterList()))
+		std::make_pair("documentation", child(_node.documentation())),
+		std::make_pair("parameters", child(_node.parameterList()))
 	};
 	if (m_stackState >= CompilerStack::State::AnalysisSuccessful)
 		_attributes.emplace_back(std::make_pair("errorSelector", _node.functionType(true)->externalIdentifierHex()));
@@ -589,7 +695,7 @@ bool ASTJsonExporter::visit(ErrorDefinition const& _node)
 
 bool ASTJsonExporter::visit(ElementaryTypeName const& _node)
 {
-	std::vector<std::pair<std::string, Json>> attributes = {
+	Members attributes = {
 		std::make_pair("name", _node.typeName().toString()),
 		std::make_pair("typeDescriptions", typePointerToJson(_node.annotation().type, true))
 	};
@@ -604,7 +710,7 @@ bool ASTJsonExporter::visit(ElementaryTypeName const& _node)
 bool ASTJsonExporter::visit(UserDefinedTypeName const& _node)
 {
 	setJsonNode(_node, "UserDefinedTypeName", {
-		std::make_pair("pathNode", toJson(_node.pathNode())),
+		std::make_pair("pathNode", child(_node.pathNode())),
 		std::make_pair("referencedDeclaration", idOrNull(_node.pathNode().annotation().referencedDeclaration)),
 		std::make_pair("typeDescriptions", typePointerToJson(_node.annotation().type, true))
 	});
@@ -616,8 +722,8 @@ bool ASTJsonExporter::visit(FunctionTypeName const& _node)
 	setJsonNode(_node, "FunctionTypeName", {
 		std::make_pair("visibility", Declaration::visibilityToString(_node.visibility())),
 		std::make_pair("stateMutability", stateMutabilityToString(_node.stateMutability())),
-		std::make_pair("parameterTypes", toJson(*_node.parameterTypeList())),
-		std::make_pair("returnParameterTypes", toJson(*_node.returnParameterTypeList())),
+		std::make_pair("parameterTypes", child(*_node.parameterTypeList())),
+		std::make_pair("returnParameterTypes", child(*_node.returnParameterTypeList())),
 		std::make_pair("typeDescriptions", typePointerToJson(_node.annotation().type, true))
 	});
 	return false;
@@ -626,10 +732,10 @@ bool ASTJsonExporter::visit(FunctionTypeName const& _node)
 bool ASTJsonExporter::visit(Mapping const& _node)
 {
 	setJsonNode(_node, "Mapping", {
-		std::make_pair("keyType", toJson(_node.keyType())),
+		std::make_pair("keyType", child(_node.keyType())),
 		std::make_pair("keyName", _node.keyName()),
 		std::make_pair("keyNameLocation", sourceLocationToString(_node.keyNameLocation())),
-		std::make_pair("valueType", toJson(_node.valueType())),
+		std::make_pair("valueType", child(_node.valueType())),
 		std::make_pair("valueName", _node.valueName()),
 		std::make_pair("valueNameLocation", sourceLocationToString(_node.valueNameLocation())),
 		std::make_pair("typeDescriptions", typePointerToJson(_node.annotation().type, true))
@@ -640,8 +746,8 @@ bool ASTJsonExporter::visit(Mapping const& _node)
 bool ASTJsonExporter::visit(ArrayTypeName const& _node)
 {
 	setJsonNode(_node, "ArrayTypeName", {
-		std::make_pair("baseType", toJson(_node.baseType())),
-		std::make_pair("length", toJsonOrNull(_node.length())),
+		std::make_pair("baseType", child(_node.baseType())),
+		std::make_pair("length", child(_node.length())),
 		std::make_pair("typeDescriptions", typePointerToJson(_node.annotation().type, true))
 	});
 	return false;
@@ -666,7 +772,7 @@ bool ASTJsonExporter::visit(InlineAssembly const& _node)
 
 	auto const& evmDialect = dynamic_cast<solidity::yul::EVMDialect const&>(_node.dialect());
 
-	std::vector<std::pair<std::string, Json>> attributes = {
+	Members attributes = {
 		std::make_pair("AST", Json(yul::AsmJsonConverter(evmDialect, sourceIndexFromLocation(_node.location()))(_node.operations().root()))),
 		std::make_pair("externalReferences", std::move(externalReferencesJson)),
 		std::make_pair("evmVersion", evmDialect.evmVersion().name())
@@ -697,7 +803,7 @@ bool ASTJsonExporter::visit(InlineAssembly const& _node)
 bool ASTJsonExporter::visit(Block const& _node)
 {
 	setJsonNode(_node, _node.unchecked() ? "UncheckedBlock" : "Block", {
-		std::make_pair("statements", toJson(_node.statements()))
+		std::make_pair("statements", children(_node.statements()))
 	});
 	return false;
 }
@@ -711,9 +817,9 @@ bool ASTJsonExporter::visit(PlaceholderStatement const& _node)
 bool ASTJsonExporter::visit(IfStatement const& _node)
 {
 	setJsonNode(_node, "IfStatement", {
-		std::make_pair("condition", toJson(_node.condition())),
-		std::make_pair("trueBody", toJson(_node.trueStatement())),
-		std::make_pair("falseBody", toJsonOrNull(_node.falseStatement()))
+		std::make_pair("condition", child(_node.condition())),
+		std::make_pair("trueBody", child(_node.trueStatement())),
+		std::make_pair("falseBody", child(_node.falseStatement()))
 	});
 	return false;
 }
@@ -722,8 +828,8 @@ bool ASTJsonExporter::visit(TryCatchClause const& _node)
 {
 	setJsonNode(_node, "TryCatchClause", {
 		std::make_pair("errorName", _node.errorName()),
-		std::make_pair("parameters", toJsonOrNull(_node.parameters())),
-		std::make_pair("block", toJson(_node.block()))
+		std::make_pair("parameters", child(_node.parameters())),
+		std::make_pair("block", child(_node.block()))
 	});
 	return false;
 }
@@ -731,8 +837,8 @@ bool ASTJsonExporter::visit(TryCatchClause const& _node)
 bool ASTJsonExporter::visit(TryStatement const& _node)
 {
 	setJsonNode(_node, "TryStatement", {
-		std::make_pair("externalCall", toJson(_node.externalCall())),
-		std::make_pair("clauses", toJson(_node.clauses()))
+		std::make_pair("externalCall", child(_node.externalCall())),
+		std::make_pair("clauses", children(_node.clauses()))
 	});
 	return false;
 }
@@ -743,8 +849,8 @@ bool ASTJsonExporter::visit(WhileStatement const& _node)
 		_node,
 		_node.isDoWhile() ? "DoWhileStatement" : "WhileStatement",
 		{
-			std::make_pair("condition", toJson(_node.condition())),
-			std::make_pair("body", toJson(_node.body()))
+			std::make_pair("condition", child(_node.condition())),
+			std::make_pair("body", child(_node.body()))
 		}
 	);
 	return false;
@@ -753,11 +859,11 @@ bool ASTJsonExporter::visit(WhileStatement const& _node)
 bool ASTJsonExporter::visit(ForStatement const& _node)
 {
 
-	std::vector<std::pair<std::string, Json>> attributes = {
-		std::make_pair("initializationExpression", toJsonOrNull(_node.initializationExpression())),
-		std::make_pair("condition", toJsonOrNull(_node.condition())),
-		std::make_pair("loopExpression", toJsonOrNull(_node.loopExpression())),
-		std::make_pair("body", toJson(_node.body()))
+	Members attributes = {
+		std::make_pair("initializationExpression", child(_node.initializationExpression())),
+		std::make_pair("condition", child(_node.condition())),
+		std::make_pair("loopExpression", child(_node.loopExpression())),
+		std::make_pair("body", child(_node.body()))
 	};
 
 	if (_node.annotation().isSimpleCounterLoop.set())
@@ -782,7 +888,7 @@ bool ASTJsonExporter::visit(Break const& _node)
 bool ASTJsonExporter::visit(Return const& _node)
 {
 	setJsonNode(_node, "Return", {
-		std::make_pair("expression", toJsonOrNull(_node.expression())),
+		std::make_pair("expression", child(_node.expression())),
 		std::make_pair("functionReturnParameters", idOrNull(_node.annotation().functionReturnParameters))
 	});
 	return false;
@@ -797,7 +903,7 @@ bool ASTJsonExporter::visit(Throw const& _node)
 bool ASTJsonExporter::visit(EmitStatement const& _node)
 {
 	setJsonNode(_node, "EmitStatement", {
-		std::make_pair("eventCall", toJson(_node.eventCall()))
+		std::make_pair("eventCall", child(_node.eventCall()))
 	});
 	return false;
 }
@@ -805,7 +911,7 @@ bool ASTJsonExporter::visit(EmitStatement const& _node)
 bool ASTJsonExporter::visit(RevertStatement const& _node)
 {
 	setJsonNode(_node, "RevertStatement", {
-		std::make_pair("errorCall", toJson(_node.errorCall()))
+		std::make_pair("errorCall", child(_node.errorCall()))
 	});
 	return false;
 }
@@ -817,8 +923,8 @@ bool ASTJsonExporter::visit(VariableDeclarationStatement const& _node)
 		appendMove(varDecs, idOrNull(v.get()));
 	setJsonNode(_node, "VariableDeclarationStatement", {
 		std::make_pair("assignments", std::move(varDecs)),
-		std::make_pair("declarations", toJson(_node.declarations())),
-		std::make_pair("initialValue", toJsonOrNull(_node.initialValue()))
+		std::make_pair("declarations", children(_node.declarations())),
+		std::make_pair("initialValue", child(_node.initialValue()))
 	});
 	return false;
 }
@@ -826,17 +932,17 @@ bool ASTJsonExporter::visit(VariableDeclarationStatement const& _node)
 bool ASTJsonExporter::visit(ExpressionStatement const& _node)
 {
 	setJsonNode(_node, "ExpressionStatement", {
-		std::make_pair("expression", toJson(_node.expression()))
+		std::make_pair("expression", child(_node.expression()))
 	});
 	return false;
 }
 
 bool ASTJsonExporter::visit(Conditional const& _node)
 {
-	std::vector<std::pair<std::string, Json>> attributes = {
-		std::make_pair("condition", toJson(_node.condition())),
-		std::make_pair("trueExpression", toJson(_node.trueExpression())),
-		std::make_pair("falseExpression", toJson(_node.falseExpression()))
+	Members attributes = {
+		std::make_pair("condition", child(_node.condition())),
+		std::make_pair("trueExpression", child(_node.trueExpression())),
+		std::make_pair("falseExpression", child(_node.falseExpression()))
 	};
 	appendExpressionAttributes(attributes, _node.annotation());
 	setJsonNode(_node, "Conditional", std::move(attributes));
@@ -845,10 +951,10 @@ bool ASTJsonExporter::visit(Conditional const& _node)
 
 bool ASTJsonExporter::visit(Assignment const& _node)
 {
-	std::vector<std::pair<std::string, Json>> attributes = {
+	Members attributes = {
 		std::make_pair("operator", TokenTraits::toString(_node.assignmentOperator())),
-		std::make_pair("leftHandSide", toJson(_node.leftHandSide())),
-		std::make_pair("rightHandSide", toJson(_node.rightHandSide()))
+		std::make_pair("leftHandSide", child(_node.leftHandSide())),
+		std::make_pair("rightHandSide", child(_node.rightHandSide()))
 	};
 	appendExpressionAttributes(attributes, _node.annotation());
 	setJsonNode(_node, "Assignment", std::move(attributes));
@@ -857,9 +963,9 @@ bool ASTJsonExporter::visit(Assignment const& _node)
 
 bool ASTJsonExporter::visit(TupleExpression const& _node)
 {
-	std::vector<std::pair<std::string, Json>> attributes = {
+	Members attributes = {
 		std::make_pair("isInlineArray", Json(_node.isInlineArray())),
-		std::make_pair("components", toJson(_node.components())),
+		std::make_pair("components", children(_node.components())),
 	};
 	appendExpressionAttributes(attributes, _node.annotation());
 	setJsonNode(_node, "TupleExpression", std::move(attributes));
@@ -868,10 +974,10 @@ bool ASTJsonExporter::visit(TupleExpression const& _node)
 
 bool ASTJsonExporter::visit(UnaryOperation const& _node)
 {
-	std::vector<std::pair<std::string, Json>> attributes = {
+	Members attributes = {
 		std::make_pair("prefix", _node.isPrefixOperation()),
 		std::make_pair("operator", TokenTraits::toString(_node.getOperator())),
-		std::make_pair("subExpression", toJson(_node.subExpression()))
+		std::make_pair("subExpression", child(_node.subExpression()))
 	};
 	// NOTE: This annotation is guaranteed to be set but only if we didn't stop at the parsing stage.
 	if (_node.annotation().userDefinedFunction.set() && *_node.annotation().userDefinedFunction != nullptr)
@@ -883,10 +989,10 @@ bool ASTJsonExporter::visit(UnaryOperation const& _node)
 
 bool ASTJsonExporter::visit(BinaryOperation const& _node)
 {
-	std::vector<std::pair<std::string, Json>> attributes = {
+	Members attributes = {
 		std::make_pair("operator", TokenTraits::toString(_node.getOperator())),
-		std::make_pair("leftExpression", toJson(_node.leftExpression())),
-		std::make_pair("rightExpression", toJson(_node.rightExpression())),
+		std::make_pair("leftExpression", child(_node.leftExpression())),
+		std::make_pair("rightExpression", child(_node.rightExpression())),
 		std::make_pair("commonType", typePointerToJson(_node.annotation().commonType)),
 	};
 	// NOTE: This annotation is guaranteed to be set but only if we didn't stop at the parsing stage.
@@ -902,11 +1008,11 @@ bool ASTJsonExporter::visit(FunctionCall const& _node)
 	Json names = Json::array();
 	for (auto const& name: _node.names())
 		names.push_back(Json(*name));
-	std::vector<std::pair<std::string, Json>> attributes = {
-		std::make_pair("expression", toJson(_node.expression())),
+	Members attributes = {
+		std::make_pair("expression", child(_node.expression())),
 		std::make_pair("names", std::move(names)),
 		std::make_pair("nameLocations", sourceLocationsToJson(_node.nameLocations())),
-		std::make_pair("arguments", toJson(_node.arguments())),
+		std::make_pair("arguments", children(_node.arguments())),
 		std::make_pair("tryCall", _node.annotation().tryCall)
 	};
 
@@ -927,10 +1033,10 @@ bool ASTJsonExporter::visit(FunctionCallOptions const& _node)
 	for (auto const& name: _node.names())
 		names.emplace_back(Json(*name));
 
-	std::vector<std::pair<std::string, Json>> attributes = {
-		std::make_pair("expression", toJson(_node.expression())),
+	Members attributes = {
+		std::make_pair("expression", child(_node.expression())),
 		std::make_pair("names", std::move(names)),
-		std::make_pair("options", toJson(_node.options())),
+		std::make_pair("options", children(_node.options())),
 	};
 	appendExpressionAttributes(attributes, _node.annotation());
 
@@ -940,8 +1046,8 @@ bool ASTJsonExporter::visit(FunctionCallOptions const& _node)
 
 bool ASTJsonExporter::visit(NewExpression const& _node)
 {
-	std::vector<std::pair<std::string, Json>> attributes = {
-		std::make_pair("typeName", toJson(_node.typeName()))
+	Members attributes = {
+		std::make_pair("typeName", child(_node.typeName()))
 	};
 	appendExpressionAttributes(attributes, _node.annotation());
 	setJsonNode(_node, "NewExpression", std::move(attributes));
@@ -950,10 +1056,10 @@ bool ASTJsonExporter::visit(NewExpression const& _node)
 
 bool ASTJsonExporter::visit(MemberAccess const& _node)
 {
-	std::vector<std::pair<std::string, Json>> attributes = {
+	Members attributes = {
 		std::make_pair("memberName", _node.memberName()),
 		std::make_pair("memberLocation", Json(sourceLocationToString(_node.memberLocation()))),
-		std::make_pair("expression", toJson(_node.expression())),
+		std::make_pair("expression", child(_node.expression())),
 		std::make_pair("referencedDeclaration", idOrNull(_node.annotation().referencedDeclaration)),
 	};
 	appendExpressionAttributes(attributes, _node.annotation());
@@ -963,9 +1069,9 @@ bool ASTJsonExporter::visit(MemberAccess const& _node)
 
 bool ASTJsonExporter::visit(IndexAccess const& _node)
 {
-	std::vector<std::pair<std::string, Json>> attributes = {
-		std::make_pair("baseExpression", toJson(_node.baseExpression())),
-		std::make_pair("indexExpression", toJsonOrNull(_node.indexExpression())),
+	Members attributes = {
+		std::make_pair("baseExpression", child(_node.baseExpression())),
+		std::make_pair("indexExpression", child(_node.indexExpression())),
 	};
 	appendExpressionAttributes(attributes, _node.annotation());
 	setJsonNode(_node, "IndexAccess", std::move(attributes));
@@ -974,10 +1080,10 @@ bool ASTJsonExporter::visit(IndexAccess const& _node)
 
 bool ASTJsonExporter::visit(IndexRangeAccess const& _node)
 {
-	std::vector<std::pair<std::string, Json>> attributes = {
-		std::make_pair("baseExpression", toJson(_node.baseExpression())),
-		std::make_pair("startExpression", toJsonOrNull(_node.startExpression())),
-		std::make_pair("endExpression", toJsonOrNull(_node.endExpression())),
+	Members attributes = {
+		std::make_pair("baseExpression", child(_node.baseExpression())),
+		std::make_pair("startExpression", child(_node.startExpression())),
+		std::make_pair("endExpression", child(_node.endExpression())),
 	};
 	appendExpressionAttributes(attributes, _node.annotation());
 	setJsonNode(_node, "IndexRangeAccess", std::move(attributes));
@@ -1001,8 +1107,8 @@ bool ASTJsonExporter::visit(Identifier const& _node)
 
 bool ASTJsonExporter::visit(ElementaryTypeNameExpression const& _node)
 {
-	std::vector<std::pair<std::string, Json>> attributes = {
-		std::make_pair("typeName", toJson(_node.type()))
+	Members attributes = {
+		std::make_pair("typeName", child(_node.type()))
 	};
 	appendExpressionAttributes(attributes, _node.annotation());
 	setJsonNode(_node, "ElementaryTypeNameExpression", std::move(attributes));
@@ -1015,7 +1121,7 @@ bool ASTJsonExporter::visit(Literal const& _node)
 	if (!util::validateUTF8(_node.value()))
 		value = Json();
 	Token subdenomination = Token(_node.subDenomination());
-	std::vector<std::pair<std::string, Json>> attributes = {
+	Members attributes = {
 		std::make_pair("kind", literalTokenKind(_node.token())),
 		std::make_pair("value", value),
 		std::make_pair("hexValue", util::toHex(util::asBytes(_node.value()))),
@@ -1034,18 +1140,13 @@ bool ASTJsonExporter::visit(Literal const& _node)
 bool ASTJsonExporter::visit(StructuredDocumentation const& _node)
 {
 	Json text = *_node.text();
-	std::vector<std::pair<std::string, Json>> attributes = {
+	Members attributes = {
 		std::make_pair("text", text)
 	};
 	setJsonNode(_node, "StructuredDocumentation", std::move(attributes));
 	return false;
 }
 
-void ASTJsonExporter::endVisit(EventDefinition const&)
-{
-	m_inEvent = false;
-}
-
 bool ASTJsonExporter::visitNode(ASTNode const& _node)
 {
 	solAssert(false, _node.experimentalSolidityOnly() ?
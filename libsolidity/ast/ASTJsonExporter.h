@@ -34,6 +34,7 @@
 #include <optional>
 #include <ostream>
 #include <stack>
+#include <variant>
 #include <vector>
 
 namespace solidity::langutil
@@ -57,8 +58,11 @@ public:
 		CompilerStack::State _stackState,
 		std::map<std::string, unsigned> _sourceIndices = std::map<std::string, unsigned>()
 	);
-	/// Output the json representation of the AST to _stream.
+	/// Output the json representation of the AST to _stream. Nothing is written if printing fails.
 	void print(std::ostream& _stream, ASTNode const& _node, util::JsonFormat const& _format);
+	/// Writes the json representation of the AST to @a _writer node by node, without converting
+	/// the AST via toJson() first. The text is the same as the one of toJson().
+	void print(util::JsonStreamWriter& _writer, ASTNode const& _node);
 	Json toJson(ASTNode const& _node);
 	template <class T>
 	Json toJson(std::vector<ASTPointer<T>> const& _nodes)
@@ -127,20 +131,28 @@ public:
 	bool visit(Literal const& _node) override;
 	bool visit(StructuredDocumentation const& _node) override;
 
-	void endVisit(EventDefinition const&) override;
-
 	bool visitNode(ASTNode const& _node) override;
 private:
+	/// Value of a member of the JSON of a node. Child nodes are only visited when the member is
+	/// converted or written, which allows print() to write them in place. Missing children in
+	/// a list of children become null.
+	using ChildNodes = std::vector<ASTNode const*>;
+	using MemberValue = std::variant<Json, ASTNode const*, ChildNodes>;
+	using Members = std::vector<std::pair<std::string, MemberValue>>;
+
 	void setJsonNode(
 		ASTNode const& _node,
 		std::string const& _nodeName,
-		std::initializer_list<std::pair<std::string, Json>>&& _attributes
+		std::initializer_list<std::pair<std::string, MemberValue>>&& _attributes
 	);
 	void setJsonNode(
 		ASTNode const& _node,
 		std::string const& _nodeName,
-		std::vector<std::pair<std::string, Json>>&& _attributes
+		Members&& _attributes
 	);
+	/// Visits @a _node and @returns the members of its JSON, sorted by name.
+	Members nodeMembers(ASTNode const& _node);
+	Json memberToJson(MemberValue const& _value);
 	/// Maps source location to an index, if source is valid and a mapping does exist, otherwise returns std::nullopt.
 	std::optional<size_t> sourceIndexFromLocation(langutil::SourceLocation const& _location) const;
 	std::string sourceLocationToString(langutil::SourceLocation const& _location) const;
@@ -150,10 +162,37 @@ private:
 	{
 		return _pt ? Json(nodeId(*_pt)) : Json();
 	}
-	Json toJsonOrNull(ASTNode const* _node)
+	static MemberValue child(ASTNode const& _node)
+	{
+		return &_node;
+	}
+	static MemberValue child(ASTNode const* _node)
+	{
+		return _node ? MemberValue(_node) : MemberValue(Json());
+	}
+	template <class T>
+	static MemberValue child(ASTPointer<T> const& _node)
+	{
+		return child(_node.get());
+	}
+	template <class T>
+	static MemberValue children(std::vector<ASTPointer<T>> const& _nodes)
+	{
+		ChildNodes nodes;
+		for (auto const& node: _nodes)
+			nodes.push_back(node.get());
+		return nodes;
+	}
+	template <class T>
+	static MemberValue children(std::vector<ASTPointer<T>> const* _nodes)
 	{
-		return _node ? toJson(*_node) : Json();
+		return _nodes ? children(*_nodes) : MemberValue(Json());
 	}
+	/// Writes @a _node and its children to @a _writer.
+	void writeNode(util::JsonStreamWriter& _writer, ASTNode const& _node);
+	void writeMember(util::JsonStreamWriter& _writer, MemberValue const& _value);
+	/// Writes @a _value to @a _writer, dropping null members like util::removeNullMembers().
+	static void writeValue(util::JsonStreamWriter& _writer, Json const& _value);
 	Json inlineAssemblyIdentifierToJson(std::pair<yul::Identifier const* , InlineAssemblyAnnotation::ExternalIdentifierInfo> _info) const;
 	static std::string location(VariableDeclaration::Location _location);
 	static std::string contractKind(ContractKind _kind);
@@ -186,7 +225,7 @@ private:
 	static Json typePointerToJson(Type const* _tp, bool _withoutDataLocation = false);
 	static Json typePointerToJson(std::optional<FuncCallArguments> const& _tps);
 	void appendExpressionAttributes(
-		std::vector<std::pair<std::string, Json>> &_attributes,
+		Members& _attributes,
 		ExpressionAnnotation const& _annotation
 	);
 	static void appendMove(Json& _array, Json&& _value)
@@ -197,7 +236,7 @@ private:
 
 	CompilerStack::State m_stackState = CompilerStack::State::Empty; ///< Used to only access information that already exists
 	bool m_inEvent = false; ///< whether we are currently inside an event or not
-	Json m_currentValue;
+	Members m_currentMembers;
 	std::map<std::string, unsigned> m_sourceIndices;
 };
 
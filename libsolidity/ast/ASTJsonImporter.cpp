@@ -37,6 +37,8 @@
 #include <boost/algorithm/string/split.hpp>
 #include <boost/algorithm/string.hpp>
 
+#include <range/v3/algorithm/binary_search.hpp>
+
 namespace solidity::frontend
 {
 
@@ -56,17 +58,34 @@ ASTPointer<T> ASTJsonImporter::nullOrCast(Json const& _json)
 
 std::map<std::string, ASTPointer<SourceUnit>> ASTJsonImporter::jsonToSourceUnit(std::map<std::string, Json> const& _sourceList)
 {
+	std::set<std::string> sourceNames;
 	for (auto const& src: _sourceList)
-		m_sourceNames.emplace_back(std::make_shared<std::string const>(src.first));
+		sourceNames.insert(src.first);
+	setSourceNames(sourceNames);
 	for (auto const& srcPair: _sourceList)
-	{
-		astAssert(!srcPair.second.is_null());
-		astAssert(member(srcPair.second,"nodeType") == "SourceUnit", "The 'nodeType' of the highest node must be 'SourceUnit'.");
-		m_sourceUnits[srcPair.first] = createSourceUnit(srcPair.second, srcPair.first);
-	}
+		jsonToSourceUnit(srcPair.first, srcPair.second);
 	return m_sourceUnits;
 }
 
+void ASTJsonImporter::setSourceNames(std::set<std::string> const& _sourceNames)
+{
+	solAssert(m_sourceNames.empty());
+	for (std::string const& sourceName: _sourceNames)
+		m_sourceNames.emplace_back(std::make_shared<std::string const>(sourceName));
+}
+
+ASTPointer<SourceUnit> ASTJsonImporter::jsonToSourceUnit(std::string const& _sourceName, Json const& _ast)
+{
+	astAssert(
+		ranges::binary_search(m_sourceNames, _sourceName, std::less<>{}, [](auto const& _name) -> std::string const& { return *_name; }),
+		"Unexpected source."
+	);
+	astAssert(!m_sourceUnits.count(_sourceName), "All sources must have unique names");
+	astAssert(!_ast.is_null());
+	astAssert(member(_ast, "nodeType") == "SourceUnit", "The 'nodeType' of the highest node must be 'SourceUnit'.");
+	return m_sourceUnits[_sourceName] = createSourceUnit(_ast, _sourceName);
+}
+
 // ============ private ===========================
 
 // =========== general creation functions ==============
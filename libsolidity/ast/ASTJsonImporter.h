@@ -49,6 +49,13 @@ public:
 	/// @returns map of sourcenames to their respective ASTs
 	std::map<std::string, ASTPointer<SourceUnit>> jsonToSourceUnit(std::map<std::string, Json> const& _sourceList);
 
+	/// Prepares the import of the ASTs of the sources @a _sourceNames one by one via
+	/// jsonToSourceUnit() below, so that their JSON does not have to be kept in memory together.
+	/// All sources have to be known in advance, because source locations refer to them by index.
+	void setSourceNames(std::set<std::string> const& _sourceNames);
+	/// Converts the AST of a single source given to setSourceNames() from JSON-format to ASTPointer
+	ASTPointer<SourceUnit> jsonToSourceUnit(std::string const& _sourceName, Json const& _ast);
+
 private:
 
 	// =========== general creation functions ==============
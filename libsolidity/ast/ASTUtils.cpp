@@ -25,6 +25,26 @@
 namespace solidity::frontend
 {
 
+namespace
+{
+
+class IDShifter: public ASTVisitor
+{
+public:
+	explicit IDShifter(int64_t _offset): m_offset(_offset) {}
+
+private:
+	bool visitNode(ASTNode& _node) override
+	{
+		_node.shiftID(m_offset);
+		return true;
+	}
+
+	int64_t m_offset;
+};
+
+}
+
 ASTNode const* locateInnermostASTNode(int _offsetInFile, SourceUnit const& _sourceUnit)
 {
 	ASTNode const* innermostMatch = nullptr;
@@ -47,6 +67,12 @@ ASTNode const* locateInnermostASTNode(int _offsetInFile, SourceUnit const& _sour
 	return innermostMatch;
 }
 
+void shiftNodeIDs(ASTNode& _root, int64_t _offset)
+{
+	IDShifter shifter{_offset};
+	_root.accept(shifter);
+}
+
 bool isConstantVariableRecursive(VariableDeclaration const& _varDecl)
 {
 	solAssert(_varDecl.isConstant(), "Constant variable expected");
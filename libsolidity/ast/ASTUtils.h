@@ -18,6 +18,8 @@
 
 #pragma once
 
+#include <cstdint>
+
 namespace solidity::frontend
 {
 
@@ -38,6 +40,10 @@ bool isConstantVariableRecursive(VariableDeclaration const& _varDecl);
 /// Returns the innermost AST node that covers the given location or nullptr if not found.
 ASTNode const* locateInnermostASTNode(int _offsetInFile, SourceUnit const& _sourceUnit);
 
+/// Adds @a _offset to the IDs of @a _root and all nodes below it.
+/// Used to relocate trees that were not created by the parser of the current compilation.
+void shiftNodeIDs(ASTNode& _root, int64_t _offset);
+
 /// @returns @a _expr itself, in case it is not a unary tuple expression. Otherwise it descends recursively
 /// into unary tuples and returns the contained expression.
 Expression const* resolveOuterUnaryTuples(Expression const* _expr);
@@ -25,134 +25,50 @@ using namespace solidity;
 using namespace solidity::frontend;
 using namespace solidity::util;
 
-BoolType const TypeProvider::m_boolean{};
-InaccessibleDynamicType const TypeProvider::m_inaccessibleDynamic{};
-
-/// The string and bytes unique_ptrs are initialized when they are first used because
-/// they rely on `byte` being available which we cannot guarantee in the static init context.
-std::unique_ptr<ArrayType> TypeProvider::m_bytesStorage;
-std::unique_ptr<ArrayType> TypeProvider::m_bytesMemory;
-std::unique_ptr<ArrayType> TypeProvider::m_bytesCalldata;
-std::unique_ptr<ArrayType> TypeProvider::m_stringStorage;
-std::unique_ptr<ArrayType> TypeProvider::m_stringMemory;
-
-TupleType const TypeProvider::m_emptyTuple{};
-AddressType const TypeProvider::m_payableAddress{StateMutability::Payable};
-AddressType const TypeProvider::m_address{StateMutability::NonPayable};
-
-std::array<std::unique_ptr<IntegerType>, 32> const TypeProvider::m_intM{{
-	{std::make_unique<IntegerType>(8 * 1, IntegerType::Modifier::Signed)},
-	{std::make_unique<IntegerType>(8 * 2, IntegerType::Modifier::Signed)},
-	{std::make_unique<IntegerType>(8 * 3, IntegerType::Modifier::Signed)},
-	{std::make_unique<IntegerType>(8 * 4, IntegerType::Modifier::Signed)},
-	{std::make_unique<IntegerType>(8 * 5, IntegerType::Modifier::Signed)},
-	{std::make_unique<IntegerType>(8 * 6, IntegerType::Modifier::Signed)},
-	{std::make_unique<IntegerType>(8 * 7, IntegerType::Modifier::Signed)},
-	{std::make_unique<IntegerType>(8 * 8, IntegerType::Modifier::Signed)},
-	{std::make_unique<IntegerType>(8 * 9, IntegerType::Modifier::Signed)},
-	{std::make_unique<IntegerType>(8 * 10, IntegerType::Modifier::Signed)},
-	{std::make_unique<IntegerType>(8 * 11, IntegerType::Modifier::Signed)},
-	{std::make_unique<IntegerType>(8 * 12, IntegerType::Modifier::Signed)},
-	{std::make_unique<IntegerType>(8 * 13, IntegerType::Modifier::Signed)},
-	{std::make_unique<IntegerType>(8 * 14, IntegerType::Modifier::Signed)},
-	{std::make_unique<IntegerType>(8 * 15, IntegerType::Modifier::Signed)},
-	{std::make_unique<IntegerType>(8 * 16, IntegerType::Modifier::Signed)},
-	{std::make_unique<IntegerType>(8 * 17, IntegerType::Modifier::Signed)},
-	{std::make_unique<IntegerType>(8 * 18, IntegerType::Modifier::Signed)},
-	{std::make_unique<IntegerType>(8 * 19, IntegerType::Modifier::Signed)},
-	{std::make_unique<IntegerType>(8 * 20, IntegerType::Modifier::Signed)},
-	{std::make_unique<IntegerType>(8 * 21, IntegerType::Modifier::Signed)},
-	{std::make_unique<IntegerType>(8 * 22, IntegerType::Modifier::Signed)},
-	{std::make_unique<IntegerType>(8 * 23, IntegerType::Modifier::Signed)},
-	{std::make_unique<IntegerType>(8 * 24, IntegerType::Modifier::Signed)},
-	{std::make_unique<IntegerType>(8 * 25, IntegerType::Modifier::Signed)},
-	{std::make_unique<IntegerType>(8 * 26, IntegerType::Modifier::Signed)},
-	{std::make_unique<IntegerType>(8 * 27, IntegerType::Modifier::Signed)},
-	{std::make_unique<IntegerType>(8 * 28, IntegerType::Modifier::Signed)},
-	{std::make_unique<IntegerType>(8 * 29, IntegerType::Modifier::Signed)},
-	{std::make_unique<IntegerType>(8 * 30, IntegerType::Modifier::Signed)},
-	{std::make_unique<IntegerType>(8 * 31, IntegerType::Modifier::Signed)},
-	{std::make_unique<IntegerType>(8 * 32, IntegerType::Modifier::Signed)}
-}};
-
-std::array<std::unique_ptr<IntegerType>, 32> const TypeProvider::m_uintM{{
-	{std::make_unique<IntegerType>(8 * 1, IntegerType::Modifier::Unsigned)},
-	{std::make_unique<IntegerType>(8 * 2, IntegerType::Modifier::Unsigned)},
-	{std::make_unique<IntegerType>(8 * 3, IntegerType::Modifier::Unsigned)},
-	{std::make_unique<IntegerType>(8 * 4, IntegerType::Modifier::Unsigned)},
-	{std::make_unique<IntegerType>(8 * 5, IntegerType::Modifier::Unsigned)},
-	{std::make_unique<IntegerType>(8 * 6, IntegerType::Modifier::Unsigned)},
-	{std::make_unique<IntegerType>(8 * 7, IntegerType::Modifier::Unsigned)},
-	{std::make_unique<IntegerType>(8 * 8, IntegerType::Modifier::Unsigned)},
-	{std::make_unique<IntegerType>(8 * 9, IntegerType::Modifier::Unsigned)},
-	{std::make_unique<IntegerType>(8 * 10, IntegerType::Modifier::Unsigned)},
-	{std::make_unique<IntegerType>(8 * 11, IntegerType::Modifier::Unsigned)},
-	{std::make_unique<IntegerType>(8 * 12, IntegerType::Modifier::Unsigned)},
-	{std::make_unique<IntegerType>(8 * 13, IntegerType::Modifier::Unsigned)},
-	{std::make_unique<IntegerType>(8 * 14, IntegerType::Modifier::Unsigned)},
-	{std::make_unique<IntegerType>(8 * 15, IntegerType::Modifier::Unsigned)},
-	{std::make_unique<IntegerType>(8 * 16, IntegerType::Modifier::Unsigned)},
-	{std::make_unique<IntegerType>(8 * 17, IntegerType::Modifier::Unsigned)},
-	{std::make_unique<IntegerType>(8 * 18, IntegerType::Modifier::Unsigned)},
-	{std::make_unique<IntegerType>(8 * 19, IntegerType::Modifier::Unsigned)},
-	{std::make_unique<IntegerType>(8 * 20, IntegerType::Modifier::Unsigned)},
-	{std::make_unique<IntegerType>(8 * 21, IntegerType::Modifier::Unsigned)},
-	{std::make_unique<IntegerType>(8 * 22, IntegerType::Modifier::Unsigned)},
-	{std::make_unique<IntegerType>(8 * 23, IntegerType::Modifier::Unsigned)},
-	{std::make_unique<IntegerType>(8 * 24, IntegerType::Modifier::Unsigned)},
-	{std::make_unique<IntegerType>(8 * 25, IntegerType::Modifier::Unsigned)},
-	{std::make_unique<IntegerType>(8 * 26, IntegerType::Modifier::Unsigned)},
-	{std::make_unique<IntegerType>(8 * 27, IntegerType::Modifier::Unsigned)},
-	{std::make_unique<IntegerType>(8 * 28, IntegerType::Modifier::Unsigned)},
-	{std::make_unique<IntegerType>(8 * 29, IntegerType::Modifier::Unsigned)},
-	{std::make_unique<IntegerType>(8 * 30, IntegerType::Modifier::Unsigned)},
-	{std::make_unique<IntegerType>(8 * 31, IntegerType::Modifier::Unsigned)},
-	{std::make_unique<IntegerType>(8 * 32, IntegerType::Modifier::Unsigned)}
-}};
-
-std::array<std::unique_ptr<FixedBytesType>, 32> const TypeProvider::m_bytesM{{
-	{std::make_unique<FixedBytesType>(1)},
-	{std::make_unique<FixedBytesType>(2)},
-	{std::make_unique<FixedBytesType>(3)},
-	{std::make_unique<FixedBytesType>(4)},
-	{std::make_unique<FixedBytesType>(5)},
-	{std::make_unique<FixedBytesType>(6)},
-	{std::make_unique<FixedBytesType>(7)},
-	{std::make_unique<FixedBytesType>(8)},
-	{std::make_unique<FixedBytesType>(9)},
-	{std::make_unique<FixedBytesType>(10)},
-	{std::make_unique<FixedBytesType>(11)},
-	{std::make_unique<FixedBytesType>(12)},
-	{std::make_unique<FixedBytesType>(13)},
-	{std::make_unique<FixedBytesType>(14)},
-	{std::make_unique<FixedBytesType>(15)},
-	{std::make_unique<FixedBytesType>(16)},
-	{std::make_unique<FixedBytesType>(17)},
-	{std::make_unique<FixedBytesType>(18)},
-	{std::make_unique<FixedBytesType>(19)},
-	{std::make_unique<FixedBytesType>(20)},
-	{std::make_unique<FixedBytesType>(21)},
-	{std::make_unique<FixedBytesType>(22)},
-	{std::make_unique<FixedBytesType>(23)},
-	{std::make_unique<FixedBytesType>(24)},
-	{std::make_unique<FixedBytesType>(25)},
-	{std::make_unique<FixedBytesType>(26)},
-	{std::make_unique<FixedBytesType>(27)},
-	{std::make_unique<FixedBytesType>(28)},
-	{std::make_unique<FixedBytesType>(29)},
-	{std::make_unique<FixedBytesType>(30)},
-	{std::make_unique<FixedBytesType>(31)},
-	{std::make_unique<FixedBytesType>(32)}
-}};
-
-std::array<std::unique_ptr<MagicType>, 5> const TypeProvider::m_magics{{
-	{std::make_unique<MagicType>(MagicType::Kind::Block)},
-	{std::make_unique<MagicType>(MagicType::Kind::Message)},
-	{std::make_unique<MagicType>(MagicType::Kind::Transaction)},
-	{std::make_unique<MagicType>(MagicType::Kind::ABI)},
-	{std::make_unique<MagicType>(MagicType::Kind::Error)}
-	// MetaType is stored separately
-}};
+namespace
+{
+
+thread_local TypeProvider* t_currentProvider = nullptr;
+
+}
+
+TypeProvider::Scope::Scope(TypeProvider* _provider):
+	m_previous(t_currentProvider)
+{
+	if (_provider)
+		t_currentProvider = _provider;
+}
+
+TypeProvider::Scope::~Scope()
+{
+	t_currentProvider = m_previous;
+}
+
+TypeProvider::TypeProvider()
+{
+	for (unsigned bytes = 1; bytes <= 32; ++bytes)
+	{
+		m_intM[bytes - 1] = std::make_unique<IntegerType>(8 * bytes, IntegerType::Modifier::Signed);
+		m_uintM[bytes - 1] = std::make_unique<IntegerType>(8 * bytes, IntegerType::Modifier::Unsigned);
+		m_bytesM[bytes - 1] = std::make_unique<FixedBytesType>(bytes);
+	}
+	m_magics = {
+		std::make_unique<MagicType>(MagicType::Kind::Block),
+		std::make_unique<MagicType>(MagicType::Kind::Message),
+		std::make_unique<MagicType>(MagicType::Kind::Transaction),
+		std::make_unique<MagicType>(MagicType::Kind::ABI),
+		std::make_unique<MagicType>(MagicType::Kind::Error)
+		// MetaType is stored separately
+	};
+}
+
+TypeProvider& TypeProvider::instance()
+{
+	if (t_currentProvider)
+		return *t_currentProvider;
+	static TypeProvider provider;
+	return provider;
+}
 
 inline void clearCache(Type const& type)
 {
@@ -176,25 +92,26 @@ inline void clearCaches(Container& container)
 
 void TypeProvider::reset()
 {
-	clearCache(m_boolean);
-	clearCache(m_inaccessibleDynamic);
-	clearCache(m_bytesStorage);
-	clearCache(m_bytesMemory);
-	clearCache(m_bytesCalldata);
-	clearCache(m_stringStorage);
-	clearCache(m_stringMemory);
-	clearCache(m_emptyTuple);
-	clearCache(m_payableAddress);
-	clearCache(m_address);
-	clearCaches(instance().m_intM);
-	clearCaches(instance().m_uintM);
-	clearCaches(instance().m_bytesM);
-	clearCaches(instance().m_magics);
-
-	instance().m_generalTypes.clear();
-	instance().m_stringLiteralTypes.clear();
-	instance().m_ufixedMxN.clear();
-	instance().m_fixedMxN.clear();
+	TypeProvider& provider = instance();
+	clearCache(provider.m_boolean);
+	clearCache(provider.m_inaccessibleDynamic);
+	clearCache(provider.m_bytesStorage);
+	clearCache(provider.m_bytesMemory);
+	clearCache(provider.m_bytesCalldata);
+	clearCache(provider.m_stringStorage);
+	clearCache(provider.m_stringMemory);
+	clearCache(provider.m_emptyTuple);
+	clearCache(provider.m_payableAddress);
+	clearCache(provider.m_address);
+	clearCaches(provider.m_intM);
+	clearCaches(provider.m_uintM);
+	clearCaches(provider.m_bytesM);
+	clearCaches(provider.m_magics);
+
+	provider.m_generalTypes.clear();
+	provider.m_stringLiteralTypes.clear();
+	provider.m_ufixedMxN.clear();
+	provider.m_fixedMxN.clear();
 }
 
 template <typename T, typename... Args>
@@ -306,37 +223,37 @@ Type const* TypeProvider::fromElementaryTypeName(std::string const& _name)
 
 ArrayType const* TypeProvider::bytesStorage()
 {
-	if (!m_bytesStorage)
-		m_bytesStorage = std::make_unique<ArrayType>(DataLocation::Storage, false);
-	return m_bytesStorage.get();
+	if (!instance().m_bytesStorage)
+		instance().m_bytesStorage = std::make_unique<ArrayType>(DataLocation::Storage, false);
+	return instance().m_bytesStorage.get();
 }
 
 ArrayType const* TypeProvider::bytesMemory()
 {
-	if (!m_bytesMemory)
-		m_bytesMemory = std::make_unique<ArrayType>(DataLocation::Memory, false);
-	return m_bytesMemory.get();
+	if (!instance().m_bytesMemory)
+		instance().m_bytesMemory = std::make_unique<ArrayType>(DataLocation::Memory, false);
+	return instance().m_bytesMemory.get();
 }
 
 ArrayType const* TypeProvider::bytesCalldata()
 {
-	if (!m_bytesCalldata)
-		m_bytesCalldata = std::make_unique<ArrayType>(DataLocation::CallData, false);
-	return m_bytesCalldata.get();
+	if (!instance().m_bytesCalldata)
+		instance().m_bytesCalldata = std::make_unique<ArrayType>(DataLocation::CallData, false);
+	return instance().m_bytesCalldata.get();
 }
 
 ArrayType const* TypeProvider::stringStorage()
 {
-	if (!m_stringStorage)
-		m_stringStorage = std::make_unique<ArrayType>(DataLocation::Storage, true);
-	return m_stringStorage.get();
+	if (!instance().m_stringStorage)
+		instance().m_stringStorage = std::make_unique<ArrayType>(DataLocation::Storage, true);
+	return instance().m_stringStorage.get();
 }
 
 ArrayType const* TypeProvider::stringMemory()
 {
-	if (!m_stringMemory)
-		m_stringMemory = std::make_unique<ArrayType>(DataLocation::Memory, true);
-	return m_stringMemory.get();
+	if (!instance().m_stringMemory)
+		instance().m_stringMemory = std::make_unique<ArrayType>(DataLocation::Memory, true);
+	return instance().m_stringMemory.get();
 }
 
 Type const* TypeProvider::forLiteral(Literal const& _literal)
@@ -402,7 +319,7 @@ FixedPointType const* TypeProvider::fixedPoint(unsigned m, unsigned n, FixedPoin
 TupleType const* TypeProvider::tuple(std::vector<Type const*> members)
 {
 	if (members.empty())
-		return &m_emptyTuple;
+		return &instance().m_emptyTuple;
 
 	return createAndGet<TupleType>(std::move(members));
 }
@@ -555,7 +472,7 @@ ModifierType const* TypeProvider::modifier(ModifierDefinition const& _def)
 MagicType const* TypeProvider::magic(MagicType::Kind _kind)
 {
 	solAssert(_kind != MagicType::Kind::MetaType, "MetaType is handled separately");
-	return m_magics.at(static_cast<size_t>(_kind)).get();
+	return instance().m_magics.at(static_cast<size_t>(_kind)).get();
 }
 
 MagicType const* TypeProvider::meta(Type const* _type)
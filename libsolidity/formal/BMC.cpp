@@ -28,6 +28,8 @@
 #include <liblangutil/CharStream.h>
 #include <liblangutil/CharStreamProvider.h>
 
+#include <libsolutil/StringUtils.h>
+
 #include <utility>
 
 using namespace solidity;
@@ -52,12 +54,32 @@ BMC::BMC(
 	solAssert(!_settings.printQuery || _settings.solvers == SMTSolverChoice::SMTLIB2(), "Only SMTLib2 solver can be enabled to print queries");
 	std::vector<std::unique_ptr<BMCSolverInterface>> solvers;
 	if (_settings.solvers.smtlib2)
+	{
 		solvers.emplace_back(std::make_unique<SMTLib2Interface>(_smtlib2Responses, _smtCallback, _settings.timeout));
+		m_solverNames.emplace_back("smtlib2");
+	}
 	if (_settings.solvers.cvc5)
+	{
 		solvers.emplace_back(std::make_unique<Cvc5SMTLib2Interface>(_smtCallback, _settings.timeout));
+		m_solverNames.emplace_back("cvc5");
+	}
 	if (_settings.solvers.z3 )
+	{
 		solvers.emplace_back(std::make_unique<Z3SMTLib2Interface>(_smtCallback, _settings.timeout));
-	m_interface = std::make_unique<SMTPortfolio>(std::move(solvers), _settings.timeout);
+		m_solverNames.emplace_back("z3");
+	}
+#ifdef EMSCRIPTEN_BUILD
+	// The solvers cannot run concurrently without threads.
+	bool const race = false;
+#else
+	bool const race = _settings.raceSolvers;
+#endif
+	m_interface = std::make_unique<SMTPortfolio>(
+		std::move(solvers),
+		_settings.timeout,
+		race,
+		std::chrono::milliseconds(_settings.raceCrossCheckTime)
+	);
 #if defined (HAVE_Z3)
 	if (m_settings.solvers.z3)
 		if (!_smtlib2Responses.empty())
@@ -134,6 +156,9 @@ void BMC::analyze(SourceUnit const& _source, std::map<ASTNode const*, std::set<V
 					" check is safe!"
 				);
 
+	if (m_settings.raceSolvers && m_settings.showSolverStatistics)
+		reportSolverStatistics();
+
 	// If this check is true, Z3 and cvc5 are not available
 	// and the query answers were not provided, since SMTPortfolio
 	// guarantees that SmtLib2Interface is the first solver, if enabled.
@@ -150,6 +175,31 @@ void BMC::analyze(SourceUnit const& _source, std::map<ASTNode const*, std::set<V
 		);
 }
 
+void BMC::reportSolverStatistics()
+{
+	auto portfolio = dynamic_cast<SMTPortfolio*>(m_interface.get());
+	solAssert(portfolio);
+	solAssert(portfolio->statistics().size() == m_solverNames.size());
+
+	std::vector<std::string> descriptions;
+	for (size_t i = 0; i < m_solverNames.size(); ++i)
+	{
+		SMTPortfolio::SolverStatistics const& statistics = portfolio->statistics()[i];
+		if (statistics.queries == 0)
+			continue;
+		descriptions.emplace_back(
+			m_solverNames[i] + ": " +
+			std::to_string(statistics.queries) + " queries, " +
+			std::to_string(statistics.firstAnswers) + " answered first, " +
+			std::to_string(statistics.cancellations) + " cancelled"
+		);
+	}
+	portfolio->resetStatistics();
+
+	if (!descriptions.empty())
+		m_errorReporter.info(4163_error, "BMC: Solver statistics: " + joinHumanReadable(descriptions, "; ") + ".");
+}
+
 bool BMC::shouldInlineFunctionCall(
 	FunctionCall const& _funCall,
 	ContractDefinition const* _scopeContract,
@@ -205,7 +205,12 @@ private:
 	smtutil::Expression mergeVariablesFromLoopCheckpoints();
 	bool isInsideLoop() const;
 
+	/// Reports how the solvers fared against each other when they are raced.
+	void reportSolverStatistics();
+
 	std::unique_ptr<smtutil::BMCSolverInterface> m_interface;
+	/// Names of the solvers in the portfolio, in portfolio order.
+	std::vector<std::string> m_solverNames;
 
 	/// Flags used for better warning messages.
 	bool m_loopExecutionHappened = false;
@@ -170,7 +170,14 @@ struct ModelCheckerSettings
 	ModelCheckerExtCalls externalCalls = {};
 	ModelCheckerInvariants invariants = ModelCheckerInvariants::Default();
 	bool printQuery = false;
+	/// Time the remaining BMC solvers get to confirm the first answer when racing.
+	unsigned raceCrossCheckTime = 0; // in milliseconds
+	/// Query the BMC solvers concurrently and use the first conclusive answer.
+	bool raceSolvers = false;
 	bool showProvedSafe = false;
+	/// Report how often each solver answered first or was cancelled when racing.
+	/// Off by default since the numbers depend on the timing of the solvers.
+	bool showSolverStatistics = false;
 	bool showUnproved = false;
 	bool showUnsupported = false;
 	smtutil::SMTSolverChoice solvers = smtutil::SMTSolverChoice::Z3();
@@ -188,7 +195,10 @@ struct ModelCheckerSettings
 			externalCalls.mode == _other.externalCalls.mode &&
 			invariants == _other.invariants &&
 			printQuery == _other.printQuery &&
+			raceCrossCheckTime == _other.raceCrossCheckTime &&
+			raceSolvers == _other.raceSolvers &&
 			showProvedSafe == _other.showProvedSafe &&
+			showSolverStatistics == _other.showSolverStatistics &&
 			showUnproved == _other.showUnproved &&
 			showUnsupported == _other.showUnsupported &&
 			solvers == _other.solvers &&
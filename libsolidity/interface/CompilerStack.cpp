@@ -45,6 +45,7 @@
 #include <libsolidity/analysis/ImmutableValidator.h>
 
 #include <libsolidity/ast/AST.h>
+#include <libsolidity/ast/ASTUtils.h>
 #include <libsolidity/ast/TypeProvider.h>
 #include <libsolidity/ast/ASTJsonImporter.h>
 #include <libsolidity/codegen/Compiler.h>
@@ -83,7 +84,10 @@
 #include <libsolutil/IpfsHash.h>
 #include <libsolutil/JSON.h>
 #include <libsolutil/Algorithms.h>
+#include <libsolutil/DiskCache.h>
 #include <libsolutil/FunctionSelector.h>
+#include <libsolutil/Profiler.h>
+#include <libsolutil/ThreadPool.h>
 
 #include <boost/algorithm/string/replace.hpp>
 
@@ -93,6 +97,7 @@
 
 #include <fmt/format.h>
 
+#include <atomic>
 #include <utility>
 #include <map>
 #include <limits>
@@ -107,23 +112,32 @@ using namespace std::string_literals;
 
 using solidity::util::errinfo_comment;
 
-static int g_compilerStackCounts = 0;
+static std::atomic<int> g_compilerStackCounts = 0;
 
-CompilerStack::CompilerStack(ReadCallback::Callback _readFile):
+CompilerStack::CompilerStack(ReadCallback::Callback _readFile, bool _ownTypeProvider):
+	m_typeProvider(_ownTypeProvider ? std::make_unique<TypeProvider>() : nullptr),
+	m_yulStringRepository(std::make_shared<yul::YulStringRepository>()),
 	m_readFile{std::move(_readFile)},
 	m_objectOptimizer(std::make_shared<yul::ObjectOptimizer>()),
 	m_errorReporter{m_errorList}
 {
-	// Because TypeProvider is currently a singleton API, we must ensure that
-	// no more than one entity is actually using it at a time.
-	solAssert(g_compilerStackCounts == 0, "You shall not have another CompilerStack aside me.");
-	++g_compilerStackCounts;
+	// Stacks using the process-wide TypeProvider would wipe each other's types,
+	// so we must ensure that no more than one of them is alive at a time.
+	if (!m_typeProvider)
+	{
+		solAssert(g_compilerStackCounts == 0, "You shall not have another CompilerStack aside me.");
+		++g_compilerStackCounts;
+	}
 }
 
 CompilerStack::~CompilerStack()
 {
-	--g_compilerStackCounts;
-	TypeProvider::reset();
+	returnASTsToCache();
+	if (!m_typeProvider)
+	{
+		--g_compilerStackCounts;
+		TypeProvider::reset();
+	}
 }
 
 void CompilerStack::createAndAssignCallGraphs()
@@ -244,6 +258,47 @@ void CompilerStack::setEOFVersion(std::optional<uint8_t> _version)
 	m_eofVersion = _version;
 }
 
+void CompilerStack::setParallelism(size_t _parallelism)
+{
+	solAssert(m_stackState < CompilationSuccessful, "Must set parallelism before compiling.");
+	solAssert(_parallelism > 0, "At least one thread is required.");
+	solAssert(_parallelism <= util::ThreadPool::maxWorkers(), "Too many threads requested.");
+	m_parallelism = _parallelism;
+}
+
+void CompilerStack::setDiscardIntermediateArtifacts(bool _discard)
+{
+	solAssert(m_stackState < CompilationSuccessful, "Must set discarding of intermediate artifacts before compiling.");
+	m_discardIntermediateArtifacts = _discard;
+}
+
+void CompilerStack::setOptimizerCacheDirectory(boost::filesystem::path const& _directory, std::uintmax_t _maxSize)
+{
+	solAssert(m_stackState < CompilationSuccessful, "Must set optimizer cache directory before compiling.");
+	solAssert(!m_sharedYulOptimizerCache, "Cannot attach a disk cache to a shared optimizer cache.");
+	m_optimizerDiskCache = std::make_shared<util::DiskCache>(_directory, VersionString, _maxSize);
+	m_objectOptimizer->setDiskCache(m_optimizerDiskCache);
+}
+
+void CompilerStack::setParsedSourceCache(std::shared_ptr<ParsedSourceCache> _cache)
+{
+	solAssert(m_stackState < Parsed, "Must set parsed source cache before parsing.");
+	m_parsedSourceCache = std::move(_cache);
+}
+
+void CompilerStack::shareYulOptimizerCache(
+	std::shared_ptr<yul::YulStringRepository> _yulStringRepository,
+	std::shared_ptr<yul::ObjectOptimizer> _objectOptimizer
+)
+{
+	solAssert(m_stackState < Parsed, "Must share the optimizer cache before parsing.");
+	solAssert(!m_optimizerDiskCache, "Cannot share an optimizer cache backed by a disk cache.");
+	solAssert(_yulStringRepository && _objectOptimizer);
+	m_yulStringRepository = std::move(_yulStringRepository);
+	m_objectOptimizer = std::move(_objectOptimizer);
+	m_sharedYulOptimizerCache = true;
+}
+
 void CompilerStack::setModelCheckerSettings(ModelCheckerSettings _settings)
 {
 	solAssert(m_stackState < ParsedAndImported, "Must set model checking settings before parsing.");
@@ -308,6 +363,7 @@ void CompilerStack::addSMTLib2Response(h256 const& _hash, std::string const& _re
 
 void CompilerStack::reset(bool _keepSettings)
 {
+	returnASTsToCache();
 	m_stackState = Empty;
 	m_sources.clear();
 	m_maxAstId.reset();
@@ -321,6 +377,9 @@ void CompilerStack::reset(bool _keepSettings)
 		m_evmVersion = langutil::EVMVersion();
 		m_eofVersion.reset();
 		m_modelCheckerSettings = ModelCheckerSettings{};
+		m_parallelism = 1;
+		m_discardIntermediateArtifacts = false;
+		m_optimizerDiskCache.reset();
 		m_selectedContracts.clear();
 		m_revertStrings = RevertStrings::Default;
 		m_optimiserSettings = OptimiserSettings::minimal();
@@ -335,7 +394,18 @@ void CompilerStack::reset(bool _keepSettings)
 	m_sourceOrder.clear();
 	m_contracts.clear();
 	m_errorReporter.clear();
-	TypeProvider::reset();
+	if (m_typeProvider)
+		m_typeProvider = std::make_unique<TypeProvider>();
+	else
+		TypeProvider::reset();
+	// Cached objects are the only Yul ASTs that survive up to here. Both get replaced so that
+	// names interned for the previous compilation are released, unless they are meant to be shared.
+	if (!m_sharedYulOptimizerCache)
+	{
+		m_objectOptimizer = std::make_shared<yul::ObjectOptimizer>();
+		m_objectOptimizer->setDiskCache(m_optimizerDiskCache);
+		m_yulStringRepository = std::make_shared<yul::YulStringRepository>();
+	}
 }
 
 void CompilerStack::setSources(StringMap _sources)
@@ -350,6 +420,8 @@ void CompilerStack::setSources(StringMap _sources)
 bool CompilerStack::parse()
 {
 	solAssert(m_stackState == SourcesSet, "Must call parse only after the SourcesSet state.");
+	YulStringRepository::Scope yulStringScope(*m_yulStringRepository);
+	TypeProvider::Scope typeScope(m_typeProvider.get());
 	m_errorReporter.clear();
 
 	if (SemVerVersion{std::string(VersionString)}.isPrerelease())
@@ -363,11 +435,87 @@ bool CompilerStack::parse()
 		for (auto const& s: m_sources)
 			sourcesToParse.push_back(s.first);
 
+		// With parallelism, sources are parsed on worker threads as soon as they are known and the
+		// results are taken over below in the sequential order, relocating their node IDs and
+		// reporting their messages only then. Sources for which this would not give the same
+		// result as sequential parsing are parsed again.
+		std::optional<util::ThreadPool> threadPool;
+		if (m_parallelism > 1)
+			threadPool.emplace(m_parallelism);
+		std::vector<std::optional<std::future<SeparatelyParsedSource>>> separateParses;
+		std::set<std::string> scheduledPaths;
+
 		for (size_t i = 0; i < sourcesToParse.size(); ++i)
 		{
+			if (threadPool)
+				for (size_t j = separateParses.size(); j < sourcesToParse.size(); ++j)
+				{
+					Source const& scheduledSource = m_sources[sourcesToParse[j]];
+					if (
+						// Standard library sources can be queued repeatedly, with new streams each time.
+						!scheduledPaths.insert(sourcesToParse[j]).second ||
+						(
+							m_parsedSourceCache &&
+							m_parsedSourceCache->contains({sourcesToParse[j], scheduledSource.keccak256(), m_evmVersion, m_eofVersion})
+						)
+					)
+						separateParses.emplace_back();
+					else
+						separateParses.emplace_back(scheduleParsing(scheduledSource.charStream, *threadPool));
+				}
+
 			std::string const& path = sourcesToParse[i];
 			Source& source = m_sources[path];
-			source.ast = parser.parse(*source.charStream);
+			source.idBegin = parser.maxID();
+			std::optional<ParsedSourceCache::Entry> cached;
+			if (m_parsedSourceCache)
+			{
+				source.cacheKey = ParsedSourceCache::Key{path, source.keccak256(), m_evmVersion, m_eofVersion};
+				cached = m_parsedSourceCache->take(*source.cacheKey, source.idBegin);
+			}
+			std::optional<SeparatelyParsedSource> separatelyParsed;
+			if (!cached && i < separateParses.size() && separateParses[i])
+			{
+				threadPool->wait(*separateParses[i]);
+				try
+				{
+					separatelyParsed = separateParses[i]->get();
+				}
+				catch (...)
+				{
+					// Parsing the source again below reports the failure.
+				}
+			}
+
+			if (cached)
+			{
+				source.ast = std::move(cached->ast);
+				parser.reserveIDs(cached->idEnd - cached->idBegin);
+			}
+			else if (
+				separatelyParsed &&
+				separatelyParsed->charStream == source.charStream &&
+				m_errorReporter.merge(separatelyParsed->messages)
+			)
+			{
+				source.ast = std::move(separatelyParsed->ast);
+				if (source.ast)
+					shiftNodeIDs(*source.ast, source.idBegin);
+				parser.reserveIDs(separatelyParsed->idCount);
+				// Reusing the AST would lose the messages of the parser.
+				if (!separatelyParsed->messages.empty())
+					source.cacheKey.reset();
+			}
+			else
+			{
+				util::Profiler::Probe probe{"parsing", "Parser", path};
+				size_t const previousMessages = m_errorReporter.errors().size();
+				source.ast = parser.parse(*source.charStream);
+				// Reusing the AST would lose the messages of the parser.
+				if (m_errorReporter.errors().size() != previousMessages)
+					source.cacheKey.reset();
+			}
+			source.idEnd = parser.maxID();
 			if (!source.ast)
 				solAssert(Error::containsErrors(m_errorReporter.errors()), "Parser returned null but did not report error.");
 			else
@@ -425,24 +573,73 @@ bool CompilerStack::parse()
 	return true;
 }
 
+std::future<CompilerStack::SeparatelyParsedSource> CompilerStack::scheduleParsing(
+	std::shared_ptr<CharStream> _charStream,
+	util::ThreadPool& _threadPool
+) const
+{
+	return _threadPool.submit([this, charStream = std::move(_charStream)]() {
+		// Inline assembly is parsed into strings of this compilation.
+		YulStringRepository::Scope yulStringScope(*m_yulStringRepository);
+		util::Profiler::Probe probe{"parsing", "Parser", charStream->name()};
+		SeparatelyParsedSource result;
+		result.charStream = charStream;
+		ErrorReporter errorReporter(result.messages);
+		Parser parser{errorReporter, m_evmVersion, m_eofVersion};
+		result.ast = parser.parse(*charStream);
+		result.idCount = parser.maxID();
+		return result;
+	});
+}
+
+void CompilerStack::returnASTsToCache()
+{
+	if (!m_parsedSourceCache)
+		return;
+	for (Source& source: m_sources | ranges::views::values)
+		if (source.ast && source.cacheKey)
+		{
+			m_parsedSourceCache->store(
+				std::move(*source.cacheKey),
+				ParsedSourceCache::Entry{std::move(source.ast), source.idBegin, source.idEnd}
+			);
+			source.cacheKey.reset();
+		}
+}
+
 void CompilerStack::importASTs(std::map<std::string, Json> const& _sources)
+{
+	std::set<std::string> sourceNames;
+	for (auto const& src: _sources)
+		sourceNames.insert(src.first);
+	importASTs(sourceNames, [&](auto const& _importAST) {
+		for (auto const& [sourceName, ast]: _sources)
+			_importAST(sourceName, ast);
+	});
+}
+
+void CompilerStack::importASTs(
+	std::set<std::string> const& _sourceNames,
+	std::function<void(std::function<void(std::string const&, Json const&)> const&)> const& _readASTs
+)
 {
 	solAssert(m_stackState == Empty, "Must call importASTs only before the SourcesSet state.");
-	std::map<std::string, ASTPointer<SourceUnit>> reconstructedSources =
-		ASTJsonImporter(m_evmVersion, m_eofVersion).jsonToSourceUnit(_sources);
-	for (auto& src: reconstructedSources)
-	{
-		solUnimplementedAssert(!src.second->experimentalSolidity());
-		std::string const& path = src.first;
+	YulStringRepository::Scope yulStringScope(*m_yulStringRepository);
+	TypeProvider::Scope typeScope(m_typeProvider.get());
+	ASTJsonImporter importer(m_evmVersion, m_eofVersion);
+	importer.setSourceNames(_sourceNames);
+	_readASTs([&](std::string const& _sourceName, Json const& _ast) {
 		Source source;
-		source.ast = src.second;
+		source.ast = importer.jsonToSourceUnit(_sourceName, _ast);
+		solUnimplementedAssert(!source.ast->experimentalSolidity());
 		source.charStream = std::make_shared<CharStream>(
-			util::jsonCompactPrint(_sources.at(src.first)),
-			src.first,
+			util::jsonCompactPrint(_ast),
+			_sourceName,
 			true // imported from AST
 		);
-		m_sources[path] = std::move(source);
-	}
+		m_sources[_sourceName] = std::move(source);
+	});
+	astAssert(m_sources.size() == _sourceNames.size(), "Missing AST of a source.");
 	m_stackState = ParsedAndImported;
 	m_compilationSourceType = CompilationSourceType::SolidityAST;
 
@@ -452,52 +649,83 @@ void CompilerStack::importASTs(std::map<std::string, Json> const& _sources)
 bool CompilerStack::analyze()
 {
 	solAssert(m_stackState == ParsedAndImported, "Must call analyze only after parsing was successful.");
+	YulStringRepository::Scope yulStringScope(*m_yulStringRepository);
+	TypeProvider::Scope typeScope(m_typeProvider.get());
 
 	if (!resolveImports())
 		return false;
 
-	for (Source const* source: m_sourceOrder)
-		if (source->ast)
-			Scoper::assignScopes(*source->ast);
+	{
+		util::Profiler::Probe probe{"analysis", "Scoper"};
+		for (Source const* source: m_sourceOrder)
+			if (source->ast)
+				Scoper::assignScopes(*source->ast);
+	}
 
 	bool noErrors = true;
 
+	// With parallelism, the checks that only look at a single source run concurrently.
+	// Checks that use types or look across sources stay sequential.
+	std::optional<util::ThreadPool> threadPool;
+	if (m_parallelism > 1 && m_sourceOrder.size() > 1)
+		threadPool.emplace(m_parallelism);
+
 	try
 	{
 		bool experimentalSolidity = isExperimentalSolidity();
 
-		SyntaxChecker syntaxChecker(m_errorReporter, m_optimiserSettings.runYulOptimiser);
-		for (Source const* source: m_sourceOrder)
-			if (source->ast && !syntaxChecker.checkSyntax(*source->ast))
+		bool const runYulOptimiser = m_optimiserSettings.runYulOptimiser;
+		{
+			util::Profiler::Probe probe{"analysis", "SyntaxChecker"};
+			if (!checkEachSource(
+				[runYulOptimiser](SourceUnit const& _source, ErrorReporter& _errorReporter) {
+					return SyntaxChecker(_errorReporter, runYulOptimiser).checkSyntax(_source);
+				},
+				threadPool ? &*threadPool : nullptr
+			))
 				noErrors = false;
+		}
 
 		m_globalContext = std::make_shared<GlobalContext>(m_evmVersion);
 		// We need to keep the same resolver during the whole process.
 		NameAndTypeResolver resolver(*m_globalContext, m_evmVersion, m_errorReporter, experimentalSolidity);
-		for (Source const* source: m_sourceOrder)
-			if (source->ast && !resolver.registerDeclarations(*source->ast))
-				return false;
+		{
+			util::Profiler::Probe probe{"analysis", "NameAndTypeResolver::registerDeclarations"};
+			for (Source const* source: m_sourceOrder)
+				if (source->ast && !resolver.registerDeclarations(*source->ast))
+					return false;
+		}
 
 		std::map<std::string, SourceUnit const*> sourceUnitsByName;
 		for (auto& source: m_sources)
 			sourceUnitsByName[source.first] = source.second.ast.get();
-		for (Source const* source: m_sourceOrder)
-			if (source->ast && !resolver.performImports(*source->ast, sourceUnitsByName))
-				return false;
+		{
+			util::Profiler::Probe probe{"analysis", "NameAndTypeResolver::performImports"};
+			for (Source const* source: m_sourceOrder)
+				if (source->ast && !resolver.performImports(*source->ast, sourceUnitsByName))
+					return false;
 
-		resolver.warnHomonymDeclarations();
+			resolver.warnHomonymDeclarations();
+		}
 
 		{
-			DocStringTagParser docStringTagParser(m_errorReporter);
-			for (Source const* source: m_sourceOrder)
-				if (source->ast && !docStringTagParser.parseDocStrings(*source->ast))
-					noErrors = false;
+			util::Profiler::Probe probe{"analysis", "DocStringTagParser::parseDocStrings"};
+			if (!checkEachSource(
+				[](SourceUnit const& _source, ErrorReporter& _errorReporter) {
+					return DocStringTagParser(_errorReporter).parseDocStrings(_source);
+				},
+				threadPool ? &*threadPool : nullptr
+			))
+				noErrors = false;
 		}
 
 		// Requires DocStringTagParser
-		for (Source const* source: m_sourceOrder)
-			if (source->ast && !resolver.resolveNamesAndTypes(*source->ast))
-				return false;
+		{
+			util::Profiler::Probe probe{"analysis", "NameAndTypeResolver::resolveNamesAndTypes"};
+			for (Source const* source: m_sourceOrder)
+				if (source->ast && !resolver.resolveNamesAndTypes(*source->ast))
+					return false;
+		}
 
 		if (experimentalSolidity)
 		{
@@ -526,30 +754,98 @@ bool CompilerStack::analyze()
 }
 
 
+bool CompilerStack::checkEachSource(
+	std::function<bool(SourceUnit const&, ErrorReporter&)> const& _check,
+	util::ThreadPool* _threadPool
+)
+{
+	bool success = true;
+	if (!_threadPool)
+	{
+		for (Source const* source: m_sourceOrder)
+			if (source->ast && !_check(*source->ast, m_errorReporter))
+				success = false;
+		return success;
+	}
+
+	struct SeparateCheck
+	{
+		langutil::ErrorList messages;
+		bool success = true;
+		/// Exception thrown by the check, rethrown once its messages have been reported.
+		std::exception_ptr exception;
+	};
+
+	std::vector<std::future<SeparateCheck>> checks;
+	for (Source const* source: m_sourceOrder)
+		if (source->ast)
+			checks.emplace_back(_threadPool->submit([this, &_check, ast = source->ast.get()]() {
+				YulStringRepository::Scope yulStringScope(*m_yulStringRepository);
+				SeparateCheck result;
+				ErrorReporter errorReporter(result.messages);
+				try
+				{
+					result.success = _check(*ast, errorReporter);
+				}
+				catch (...)
+				{
+					result.exception = std::current_exception();
+				}
+				return result;
+			}));
+
+	// The checks refer to @a _check, so none of them may still be running when leaving early.
+	ScopeGuard waitForChecks([&]() {
+		for (auto const& check: checks)
+			if (check.valid())
+				_threadPool->wait(check);
+	});
+	for (auto& check: checks)
+	{
+		_threadPool->wait(check);
+		SeparateCheck result = check.get();
+		m_errorReporter.replay(result.messages);
+		if (result.exception)
+			std::rethrow_exception(result.exception);
+		if (!result.success)
+			success = false;
+	}
+	return success;
+}
+
 bool CompilerStack::analyzeLegacy(bool _noErrorsSoFar)
 {
 	bool noErrors = _noErrorsSoFar;
 
-	DeclarationTypeChecker declarationTypeChecker(m_errorReporter, m_evmVersion);
-	for (Source const* source: m_sourceOrder)
-		if (source->ast && !declarationTypeChecker.check(*source->ast))
-			return false;
+	{
+		util::Profiler::Probe probe{"analysis", "DeclarationTypeChecker"};
+		DeclarationTypeChecker declarationTypeChecker(m_errorReporter, m_evmVersion);
+		for (Source const* source: m_sourceOrder)
+			if (source->ast && !declarationTypeChecker.check(*source->ast))
+				return false;
+	}
 
 	// Requires DeclarationTypeChecker to have run
-	DocStringTagParser docStringTagParser(m_errorReporter);
-	for (Source const* source: m_sourceOrder)
-		if (source->ast && !docStringTagParser.validateDocStringsUsingTypes(*source->ast))
-			noErrors = false;
+	{
+		util::Profiler::Probe probe{"analysis", "DocStringTagParser::validateDocStringsUsingTypes"};
+		DocStringTagParser docStringTagParser(m_errorReporter);
+		for (Source const* source: m_sourceOrder)
+			if (source->ast && !docStringTagParser.validateDocStringsUsingTypes(*source->ast))
+				noErrors = false;
+	}
 
 	// Next, we check inheritance, overrides, function collisions and other things at
 	// contract or function level.
 	// This also calculates whether a contract is abstract, which is needed by the
 	// type checker.
-	ContractLevelChecker contractLevelChecker(m_errorReporter);
+	{
+		util::Profiler::Probe probe{"analysis", "ContractLevelChecker"};
+		ContractLevelChecker contractLevelChecker(m_errorReporter);
 
-	for (Source const* source: m_sourceOrder)
-		if (auto sourceAst = source->ast)
-			noErrors = contractLevelChecker.check(*sourceAst);
+		for (Source const* source: m_sourceOrder)
+			if (auto sourceAst = source->ast)
+				noErrors = contractLevelChecker.check(*sourceAst);
+	}
 
 	// Now we run full type checks that go down to the expression level. This
 	// cannot be done earlier, because we need cross-contract types and information
@@ -558,14 +854,18 @@ bool CompilerStack::analyzeLegacy(bool _noErrorsSoFar)
 	//
 	// Note: this does not resolve overloaded functions. In order to do that, types of arguments are needed,
 	// which is only done one step later.
-	TypeChecker typeChecker(m_evmVersion, m_eofVersion, m_errorReporter);
-	for (Source const* source: m_sourceOrder)
-		if (source->ast && !typeChecker.checkTypeRequirements(*source->ast))
-			noErrors = false;
+	{
+		util::Profiler::Probe probe{"analysis", "TypeChecker"};
+		TypeChecker typeChecker(m_evmVersion, m_eofVersion, m_errorReporter);
+		for (Source const* source: m_sourceOrder)
+			if (source->ast && !typeChecker.checkTypeRequirements(*source->ast))
+				noErrors = false;
+	}
 
 	if (noErrors)
 	{
 		// Requires ContractLevelChecker and TypeChecker
+		util::Profiler::Probe probe{"analysis", "DocStringAnalyser"};
 		DocStringAnalyser docStringAnalyser(m_errorReporter);
 		for (Source const* source: m_sourceOrder)
 			if (source->ast && !docStringAnalyser.analyseDocStrings(*source->ast))
@@ -575,6 +875,7 @@ bool CompilerStack::analyzeLegacy(bool _noErrorsSoFar)
 	if (noErrors)
 	{
 		// Checks that can only be done when all types of all AST nodes are known.
+		util::Profiler::Probe probe{"analysis", "PostTypeChecker"};
 		PostTypeChecker postTypeChecker(m_errorReporter);
 		for (Source const* source: m_sourceOrder)
 			if (source->ast && !postTypeChecker.check(*source->ast))
@@ -586,29 +887,37 @@ bool CompilerStack::analyzeLegacy(bool _noErrorsSoFar)
 	// Create & assign callgraphs and check for contract dependency cycles
 	if (noErrors)
 	{
+		util::Profiler::Probe probe{"analysis", "CallGraph"};
 		createAndAssignCallGraphs();
 		annotateInternalFunctionIDs();
 		findAndReportCyclicContractDependencies();
 	}
 
 	if (noErrors)
+	{
+		util::Profiler::Probe probe{"analysis", "PostTypeContractLevelChecker"};
 		for (Source const* source: m_sourceOrder)
 			if (source->ast && !PostTypeContractLevelChecker{m_errorReporter}.check(*source->ast))
 				noErrors = false;
+	}
 
 	// Check that immutable variables are never read in c'tors and assigned
 	// exactly once
 	if (noErrors)
+	{
+		util::Profiler::Probe probe{"analysis", "ImmutableValidator"};
 		for (Source const* source: m_sourceOrder)
 			if (source->ast)
 				for (ASTPointer<ASTNode> const& node: source->ast->nodes())
 					if (ContractDefinition* contract = dynamic_cast<ContractDefinition*>(node.get()))
 						ImmutableValidator(m_errorReporter, *contract).analyze();
+	}
 
 	if (noErrors)
 	{
 		// Control flow graph generator and analyzer. It can check for issues such as
 		// variable is used before it is assigned to.
+		util::Profiler::Probe probe{"analysis", "ControlFlowAnalyzer"};
 		CFG cfg(m_errorReporter);
 		for (Source const* source: m_sourceOrder)
 			if (source->ast && !cfg.constructFlow(*source->ast))
@@ -628,6 +937,7 @@ bool CompilerStack::analyzeLegacy(bool _noErrorsSoFar)
 	if (noErrors)
 	{
 		// Checks for common mistakes. Only generates warnings.
+		util::Profiler::Probe probe{"analysis", "StaticAnalyzer"};
 		StaticAnalyzer staticAnalyzer(m_errorReporter);
 		for (Source const* source: m_sourceOrder)
 			if (source->ast && !staticAnalyzer.analyze(*source->ast))
@@ -637,6 +947,7 @@ bool CompilerStack::analyzeLegacy(bool _noErrorsSoFar)
 	if (noErrors)
 	{
 		// Check for state mutability in every function.
+		util::Profiler::Probe probe{"analysis", "ViewPureChecker"};
 		std::vector<ASTPointer<ASTNode>> ast;
 		for (Source const* source: m_sourceOrder)
 			if (source->ast)
@@ -649,6 +960,7 @@ bool CompilerStack::analyzeLegacy(bool _noErrorsSoFar)
 	if (noErrors)
 	{
 		// Run SMTChecker
+		util::Profiler::Probe probe{"analysis", "ModelChecker"};
 
 		auto allSources = util::applyMap(m_sourceOrder, [](Source const* _source) { return _source->ast; });
 		if (ModelChecker::isPragmaPresent(allSources))
@@ -674,6 +986,7 @@ bool CompilerStack::analyzeExperimental()
 {
 	solAssert(!m_experimentalAnalysis);
 	solAssert(m_maxAstId && *m_maxAstId >= 0);
+	util::Profiler::Probe probe{"analysis", "experimental::Analysis"};
 	m_experimentalAnalysis = std::make_unique<experimental::Analysis>(m_errorReporter, static_cast<std::uint64_t>(*m_maxAstId));
 	std::vector<std::shared_ptr<SourceUnit const>> sourceAsts;
 	for (Source const* source: m_sourceOrder)
@@ -719,6 +1032,16 @@ bool CompilerStack::isRequestedContract(ContractDefinition const& _contract) con
 	return false;
 }
 
+bool CompilerStack::keepsIR(ContractDefinition const& _contract) const
+{
+	return !m_discardIntermediateArtifacts || requestedPipelineConfig(_contract).irCodegen;
+}
+
+bool CompilerStack::keepsOptimizedIR(ContractDefinition const& _contract) const
+{
+	return !m_discardIntermediateArtifacts || requestedPipelineConfig(_contract).irOptimization;
+}
+
 CompilerStack::PipelineConfig CompilerStack::requestedPipelineConfig(ContractDefinition const& _contract) const
 {
 	static PipelineConfig constexpr defaultPipelineConfig = PipelineConfig{
@@ -743,6 +1066,8 @@ CompilerStack::PipelineConfig CompilerStack::requestedPipelineConfig(ContractDef
 
 bool CompilerStack::compile(State _stopAfter)
 {
+	YulStringRepository::Scope yulStringScope(*m_yulStringRepository);
+	TypeProvider::Scope typeScope(m_typeProvider.get());
 	m_stopAfter = _stopAfter;
 	if (m_stackState < AnalysisSuccessful)
 		if (!parseAndAnalyze(_stopAfter))
@@ -752,43 +1077,92 @@ bool CompilerStack::compile(State _stopAfter)
 		return true;
 
 	// Only compile contracts individually which have been requested.
-	std::map<ContractDefinition const*, std::shared_ptr<Compiler const>> otherCompilers;
-
+	std::vector<ContractDefinition const*> requestedContracts;
 	for (Source const* source: m_sourceOrder)
 		for (ASTPointer<ASTNode> const& node: source->ast->nodes())
 			if (auto contract = dynamic_cast<ContractDefinition const*>(node.get()))
 				if (isRequestedContract(*contract))
-				{
-					PipelineConfig pipelineConfig = requestedPipelineConfig(*contract);
+					requestedContracts.push_back(contract);
 
-					try
-					{
-						if (pipelineConfig.needIR(m_viaIR))
-							generateIR(*contract, pipelineConfig.needIRCodegenOnly(m_viaIR));
-						if (pipelineConfig.needBytecode())
-						{
-							if (m_viaIR)
-								generateEVMFromIR(*contract);
-							else
-							{
-								if (m_experimentalAnalysis)
-									solThrow(CompilerError, "Legacy codegen after experimental analysis is unsupported.");
-								compileContract(*contract, otherCompilers);
-							}
-						}
-					}
-					catch (Error const& _error)
-					{
-						reportCodeGenerationError(_error, contract);
-					}
-					catch (UnimplementedFeatureError const& _error)
-					{
-						reportUnimplementedFeatureError(_error, contract);
+	// Declared before the pool, so that the pointer is only cleared after all workers have finished.
+	ScopeGuard clearThreadPool([&]() { m_threadPool = nullptr; });
+	std::optional<util::ThreadPool> threadPool;
+	std::map<ContractDefinition const*, ScheduledIRCompilation> scheduledIRCompilations;
+	if (m_parallelism > 1)
+	{
+		threadPool.emplace(m_parallelism);
+		m_threadPool = &*threadPool;
+		scheduledIRCompilations = scheduleIRCompilation(requestedContracts, *threadPool);
+	}
+
+	// Index of the last requested contract whose IR generation reads the IR of a given contract,
+	// i.e. the IR of the contract itself and of the contracts it creates.
+	std::map<ContractDefinition const*, size_t> lastIRUse;
+	if (m_discardIntermediateArtifacts)
+		for (size_t index = 0; index < requestedContracts.size(); ++index)
+			if (requestedPipelineConfig(*requestedContracts[index]).needIR(m_viaIR))
+				for (ContractDefinition const* dependency: util::BreadthFirstSearch<ContractDefinition const*>{{requestedContracts[index]}}.run(
+					[](ContractDefinition const* _contract, auto&& _addChild) {
+						for (auto const& [dependency, referencee]: _contract->annotation().contractDependencies)
+							_addChild(dependency);
 					}
+				).visited)
+					lastIRUse[dependency] = index;
 
-					if (m_errorReporter.hasErrors())
-						return false;
+	std::map<ContractDefinition const*, std::shared_ptr<Compiler const>> otherCompilers;
+	for (size_t index = 0; index < requestedContracts.size(); ++index)
+	{
+		ContractDefinition const* contract = requestedContracts[index];
+		PipelineConfig pipelineConfig = requestedPipelineConfig(*contract);
+
+		try
+		{
+			std::optional<IRAssembly> irAssembly;
+			if (pipelineConfig.needIR(m_viaIR))
+			{
+				if (threadPool)
+					irAssembly = collectIRCompilation(*contract, scheduledIRCompilations.at(contract));
+				else
+				{
+					generateIR(*contract);
+					processIR(*contract, pipelineConfig.needIRCodegenOnly(m_viaIR));
 				}
+			}
+			if (pipelineConfig.needBytecode())
+			{
+				if (m_viaIR)
+					generateEVMFromIR(*contract, std::move(irAssembly));
+				else
+				{
+					if (m_experimentalAnalysis)
+						solThrow(CompilerError, "Legacy codegen after experimental analysis is unsupported.");
+					compileContract(*contract, otherCompilers);
+				}
+			}
+		}
+		catch (Error const& _error)
+		{
+			reportCodeGenerationError(_error, contract);
+		}
+		catch (UnimplementedFeatureError const& _error)
+		{
+			reportUnimplementedFeatureError(_error, contract);
+		}
+
+		// NOTE: Not using m_errorReporter.hasErrors() because errors reported during scheduling
+		// are already counted even though they end up in the list only when collected.
+		if (Error::containsErrors(m_errorList))
+			return false;
+
+		if (m_discardIntermediateArtifacts)
+		{
+			if (!keepsOptimizedIR(*contract))
+				m_contracts.at(contract->fullyQualifiedName()).yulStackOptimized.reset();
+			for (auto const& [irContract, lastUse]: lastIRUse)
+				if (lastUse == index && !keepsIR(*irContract))
+					m_contracts.at(irContract->fullyQualifiedName()).yulIR.reset();
+		}
+	}
 
 	solAssert(!m_errorReporter.hasErrors());
 	m_stackState = CompilationSuccessful;
@@ -806,9 +1180,11 @@ void CompilerStack::link()
 	}
 }
 
-YulStack CompilerStack::loadGeneratedIR(std::string const& _ir) const
+std::unique_ptr<YulStack> CompilerStack::loadGeneratedIR(std::string const& _ir) const
 {
-	YulStack stack(
+	// NOTE: Also called on worker threads and for outputs requested after compilation.
+	YulStringRepository::Scope yulStringScope(*m_yulStringRepository);
+	auto stack = std::make_unique<YulStack>(
 		m_evmVersion,
 		m_eofVersion,
 		YulStack::Language::StrictAssembly,
@@ -817,12 +1193,14 @@ YulStack CompilerStack::loadGeneratedIR(std::string const& _ir) const
 		this, // _soliditySourceProvider
 		m_objectOptimizer
 	);
-	bool yulAnalysisSuccessful = stack.parseAndAnalyze("", _ir);
+	// Sub-objects of the contract are optimized and assembled on the pool of the running compilation, if any.
+	stack->setThreadPool(m_threadPool);
+	bool yulAnalysisSuccessful = stack->parseAndAnalyze("", _ir);
 	solAssert(
 		yulAnalysisSuccessful,
 		_ir + "\n\n"
 		"Invalid IR generated:\n" +
-		SourceReferenceFormatter::formatErrorInformation(stack.errors(), stack) + "\n"
+		SourceReferenceFormatter::formatErrorInformation(stack->errors(), *stack) + "\n"
 	);
 
 	return stack;
@@ -984,10 +1362,10 @@ std::optional<Json> CompilerStack::yulIRAst(std::string const& _contractName) co
 	// keep it around when compiling a large project containing many contracts.
 	Contract const& currentContract = contract(_contractName);
 	yulAssert(currentContract.contract);
-	yulAssert(currentContract.yulIR.has_value() == currentContract.contract->canBeDeployed());
+	yulAssert(currentContract.yulIR.has_value() == (currentContract.contract->canBeDeployed() && keepsIR(*currentContract.contract)));
 	if (!currentContract.yulIR)
 		return std::nullopt;
-	return loadGeneratedIR(*currentContract.yulIR).astJson();
+	return loadGeneratedIR(*currentContract.yulIR)->astJson();
 }
 
 std::optional<Json> CompilerStack::yulCFGJson(std::string const& _contractName) const
@@ -999,16 +1377,23 @@ std::optional<Json> CompilerStack::yulCFGJson(std::string const& _contractName)
 	// keep it around when compiling a large project containing many contracts.
 	Contract const& currentContract = contract(_contractName);
 	yulAssert(currentContract.contract);
-	yulAssert(currentContract.yulIROptimized.has_value() == currentContract.contract->canBeDeployed());
-	if (!currentContract.yulIROptimized)
+	yulAssert(!!currentContract.yulStackOptimized == (currentContract.contract->canBeDeployed() && keepsOptimizedIR(*currentContract.contract)));
+	if (!currentContract.yulStackOptimized)
 		return std::nullopt;
-	return loadGeneratedIR(*currentContract.yulIROptimized).cfgJson();
+	YulStringRepository::Scope yulStringScope(*m_yulStringRepository);
+	return currentContract.yulStackOptimized->cfgJson();
 }
 
 std::optional<std::string> const& CompilerStack::yulIROptimized(std::string const& _contractName) const
 {
 	solAssert(m_stackState == CompilationSuccessful, "Compilation was not successful.");
-	return contract(_contractName).yulIROptimized;
+	Contract const& currentContract = contract(_contractName);
+	return currentContract.yulIROptimized.init([&]() -> std::optional<std::string> {
+		if (!currentContract.yulStackOptimized)
+			return std::nullopt;
+		YulStringRepository::Scope yulStringScope(*m_yulStringRepository);
+		return currentContract.yulStackOptimized->print();
+	});
 }
 
 std::optional<Json> CompilerStack::yulIROptimizedAst(std::string const& _contractName) const
@@ -1020,10 +1405,11 @@ std::optional<Json> CompilerStack::yulIROptimizedAst(std::string const& _contrac
 	// keep it around when compiling a large project containing many contracts.
 	Contract const& currentContract = contract(_contractName);
 	yulAssert(currentContract.contract);
-	yulAssert(currentContract.yulIROptimized.has_value() == currentContract.contract->canBeDeployed());
-	if (!currentContract.yulIROptimized)
+	yulAssert(!!currentContract.yulStackOptimized == (currentContract.contract->canBeDeployed() && keepsOptimizedIR(*currentContract.contract)));
+	if (!currentContract.yulStackOptimized)
 		return std::nullopt;
-	return loadGeneratedIR(*currentContract.yulIROptimized).astJson();
+	YulStringRepository::Scope yulStringScope(*m_yulStringRepository);
+	return currentContract.yulStackOptimized->astJson();
 }
 
 evmasm::LinkerObject const& CompilerStack::object(std::string const& _contractName) const
@@ -1418,6 +1804,7 @@ void CompilerStack::assembleYul(
 {
 	solAssert(m_stackState >= AnalysisSuccessful, "");
 
+	util::Profiler::Probe probe{"assembly", "CompilerStack::assembleYul", _contract.fullyQualifiedName()};
 	Contract& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
 
 	compiledContract.evmAssembly = _assembly;
@@ -1500,6 +1887,7 @@ void CompilerStack::compileContract(
 	if (!_contract.canBeDeployed())
 		return;
 
+	util::Profiler::Probe probe{"codegen", "Compiler", _contract.fullyQualifiedName()};
 	Contract& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
 
 	std::shared_ptr<Compiler> compiler = std::make_shared<Compiler>(
@@ -1522,7 +1910,7 @@ void CompilerStack::compileContract(
 	assembleYul(_contract, compiler->assemblyPtr(), compiler->runtimeAssemblyPtr());
 }
 
-void CompilerStack::generateIR(ContractDefinition const& _contract, bool _unoptimizedOnly)
+void CompilerStack::generateIR(ContractDefinition const& _contract)
 {
 	solAssert(m_stackState >= AnalysisSuccessful, "");
 
@@ -1543,11 +1931,12 @@ void CompilerStack::generateIR(ContractDefinition const& _contract, bool _unopti
 
 	std::string dependenciesSource;
 	for (auto const& [dependency, referencee]: _contract.annotation().contractDependencies)
-		generateIR(*dependency, _unoptimizedOnly);
+		generateIR(*dependency);
 
 	if (!_contract.canBeDeployed())
 		return;
 
+	util::Profiler::Probe probe{"codegen", "IRGenerator", _contract.fullyQualifiedName()};
 	std::map<ContractDefinition const*, std::string_view const> otherYulSources;
 	for (auto const& pair: m_contracts)
 		otherYulSources.emplace(pair.second.contract, pair.second.yulIR ? *pair.second.yulIR : std::string_view{});
@@ -1588,15 +1977,27 @@ void CompilerStack::generateIR(ContractDefinition const& _contract, bool _unopti
 	}
 
 	yulAssert(compiledContract.yulIR);
-	YulStack stack = loadGeneratedIR(*compiledContract.yulIR);
-	if (!_unoptimizedOnly)
-	{
-		stack.optimize();
-		compiledContract.yulIROptimized = stack.print();
-	}
 }
 
-void CompilerStack::generateEVMFromIR(ContractDefinition const& _contract)
+void CompilerStack::processIR(ContractDefinition const& _contract, bool _unoptimizedOnly)
+{
+	solAssert(m_stackState >= AnalysisSuccessful, "");
+
+	if (!_contract.canBeDeployed())
+		return;
+
+	util::Profiler::Probe probe{"yulOptimizer", "CompilerStack::processIR", _contract.fullyQualifiedName()};
+	Contract& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
+	yulAssert(compiledContract.yulIR);
+
+	if (_unoptimizedOnly)
+		// Only make sure that the generated code is valid.
+		loadGeneratedIR(*compiledContract.yulIR);
+	else if (!compiledContract.yulStackOptimized)
+		compiledContract.yulStackOptimized = optimizeIR(*compiledContract.yulIR);
+}
+
+void CompilerStack::generateEVMFromIR(ContractDefinition const& _contract, std::optional<IRAssembly> _irAssembly)
 {
 	solAssert(m_stackState >= AnalysisSuccessful, "");
 
@@ -1604,21 +2005,19 @@ void CompilerStack::generateEVMFromIR(ContractDefinition const& _contract)
 		return;
 
 	Contract& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
-	solAssert(compiledContract.yulIROptimized);
-	solAssert(!compiledContract.yulIROptimized->empty());
+	solAssert(compiledContract.yulStackOptimized);
 	if (!compiledContract.object.bytecode.empty())
 		return;
 
-	// Re-parse the Yul IR in EVM dialect
-	YulStack stack = loadGeneratedIR(*compiledContract.yulIROptimized);
+	if (!_irAssembly.has_value())
+		_irAssembly = assembleIR(_contract, *compiledContract.yulStackOptimized);
 
-	std::string deployedName = IRNames::deployedObject(_contract);
-	solAssert(!deployedName.empty(), "");
-	tie(compiledContract.evmAssembly, compiledContract.evmRuntimeAssembly) = stack.assembleEVMWithDeployed(deployedName);
+	compiledContract.evmAssembly = std::move(_irAssembly->evmAssembly);
+	compiledContract.evmRuntimeAssembly = std::move(_irAssembly->evmRuntimeAssembly);
 
-	if (stack.hasErrors())
+	if (Error::containsErrors(_irAssembly->errors))
 	{
-		for (std::shared_ptr<Error const> const& error: stack.errors())
+		for (std::shared_ptr<Error const> const& error: _irAssembly->errors)
 			reportIRPostAnalysisError(error.get(), compiledContract.contract);
 		return;
 	}
@@ -1626,6 +2025,113 @@ void CompilerStack::generateEVMFromIR(ContractDefinition const& _contract)
 	assembleYul(_contract, compiledContract.evmAssembly, compiledContract.evmRuntimeAssembly);
 }
 
+std::shared_ptr<YulStack> CompilerStack::optimizeIR(std::string const& _ir) const
+{
+	YulStringRepository::Scope yulStringScope(*m_yulStringRepository);
+	std::shared_ptr<YulStack> stack = loadGeneratedIR(_ir);
+	// NOTE: The optimizer reparses the optimized code, so the resulting AST matches its printed form.
+	stack->optimize();
+	return stack;
+}
+
+CompilerStack::IRAssembly CompilerStack::assembleIR(ContractDefinition const& _contract, YulStack& _optimizedStack) const
+{
+	YulStringRepository::Scope yulStringScope(*m_yulStringRepository);
+	util::Profiler::Probe probe{"assembly", "CompilerStack::assembleIR", _contract.fullyQualifiedName()};
+
+	std::string deployedName = IRNames::deployedObject(_contract);
+	solAssert(!deployedName.empty(), "");
+
+	IRAssembly irAssembly;
+	tie(irAssembly.evmAssembly, irAssembly.evmRuntimeAssembly) = _optimizedStack.assembleEVMWithDeployed(deployedName);
+	irAssembly.errors = _optimizedStack.errors();
+	return irAssembly;
+}
+
+std::map<ContractDefinition const*, CompilerStack::ScheduledIRCompilation> CompilerStack::scheduleIRCompilation(
+	std::vector<ContractDefinition const*> const& _contracts,
+	util::ThreadPool& _threadPool
+)
+{
+	solAssert(m_stackState >= AnalysisSuccessful, "");
+
+	std::map<ContractDefinition const*, ScheduledIRCompilation> scheduledCompilations;
+	for (ContractDefinition const* contract: _contracts)
+	{
+		PipelineConfig pipelineConfig = requestedPipelineConfig(*contract);
+		if (!pipelineConfig.needIR(m_viaIR))
+			continue;
+
+		ScheduledIRCompilation& scheduledCompilation = scheduledCompilations[contract];
+
+		// IR generation must stay sequential because it relies on global state shared with
+		// analysis (e.g. the type provider). It reports diagnostics directly to m_errorReporter
+		// so we temporarily swap out its error list to catch them.
+		langutil::ErrorList diagnostics;
+		std::swap(diagnostics, m_errorList);
+		try
+		{
+			generateIR(*contract);
+		}
+		catch (...)
+		{
+			scheduledCompilation.codegenFailure = std::current_exception();
+		}
+		std::swap(diagnostics, m_errorList);
+		scheduledCompilation.codegenDiagnostics = std::move(diagnostics);
+
+		if (scheduledCompilation.codegenFailure || Error::containsErrors(scheduledCompilation.codegenDiagnostics))
+			// Sequential compilation would not get past this contract either.
+			break;
+
+		if (!contract->canBeDeployed())
+			continue;
+
+		bool const unoptimizedOnly = pipelineConfig.needIRCodegenOnly(m_viaIR);
+		bool const assemble = pipelineConfig.needBytecode() && m_viaIR;
+		solAssert(!(unoptimizedOnly && assemble));
+
+		// NOTE: Worker threads only read the IR of this contract, which is not modified anymore.
+		std::string const* ir = &*m_contracts.at(contract->fullyQualifiedName()).yulIR;
+		scheduledCompilation.compilation = _threadPool.submit([this, contract, ir, unoptimizedOnly, assemble]() {
+			IRCompilation compilation;
+			{
+				// Same as processIR().
+				util::Profiler::Probe probe{"yulOptimizer", "CompilerStack::processIR", contract->fullyQualifiedName()};
+				if (unoptimizedOnly)
+					loadGeneratedIR(*ir);
+				else
+					compilation.yulStackOptimized = optimizeIR(*ir);
+			}
+			if (assemble)
+				compilation.irAssembly = assembleIR(*contract, *compilation.yulStackOptimized);
+			return compilation;
+		});
+	}
+	return scheduledCompilations;
+}
+
+std::optional<CompilerStack::IRAssembly> CompilerStack::collectIRCompilation(
+	ContractDefinition const& _contract,
+	ScheduledIRCompilation& _scheduledCompilation
+)
+{
+	m_errorReporter.append(_scheduledCompilation.codegenDiagnostics);
+	if (_scheduledCompilation.codegenFailure)
+		std::rethrow_exception(_scheduledCompilation.codegenFailure);
+
+	if (!_scheduledCompilation.compilation.has_value())
+		return std::nullopt;
+
+	// Help with the queued tasks instead of blocking, since they may be waiting for a free worker.
+	solAssert(m_threadPool);
+	m_threadPool->wait(*_scheduledCompilation.compilation);
+	IRCompilation compilation = _scheduledCompilation.compilation->get();
+	if (compilation.yulStackOptimized)
+		m_contracts.at(_contract.fullyQualifiedName()).yulStackOptimized = std::move(compilation.yulStackOptimized);
+	return std::move(compilation.irAssembly);
+}
+
 CompilerStack::Contract const& CompilerStack::contract(std::string const& _contractName) const
 {
 	solAssert(m_stackState >= AnalysisSuccessful, "");
@@ -28,6 +28,7 @@
 #include <libsolidity/interface/ReadFile.h>
 #include <libsolidity/interface/ImportRemapper.h>
 #include <libsolidity/interface/OptimiserSettings.h>
+#include <libsolidity/interface/ParsedSourceCache.h>
 #include <libsolidity/interface/Version.h>
 #include <libsolidity/interface/DebugSettings.h>
 
@@ -50,8 +51,13 @@
 #include <libsolutil/JSON.h>
 
 #include <libyul/ObjectOptimizer.h>
+#include <libyul/YulString.h>
 
+#include <boost/filesystem.hpp>
+
+#include <exception>
 #include <functional>
+#include <future>
 #include <memory>
 #include <ostream>
 #include <set>
@@ -76,6 +82,12 @@ namespace solidity::yul
 class YulStack;
 }
 
+namespace solidity::util
+{
+class DiskCache;
+class ThreadPool;
+}
+
 namespace solidity::frontend
 {
 
@@ -88,6 +100,7 @@ class Compiler;
 class GlobalContext;
 class Natspec;
 class DeclarationContainer;
+class TypeProvider;
 namespace experimental
 {
 class Analysis;
@@ -184,7 +197,11 @@ public:
 	/// Creates a new compiler stack.
 	/// @param _readFile callback used to read files for import statements. Must return
 	/// and must not emit exceptions.
-	explicit CompilerStack(ReadCallback::Callback _readFile = ReadCallback::Callback());
+	/// @param _ownTypeProvider if true, the types of this compilation are kept in a TypeProvider of
+	/// its own instead of the process-wide one, so that other compiler stacks can be alive at the same
+	/// time, also on other threads. Types obtained from such a stack outside of its member functions must
+	/// only be used while its typeProvider() is made current via TypeProvider::Scope.
+	explicit CompilerStack(ReadCallback::Callback _readFile = ReadCallback::Callback(), bool _ownTypeProvider = false);
 
 	~CompilerStack() override;
 
@@ -235,6 +252,52 @@ public:
 	/// Set model checker settings.
 	void setModelCheckerSettings(ModelCheckerSettings _settings);
 
+	/// Sets the maximum number of threads used for parsing, analysis and code generation.
+	/// With values greater than 1, sources are parsed and checked separately concurrently where possible
+	/// and the optimization and assembly of IR of independent contracts and of their sibling Yul
+	/// sub-objects is performed concurrently.
+	/// The output does not depend on this setting.
+	/// Must be set before the respective step (parsing, analysis, compilation) to affect it and must
+	/// not exceed util::ThreadPool::maxWorkers().
+	void setParallelism(size_t _parallelism);
+
+	/// If enabled, the unoptimized IR of a contract and its parsed optimized form are freed during
+	/// compilation as soon as neither the outputs selected for the contract nor the compilation of
+	/// other contracts need them anymore. Outputs that were not selected are not available then.
+	/// Must be set before compiling.
+	void setDiscardIntermediateArtifacts(bool _discard);
+
+	/// Size in bytes above which least recently used entries are removed from the optimizer cache
+	/// on disk, unless specified otherwise.
+	static std::uintmax_t constexpr defaultOptimizerCacheMaxSize = 1024 * 1024 * 1024;
+
+	/// Enables a persistent cache of Yul optimizer results in the given directory.
+	/// The directory may be shared with other, concurrently running compiler processes.
+	/// Least recently used entries are removed when the cache grows beyond @a _maxSize bytes.
+	/// Must be set before compiling.
+	void setOptimizerCacheDirectory(
+		boost::filesystem::path const& _directory,
+		std::uintmax_t _maxSize = defaultOptimizerCacheMaxSize
+	);
+
+	/// Takes the ASTs of unchanged sources from @a _cache instead of parsing them again and
+	/// gives them back to it on reset. Not affected by resetting the settings.
+	/// Must be set before parsing.
+	void setParsedSourceCache(std::shared_ptr<ParsedSourceCache> _cache);
+
+	/// Makes the compiler intern Yul names in @a _yulStringRepository and optimize Yul code using
+	/// @a _objectOptimizer, so that consecutive compilations given the same pair reuse each other's
+	/// optimized objects. The cached objects refer to names in the repository, so the optimizer must
+	/// never be used with another one. Neither is replaced on reset.
+	/// Must be set before parsing and cannot be combined with setOptimizerCacheDirectory().
+	void shareYulOptimizerCache(
+		std::shared_ptr<yul::YulStringRepository> _yulStringRepository,
+		std::shared_ptr<yul::ObjectOptimizer> _objectOptimizer
+	);
+
+	/// @returns the type provider owned by this compiler stack or nullptr if it uses the process-wide one.
+	TypeProvider* typeProvider() const { return m_typeProvider.get(); }
+
 	/// Sets names of the contracts from each source that should be compiled.
 	/// If empty, no filtering is performed and every contract found in the supplied sources goes
 	/// through the default pipeline stages (bytecode-only, no IR).
@@ -269,6 +332,13 @@ public:
 	/// Imports given SourceUnits so they can be analyzed. Leads to the same internal state as parse().
 	/// Will throw errors if the import fails
 	void importASTs(std::map<std::string, Json> const& _sources);
+	/// Same as above, but imports the sources one by one, so that their JSON does not have to be
+	/// kept in memory together. @a _readASTs has to pass the name and the AST of each source in
+	/// @a _sourceNames to the function it is given.
+	void importASTs(
+		std::set<std::string> const& _sourceNames,
+		std::function<void(std::function<void(std::string const&, Json const&)> const&)> const& _readASTs
+	);
 
 	/// Performs the analysis steps (imports, scopesetting, syntaxCheck, referenceResolving,
 	///  typechecking, staticAnalysis) on previously parsed sources.
@@ -425,6 +495,11 @@ private:
 	{
 		std::shared_ptr<langutil::CharStream> charStream;
 		std::shared_ptr<SourceUnit> ast;
+		/// Set if the AST can be given to the parsed source cache once the compilation is over.
+		std::optional<ParsedSourceCache::Key> cacheKey;
+		/// Values of the ID counter of the parser before and after the AST was created.
+		int64_t idBegin = 0;
+		int64_t idEnd = 0;
 		util::h256 mutable keccak256HashCached;
 		util::h256 mutable swarmHashCached;
 		std::string mutable ipfsUrlCached;
@@ -446,7 +521,10 @@ private:
 		evmasm::LinkerObject object; ///< Deployment object (includes the runtime sub-object).
 		evmasm::LinkerObject runtimeObject; ///< Runtime object.
 		std::optional<std::string> yulIR; ///< Yul IR code straight from the code generator.
-		std::optional<std::string> yulIROptimized; ///< Reparsed and possibly optimized Yul IR code.
+		/// Reparsed and possibly optimized Yul IR, kept in parsed and analyzed form so that it can be
+		/// assembled without printing and parsing it again.
+		std::shared_ptr<yul::YulStack> yulStackOptimized;
+		util::LazyInit<std::optional<std::string> const> yulIROptimized; ///< Source of @a yulStackOptimized, printed on request.
 		util::LazyInit<std::string const> metadata; ///< The metadata json that will be hashed into the chain.
 		util::LazyInit<Json const> abi;
 		util::LazyInit<Json const> storageLayout;
@@ -457,9 +535,55 @@ private:
 		mutable std::optional<std::string const> runtimeSourceMapping;
 	};
 
+	/// EVM assembly produced from the optimized IR of a single contract along with the
+	/// diagnostics reported by the Yul stack in the process.
+	struct IRAssembly
+	{
+		std::shared_ptr<evmasm::Assembly> evmAssembly;
+		std::shared_ptr<evmasm::Assembly> evmRuntimeAssembly;
+		langutil::ErrorList errors;
+	};
+
+	/// The part of the via-IR pipeline for a single contract that does not depend on the state
+	/// of other contracts and can be executed on a worker thread.
+	struct IRCompilation
+	{
+		std::shared_ptr<yul::YulStack> yulStackOptimized;
+		std::optional<IRAssembly> irAssembly;
+	};
+
+	/// Progress of a contract scheduled for concurrent compilation by @a scheduleIRCompilation.
+	struct ScheduledIRCompilation
+	{
+		/// Diagnostics reported while generating IR. Set aside so that they can be reported in
+		/// the same order as in sequential compilation.
+		langutil::ErrorList codegenDiagnostics;
+		/// Exception thrown while generating IR, if any. In that case nothing gets scheduled.
+		std::exception_ptr codegenFailure;
+		std::optional<std::future<IRCompilation>> compilation;
+	};
+
+	/// A source parsed on a worker thread by a parser and error reporter of its own.
+	struct SeparatelyParsedSource
+	{
+		/// The stream that was parsed. The result is only used if the source still has this stream.
+		std::shared_ptr<langutil::CharStream> charStream;
+		std::shared_ptr<SourceUnit> ast;
+		/// Number of node IDs used by the parser. The IDs of @a ast start at one.
+		int64_t idCount = 0;
+		langutil::ErrorList messages;
+	};
+
 	void createAndAssignCallGraphs();
 	void findAndReportCyclicContractDependencies();
 
+	/// Queues parsing @a _charStream in @a _threadPool, so that its result can be taken over by
+	/// @a parse() when it reaches the source, instead of parsing it then.
+	std::future<SeparatelyParsedSource> scheduleParsing(
+		std::shared_ptr<langutil::CharStream> _charStream,
+		util::ThreadPool& _threadPool
+	) const;
+
 	/// Loads the missing sources from @a _ast (named @a _path) using the callback
 	/// @a m_readFile
 	/// @returns the newly loaded sources.
@@ -470,6 +594,9 @@ private:
 	/// Store the contract definitions in m_contracts.
 	void storeContractDefinitions();
 
+	/// Gives the ASTs that may be reused by later compilations to the parsed source cache.
+	void returnASTsToCache();
+
 	/// Annotate internal dispatch function Ids
 	void annotateInternalFunctionIDs();
 
@@ -483,6 +610,21 @@ private:
 	///     Applies defaults for contracts that were not explicitly selected and combines
 	///     multiple entries if the contact is matched by wildcards.
 	PipelineConfig requestedPipelineConfig(ContractDefinition const& _contract) const;
+	/// @returns false if the unoptimized IR of @a _contract is discarded once no other contract needs it,
+	/// i.e. if intermediate artifacts are discarded and no unoptimized IR output was requested for it.
+	bool keepsIR(ContractDefinition const& _contract) const;
+	/// @returns false if the optimized IR of @a _contract is discarded once its bytecode was generated,
+	/// i.e. if intermediate artifacts are discarded and no optimized IR output was requested for it.
+	bool keepsOptimizedIR(ContractDefinition const& _contract) const;
+
+	/// Runs @a _check on the AST of each source, reporting messages in the order of the sources.
+	/// If @a _threadPool is given, the checks run concurrently, each with an error reporter of its
+	/// own, so they must not access anything but their own source, in particular no types.
+	/// @returns false if any of the checks returned false.
+	bool checkEachSource(
+		std::function<bool(SourceUnit const&, langutil::ErrorReporter&)> const& _check,
+		util::ThreadPool* _threadPool
+	);
 
 	/// Perform the analysis steps of legacy language mode.
 	/// @returns false on error.
@@ -508,19 +650,56 @@ private:
 		std::map<ContractDefinition const*, std::shared_ptr<Compiler const>>& _otherCompilers
 	);
 
-	/// Generate Yul IR for a single contract.
+	/// Generate Yul IR for a single contract and the contracts it depends on.
+	/// Only the IR coming directly from the code generator is stored. It becomes usable for
+	/// code generation only after going through processIR.
+	/// @param _contract Contract to generate IR for.
+	void generateIR(ContractDefinition const& _contract);
+
+	/// Reparses IR generated by generateIR and passes it through the optimizer.
 	/// Unoptimized IR is stored but otherwise unused, while optimized IR may be used for code
 	/// generation if compilation via IR is enabled. Note that whether "optimized IR" is actually
 	/// optimized depends on the optimizer settings.
-	/// @param _contract Contract to generate IR for.
-	/// @param _unoptimizedOnly If true, only the IR coming directly from the codegen is stored.
+	/// @param _contract Contract to process the IR of.
+	/// @param _unoptimizedOnly If true, the IR is only checked for validity.
 	///     Optimizer is not invoked and optimized IR output is not available, which means that
 	///     optimized IR, its AST or compilation via IR must not be requested.
-	void generateIR(ContractDefinition const& _contract, bool _unoptimizedOnly);
+	void processIR(ContractDefinition const& _contract, bool _unoptimizedOnly);
 
 	/// Generate EVM representation for a single contract.
-	/// Depends on output generated by generateIR.
-	void generateEVMFromIR(ContractDefinition const& _contract);
+	/// Depends on output generated by processIR.
+	/// @param _irAssembly Assembly already produced from the optimized IR of the contract by
+	///     assembleIR. Produced from scratch if not provided.
+	void generateEVMFromIR(ContractDefinition const& _contract, std::optional<IRAssembly> _irAssembly = std::nullopt);
+
+	/// Parses, analyzes and optimizes the given IR.
+	/// Does not modify the state of the stack and is safe to call from multiple threads.
+	/// @returns the Yul stack holding the optimized IR.
+	std::shared_ptr<yul::YulStack> optimizeIR(std::string const& _ir) const;
+
+	/// Translates optimized IR of @a _contract into EVM assembly.
+	/// Does not modify the state of the stack and is safe to call from multiple threads
+	/// as long as they use distinct Yul stacks.
+	/// @param _optimizedStack Yul stack returned by optimizeIR.
+	IRAssembly assembleIR(ContractDefinition const& _contract, yul::YulStack& _optimizedStack) const;
+
+	/// Generates IR for all of @a _contracts that need it and queues its further processing
+	/// (optimization and, for compilation via IR, assembly) in @a _threadPool.
+	/// IR generation itself happens on the current thread in the order of @a _contracts and stops
+	/// at the first contract for which it fails.
+	/// The results must be collected with collectIRCompilation in the same order.
+	std::map<ContractDefinition const*, ScheduledIRCompilation> scheduleIRCompilation(
+		std::vector<ContractDefinition const*> const& _contracts,
+		util::ThreadPool& _threadPool
+	);
+
+	/// Stores the results of processing the IR of @a _contract by scheduleIRCompilation and reports
+	/// diagnostics set aside during IR generation. Rethrows any exception encountered.
+	/// @returns the EVM assembly produced from the IR if compilation via IR was requested.
+	std::optional<IRAssembly> collectIRCompilation(
+		ContractDefinition const& _contract,
+		ScheduledIRCompilation& _scheduledCompilation
+	);
 
 	/// Links all the known library addresses in the available objects. Any unknown
 	/// library will still be kept as an unlinked placeholder in the objects.
@@ -529,7 +708,7 @@ private:
 	/// Parses and analyzes specified Yul source and returns the YulStack that can be used to manipulate it.
 	/// Assumes that the IR was generated from sources loaded currently into CompilerStack, which
 	/// means that it is error-free and uses the same settings.
-	yul::YulStack loadGeneratedIR(std::string const& _ir) const;
+	std::unique_ptr<yul::YulStack> loadGeneratedIR(std::string const& _ir) const;
 
 	/// @returns the contract object for the given @a _contractName.
 	/// Can only be called after state is CompilationSuccessful.
@@ -585,6 +764,13 @@ private:
 	void reportCodeGenerationError(langutil::Error const& _error, ContractDefinition const* _contractDefinition);
 	void reportIRPostAnalysisError(langutil::Error const* _error, ContractDefinition const* _contractDefinition);
 
+	/// Owns the types of this compilation if it does not use the process-wide TypeProvider.
+	std::unique_ptr<TypeProvider> m_typeProvider;
+	/// Owns the Yul names used by this compilation. Declared first so that it outlives all the
+	/// ASTs and cached objects referring to it.
+	std::shared_ptr<yul::YulStringRepository> m_yulStringRepository;
+	/// True if the Yul names and optimizer cache are shared with other compilations.
+	bool m_sharedYulOptimizerCache = false;
 	ReadCallback::Callback m_readFile;
 	OptimiserSettings m_optimiserSettings;
 	RevertStrings m_revertStrings = RevertStrings::Default;
@@ -593,6 +779,10 @@ private:
 	langutil::EVMVersion m_evmVersion;
 	std::optional<uint8_t> m_eofVersion;
 	ModelCheckerSettings m_modelCheckerSettings;
+	size_t m_parallelism = 1;
+	bool m_discardIntermediateArtifacts = false;
+	/// Worker pool of the currently running compile() call, if it runs in parallel. Not owned.
+	util::ThreadPool* m_threadPool = nullptr;
 	ContractSelection m_selectedContracts;
 	std::map<std::string, util::h160> m_libraries;
 	ImportRemapper m_importRemapper;
@@ -604,6 +794,8 @@ private:
 	std::vector<Source const*> m_sourceOrder;
 	std::map<std::string const, Contract> m_contracts;
 	std::shared_ptr<yul::ObjectOptimizer> m_objectOptimizer;
+	std::shared_ptr<util::DiskCache> m_optimizerDiskCache;
+	std::shared_ptr<ParsedSourceCache> m_parsedSourceCache;
 
 	langutil::ErrorList m_errorList;
 	langutil::ErrorReporter m_errorReporter;
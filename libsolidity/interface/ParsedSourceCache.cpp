@@ -0,0 +1,180 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolidity/interface/ParsedSourceCache.h>
+
+#include <libsolidity/ast/AST.h>
+#include <libsolidity/ast/ASTUtils.h>
+#include <libsolidity/ast/ASTVisitor.h>
+
+#include <libyul/AST.h>
+#include <libyul/YulString.h>
+#include <libyul/optimiser/ASTCopier.h>
+
+using namespace solidity;
+using namespace solidity::frontend;
+
+namespace
+{
+
+class AnalysisRemover: public ASTVisitor
+{
+public:
+	std::vector<InlineAssembly*> inlineAssemblies;
+	size_t nodeCount = 0;
+
+private:
+	bool visit(InlineAssembly& _inlineAssembly) override
+	{
+		inlineAssemblies.push_back(&_inlineAssembly);
+		return visitNode(_inlineAssembly);
+	}
+	bool visitNode(ASTNode& _node) override
+	{
+		_node.resetAnalysis();
+		++nodeCount;
+		return true;
+	}
+};
+
+/// Copies Yul code, interning all names in the Yul string repository that is current.
+class YulNameInterner: public yul::ASTCopier
+{
+protected:
+	yul::YulName translateIdentifier(yul::YulName _name) override { return yul::YulName{_name.str()}; }
+};
+
+void internYulNames(std::vector<InlineAssembly*> const& _inlineAssemblies)
+{
+	for (InlineAssembly* inlineAssembly: _inlineAssemblies)
+	{
+		yul::AST const& operations = inlineAssembly->operations();
+		inlineAssembly->replaceOperations(std::make_shared<yul::AST>(
+			operations.dialect(),
+			YulNameInterner{}.translate(operations.root())
+		));
+	}
+}
+
+}
+
+std::optional<ParsedSourceCache::Entry> ParsedSourceCache::take(Key const& _key, int64_t _idBegin)
+{
+	std::optional<Entry> entry;
+	std::vector<InlineAssembly*> inlineAssemblies;
+	// Keeps the names of the inline assembly alive until they are interned in the current repository.
+	std::shared_ptr<yul::YulStringRepository> yulStrings;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		auto it = m_entries.find(_key);
+		if (it == m_entries.end())
+			return std::nullopt;
+		entry = std::move(it->second.entry);
+		inlineAssemblies = std::move(it->second.inlineAssemblies);
+		yulStrings = std::move(it->second.yulStrings);
+		remove(it);
+	}
+
+	internYulNames(inlineAssemblies);
+	if (int64_t offset = _idBegin - entry->idBegin)
+	{
+		shiftNodeIDs(*entry->ast, offset);
+		entry->idBegin += offset;
+		entry->idEnd += offset;
+	}
+	return entry;
+}
+
+void ParsedSourceCache::store(Key _key, Entry _entry)
+{
+	AnalysisRemover remover;
+	_entry.ast->accept(remover);
+	size_t const memoryUsage = remover.nodeCount * c_estimatedBytesPerNode;
+	if (memoryUsage > m_memoryBudget)
+		return;
+
+	std::shared_ptr<yul::YulStringRepository> yulStrings;
+	if (!remover.inlineAssemblies.empty())
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			if (!m_yulStringRepository)
+				m_yulStringRepository = std::make_shared<yul::YulStringRepository>();
+			yulStrings = m_yulStringRepository;
+		}
+		yul::YulStringRepository::Scope yulStringScope(*yulStrings);
+		internYulNames(remover.inlineAssemblies);
+	}
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+	if (m_singleVersionPerSource)
+	{
+		// Entries are ordered by source unit name first.
+		auto it = m_entries.lower_bound(Key{_key.sourceUnitName, util::h256{}, langutil::EVMVersion::allVersions().front(), std::nullopt});
+		while (it != m_entries.end() && it->first.sourceUnitName == _key.sourceUnitName)
+			remove(it++);
+	}
+	else if (auto it = m_entries.find(_key); it != m_entries.end())
+		remove(it);
+	while (!m_storeOrder.empty() && m_memoryUsage + memoryUsage > m_memoryBudget)
+		remove(m_entries.find(m_storeOrder.front()));
+
+	auto age = m_storeOrder.insert(m_storeOrder.end(), _key);
+	m_entries.emplace(
+		std::move(_key),
+		StoredEntry{std::move(_entry), memoryUsage, age, std::move(remover.inlineAssemblies), std::move(yulStrings)}
+	);
+	m_memoryUsage += memoryUsage;
+}
+
+bool ParsedSourceCache::contains(Key const& _key) const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_entries.count(_key) > 0;
+}
+
+size_t ParsedSourceCache::size() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_entries.size();
+}
+
+size_t ParsedSourceCache::memoryUsage() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_memoryUsage;
+}
+
+void ParsedSourceCache::clear()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_entries.clear();
+	m_storeOrder.clear();
+	m_memoryUsage = 0;
+	m_yulStringRepository.reset();
+}
+
+void ParsedSourceCache::remove(std::map<Key, StoredEntry>::iterator _it)
+{
+	m_memoryUsage -= _it->second.memoryUsage;
+	m_storeOrder.erase(_it->second.age);
+	m_entries.erase(_it);
+	// Releases the names of inline assembly that is not stored anymore, unless a tree still refers to them.
+	if (m_yulStringRepository && m_yulStringRepository.use_count() == 1)
+		m_yulStringRepository.reset();
+}
@@ -0,0 +1,152 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Store of parsed source units that outlives a single compilation.
+ */
+
+#pragma once
+
+#include <libsolidity/ast/ASTForward.h>
+
+#include <liblangutil/EVMVersion.h>
+
+#include <libsolutil/FixedHash.h>
+
+#include <limits>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace solidity::yul
+{
+class YulStringRepository;
+}
+
+namespace solidity::frontend
+{
+
+/**
+ * Store of parsed source units that can be reused by later compilations.
+ *
+ * A CompilerStack that is given a cache takes the AST of a source from it instead of parsing the
+ * source again if the source unit name, the content and the parser settings match, and gives
+ * its ASTs back when it is reset or destroyed. Since analysis stores its results in the AST,
+ * a tree is used by at most one compilation at a time and everything analysis attached to it
+ * is removed when it is given back.
+ *
+ * The Yul ASTs of inline assembly refer to strings of the compilation that parsed them. When a tree
+ * is stored, its Yul names are copied into a string repository of the cache, which the stored tree
+ * keeps alive, and when it is taken, into the repository of the compilation that takes it.
+ * The repository of the cache is replaced once no stored tree refers to it anymore.
+ *
+ * The memory used by the stored trees is estimated from their number of nodes. If it exceeds
+ * the budget, the trees that were stored the longest time ago are dropped. Users that only
+ * ever compile the latest version of each source, like the language server, can in addition
+ * have all other trees of a source unit name dropped when a tree is stored for it.
+ */
+class ParsedSourceCache
+{
+public:
+	/// Rough average of the memory used by an AST node, including its annotation and the strings it owns.
+	static size_t constexpr c_estimatedBytesPerNode = 256;
+
+	/// @param _memoryBudget upper bound of the estimated memory used by the stored trees, in bytes.
+	/// @param _singleVersionPerSource whether storing a tree drops the other trees of its source unit name.
+	explicit ParsedSourceCache(
+		size_t _memoryBudget = std::numeric_limits<size_t>::max(),
+		bool _singleVersionPerSource = false
+	):
+		m_memoryBudget(_memoryBudget),
+		m_singleVersionPerSource(_singleVersionPerSource)
+	{}
+
+	struct Key
+	{
+		std::string sourceUnitName;
+		util::h256 contentHash;
+		langutil::EVMVersion evmVersion;
+		std::optional<uint8_t> eofVersion;
+
+		bool operator<(Key const& _other) const
+		{
+			return
+				std::tie(sourceUnitName, contentHash, evmVersion, eofVersion) <
+				std::tie(_other.sourceUnitName, _other.contentHash, _other.evmVersion, _other.eofVersion);
+		}
+	};
+
+	struct Entry
+	{
+		std::shared_ptr<SourceUnit> ast;
+		/// The node IDs of the tree are in the half-open range (idBegin, idEnd], i.e. these are
+		/// the values of the ID counter of the parser before and after parsing the source.
+		int64_t idBegin = 0;
+		int64_t idEnd = 0;
+	};
+
+	/// Removes the tree stored for @a _key from the cache and relocates its node IDs
+	/// so that they start after @a _idBegin. The names of its inline assembly are interned
+	/// in the Yul string repository that is current.
+	/// @returns the relocated entry or nullopt if there is no tree for @a _key.
+	std::optional<Entry> take(Key const& _key, int64_t _idBegin);
+
+	/// Removes all analysis results from the tree of @a _entry and stores it for @a _key,
+	/// unless it exceeds the memory budget on its own.
+	/// Requires the Yul strings of the tree to still be alive.
+	void store(Key _key, Entry _entry);
+
+	/// @returns true if a tree is stored for @a _key.
+	bool contains(Key const& _key) const;
+	/// @returns the number of stored trees.
+	size_t size() const;
+	/// @returns the estimated memory used by the stored trees, in bytes.
+	size_t memoryUsage() const;
+	size_t memoryBudget() const { return m_memoryBudget; }
+	void clear();
+
+private:
+	struct StoredEntry
+	{
+		Entry entry;
+		size_t memoryUsage = 0;
+		/// Position in m_storeOrder.
+		std::list<Key>::iterator age;
+		/// Inline assembly in the tree, whose names are interned in @a yulStrings.
+		std::vector<InlineAssembly*> inlineAssemblies;
+		std::shared_ptr<yul::YulStringRepository> yulStrings;
+	};
+
+	void remove(std::map<Key, StoredEntry>::iterator _it);
+
+	size_t const m_memoryBudget;
+	bool const m_singleVersionPerSource;
+	mutable std::mutex m_mutex;
+	std::map<Key, StoredEntry> m_entries;
+	/// Keys of the stored trees, least recently stored first.
+	std::list<Key> m_storeOrder;
+	size_t m_memoryUsage = 0;
+	/// Repository the names of inline assembly are interned in while it is stored.
+	std::shared_ptr<yul::YulStringRepository> m_yulStringRepository;
+};
+
+}
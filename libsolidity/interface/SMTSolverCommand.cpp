@@ -19,71 +19,324 @@
 
 #include <liblangutil/Exceptions.h>
 
+#include <libsmtutil/CancellationToken.h>
+
+#include <libsolutil/Common.h>
+
 #include <boost/algorithm/string/join.hpp>
+#include <boost/algorithm/string/predicate.hpp>
 #include <boost/process.hpp>
 
+#include <algorithm>
+#include <optional>
+#include <tuple>
+
 namespace solidity::frontend
 {
 
+namespace
+{
+
+/// Printed by the solver after the response to each query of a session.
+std::string const sessionResponseEnd = "solc-query-done";
+
+}
+
+std::vector<std::string> SMTSolverSessionState::splitCommands(std::string const& _script)
+{
+	std::vector<std::string> commands;
+	size_t depth = 0;
+	size_t start = 0;
+	for (size_t i = 0; i < _script.size(); ++i)
+	{
+		char const c = _script[i];
+		if (c == '|')
+			i = _script.find('|', i + 1);
+		else if (c == '"')
+			// Quotes inside of string literals are escaped as "".
+			while (true)
+			{
+				i = _script.find('"', i + 1);
+				if (i == std::string::npos || i + 1 == _script.size() || _script[i + 1] != '"')
+					break;
+				++i;
+			}
+		else if (c == ';')
+			i = _script.find('\n', i);
+		else if (c == '(')
+		{
+			if (depth++ == 0)
+				start = i;
+		}
+		else if (c == ')' && depth > 0)
+		{
+			if (--depth == 0)
+				commands.emplace_back(_script.substr(start, i + 1 - start));
+		}
+
+		if (i == std::string::npos)
+			break;
+	}
+	// Let the solver report unterminated commands.
+	if (depth > 0)
+		commands.emplace_back(_script.substr(start));
+	return commands;
+}
+
+std::string SMTSolverSessionState::input(std::string const& _query)
+{
+	std::vector<std::string> const commands = splitCommands(_query);
+	auto const preambleEnd = std::find_if(commands.begin(), commands.end(), [](std::string const& _command) {
+		return !boost::starts_with(_command, "(set-option") && !boost::starts_with(_command, "(set-logic");
+	});
+	auto const actionsBegin = std::find_if(preambleEnd, commands.end(), [](std::string const& _command) {
+		return boost::starts_with(_command, "(check-sat");
+	});
+	std::vector<std::string> const preamble(commands.begin(), preambleEnd);
+	std::vector<std::string> const state(preambleEnd, actionsBegin);
+
+	// Horn solvers do not support push and pop, the query is sent in full.
+	bool const incremental = std::find(preamble.begin(), preamble.end(), "(set-logic HORN)") == preamble.end();
+
+	std::string input;
+	if (!incremental || preamble != m_preamble)
+	{
+		input += "(reset)\n";
+		for (std::string const& command: preamble)
+			input += command + '\n';
+		m_preamble = preamble;
+		m_frames.clear();
+	}
+
+	if (incremental)
+	{
+		// Keep the frames the new query starts with.
+		size_t keptFrames = 0;
+		size_t matched = 0;
+		for (; keptFrames < m_frames.size(); ++keptFrames)
+		{
+			std::vector<std::string> const& frame = m_frames[keptFrames];
+			if (
+				frame.size() > state.size() - matched ||
+				!std::equal(frame.begin(), frame.end(), state.begin() + static_cast<ptrdiff_t>(matched))
+			)
+				break;
+			matched += frame.size();
+		}
+		size_t common = matched;
+		if (keptFrames < m_frames.size())
+			for (std::string const& command: m_frames[keptFrames])
+			{
+				if (common == state.size() || state[common] != command)
+					break;
+				++common;
+			}
+		for (size_t i = keptFrames; i < m_frames.size(); ++i)
+			input += "(pop 1)\n";
+		m_frames.resize(keptFrames);
+
+		// Place a frame boundary where the new query diverges from the previous one,
+		// so that the common part stays loaded for subsequent queries.
+		pushFrame(input, state.begin() + static_cast<ptrdiff_t>(matched), state.begin() + static_cast<ptrdiff_t>(common));
+		pushFrame(input, state.begin() + static_cast<ptrdiff_t>(common), state.end());
+	}
+	else
+		for (std::string const& command: state)
+			input += command + '\n';
+
+	for (auto action = actionsBegin; action != commands.end(); ++action)
+		input += *action + '\n';
+	return input;
+}
+
+void SMTSolverSessionState::pushFrame(
+	std::string& _input,
+	std::vector<std::string>::const_iterator _begin,
+	std::vector<std::string>::const_iterator _end
+)
+{
+	if (_begin == _end)
+		return;
+	_input += "(push 1)\n";
+	for (auto command = _begin; command != _end; ++command)
+		_input += *command + '\n';
+	m_frames.emplace_back(_begin, _end);
+}
+
+/// A running solver process together with the commands it currently has loaded.
+class SMTSolverCommand::Session
+{
+public:
+	Session(boost::filesystem::path const& _solverBin, std::vector<std::string> const& _arguments):
+		m_process(
+			_solverBin,
+			_arguments,
+			boost::process::std_out > m_out,
+			boost::process::std_in < m_in,
+			boost::process::std_err > boost::process::null
+		)
+	{}
+
+	~Session()
+	{
+		try
+		{
+			// Writing to a solver that is gone would raise SIGPIPE.
+			if (!m_terminated)
+				m_in << "(exit)" << std::endl;
+			m_in.pipe().close();
+			m_in.close();
+			m_process.wait();
+		}
+		catch (...)
+		{
+		}
+	}
+
+	/// Sends the part of @a _query that is not loaded yet and waits for the response.
+	/// Only one query can be running at a time, concurrent calls wait for each other.
+	/// @returns nullopt if the solver terminated or was cancelled before responding.
+	std::optional<std::string> query(std::string const& _query)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if (m_terminated)
+			return std::nullopt;
+
+		std::string input = m_state.input(_query);
+		input += "(echo \"" + sessionResponseEnd + "\")\n";
+
+		m_in << input << std::flush;
+
+		// Only registered once the input is written, so that the process is not killed while writing to it.
+		smtutil::CancellationToken* token = smtutil::CancellationToken::current();
+		std::optional<size_t> cancellation;
+		if (token)
+			cancellation = token->addCallback([this]() {
+				std::error_code error;
+				m_process.terminate(error);
+			});
+		ScopeGuard removeCancellation([&]() {
+			if (cancellation)
+				token->removeCallback(*cancellation);
+		});
+
+		std::vector<std::string> data;
+		std::string line;
+		while (std::getline(m_out, line))
+		{
+			// Solvers differ in whether they print the quotes.
+			if (line == sessionResponseEnd || line == '"' + sessionResponseEnd + '"')
+				return boost::join(data, "\n");
+			if (!line.empty())
+				data.push_back(line);
+		}
+		m_terminated = true;
+		return std::nullopt;
+	}
+
+private:
+	boost::process::opstream m_in;  ///< input to subprocess written to by the main process
+	boost::process::ipstream m_out; ///< output from subprocess read by the main process
+	boost::process::child m_process;
+	std::mutex m_mutex;
+	/// Set once the process stopped responding, after which the session cannot be used anymore.
+	bool m_terminated = false;
+	SMTSolverSessionState m_state;
+};
+
+SMTSolverCommand::SMTSolverCommand() = default;
+
+SMTSolverCommand::~SMTSolverCommand() = default;
+
+SMTSolverCommand::Configuration& SMTSolverCommand::configuration()
+{
+	smtutil::CancellationToken const* token = smtutil::CancellationToken::current();
+	if (!token)
+		return m_configuration;
+
+	// Cancellable queries of different threads may run concurrently, configure each of them separately.
+	// A new token starts with an empty configuration.
+	static thread_local std::tuple<SMTSolverCommand const*, std::uint64_t, Configuration> scopedConfiguration;
+	auto& [command, tokenID, configuration] = scopedConfiguration;
+	if (command != this || tokenID != token->id())
+	{
+		command = this;
+		tokenID = token->id();
+		configuration = {};
+	}
+	return configuration;
+}
+
+void SMTSolverCommand::setSessionMode(bool _enabled)
+{
+	std::lock_guard<std::mutex> lock(m_sessionsMutex);
+	m_sessionMode = _enabled;
+	if (!m_sessionMode)
+		m_sessions.clear();
+}
+
 void SMTSolverCommand::setEldarica(std::optional<unsigned int> timeoutInMilliseconds, bool computeInvariants)
 {
-	m_arguments.clear();
-	m_solverCmd = "eld";
-	m_arguments.emplace_back("-hsmt"); // Tell Eldarica to expect input in SMT2 format
-	m_arguments.emplace_back("-in"); // Tell Eldarica to read from standard input
+	auto& [solverCmd, arguments] = configuration();
+	arguments.clear();
+	solverCmd = "eld";
+	arguments.emplace_back("-hsmt"); // Tell Eldarica to expect input in SMT2 format
+	arguments.emplace_back("-in"); // Tell Eldarica to read from standard input
 	if (timeoutInMilliseconds)
 	{
 		unsigned int timeoutInSeconds = timeoutInMilliseconds.value() / 1000u;
 		timeoutInSeconds = timeoutInSeconds == 0 ? 1 : timeoutInSeconds;
-		m_arguments.push_back("-t:" + std::to_string(timeoutInSeconds));
+		arguments.push_back("-t:" + std::to_string(timeoutInSeconds));
 	}
 	if (computeInvariants)
-		m_arguments.emplace_back("-ssol"); // Tell Eldarica to produce model (invariant)
+		arguments.emplace_back("-ssol"); // Tell Eldarica to produce model (invariant)
 }
 
 void SMTSolverCommand::setCvc5(std::optional<unsigned int> timeoutInMilliseconds)
 {
-	m_arguments.clear();
-	m_solverCmd = "cvc5";
+	auto& [solverCmd, arguments] = configuration();
+	arguments.clear();
+	solverCmd = "cvc5";
 	if (timeoutInMilliseconds)
 	{
-		m_arguments.emplace_back("--tlimit-per");
-		m_arguments.push_back(std::to_string(timeoutInMilliseconds.value()));
+		arguments.emplace_back("--tlimit-per");
+		arguments.push_back(std::to_string(timeoutInMilliseconds.value()));
 	}
 	else
 	{
-		m_arguments.emplace_back("--rlimit"); // Set resource limit cvc5 can spend on a query
-		m_arguments.push_back(std::to_string(12000));
+		arguments.emplace_back("--rlimit"); // Set resource limit cvc5 can spend on a query
+		arguments.push_back(std::to_string(12000));
 	}
 }
 
 void SMTSolverCommand::setZ3(std::optional<unsigned int> timeoutInMilliseconds, bool _preprocessing, bool _computeInvariants)
 {
+	auto& [solverCmd, arguments] = configuration();
 	constexpr int Z3ResourceLimit = 2000000;
-	m_arguments.clear();
-	m_solverCmd = "z3";
-	m_arguments.emplace_back("-in"); // Read from standard input
-	m_arguments.emplace_back("-smt2"); // Expect input in SMT-LIB2 format
+	arguments.clear();
+	solverCmd = "z3";
+	arguments.emplace_back("-in"); // Read from standard input
+	arguments.emplace_back("-smt2"); // Expect input in SMT-LIB2 format
 	if (_computeInvariants)
-		m_arguments.emplace_back("-model"); // Output model automatically after check-sat
+		arguments.emplace_back("-model"); // Output model automatically after check-sat
 	if (timeoutInMilliseconds)
-		m_arguments.emplace_back("-t:" + std::to_string(timeoutInMilliseconds.value()));
+		arguments.emplace_back("-t:" + std::to_string(timeoutInMilliseconds.value()));
 	else
-		m_arguments.emplace_back("rlimit=" + std::to_string(Z3ResourceLimit));
+		arguments.emplace_back("rlimit=" + std::to_string(Z3ResourceLimit));
 
 	// These options have been empirically established to be helpful
-	m_arguments.emplace_back("rewriter.pull_cheap_ite=true");
-	m_arguments.emplace_back("fp.spacer.q3.use_qgen=true");
-	m_arguments.emplace_back("fp.spacer.mbqi=false");
-	m_arguments.emplace_back("fp.spacer.ground_pobs=false");
+	arguments.emplace_back("rewriter.pull_cheap_ite=true");
+	arguments.emplace_back("fp.spacer.q3.use_qgen=true");
+	arguments.emplace_back("fp.spacer.mbqi=false");
+	arguments.emplace_back("fp.spacer.ground_pobs=false");
 
 	// Spacer optimization should be
 	// - enabled for better solving (default)
 	// - disable for counterexample generation
 	std::string preprocessingArg = _preprocessing ? "true" : "false";
-	m_arguments.emplace_back("fp.xform.slice=" + preprocessingArg);
-	m_arguments.emplace_back("fp.xform.inline_linear=" + preprocessingArg);
-	m_arguments.emplace_back("fp.xform.inline_eager=" + preprocessingArg);
+	arguments.emplace_back("fp.xform.slice=" + preprocessingArg);
+	arguments.emplace_back("fp.xform.inline_linear=" + preprocessingArg);
+	arguments.emplace_back("fp.xform.inline_eager=" + preprocessingArg);
 }
 
 ReadCallback::Result SMTSolverCommand::solve(std::string const& _kind, std::string const& _query) const
@@ -93,15 +346,24 @@ ReadCallback::Result SMTSolverCommand::solve(std::string const& _kind, std::stri
 		if (_kind != ReadCallback::kindString(ReadCallback::Kind::SMTQuery))
 			solAssert(false, "SMTQuery callback used as callback kind " + _kind);
 
-		if (m_solverCmd.empty())
+		Configuration const configuration = this->configuration();
+		if (configuration.solverCmd.empty())
 			return ReadCallback::Result{false, "No solver set."};
 
-		auto solverBin = boost::process::search_path(m_solverCmd);
+		auto solverBin = boost::process::search_path(configuration.solverCmd);
 
 		if (solverBin.empty())
-			return ReadCallback::Result{false, m_solverCmd + " binary not found."};
+			return ReadCallback::Result{false, configuration.solverCmd + " binary not found."};
+
+		smtutil::CancellationToken* token = smtutil::CancellationToken::current();
+		if (token && token->cancelled())
+			return ReadCallback::Result{false, "Query cancelled."};
+
+		// Eldarica reads its input until the end of the stream and cannot be kept running.
+		if (m_sessionMode && configuration.solverCmd != "eld")
+			return solveInSession(configuration, solverBin, _query);
 
-		auto args = m_arguments;
+		auto args = configuration.arguments;
 
 		boost::process::opstream in;  // input to subprocess written to by the main process
 		boost::process::ipstream out; // output from subprocess read by the main process
@@ -118,10 +380,25 @@ ReadCallback::Result SMTSolverCommand::solve(std::string const& _kind, std::stri
 		in.close();
 
 		std::vector<std::string> data;
-		std::string line;
-		while (!(out.fail() || out.eof()) && std::getline(out, line))
-			if (!line.empty())
-				data.push_back(line);
+		{
+			// Only registered once the input is written, so that the process is not killed while writing to it.
+			std::optional<size_t> cancellation;
+			if (token)
+				cancellation = token->addCallback([&]() {
+					std::error_code error;
+					solverProcess.terminate(error);
+				});
+			// Has to happen before waiting for the process, which must not be terminated concurrently.
+			ScopeGuard removeCancellation([&]() {
+				if (cancellation)
+					token->removeCallback(*cancellation);
+			});
+
+			std::string line;
+			while (!(out.fail() || out.eof()) && std::getline(out, line))
+				if (!line.empty())
+					data.push_back(line);
+		}
 
 		solverProcess.wait();
 
@@ -133,4 +410,51 @@ ReadCallback::Result SMTSolverCommand::solve(std::string const& _kind, std::stri
 	}
 }
 
+ReadCallback::Result SMTSolverCommand::solveInSession(
+	Configuration const& _configuration,
+	boost::filesystem::path const& _solverBin,
+	std::string const& _query
+) const
+{
+	auto args = _configuration.arguments;
+	if (_configuration.solverCmd == "cvc5")
+	{
+		// The resource limit of cvc5 applies to the whole process unless it is set per query.
+		std::replace(args.begin(), args.end(), std::string("--rlimit"), std::string("--rlimit-per"));
+		args.emplace_back("--incremental");
+	}
+
+	std::vector<std::string> commandLine = args;
+	commandLine.insert(commandLine.begin(), _solverBin.string());
+	std::shared_ptr<Session> session;
+	// The state of the solver is unknown after a failure, start a new process for the next query.
+	auto discardSession = [&]() {
+		std::lock_guard<std::mutex> lock(m_sessionsMutex);
+		if (auto it = m_sessions.find(commandLine); it != m_sessions.end() && it->second == session)
+			m_sessions.erase(it);
+	};
+	try
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_sessionsMutex);
+			std::shared_ptr<Session>& entry = m_sessions[commandLine];
+			if (!entry)
+				entry = std::make_shared<Session>(_solverBin, args);
+			session = entry;
+		}
+		std::optional<std::string> response = session->query(_query);
+		if (!response)
+		{
+			discardSession();
+			return ReadCallback::Result{false, _configuration.solverCmd + " terminated unexpectedly."};
+		}
+		return ReadCallback::Result{true, std::move(*response)};
+	}
+	catch (...)
+	{
+		discardSession();
+		throw;
+	}
+}
+
 }
@@ -21,13 +21,54 @@
 
 #include <boost/filesystem.hpp>
 
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
 namespace solidity::frontend
 {
 
+/// Commands an SMT solver process has loaded in session mode of SMTSolverCommand.
+/// Computes the input that brings the solver from the previous query to the next one.
+class SMTSolverSessionState
+{
+public:
+	/// Splits an SMT-LIB2 script into its top-level commands.
+	/// Comments and whitespace between the commands are dropped.
+	static std::vector<std::string> splitCommands(std::string const& _script);
+
+	/// @returns the input that makes a solver that received all previous inputs answer @a _query.
+	/// Push frames whose commands the query still starts with are kept, the others are popped.
+	/// Changes of the leading set-option and set-logic commands and Horn queries, which cannot be
+	/// solved incrementally, start over after a (reset).
+	std::string input(std::string const& _query);
+
+private:
+	void pushFrame(
+		std::string& _input,
+		std::vector<std::string>::const_iterator _begin,
+		std::vector<std::string>::const_iterator _end
+	);
+
+	/// Leading set-option and set-logic commands of the loaded queries.
+	std::vector<std::string> m_preamble;
+	/// Commands loaded after the preamble. Each group was sent in its own push frame.
+	std::vector<std::vector<std::string>> m_frames;
+};
+
 /// SMTSolverCommand wraps an SMT solver called via its binary in the OS.
+///
+/// Queries made while a smtutil::CancellationToken is current are aborted when the token
+/// is cancelled. Such queries may run concurrently, so the solver configuration set while
+/// the token is current only applies to the calling thread until the token changes.
 class SMTSolverCommand
 {
 public:
+	SMTSolverCommand();
+	~SMTSolverCommand();
+
 	/// Calls an SMT solver with the given query.
 	frontend::ReadCallback::Result solve(std::string const& _kind, std::string const& _query) const;
 
@@ -40,10 +81,41 @@ public:
 	void setCvc5(std::optional<unsigned int> timeoutInMilliseconds);
 	void setZ3(std::optional<unsigned int> timeoutInMilliseconds, bool _preprocessing, bool _computeInvariants);
 
+	/// In session mode, one solver process is kept alive per solver configuration instead of
+	/// starting a new one for every query. Consecutive queries usually share most of their
+	/// declarations and assertions, so only the commands that differ from the previous query
+	/// are sent, using push and pop to discard the ones that are no longer needed.
+	/// Horn queries are not solved incrementally, but still reuse the running process.
+	/// Eldarica is always called with one process per query.
+	void setSessionMode(bool _enabled);
+
 private:
-	/// The name of the solver's binary.
-	std::string m_solverCmd;
-	std::vector<std::string> m_arguments;
+	class Session;
+
+	struct Configuration
+	{
+		/// The name of the solver's binary.
+		std::string solverCmd;
+		std::vector<std::string> arguments;
+	};
+
+	/// @returns the configuration that applies to queries of the calling thread.
+	Configuration& configuration();
+	Configuration const& configuration() const { return const_cast<SMTSolverCommand*>(this)->configuration(); }
+
+	/// Sends the query to the session of @a _configuration, starting it if necessary.
+	frontend::ReadCallback::Result solveInSession(
+		Configuration const& _configuration,
+		boost::filesystem::path const& _solverBin,
+		std::string const& _query
+	) const;
+
+	Configuration m_configuration;
+
+	bool m_sessionMode = false;
+	/// Running solver processes, indexed by their full command line.
+	mutable std::map<std::vector<std::string>, std::shared_ptr<Session>> m_sessions;
+	mutable std::mutex m_sessionsMutex;
 };
 
 }
@@ -39,11 +39,14 @@
 #include <libsolutil/JSON.h>
 #include <libsolutil/Keccak256.h>
 #include <libsolutil/CommonData.h>
+#include <libsolutil/Profiler.h>
+#include <libsolutil/ThreadPool.h>
 
 #include <boost/algorithm/string/predicate.hpp>
 
 #include <algorithm>
 #include <optional>
+#include <sstream>
 
 using namespace solidity;
 using namespace solidity::yul;
@@ -85,6 +88,164 @@ Json formatFatalError(Error::Type _type, std::string const& _message)
 	return output;
 }
 
+/// @returns the output reporting the exception that is currently being handled.
+/// Must only be called from within a catch block.
+Json formatCurrentException()
+{
+	try
+	{
+		throw;
+	}
+	catch (UnimplementedFeatureError const& _exception)
+	{
+		solAssert(_exception.comment(), "Unimplemented feature errors must include a message for the user");
+		return formatFatalError(Error::Type::UnimplementedFeatureError, stringOrDefault(_exception.comment()));
+	}
+	catch (...)
+	{
+		return formatFatalError(Error::Type::InternalCompilerError, "Internal exception in StandardCompiler::compile: " +  boost::current_exception_diagnostic_information());
+	}
+}
+
+/// Collects the output of a Solidity compilation. Without a stream writer, the output is gathered
+/// in a JSON object. Otherwise each part is written out as soon as it is complete, so that it can be
+/// freed right away. Since the writer needs the keys in order, the top-level members have to be
+/// added in the order "auxiliaryInputRequested", "contracts", "errors", "profile", "sources", the
+/// contracts sorted by source unit name and contract name and the sources by name.
+/// A failure after "errors" has been written cannot be reported in the output anymore (see abort()).
+class SolidityOutput
+{
+public:
+	explicit SolidityOutput(util::JsonStreamWriter* _stream):
+		m_stream(_stream)
+	{
+		if (m_stream)
+			m_stream->beginObject();
+		else
+			m_output["sources"] = Json::object();
+	}
+
+	void member(std::string const& _key, Json _value)
+	{
+		if (!m_stream)
+		{
+			m_output[_key] = std::move(_value);
+			return;
+		}
+		closeSection();
+		m_stream->member(_key, _value);
+		m_lastKey = _key;
+	}
+
+	void contract(std::string const& _file, std::string const& _name, Json _data)
+	{
+		if (!m_stream)
+		{
+			m_output["contracts"][_file][_name] = std::move(_data);
+			return;
+		}
+		openSection("contracts");
+		if (m_currentFile != _file)
+		{
+			if (m_currentFile)
+				m_stream->endObject();
+			m_stream->key(_file);
+			m_stream->beginObject();
+			m_currentFile = _file;
+		}
+		m_stream->member(_name, _data);
+	}
+
+	/// Adds the output of a source with the AST @a _ast, if it is requested.
+	void source(std::string const& _name, unsigned _id, SourceUnit const* _ast, ASTJsonExporter& _astExporter)
+	{
+		if (!m_stream)
+		{
+			Json sourceResult;
+			sourceResult["id"] = _id;
+			if (_ast)
+				sourceResult["ast"] = _astExporter.toJson(*_ast);
+			m_output["sources"][_name] = std::move(sourceResult);
+			return;
+		}
+		// The output of a source is nested in the output object and its "sources" member.
+		// It is printed completely before it is written, so that a failure while exporting
+		// the AST does not leave a truncated source behind.
+		std::ostringstream printed;
+		util::JsonStreamWriter writer(printed, m_stream->format(), 2);
+		writer.beginObject();
+		if (_ast)
+		{
+			writer.key("ast");
+			_astExporter.print(writer, *_ast);
+		}
+		writer.member("id", _id);
+		writer.endObject();
+		openSection("sources");
+		m_stream->key(_name);
+		m_stream->printedValue(printed.str());
+	}
+
+	/// Completes the output. @returns the collected output or null if it has been written to the stream.
+	Json finish()
+	{
+		if (!m_stream)
+			return std::move(m_output);
+		openSection("sources");
+		closeSection();
+		m_stream->endObject();
+		return {};
+	}
+
+	/// Completes the streamed output with an error that occurred while producing it.
+	/// @returns false if the error could not be reported anymore because "errors" or a later member
+	/// has already been written. The output is completed without it then.
+	bool abort(Json const& _fatalError)
+	{
+		solAssert(m_stream);
+		if (m_lastKey && *m_lastKey >= "errors")
+		{
+			finish();
+			return false;
+		}
+		closeSection();
+		m_stream->member("errors", _fatalError["errors"]);
+		m_stream->endObject();
+		return true;
+	}
+
+private:
+	void openSection(std::string const& _key)
+	{
+		if (m_section == _key)
+			return;
+		closeSection();
+		m_stream->key(_key);
+		m_stream->beginObject();
+		m_section = _key;
+		m_lastKey = _key;
+	}
+
+	void closeSection()
+	{
+		if (!m_section)
+			return;
+		if (m_currentFile)
+			m_stream->endObject();
+		m_stream->endObject();
+		m_section.reset();
+		m_currentFile.reset();
+	}
+
+	util::JsonStreamWriter* m_stream = nullptr;
+	Json m_output;
+	/// Top-level member that is currently open in the stream.
+	std::optional<std::string> m_section;
+	/// Source unit whose contracts are currently being written.
+	std::optional<std::string> m_currentFile;
+	std::optional<std::string> m_lastKey;
+};
+
 Json formatSourceLocation(SourceLocation const* location)
 {
 	if (!location || !location->sourceName)
@@ -406,13 +567,19 @@ std::optional<Json> checkAuxiliaryInputKeys(Json const& _input)
 
 std::optional<Json> checkSettingsKeys(Json const& _input)
 {
-	static std::set<std::string> keys{"debug", "evmVersion", "eofVersion", "libraries", "metadata", "modelChecker", "optimizer", "outputSelection", "remappings", "stopAfter", "viaIR"};
+	static std::set<std::string> keys{"debug", "discardIntermediateArtifacts", "evmVersion", "eofVersion", "libraries", "metadata", "modelChecker", "optimizer", "optimizerCache", "outputSelection", "parallelism", "profile", "remappings", "stopAfter", "viaIR"};
 	return checkKeys(_input, keys, "settings");
 }
 
+std::optional<Json> checkOptimizerCacheKeys(Json const& _input)
+{
+	static std::set<std::string> keys{"directory", "maxSize"};
+	return checkKeys(_input, keys, "settings.optimizerCache");
+}
+
 std::optional<Json> checkModelCheckerSettingsKeys(Json const& _input)
 {
-	static std::set<std::string> keys{"bmcLoopIterations", "contracts", "divModNoSlacks", "engine", "extCalls", "invariants", "printQuery", "showProvedSafe", "showUnproved", "showUnsupported", "solvers", "targets", "timeout"};
+	static std::set<std::string> keys{"bmcLoopIterations", "contracts", "divModNoSlacks", "engine", "extCalls", "invariants", "printQuery", "raceCrossCheckTime", "raceSolvers", "showProvedSafe", "showSolverStatistics", "showUnproved", "showUnsupported", "solvers", "targets", "timeout"};
 	return checkKeys(_input, keys, "modelChecker");
 }
 
@@ -797,6 +964,47 @@ std::variant<StandardCompiler::InputsAndSettings, Json> StandardCompiler::parseI
 		ret.viaIR = settings["viaIR"].get<bool>();
 	}
 
+	if (settings.contains("parallelism"))
+	{
+		if (!settings["parallelism"].is_number_unsigned() || settings["parallelism"].get<size_t>() == 0)
+			return formatFatalError(Error::Type::JSONError, "\"settings.parallelism\" must be a positive integer.");
+		ret.parallelism = std::min<size_t>(settings["parallelism"].get<size_t>(), util::ThreadPool::maxWorkers());
+	}
+
+	if (settings.contains("profile"))
+	{
+		if (!settings["profile"].is_boolean())
+			return formatFatalError(Error::Type::JSONError, "\"settings.profile\" must be a Boolean.");
+		ret.profile = settings["profile"].get<bool>();
+	}
+
+	if (settings.contains("discardIntermediateArtifacts"))
+	{
+		if (!settings["discardIntermediateArtifacts"].is_boolean())
+			return formatFatalError(Error::Type::JSONError, "\"settings.discardIntermediateArtifacts\" must be a Boolean.");
+		ret.discardIntermediateArtifacts = settings["discardIntermediateArtifacts"].get<bool>();
+	}
+
+	if (settings.contains("optimizerCache"))
+	{
+		Json const& optimizerCache = settings["optimizerCache"];
+		if (auto result = checkOptimizerCacheKeys(optimizerCache))
+			return *result;
+		if (!optimizerCache.contains("directory") || !optimizerCache["directory"].is_string() || optimizerCache["directory"].get<std::string>().empty())
+			return formatFatalError(Error::Type::JSONError, "\"settings.optimizerCache.directory\" must be a non-empty string.");
+		ret.optimizerCacheDirectory = optimizerCache["directory"].get<std::string>();
+		if (optimizerCache.contains("maxSize"))
+		{
+			if (
+				!optimizerCache["maxSize"].is_number_unsigned() ||
+				optimizerCache["maxSize"].get<uint64_t>() == 0 ||
+				optimizerCache["maxSize"].get<uint64_t>() > std::numeric_limits<std::uintmax_t>::max() / (1024 * 1024)
+			)
+				return formatFatalError(Error::Type::JSONError, "\"settings.optimizerCache.maxSize\" must be a positive number of MiB.");
+			ret.optimizerCacheMaxSize = optimizerCache["maxSize"].get<uint64_t>() * 1024 * 1024;
+		}
+	}
+
 	if (settings.contains("evmVersion"))
 	{
 		if (!settings["evmVersion"].is_string())
@@ -1124,6 +1332,33 @@ std::variant<StandardCompiler::InputsAndSettings, Json> StandardCompiler::parseI
 		ret.modelCheckerSettings.printQuery = printQuery.get<bool>();
 	}
 
+	if (modelCheckerSettings.contains("raceSolvers"))
+	{
+		auto const& raceSolvers = modelCheckerSettings["raceSolvers"];
+		if (!raceSolvers.is_boolean())
+			return formatFatalError(Error::Type::JSONError, "settings.modelChecker.raceSolvers must be a Boolean value.");
+		ret.modelCheckerSettings.raceSolvers = raceSolvers.get<bool>();
+	}
+
+	if (modelCheckerSettings.contains("raceCrossCheckTime"))
+	{
+		if (!modelCheckerSettings["raceCrossCheckTime"].is_number_unsigned())
+			return formatFatalError(Error::Type::JSONError, "settings.modelChecker.raceCrossCheckTime must be an unsigned integer.");
+		if (!ret.modelCheckerSettings.raceSolvers)
+			return formatFatalError(Error::Type::JSONError, "settings.modelChecker.raceCrossCheckTime requires settings.modelChecker.raceSolvers to be enabled.");
+		ret.modelCheckerSettings.raceCrossCheckTime = modelCheckerSettings["raceCrossCheckTime"].get<Json::number_unsigned_t>();
+	}
+
+	if (modelCheckerSettings.contains("showSolverStatistics"))
+	{
+		auto const& showSolverStatistics = modelCheckerSettings["showSolverStatistics"];
+		if (!showSolverStatistics.is_boolean())
+			return formatFatalError(Error::Type::JSONError, "settings.modelChecker.showSolverStatistics must be a Boolean value.");
+		if (showSolverStatistics.get<bool>() && !ret.modelCheckerSettings.raceSolvers)
+			return formatFatalError(Error::Type::JSONError, "settings.modelChecker.showSolverStatistics requires settings.modelChecker.raceSolvers to be enabled.");
+		ret.modelCheckerSettings.showSolverStatistics = showSolverStatistics.get<bool>();
+	}
+
 	if (modelCheckerSettings.contains("targets"))
 	{
 		auto const& targetsArray = modelCheckerSettings["targets"];
@@ -1155,21 +1390,25 @@ std::variant<StandardCompiler::InputsAndSettings, Json> StandardCompiler::parseI
 	return {std::move(ret)};
 }
 
-std::map<std::string, Json> StandardCompiler::parseAstFromInput(StringMap const& _sources)
+void StandardCompiler::importASTs(CompilerStack& _compilerStack, StringMap const& _sources)
 {
-	std::map<std::string, Json> sourceJsons;
-	for (auto const& [sourceName, sourceCode]: _sources)
-	{
-		Json ast;
-		astAssert(util::jsonParseStrict(sourceCode, ast), "Input file could not be parsed to JSON");
-		std::string astKey = ast.contains("ast") ? "ast" : "AST";
+	std::set<std::string> sourceNames;
+	for (auto const& source: _sources)
+		sourceNames.insert(source.first);
 
-		astAssert(ast.contains(astKey), "astkey is not member");
-		astAssert(ast[astKey]["nodeType"].get<std::string>() == "SourceUnit", "Top-level node should be a 'SourceUnit'");
-		astAssert(sourceJsons.count(sourceName) == 0, "All sources must have unique names");
-		sourceJsons.emplace(sourceName, std::move(ast[astKey]));
-	}
-	return sourceJsons;
+	// Parse the sources one at a time so that only one of their ASTs is in memory as JSON.
+	_compilerStack.importASTs(sourceNames, [&](auto const& _importAST) {
+		for (auto const& [sourceName, sourceCode]: _sources)
+		{
+			Json ast;
+			astAssert(util::jsonParseStrict(sourceCode, ast), "Input file could not be parsed to JSON");
+			std::string astKey = ast.contains("ast") ? "ast" : "AST";
+
+			astAssert(ast.contains(astKey), "astkey is not member");
+			astAssert(ast[astKey]["nodeType"].get<std::string>() == "SourceUnit", "Top-level node should be a 'SourceUnit'");
+			_importAST(sourceName, ast[astKey]);
+		}
+	});
 }
 
 Json StandardCompiler::importEVMAssembly(StandardCompiler::InputsAndSettings _inputsAndSettings)
@@ -1277,11 +1516,20 @@ Json StandardCompiler::importEVMAssembly(StandardCompiler::InputsAndSettings _in
 	return util::removeNullMembers(output);
 }
 
-Json StandardCompiler::compileSolidity(StandardCompiler::InputsAndSettings _inputsAndSettings)
+Json StandardCompiler::compileSolidity(
+	StandardCompiler::InputsAndSettings _inputsAndSettings,
+	util::JsonStreamWriter* _stream,
+	util::Profiler::Session const* _profilerSession
+)
 {
 	solAssert(_inputsAndSettings.jsonSources.empty());
 
 	CompilerStack compilerStack(m_readFile);
+	if (m_parsedSourceCache)
+		compilerStack.setParsedSourceCache(m_parsedSourceCache);
+	// A cache on disk is attached to the optimizer of the compilation, so it takes the place of the shared one.
+	if (m_objectOptimizer && !_inputsAndSettings.optimizerCacheDirectory.has_value())
+		compilerStack.shareYulOptimizerCache(m_yulStringRepository, m_objectOptimizer);
 
 	StringMap sourceList = std::move(_inputsAndSettings.sources);
 	if (_inputsAndSettings.language == "Solidity")
@@ -1289,10 +1537,14 @@ Json StandardCompiler::compileSolidity(StandardCompiler::InputsAndSettings _inpu
 	for (auto const& smtLib2Response: _inputsAndSettings.smtLib2Responses)
 		compilerStack.addSMTLib2Response(smtLib2Response.first, smtLib2Response.second);
 	compilerStack.setViaIR(_inputsAndSettings.viaIR);
+	compilerStack.setParallelism(_inputsAndSettings.parallelism);
+	compilerStack.setDiscardIntermediateArtifacts(_inputsAndSettings.discardIntermediateArtifacts);
 	compilerStack.setEVMVersion(_inputsAndSettings.evmVersion);
 	compilerStack.setEOFVersion(_inputsAndSettings.eofVersion);
 	compilerStack.setRemappings(std::move(_inputsAndSettings.remappings));
 	compilerStack.setOptimiserSettings(std::move(_inputsAndSettings.optimiserSettings));
+	if (_inputsAndSettings.optimizerCacheDirectory.has_value())
+		compilerStack.setOptimizerCacheDirectory(*_inputsAndSettings.optimizerCacheDirectory, _inputsAndSettings.optimizerCacheMaxSize);
 	compilerStack.setRevertStringBehaviour(_inputsAndSettings.revertStrings);
 	if (_inputsAndSettings.debugInfoSelection.has_value())
 		compilerStack.selectDebugInfo(_inputsAndSettings.debugInfoSelection.value());
@@ -1313,7 +1565,7 @@ Json StandardCompiler::compileSolidity(StandardCompiler::InputsAndSettings _inpu
 		{
 			try
 			{
-				compilerStack.importASTs(parseAstFromInput(sourceList));
+				importASTs(compilerStack, sourceList);
 				if (!compilerStack.analyze())
 					errors.emplace_back(formatError(Error::Type::FatalError, "general", "Analysis of the AST failed."));
 				if (binariesRequested)
@@ -1407,149 +1659,172 @@ Json StandardCompiler::compileSolidity(StandardCompiler::InputsAndSettings _inpu
 	if (compilationFailed || analysisFailed || !parsingSuccess)
 		solAssert(!errors.empty(), "No error reported, but compilation failed.");
 
-	Json output;
+	SolidityOutput output(_stream);
+	try
+	{
+		Json auxiliaryInput;
+		for (std::string const& query: compilerStack.unhandledSMTLib2Queries())
+			auxiliaryInput["smtlib2queries"]["0x" + util::keccak256(query).hex()] = query;
+		if (!auxiliaryInput.empty())
+			output.member("auxiliaryInputRequested", std::move(auxiliaryInput));
+
+		// Contract names are sorted, but ``a.sol:C`` comes before ``a:C``, so group them by source unit
+		// to write them in the order of the output.
+		std::map<std::string, std::vector<std::string>> contractsBySource;
+		for (std::string const& contractName: analysisSuccess ? compilerStack.contractNames() : std::vector<std::string>())
+		{
+			size_t colon = contractName.rfind(':');
+			solAssert(colon != std::string::npos, "");
+			contractsBySource[contractName.substr(0, colon)].push_back(contractName.substr(colon + 1));
+		}
+		for (auto const& [file, names]: contractsBySource)
+			for (std::string const& name: names)
+			{
+				Json contractData = formatContract(compilerStack, _inputsAndSettings, sourceList, file, name, compilationSuccess);
+				if (!contractData.empty())
+					output.contract(file, name, std::move(contractData));
+			}
 
-	if (errors.size() > 0)
-		output["errors"] = std::move(errors);
+		if (errors.size() > 0)
+			output.member("errors", std::move(errors));
 
-	if (!compilerStack.unhandledSMTLib2Queries().empty())
-		for (std::string const& query: compilerStack.unhandledSMTLib2Queries())
-			output["auxiliaryInputRequested"]["smtlib2queries"]["0x" + util::keccak256(query).hex()] = query;
+		if (_profilerSession)
+			output.member("profile", _profilerSession->toJson());
 
-	bool const wildcardMatchesExperimental = false;
+		unsigned sourceIndex = 0;
+		ASTJsonExporter astExporter(compilerStack.state(), compilerStack.sourceIndices());
+		// NOTE: A case that will pass `parsingSuccess && !analysisFailed` but not `analysisSuccess` is
+		// stopAfter: parsing with no parsing errors.
+		if (parsingSuccess && !analysisFailed)
+			for (std::string const& sourceName: compilerStack.sourceNames())
+			{
+				bool const astRequested = isArtifactRequested(_inputsAndSettings.outputSelection, sourceName, "", "ast", false);
+				output.source(sourceName, sourceIndex++, astRequested ? &compilerStack.ast(sourceName) : nullptr, astExporter);
+			}
 
-	output["sources"] = Json::object();
-	unsigned sourceIndex = 0;
-	// NOTE: A case that will pass `parsingSuccess && !analysisFailed` but not `analysisSuccess` is
-	// stopAfter: parsing with no parsing errors.
-	if (parsingSuccess && !analysisFailed)
-		for (std::string const& sourceName: compilerStack.sourceNames())
-		{
-			Json sourceResult;
-			sourceResult["id"] = sourceIndex++;
-			if (isArtifactRequested(_inputsAndSettings.outputSelection, sourceName, "", "ast", wildcardMatchesExperimental))
-				sourceResult["ast"] = ASTJsonExporter(compilerStack.state(), compilerStack.sourceIndices()).toJson(compilerStack.ast(sourceName));
-			output["sources"][sourceName] = sourceResult;
-		}
+		return output.finish();
+	}
+	catch (...)
+	{
+		// Without a stream, StandardCompiler::compile() reports the exception.
+		if (!_stream || !output.abort(formatCurrentException()))
+			throw;
+		return {};
+	}
+}
 
-	Json contractsOutput;
-	for (std::string const& contractName: analysisSuccess ? compilerStack.contractNames() : std::vector<std::string>())
-	{
-		size_t colon = contractName.rfind(':');
-		solAssert(colon != std::string::npos, "");
-		std::string file = contractName.substr(0, colon);
-		std::string name = contractName.substr(colon + 1);
-
-		// ABI, storage layout, documentation and metadata
-		Json contractData;
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "abi", wildcardMatchesExperimental))
-			contractData["abi"] = compilerStack.contractABI(contractName);
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "storageLayout", false))
-			contractData["storageLayout"] = compilerStack.storageLayout(contractName);
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "transientStorageLayout", false))
-			contractData["transientStorageLayout"] = compilerStack.transientStorageLayout(contractName);
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "metadata", wildcardMatchesExperimental))
-			contractData["metadata"] = compilerStack.metadata(contractName);
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "userdoc", wildcardMatchesExperimental))
-			contractData["userdoc"] = compilerStack.natspecUser(contractName);
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "devdoc", wildcardMatchesExperimental))
-			contractData["devdoc"] = compilerStack.natspecDev(contractName);
-
-		// IR
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "ir", wildcardMatchesExperimental))
-			contractData["ir"] = compilerStack.yulIR(contractName).value_or("");
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "irAst", wildcardMatchesExperimental))
-			contractData["irAst"] = compilerStack.yulIRAst(contractName).value_or(Json{});
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "irOptimized", wildcardMatchesExperimental))
-			contractData["irOptimized"] = compilerStack.yulIROptimized(contractName).value_or("");
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "irOptimizedAst", wildcardMatchesExperimental))
-			contractData["irOptimizedAst"] = compilerStack.yulIROptimizedAst(contractName).value_or(Json{});
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "yulCFGJson", wildcardMatchesExperimental))
-			contractData["yulCFGJson"] = compilerStack.yulCFGJson(contractName).value_or(Json{});
-
-		// EVM
-		Json evmData;
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.assembly", wildcardMatchesExperimental))
-			evmData["assembly"] = compilerStack.assemblyString(contractName, sourceList);
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.legacyAssembly", wildcardMatchesExperimental))
-			evmData["legacyAssembly"] = compilerStack.assemblyJSON(contractName);
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.methodIdentifiers", wildcardMatchesExperimental))
-			evmData["methodIdentifiers"] = compilerStack.interfaceSymbols(contractName)["methods"];
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.gasEstimates", wildcardMatchesExperimental))
-			evmData["gasEstimates"] = compilerStack.gasEstimates(contractName);
-
-		if (compilationSuccess && isArtifactRequested(
-			_inputsAndSettings.outputSelection,
-			file,
-			name,
-			evmObjectComponents("bytecode"),
-			wildcardMatchesExperimental
-		))
-		{
-			auto const evmCreationArtifactRequested = [&](std::string const& _element) {
-				return isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.bytecode." + _element, wildcardMatchesExperimental);
-			};
+Json StandardCompiler::formatContract(
+	CompilerStack const& _compilerStack,
+	InputsAndSettings const& _inputsAndSettings,
+	StringMap const& _sourceList,
+	std::string const& _file,
+	std::string const& _name,
+	bool _compilationSuccess
+)
+{
+	std::string const contractName = _file + ":" + _name;
+	bool const wildcardMatchesExperimental = false;
 
-			Json creationJSON;
-			if (evmCreationArtifactRequested("object"))
-				creationJSON["object"] = compilerStack.object(contractName).toHex();
-			if (evmCreationArtifactRequested("opcodes"))
-				creationJSON["opcodes"] = evmasm::disassemble(compilerStack.object(contractName).bytecode, _inputsAndSettings.evmVersion);
-			if (evmCreationArtifactRequested("sourceMap"))
-				creationJSON["sourceMap"] = compilerStack.sourceMapping(contractName) ? *compilerStack.sourceMapping(contractName) : "";
-			if (evmCreationArtifactRequested("functionDebugData"))
-				creationJSON["functionDebugData"] = formatFunctionDebugData(compilerStack.object(contractName).functionDebugData);
-			if (evmCreationArtifactRequested("linkReferences"))
-				creationJSON["linkReferences"] = formatLinkReferences(compilerStack.object(contractName).linkReferences);
-			if (evmCreationArtifactRequested("generatedSources"))
-				creationJSON["generatedSources"] = compilerStack.generatedSources(contractName, /* _runtime */ false);
-			evmData["bytecode"] = creationJSON;
-		}
+	// ABI, storage layout, documentation and metadata
+	Json contractData;
+	if (isArtifactRequested(_inputsAndSettings.outputSelection, _file, _name, "abi", wildcardMatchesExperimental))
+		contractData["abi"] = _compilerStack.contractABI(contractName);
+	if (isArtifactRequested(_inputsAndSettings.outputSelection, _file, _name, "storageLayout", false))
+		contractData["storageLayout"] = _compilerStack.storageLayout(contractName);
+	if (isArtifactRequested(_inputsAndSettings.outputSelection, _file, _name, "transientStorageLayout", false))
+		contractData["transientStorageLayout"] = _compilerStack.transientStorageLayout(contractName);
+	if (isArtifactRequested(_inputsAndSettings.outputSelection, _file, _name, "metadata", wildcardMatchesExperimental))
+		contractData["metadata"] = _compilerStack.metadata(contractName);
+	if (isArtifactRequested(_inputsAndSettings.outputSelection, _file, _name, "userdoc", wildcardMatchesExperimental))
+		contractData["userdoc"] = _compilerStack.natspecUser(contractName);
+	if (isArtifactRequested(_inputsAndSettings.outputSelection, _file, _name, "devdoc", wildcardMatchesExperimental))
+		contractData["devdoc"] = _compilerStack.natspecDev(contractName);
+
+	// IR
+	if (_compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, _file, _name, "ir", wildcardMatchesExperimental))
+		contractData["ir"] = _compilerStack.yulIR(contractName).value_or("");
+	if (_compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, _file, _name, "irAst", wildcardMatchesExperimental))
+		contractData["irAst"] = _compilerStack.yulIRAst(contractName).value_or(Json{});
+	if (_compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, _file, _name, "irOptimized", wildcardMatchesExperimental))
+		contractData["irOptimized"] = _compilerStack.yulIROptimized(contractName).value_or("");
+	if (_compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, _file, _name, "irOptimizedAst", wildcardMatchesExperimental))
+		contractData["irOptimizedAst"] = _compilerStack.yulIROptimizedAst(contractName).value_or(Json{});
+	if (_compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, _file, _name, "yulCFGJson", wildcardMatchesExperimental))
+		contractData["yulCFGJson"] = _compilerStack.yulCFGJson(contractName).value_or(Json{});
 
-		if (compilationSuccess && isArtifactRequested(
-			_inputsAndSettings.outputSelection,
-			file,
-			name,
-			evmObjectComponents("deployedBytecode"),
-			wildcardMatchesExperimental
-		))
-		{
-			auto const evmDeployedArtifactRequested = [&](std::string const& _element) {
-				return isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.deployedBytecode." + _element, wildcardMatchesExperimental);
-			};
+	// EVM
+	Json evmData;
+	if (_compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, _file, _name, "evm.assembly", wildcardMatchesExperimental))
+		evmData["assembly"] = _compilerStack.assemblyString(contractName, _sourceList);
+	if (_compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, _file, _name, "evm.legacyAssembly", wildcardMatchesExperimental))
+		evmData["legacyAssembly"] = _compilerStack.assemblyJSON(contractName);
+	if (isArtifactRequested(_inputsAndSettings.outputSelection, _file, _name, "evm.methodIdentifiers", wildcardMatchesExperimental))
+		evmData["methodIdentifiers"] = _compilerStack.interfaceSymbols(contractName)["methods"];
+	if (_compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, _file, _name, "evm.gasEstimates", wildcardMatchesExperimental))
+		evmData["gasEstimates"] = _compilerStack.gasEstimates(contractName);
+
+	if (_compilationSuccess && isArtifactRequested(
+		_inputsAndSettings.outputSelection,
+		_file,
+		_name,
+		evmObjectComponents("bytecode"),
+		wildcardMatchesExperimental
+	))
+	{
+		auto const evmCreationArtifactRequested = [&](std::string const& _element) {
+			return isArtifactRequested(_inputsAndSettings.outputSelection, _file, _name, "evm.bytecode." + _element, wildcardMatchesExperimental);
+		};
 
-			Json deployedJSON;
-			if (evmDeployedArtifactRequested("object"))
-				deployedJSON["object"] = compilerStack.runtimeObject(contractName).toHex();
-			if (evmDeployedArtifactRequested("opcodes"))
-				deployedJSON["opcodes"] = evmasm::disassemble(compilerStack.runtimeObject(contractName).bytecode, _inputsAndSettings.evmVersion);
-			if (evmDeployedArtifactRequested("sourceMap"))
-				deployedJSON["sourceMap"] = compilerStack.runtimeSourceMapping(contractName) ? *compilerStack.runtimeSourceMapping(contractName) : "";
-			if (evmDeployedArtifactRequested("functionDebugData"))
-				deployedJSON["functionDebugData"] = formatFunctionDebugData(compilerStack.runtimeObject(contractName).functionDebugData);
-			if (evmDeployedArtifactRequested("linkReferences"))
-				deployedJSON["linkReferences"] = formatLinkReferences(compilerStack.runtimeObject(contractName).linkReferences);
-			if (evmDeployedArtifactRequested("immutableReferences"))
-				deployedJSON["immutableReferences"] = formatImmutableReferences(compilerStack.runtimeObject(contractName).immutableReferences);
-			if (evmDeployedArtifactRequested("generatedSources"))
-				deployedJSON["generatedSources"] = compilerStack.generatedSources(contractName, /* _runtime */ true);
-			evmData["deployedBytecode"] = deployedJSON;
-		}
+		Json creationJSON;
+		if (evmCreationArtifactRequested("object"))
+			creationJSON["object"] = _compilerStack.object(contractName).toHex();
+		if (evmCreationArtifactRequested("opcodes"))
+			creationJSON["opcodes"] = evmasm::disassemble(_compilerStack.object(contractName).bytecode, _inputsAndSettings.evmVersion);
+		if (evmCreationArtifactRequested("sourceMap"))
+			creationJSON["sourceMap"] = _compilerStack.sourceMapping(contractName) ? *_compilerStack.sourceMapping(contractName) : "";
+		if (evmCreationArtifactRequested("functionDebugData"))
+			creationJSON["functionDebugData"] = formatFunctionDebugData(_compilerStack.object(contractName).functionDebugData);
+		if (evmCreationArtifactRequested("linkReferences"))
+			creationJSON["linkReferences"] = formatLinkReferences(_compilerStack.object(contractName).linkReferences);
+		if (evmCreationArtifactRequested("generatedSources"))
+			creationJSON["generatedSources"] = _compilerStack.generatedSources(contractName, /* _runtime */ false);
+		evmData["bytecode"] = creationJSON;
+	}
 
-		if (!evmData.empty())
-			contractData["evm"] = evmData;
+	if (_compilationSuccess && isArtifactRequested(
+		_inputsAndSettings.outputSelection,
+		_file,
+		_name,
+		evmObjectComponents("deployedBytecode"),
+		wildcardMatchesExperimental
+	))
+	{
+		auto const evmDeployedArtifactRequested = [&](std::string const& _element) {
+			return isArtifactRequested(_inputsAndSettings.outputSelection, _file, _name, "evm.deployedBytecode." + _element, wildcardMatchesExperimental);
+		};
 
-		if (!contractData.empty())
-		{
-			if (!contractsOutput.contains(file))
-				contractsOutput[file] = Json::object();
-			contractsOutput[file][name] = contractData;
-		}
+		Json deployedJSON;
+		if (evmDeployedArtifactRequested("object"))
+			deployedJSON["object"] = _compilerStack.runtimeObject(contractName).toHex();
+		if (evmDeployedArtifactRequested("opcodes"))
+			deployedJSON["opcodes"] = evmasm::disassemble(_compilerStack.runtimeObject(contractName).bytecode, _inputsAndSettings.evmVersion);
+		if (evmDeployedArtifactRequested("sourceMap"))
+			deployedJSON["sourceMap"] = _compilerStack.runtimeSourceMapping(contractName) ? *_compilerStack.runtimeSourceMapping(contractName) : "";
+		if (evmDeployedArtifactRequested("functionDebugData"))
+			deployedJSON["functionDebugData"] = formatFunctionDebugData(_compilerStack.runtimeObject(contractName).functionDebugData);
+		if (evmDeployedArtifactRequested("linkReferences"))
+			deployedJSON["linkReferences"] = formatLinkReferences(_compilerStack.runtimeObject(contractName).linkReferences);
+		if (evmDeployedArtifactRequested("immutableReferences"))
+			deployedJSON["immutableReferences"] = formatImmutableReferences(_compilerStack.runtimeObject(contractName).immutableReferences);
+		if (evmDeployedArtifactRequested("generatedSources"))
+			deployedJSON["generatedSources"] = _compilerStack.generatedSources(contractName, /* _runtime */ true);
+		evmData["deployedBytecode"] = deployedJSON;
 	}
-	if (!contractsOutput.empty())
-		output["contracts"] = contractsOutput;
 
-	return output;
+	if (!evmData.empty())
+		contractData["evm"] = evmData;
+
+	return contractData;
 }
 
 
@@ -1705,34 +1980,7 @@ Json StandardCompiler::compileYul(InputsAndSettings _inputsAndSettings)
 
 Json StandardCompiler::compile(Json const& _input) noexcept
 {
-	YulStringRepository::reset();
-
-	try
-	{
-		auto parsed = parseInput(_input);
-		if (std::holds_alternative<Json>(parsed))
-			return std::get<Json>(std::move(parsed));
-		InputsAndSettings settings = std::get<InputsAndSettings>(std::move(parsed));
-		if (settings.language == "Solidity")
-			return compileSolidity(std::move(settings));
-		else if (settings.language == "Yul")
-			return compileYul(std::move(settings));
-		else if (settings.language == "SolidityAST")
-			return compileSolidity(std::move(settings));
-		else if (settings.language == "EVMAssembly")
-			return importEVMAssembly(std::move(settings));
-		else
-			return formatFatalError(Error::Type::JSONError, "Only \"Solidity\", \"Yul\", \"SolidityAST\" or \"EVMAssembly\" is supported as a language.");
-	}
-	catch (UnimplementedFeatureError const& _exception)
-	{
-		solAssert(_exception.comment(), "Unimplemented feature errors must include a message for the user");
-		return formatFatalError(Error::Type::UnimplementedFeatureError, stringOrDefault(_exception.comment()));
-	}
-	catch (...)
-	{
-		return formatFatalError(Error::Type::InternalCompilerError, "Internal exception in StandardCompiler::compile: " +  boost::current_exception_diagnostic_information());
-	}
+	return compile(_input, nullptr);
 }
 
 std::string StandardCompiler::compile(std::string const& _input) noexcept
@@ -1766,6 +2014,75 @@ std::string StandardCompiler::compile(std::string const& _input) noexcept
 	}
 }
 
+void StandardCompiler::compile(std::string const& _input, std::ostream& _output)
+{
+	Json input;
+	bool inputValid = false;
+	try
+	{
+		inputValid = util::jsonParseStrict(_input, input);
+	}
+	catch (...)
+	{
+	}
+	if (!inputValid)
+	{
+		// Let the non-streaming variant produce the error message.
+		_output << compile(_input);
+		return;
+	}
+
+	util::JsonStreamWriter writer(_output, m_jsonPrintingFormat);
+	compile(input, &writer);
+}
+
+Json StandardCompiler::compile(Json const& _input, util::JsonStreamWriter* _stream)
+{
+	YulStringRepository::reset();
+
+	Json output;
+	try
+	{
+		auto parsed = parseInput(_input);
+		if (std::holds_alternative<Json>(parsed))
+			output = std::get<Json>(std::move(parsed));
+		else
+		{
+			InputsAndSettings settings = std::get<InputsAndSettings>(std::move(parsed));
+			std::optional<util::Profiler::Session> profilerSession;
+			if (settings.profile)
+				profilerSession.emplace();
+			util::Profiler::Session const* profile = profilerSession.has_value() ? &*profilerSession : nullptr;
+
+			if (settings.language == "Solidity")
+				output = compileSolidity(std::move(settings), _stream, profile);
+			else if (settings.language == "Yul")
+				output = compileYul(std::move(settings));
+			else if (settings.language == "SolidityAST")
+				output = compileSolidity(std::move(settings), _stream, profile);
+			else if (settings.language == "EVMAssembly")
+				output = importEVMAssembly(std::move(settings));
+			else
+				output = formatFatalError(Error::Type::JSONError, "Only \"Solidity\", \"Yul\", \"SolidityAST\" or \"EVMAssembly\" is supported as a language.");
+
+			// Solidity output, which may have been written to the stream already, includes the profile.
+			if (profile && output.is_object() && !output.contains("profile"))
+				output["profile"] = profile->toJson();
+		}
+	}
+	catch (...)
+	{
+		// The exception could not be reported in the part of the output that has already been written.
+		if (_stream && (_stream->depth() > 0 || _stream->finished()))
+			throw;
+		output = formatCurrentException();
+	}
+
+	if (_stream && !_stream->finished())
+		_stream->value(output);
+	return output;
+}
+
 Json StandardCompiler::formatFunctionDebugData(
 	std::map<std::string, evmasm::LinkerObject::FunctionDebugData> const& _debugInfo
 )
@@ -25,10 +25,12 @@
 
 #include <libsolidity/interface/CompilerStack.h>
 #include <libsolutil/JSON.h>
+#include <libsolutil/Profiler.h>
 
 #include <liblangutil/DebugInfoSelection.h>
 
 #include <optional>
+#include <ostream>
 #include <utility>
 #include <variant>
 
@@ -62,6 +64,29 @@ public:
 	/// Parses input as JSON and performs the above processing steps, returning a serialized JSON
 	/// output. Parsing errors are returned as regular errors.
 	std::string compile(std::string const& _input) noexcept;
+	/// Same as the above, but writes the serialized output to @a _output. The outputs of the
+	/// individual sources and contracts are written as soon as they are ready and are not kept
+	/// in memory together. The text written is the same as the one returned by the above, except
+	/// that a failure while producing the output is reported as an error after the parts that
+	/// have already been written.
+	/// @throws if such a failure occurs after the errors have already been written, e.g. while
+	/// exporting the AST of a source. The output is completed without the failed part then.
+	void compile(std::string const& _input, std::ostream& _output);
+
+	/// Takes the ASTs of unchanged Solidity sources from @a _cache instead of parsing them again
+	/// and stores the ASTs of the compiled sources in it. The cache can be shared by consecutive
+	/// compilations. See CompilerStack::setParsedSourceCache().
+	void setParsedSourceCache(std::shared_ptr<ParsedSourceCache> _cache) { m_parsedSourceCache = std::move(_cache); }
+	/// Makes consecutive compilations reuse each other's optimized Yul code.
+	/// See CompilerStack::shareYulOptimizerCache().
+	void shareYulOptimizerCache(
+		std::shared_ptr<yul::YulStringRepository> _yulStringRepository,
+		std::shared_ptr<yul::ObjectOptimizer> _objectOptimizer
+	)
+	{
+		m_yulStringRepository = std::move(_yulStringRepository);
+		m_objectOptimizer = std::move(_objectOptimizer);
+	}
 
 	static Json formatFunctionDebugData(
 		std::map<std::string, evmasm::LinkerObject::FunctionDebugData> const& _debugInfo
@@ -89,18 +114,45 @@ private:
 		Json outputSelection;
 		ModelCheckerSettings modelCheckerSettings = ModelCheckerSettings{};
 		bool viaIR = false;
+		size_t parallelism = 1;
+		bool profile = false;
+		bool discardIntermediateArtifacts = false;
+		std::optional<boost::filesystem::path> optimizerCacheDirectory;
+		std::uintmax_t optimizerCacheMaxSize = CompilerStack::defaultOptimizerCacheMaxSize;
 	};
 
 	/// Parses the input json (and potentially invokes the read callback) and either returns
 	/// it in condensed form or an error as a json object.
 	std::variant<InputsAndSettings, Json> parseInput(Json const& _input);
 
-	std::map<std::string, Json> parseAstFromInput(StringMap const& _sources);
+	/// Imports the ASTs given as JSON in @a _sources into @a _compilerStack.
+	static void importASTs(CompilerStack& _compilerStack, StringMap const& _sources);
 	Json importEVMAssembly(InputsAndSettings _inputsAndSettings);
-	Json compileSolidity(InputsAndSettings _inputsAndSettings);
+	/// Performs the compilation described by @a _input. If @a _stream is given, the output is also
+	/// written to it, for Solidity piece by piece, in which case the returned output may be null.
+	Json compile(Json const& _input, util::JsonStreamWriter* _stream);
+	/// Compiles Solidity sources or ASTs. If @a _stream is given, the output is written to it
+	/// instead of being returned. If @a _profilerSession is given, its measurements are included
+	/// in the output.
+	Json compileSolidity(
+		InputsAndSettings _inputsAndSettings,
+		util::JsonStreamWriter* _stream = nullptr,
+		util::Profiler::Session const* _profilerSession = nullptr
+	);
+	static Json formatContract(
+		CompilerStack const& _compilerStack,
+		InputsAndSettings const& _inputsAndSettings,
+		StringMap const& _sourceList,
+		std::string const& _file,
+		std::string const& _name,
+		bool _compilationSuccess
+	);
 	Json compileYul(InputsAndSettings _inputsAndSettings);
 
 	ReadCallback::Callback m_readFile;
+	std::shared_ptr<ParsedSourceCache> m_parsedSourceCache;
+	std::shared_ptr<yul::YulStringRepository> m_yulStringRepository;
+	std::shared_ptr<yul::ObjectOptimizer> m_objectOptimizer;
 
 	util::JsonFormat m_jsonPrintingFormat;
 };
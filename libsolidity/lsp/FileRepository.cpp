@@ -25,6 +25,7 @@
 
 #include <range/v3/algorithm/none_of.hpp>
 #include <range/v3/range/conversion.hpp>
+#include <range/v3/view/map.hpp>
 #include <range/v3/view/transform.hpp>
 #include <boost/algorithm/string/predicate.hpp>
 
@@ -50,7 +51,15 @@ FileRepository::FileRepository(boost::filesystem::path _basePath, std::vector<bo
 
 void FileRepository::setIncludePaths(std::vector<boost::filesystem::path> _paths)
 {
+	if (_paths == m_includePaths)
+		return;
 	m_includePaths = std::move(_paths);
+
+	// Imports might resolve to different files now.
+	for (auto const& sourceUnitName: m_diskFiles | ranges::views::keys)
+		if (m_sourceCodes.erase(sourceUnitName))
+			m_dirtySourceUnits.insert(sourceUnitName);
+	m_diskFiles.clear();
 }
 
 std::string FileRepository::sourceUnitNameToUri(std::string const& _sourceUnitName) const
@@ -98,7 +107,89 @@ void FileRepository::setSourceByUri(std::string const& _uri, std::string _source
 	auto sourceUnitName = uriToSourceUnitName(_uri);
 	lspDebug(fmt::format("FileRepository.setSourceByUri({}): {}", _uri, _source));
 	m_sourceUnitNamesToUri.emplace(sourceUnitName, _uri);
-	m_sourceCodes[sourceUnitName] = std::move(_source);
+	m_diskFiles.erase(sourceUnitName);
+	setSource(sourceUnitName, std::move(_source));
+}
+
+void FileRepository::loadSourceByUri(std::string const& _uri, boost::filesystem::path const& _path)
+{
+	auto sourceUnitName = uriToSourceUnitName(_uri);
+	m_sourceUnitNamesToUri.emplace(sourceUnitName, _uri);
+	if (m_sourceCodes.count(sourceUnitName))
+	{
+		auto it = m_diskFiles.find(sourceUnitName);
+		if (it != m_diskFiles.end() && it->second.path == _path)
+			// Changes are picked up by refreshSourcesFromDisk().
+			return;
+	}
+	readSourceFromDisk(sourceUnitName, _path);
+}
+
+void FileRepository::refreshSourcesFromDisk()
+{
+	for (auto it = m_diskFiles.begin(); it != m_diskFiles.end();)
+	{
+		std::string const& sourceUnitName = it->first;
+		boost::system::error_code error;
+		std::time_t const lastWriteTime = boost::filesystem::last_write_time(it->second.path, error);
+		if (error)
+		{
+			lspDebug(fmt::format("FileRepository: {} was removed", sourceUnitName));
+			m_sourceCodes.erase(sourceUnitName);
+			m_dirtySourceUnits.insert(sourceUnitName);
+			it = m_diskFiles.erase(it);
+			continue;
+		}
+
+		if (it->second.lastWriteTime != lastWriteTime)
+			readSourceFromDisk(sourceUnitName, it->second.path);
+		++it;
+	}
+}
+
+void FileRepository::removeSource(std::string const& _sourceUnitName)
+{
+	m_diskFiles.erase(_sourceUnitName);
+	if (m_sourceCodes.erase(_sourceUnitName))
+		m_dirtySourceUnits.insert(_sourceUnitName);
+}
+
+void FileRepository::removeSourcesFromDisk(std::set<std::string> const& _keep)
+{
+	for (auto it = m_diskFiles.begin(); it != m_diskFiles.end();)
+		if (_keep.count(it->first))
+			++it;
+		else
+		{
+			// Not marked as dirty, since the source was not part of the compilation.
+			m_sourceCodes.erase(it->first);
+			it = m_diskFiles.erase(it);
+		}
+}
+
+void FileRepository::clearDirtySourceUnits()
+{
+	m_dirtySourceUnits.clear();
+	m_hadFailedReads = false;
+}
+
+void FileRepository::setSource(std::string const& _sourceUnitName, std::string _source)
+{
+	auto [it, inserted] = m_sourceCodes.try_emplace(_sourceUnitName);
+	if (inserted || it->second != _source)
+	{
+		it->second = std::move(_source);
+		m_dirtySourceUnits.insert(_sourceUnitName);
+	}
+}
+
+void FileRepository::readSourceFromDisk(std::string const& _sourceUnitName, boost::filesystem::path const& _path)
+{
+	std::optional<std::time_t> lastWriteTime = boost::filesystem::last_write_time(_path);
+	if (*lastWriteTime >= std::time(nullptr))
+		lastWriteTime.reset();
+	setSource(_sourceUnitName, readFileAsString(_path));
+	m_diskFiles[_sourceUnitName] = DiskFile{_path, lastWriteTime};
 }
 
 Result<boost::filesystem::path> FileRepository::tryResolvePath(std::string const& _strippedSourceUnitName) const
@@ -163,15 +254,18 @@ frontend::ReadCallback::Result FileRepository::readFile(std::string const& _kind
 		std::string const strippedSourceUnitName = stripFileUriSchemePrefix(_sourceUnitName);
 		Result<boost::filesystem::path> const resolvedPath = tryResolvePath(strippedSourceUnitName);
 		if (!resolvedPath.message().empty())
+		{
+			m_hadFailedReads = true;
 			return ReadCallback::Result{false, resolvedPath.message()};
+		}
 
-		auto contents = readFileAsString(resolvedPath.get());
 		solAssert(m_sourceCodes.count(_sourceUnitName) == 0, "");
-		m_sourceCodes[_sourceUnitName] = contents;
-		return ReadCallback::Result{true, std::move(contents)};
+		readSourceFromDisk(_sourceUnitName, resolvedPath.get());
+		return ReadCallback::Result{true, m_sourceCodes.at(_sourceUnitName)};
 	}
 	catch (...)
 	{
+		m_hadFailedReads = true;
 		return ReadCallback::Result{false, "Exception in read callback: " + boost::current_exception_diagnostic_information()};
 	}
 }
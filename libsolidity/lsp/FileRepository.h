@@ -20,8 +20,11 @@
 #include <libsolidity/interface/FileReader.h>
 #include <libsolutil/Result.h>
 
-#include <string>
+#include <ctime>
 #include <map>
+#include <optional>
+#include <set>
+#include <string>
 
 namespace solidity::lsp
 {
@@ -48,6 +51,28 @@ public:
 	/// Changes the source identified by the LSP client path _uri to _text.
 	void setSourceByUri(std::string const& _uri, std::string _text);
 
+	/// Sets the source identified by the LSP client path _uri to the content of the file at _path,
+	/// unless it is already known and the file did not change since it was last read.
+	void loadSourceByUri(std::string const& _uri, boost::filesystem::path const& _path);
+
+	/// Reads all sources again that were loaded from files which changed on disk since
+	/// and removes those whose files no longer exist.
+	void refreshSourcesFromDisk();
+
+	/// Removes the source with the given name.
+	void removeSource(std::string const& _sourceUnitName);
+
+	/// Removes all sources that were loaded from disk, except those in _keep.
+	void removeSourcesFromDisk(std::set<std::string> const& _keep);
+
+	/// @returns the names of all sources that were added, changed or removed since the last call
+	/// to clearDirtySourceUnits().
+	std::set<std::string> const& dirtySourceUnits() const noexcept { return m_dirtySourceUnits; }
+	/// @returns true if any file could not be read through the callback since the last call
+	/// to clearDirtySourceUnits(). Such a file might have been created in the meantime.
+	bool hadFailedReads() const noexcept { return m_hadFailedReads; }
+	void clearDirtySourceUnits();
+
 	void setSourceUnits(StringMap _sources);
 	frontend::ReadCallback::Result readFile(std::string const& _kind, std::string const& _sourceUnitName);
 	frontend::ReadCallback::Callback reader()
@@ -58,6 +83,11 @@ public:
 	util::Result<boost::filesystem::path> tryResolvePath(std::string const& _sourceUnitName) const;
 
 private:
+	/// Sets the source with the given name and marks it as dirty if its content changed.
+	void setSource(std::string const& _sourceUnitName, std::string _source);
+	/// Reads the source with the given name from _path and remembers the file for refreshSourcesFromDisk().
+	void readSourceFromDisk(std::string const& _sourceUnitName, boost::filesystem::path const& _path);
+
 	/// Base path without URI scheme.
 	boost::filesystem::path m_basePath;
 
@@ -69,6 +99,20 @@ private:
 
 	/// Mapping of source unit names to their file content.
 	StringMap m_sourceCodes;
+
+	struct DiskFile
+	{
+		boost::filesystem::path path;
+		/// Modification time of the file when it was read. Not set if the file was read in the same
+		/// second in which it was modified, since it could have been modified again without this
+		/// being visible in the modification time.
+		std::optional<std::time_t> lastWriteTime;
+	};
+	/// Files from which the sources that are not provided by the client were read.
+	std::map<std::string, DiskFile> m_diskFiles;
+
+	std::set<std::string> m_dirtySourceUnits;
+	bool m_hadFailedReads = false;
 };
 
 }
@@ -18,6 +18,8 @@
 #include <libsolidity/ast/AST.h>
 #include <libsolidity/ast/ASTUtils.h>
 #include <libsolidity/ast/ASTVisitor.h>
+#include <libsolidity/ast/TypeProvider.h>
+#include <libsolidity/interface/ParsedSourceCache.h>
 #include <libsolidity/interface/ReadFile.h>
 #include <libsolidity/interface/StandardCompiler.h>
 #include <libsolidity/lsp/LanguageServer.h>
@@ -59,6 +61,20 @@ namespace fs = boost::filesystem;
 namespace
 {
 
+/// Time without further changes after which the sources are analysed.
+constexpr std::chrono::milliseconds c_analysisDelay{100};
+
+/// Estimated size above which the least recently stored ASTs are dropped.
+constexpr size_t c_parsedSourceCacheBudget = 256 * 1024 * 1024;
+
+/// Requests that are answered from the last completed analysis, if it includes the document.
+std::set<std::string> const c_analysisQueries{
+	"textDocument/definition",
+	"textDocument/hover",
+	"textDocument/implementation",
+	"textDocument/semanticTokens/full",
+};
+
 bool resolvesToRegularFile(boost::filesystem::path _path, int maxRecursionDepth = 10)
 {
 	fs::file_status fileStatus = fs::status(_path);
@@ -134,8 +150,8 @@ Json semanticTokensLegend()
 LanguageServer::LanguageServer(Transport& _transport):
 	m_client{_transport},
 	m_handlers{
-		{"$/cancelRequest", [](auto, auto) {/*nothing for now as we are synchronous */}},
-		{"cancelRequest", [](auto, auto) {/*nothing for now as we are synchronous */}},
+		{"$/cancelRequest", [](auto, auto) {/*nothing for now as requests are answered synchronously */}},
+		{"cancelRequest", [](auto, auto) {/*nothing for now as requests are answered synchronously */}},
 		{"exit", [this](auto, auto) { m_state = (m_state == State::ShutdownRequested ? State::ExitRequested : State::ExitWithoutShutdown); }},
 		{"initialize", std::bind(&LanguageServer::handleInitialize, this, _1, _2)},
 		{"initialized", std::bind(&LanguageServer::handleInitialized, this, _1, _2)},
@@ -152,8 +168,20 @@ LanguageServer::LanguageServer(Transport& _transport):
 		{"workspace/didChangeConfiguration", std::bind(&LanguageServer::handleWorkspaceDidChangeConfiguration, this, _2)},
 	},
 	m_fileRepository("/" /* basePath */, {} /* no search paths */),
-	m_compilerStack{m_fileRepository.reader()}
+	m_parsedSourceCache(std::make_shared<ParsedSourceCache>(c_parsedSourceCacheBudget, true /* _singleVersionPerSource */)),
+	m_compilerStack(std::make_unique<CompilerStack>(ReadCallback::Callback{}, true /* _ownTypeProvider */))
 {
+	m_analysisThread = std::thread(&LanguageServer::analyseInBackground, this);
+}
+
+LanguageServer::~LanguageServer()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_stopAnalysis = true;
+	}
+	m_analysisRequested.notify_one();
+	m_analysisThread.join();
 }
 
 Json LanguageServer::toRange(SourceLocation const& _location)
@@ -236,43 +264,183 @@ std::vector<boost::filesystem::path> LanguageServer::allSolidityFilesFromProject
 	return collectedPaths;
 }
 
-void LanguageServer::compile()
+std::unique_ptr<CompilerStack> LanguageServer::prepareAnalysis(std::set<std::string>& _rootSourceUnits)
 {
-	// For files that are not open, we have to take changes on disk into account,
-	// so we just remove all non-open files.
+	// For files that are not open, we have to take changes on disk into account.
+	// Files are only read again if they were modified since they were last read.
+	m_fileRepository.refreshSourcesFromDisk();
 
-	FileRepository oldRepository(m_fileRepository.basePath(), m_fileRepository.includePaths());
-	std::swap(oldRepository, m_fileRepository);
+	for (std::string const& fileName: m_openFiles)
+		_rootSourceUnits.insert(m_fileRepository.uriToSourceUnitName(fileName));
 
-	// Load all solidity files from project.
+	// Load all solidity files from project, except the ones opened by the client,
+	// which might potentially have changes.
 	if (m_fileLoadStrategy == FileLoadStrategy::ProjectDirectory)
 		for (auto const& projectFile: allSolidityFilesFromProject())
 		{
-			lspDebug(fmt::format("adding project file: {}", projectFile.generic_string()));
-			m_fileRepository.setSourceByUri(
-				m_fileRepository.sourceUnitNameToUri(projectFile.generic_string()),
-				util::readFileAsString(projectFile)
-			);
+			std::string const uri = m_fileRepository.sourceUnitNameToUri(projectFile.generic_string());
+			std::string const sourceUnitName = m_fileRepository.uriToSourceUnitName(uri);
+			if (_rootSourceUnits.insert(sourceUnitName).second)
+			{
+				lspDebug(fmt::format("adding project file: {}", projectFile.generic_string()));
+				m_fileRepository.loadSourceByUri(uri, projectFile);
+			}
 		}
 
-	// Overwrite all files as opened by the client, including the ones which might potentially have changes.
-	for (std::string const& fileName: m_openFiles)
-		m_fileRepository.setSourceByUri(
-			fileName,
-			oldRepository.sourceUnits().at(oldRepository.uriToSourceUnitName(fileName))
-		);
+	if (
+		m_compilerStack->state() != CompilerStack::Empty &&
+		_rootSourceUnits == m_compiledRootSourceUnits &&
+		m_fileRepository.dirtySourceUnits().empty() &&
+		!m_fileRepository.hadFailedReads()
+	)
+	{
+		lspDebug("nothing changed since the last compilation");
+		return nullptr;
+	}
+	lspDebug(fmt::format("recompiling, {} source unit(s) changed", m_fileRepository.dirtySourceUnits().size()));
+
+	StringMap sources;
+	for (std::string const& sourceUnitName: _rootSourceUnits)
+		sources[sourceUnitName] = m_fileRepository.sourceUnits().at(sourceUnitName);
+
+	// Imports are read during parsing, which happens without holding the lock.
+	auto compilerStack = std::make_unique<CompilerStack>(
+		[this](std::string const& _kind, std::string const& _path) {
+			std::lock_guard<std::mutex> lock(m_mutex);
+			return m_fileRepository.readFile(_kind, _path);
+		},
+		true /* _ownTypeProvider */
+	);
+	// Sources that did not change are not parsed again, but taken from the parsed source cache.
+	// The cache only gets the ASTs of the current analysis back once it is replaced.
+	compilerStack->setParsedSourceCache(m_parsedSourceCache);
+	compilerStack->setSources(std::move(sources));
+	return compilerStack;
+}
 
-	// TODO: optimize! do not recompile if nothing has changed (file(s) not flagged dirty).
+void LanguageServer::scheduleAnalysis()
+{
+	++m_requestedGeneration;
+	m_lastChange = std::chrono::steady_clock::now();
+	m_analysisRequested.notify_one();
+}
 
-	m_compilerStack.reset(false);
-	m_compilerStack.setSources(m_fileRepository.sourceUnits());
-	m_compilerStack.compile(CompilerStack::State::AnalysisSuccessful);
+void LanguageServer::waitForAnalysis(std::unique_lock<std::mutex>& _lock, std::string const& _methodName, Json const& _params)
+{
+	std::optional<std::string> sourceUnitName;
+	if (
+		_params.contains("textDocument") &&
+		_params["textDocument"].contains("uri") &&
+		_params["textDocument"]["uri"].is_string()
+	)
+		sourceUnitName = m_fileRepository.uriToSourceUnitName(_params["textDocument"]["uri"].get<std::string>());
+
+	// Renaming has to be based on the current sources. Other queries can be answered
+	// from an outdated analysis, but not if it does not include the document at all.
+	bool wait = _methodName == "textDocument/rename";
+	if (c_analysisQueries.count(_methodName) && sourceUnitName)
+		wait = !util::contains(m_compilerStack->sourceNames(), *sourceUnitName);
+
+	if (wait)
+		m_analysisFinished.wait(_lock, [&] { return m_analysedGeneration == m_requestedGeneration; });
+	if (_methodName == "textDocument/rename")
+		lspRequire(
+			!m_failedCompilerStack,
+			ErrorCode::RequestFailed,
+			"Cannot rename symbols while the sources contain errors."
+		);
+
+	// Documents that have contained errors ever since they were opened are only part of the failed analysis.
+	m_queriedCompilerStack = m_compilerStack.get();
+	if (
+		m_failedCompilerStack &&
+		sourceUnitName &&
+		!util::contains(m_compilerStack->sourceNames(), *sourceUnitName) &&
+		util::contains(m_failedCompilerStack->sourceNames(), *sourceUnitName)
+	)
+		m_queriedCompilerStack = m_failedCompilerStack.get();
 }
 
-void LanguageServer::compileAndUpdateDiagnostics()
+void LanguageServer::analyseInBackground()
 {
-	compile();
+	std::unique_lock<std::mutex> lock(m_mutex);
+	while (true)
+	{
+		m_analysisRequested.wait(lock, [&] { return m_stopAnalysis || m_analysedGeneration != m_requestedGeneration; });
+		// Changes usually come in bursts, e.g. while typing. Only the last one is worth analysing.
+		while (!m_stopAnalysis && std::chrono::steady_clock::now() < m_lastChange + c_analysisDelay)
+			m_analysisRequested.wait_until(lock, m_lastChange + c_analysisDelay);
+		if (m_stopAnalysis)
+			return;
+
+		uint64_t const generation = m_requestedGeneration;
+		auto const superseded = [&]() { return m_stopAnalysis || m_requestedGeneration != generation; };
+
+		std::set<std::string> rootSourceUnits;
+		std::unique_ptr<CompilerStack> compilerStack;
+		try
+		{
+			compilerStack = prepareAnalysis(rootSourceUnits);
+			if (compilerStack)
+			{
+				// Sources may change again in the meantime. Analysing them is pointless then.
+				lock.unlock();
+				bool const parsed = compilerStack->parse();
+				lock.lock();
+				if (parsed && !superseded())
+				{
+					lock.unlock();
+					compilerStack->analyze();
+					lock.lock();
+				}
+			}
+		}
+		catch (...)
+		{
+			if (!lock.owns_lock())
+				lock.lock();
+			m_client.trace("Analysis failed: "s + boost::current_exception_diagnostic_information());
+			m_analysedGeneration = generation;
+			m_analysisFinished.notify_all();
+			continue;
+		}
+
+		if (superseded())
+		{
+			lspDebug("discarding analysis of outdated sources");
+			continue;
+		}
+
+		if (compilerStack)
+		{
+			// Files that are no longer imported are not part of the next compilation either.
+			std::set<std::string> usedSourceUnits = rootSourceUnits;
+			for (std::string const& sourceUnitName: compilerStack->sourceNames())
+				usedSourceUnits.insert(sourceUnitName);
+			m_fileRepository.removeSourcesFromDisk(usedSourceUnits);
+			m_fileRepository.clearDirtySourceUnits();
+			m_compiledRootSourceUnits = std::move(rootSourceUnits);
+			// Queries keep being answered from the last successful analysis while the sources
+			// contain errors, unless there is none yet.
+			if (
+				compilerStack->state() >= CompilerStack::AnalysisSuccessful ||
+				m_compilerStack->state() < CompilerStack::AnalysisSuccessful
+			)
+			{
+				std::swap(m_compilerStack, compilerStack);
+				m_failedCompilerStack.reset();
+			}
+			else
+				m_failedCompilerStack = std::move(compilerStack);
+		}
+		m_analysedGeneration = generation;
+		publishDiagnostics(m_failedCompilerStack ? *m_failedCompilerStack : *m_compilerStack);
+		m_analysisFinished.notify_all();
+	}
+}
 
+void LanguageServer::publishDiagnostics(CompilerStack const& _compilerStack)
+{
 	// These are the source units we will sent diagnostics to the client for sure,
 	// even if it is just to clear previous diagnostics.
 	std::map<std::string, Json> diagnosticsBySourceUnit;
@@ -281,7 +449,7 @@ void LanguageServer::compileAndUpdateDiagnostics()
 	for (std::string const& sourceUnitName: m_nonemptyDiagnostics)
 		diagnosticsBySourceUnit[sourceUnitName] = Json::array();
 
-	for (std::shared_ptr<Error const> const& error: m_compilerStack.errors())
+	for (std::shared_ptr<Error const> const& error: _compilerStack.errors())
 	{
 		SourceLocation const* location = error->sourceLocation();
 		if (!location || !location->sourceName)
@@ -348,7 +516,12 @@ bool LanguageServer::run()
 				lspDebug(fmt::format("received method call: {}", methodName));
 
 				if (auto handler = util::valueOrDefault(m_handlers, methodName))
+				{
+					std::unique_lock<std::mutex> lock(m_mutex);
+					waitForAnalysis(lock, methodName, (*jsonMessage)["params"]);
+					TypeProvider::Scope typeScope(compilerStack().typeProvider());
 					handler(id, (*jsonMessage)["params"]);
+				}
 				else
 					m_client.error(id, ErrorCode::MethodNotFound, "Unknown method " + methodName);
 			}
@@ -432,7 +605,7 @@ void LanguageServer::handleInitialize(MessageID _id, Json const& _args)
 void LanguageServer::handleInitialized(MessageID, Json const&)
 {
 	if (m_fileLoadStrategy == FileLoadStrategy::ProjectDirectory)
-		compileAndUpdateDiagnostics();
+		scheduleAnalysis();
 }
 
 void LanguageServer::semanticTokensFull(MessageID _id, Json const& _args)
@@ -441,12 +614,15 @@ void LanguageServer::semanticTokensFull(MessageID _id, Json const& _args)
 	{
 		auto uri = _args["textDocument"]["uri"];
 
-		compile();
-
 		auto const sourceName = m_fileRepository.uriToSourceUnitName(uri.get<std::string>());
-		SourceUnit const& ast = m_compilerStack.ast(sourceName);
-		m_compilerStack.charStream(sourceName);
-		Json data = SemanticTokensBuilder().build(ast, m_compilerStack.charStream(sourceName));
+		lspRequire(
+			compilerStack().state() >= CompilerStack::ParsedAndImported &&
+			util::contains(compilerStack().sourceNames(), sourceName),
+			ErrorCode::RequestFailed,
+			"Unknown file: " + uri.get<std::string>()
+		);
+		SourceUnit const& ast = compilerStack().ast(sourceName);
+		Json data = SemanticTokensBuilder().build(ast, compilerStack().charStream(sourceName));
 
 		Json reply;
 		reply["data"] = data;
@@ -496,7 +672,7 @@ void LanguageServer::handleTextDocumentDidOpen(Json const& _args)
 		std::string uri = _args["textDocument"]["uri"].get<std::string>();
 		m_openFiles.insert(uri);
 		m_fileRepository.setSourceByUri(uri, std::move(text));
-		compileAndUpdateDiagnostics();
+		scheduleAnalysis();
 	}
 }
 
@@ -543,7 +719,7 @@ void LanguageServer::handleTextDocumentDidChange(Json const& _args)
 				}
 			}
 
-		compileAndUpdateDiagnostics();
+		scheduleAnalysis();
 	}
 }
 
@@ -561,8 +737,10 @@ void LanguageServer::handleTextDocumentDidClose(Json const& _args)
 	{
 		std::string uri = _args["textDocument"]["uri"].get<std::string>();
 		m_openFiles.erase(uri);
+		// The file is read from disk again if it is still part of the compilation.
+		m_fileRepository.removeSource(m_fileRepository.uriToSourceUnitName(uri));
 
-		compileAndUpdateDiagnostics();
+		scheduleAnalysis();
 	}
 }
 
@@ -573,14 +751,14 @@ ASTNode const* LanguageServer::astNodeAtSourceLocation(std::string const& _sourc
 
 std::tuple<ASTNode const*, int> LanguageServer::astNodeAndOffsetAtSourceLocation(std::string const& _sourceUnitName, LineColumn const& _filePos)
 {
-	if (m_compilerStack.state() < CompilerStack::AnalysisSuccessful)
+	if (compilerStack().state() < CompilerStack::AnalysisSuccessful)
 		return {nullptr, -1};
-	if (!m_fileRepository.sourceUnits().count(_sourceUnitName))
+	if (!util::contains(compilerStack().sourceNames(), _sourceUnitName))
 		return {nullptr, -1};
 
-	std::optional<int> sourcePos = m_compilerStack.charStream(_sourceUnitName).translateLineColumnToPosition(_filePos);
+	std::optional<int> sourcePos = compilerStack().charStream(_sourceUnitName).translateLineColumnToPosition(_filePos);
 	if (!sourcePos)
 		return {nullptr, -1};
 
-	return {locateInnermostASTNode(*sourcePos, m_compilerStack.ast(_sourceUnitName)), *sourcePos};
+	return {locateInnermostASTNode(*sourcePos, compilerStack().ast(_sourceUnitName)), *sourcePos};
 }
@@ -24,12 +24,23 @@
 
 #include <libsolutil/JSON.h>
 
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
 #include <functional>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
+#include <thread>
 #include <vector>
 
+namespace solidity::frontend
+{
+class ParsedSourceCache;
+}
+
 namespace solidity::lsp
 {
 
@@ -57,15 +68,16 @@ enum class FileLoadStrategy
  * Solidity Language Server, managing one LSP client.
  * This implements a subset of LSP version 3.16 that can be found at:
  * https://microsoft.github.io/language-server-protocol/specifications/specification-3-16/
+ *
+ * Sources are analysed on a background thread, once changes have settled for a moment.
+ * Requests are answered from the result of the last completed analysis in the meantime.
  */
 class LanguageServer
 {
 public:
 	/// @param _transport Customizable transport layer.
 	explicit LanguageServer(Transport& _transport);
-
-	/// Re-compiles the project and updates the diagnostics pushed to the client.
-	void compileAndUpdateDiagnostics();
+	~LanguageServer();
 
 	/// Loops over incoming messages via the transport layer until shutdown condition is met.
 	///
@@ -79,7 +91,8 @@ public:
 	Transport& client() noexcept { return m_client; }
 	std::tuple<frontend::ASTNode const*, int> astNodeAndOffsetAtSourceLocation(std::string const& _sourceUnitName, langutil::LineColumn const& _filePos);
 	frontend::ASTNode const* astNodeAtSourceLocation(std::string const& _sourceUnitName, langutil::LineColumn const& _filePos);
-	frontend::CompilerStack const& compilerStack() const noexcept { return m_compilerStack; }
+	/// @returns the compiler stack holding the result of the last completed analysis.
+	frontend::CompilerStack const& compilerStack() const noexcept { return *m_queriedCompilerStack; }
 
 private:
 	/// Checks if the server is initialized (to be used by messages that need it to be initialized).
@@ -99,8 +112,19 @@ private:
 	/// Invoked when the server user-supplied configuration changes (initiated by the client).
 	void changeConfiguration(Json const&);
 
-	/// Compile everything until after analysis phase.
-	void compile();
+	/// Requests a new analysis of the sources, superseding the one currently running, if any.
+	void scheduleAnalysis();
+	/// Blocks until the sources requested by the message @a _methodName with @a _params are analysed,
+	/// unless the request can be answered from the last completed analysis.
+	/// Selects the analysis the message is answered from.
+	void waitForAnalysis(std::unique_lock<std::mutex>& _lock, std::string const& _methodName, Json const& _params);
+	/// Runs on the analysis thread until the server is destroyed.
+	void analyseInBackground();
+	/// @returns a compiler stack with the sources to analyse set or nullptr if nothing changed
+	/// since the last analysis. Stores the source units given to the compiler in @a _rootSourceUnits.
+	std::unique_ptr<frontend::CompilerStack> prepareAnalysis(std::set<std::string>& _rootSourceUnits);
+	/// Publishes the diagnostics of @a _compilerStack to the client.
+	void publishDiagnostics(frontend::CompilerStack const& _compilerStack);
 
 	std::vector<boost::filesystem::path> allSolidityFilesFromProject() const;
 
@@ -119,15 +143,42 @@ private:
 
 	/// Set of files (names in URI form) known to be open by the client.
 	std::set<std::string> m_openFiles;
+	/// Source unit names explicitly given to the compiler in the last compilation,
+	/// i.e. the open files and, depending on the file load strategy, all project files.
+	std::set<std::string> m_compiledRootSourceUnits;
 	/// Set of source unit names for which we sent diagnostics to the client in the last iteration.
 	std::set<std::string> m_nonemptyDiagnostics;
 	FileRepository m_fileRepository;
 	FileLoadStrategy m_fileLoadStrategy = FileLoadStrategy::ProjectDirectory;
 
-	frontend::CompilerStack m_compilerStack;
-
 	/// User-supplied custom configuration settings (such as EVM version).
 	Json m_settingsObject;
+
+	/// Keeps the ASTs of unchanged sources across analyses.
+	std::shared_ptr<frontend::ParsedSourceCache> m_parsedSourceCache;
+	/// Result of the last successful analysis, which answers the queries. Uses a TypeProvider of its
+	/// own, so that the next analysis can run on the analysis thread while it is still in use.
+	std::unique_ptr<frontend::CompilerStack> m_compilerStack;
+	/// Result of the last analysis if it failed. Used for diagnostics and for queries about
+	/// documents the last successful analysis does not include.
+	std::unique_ptr<frontend::CompilerStack> m_failedCompilerStack;
+	/// Analysis the message that is being handled is answered from.
+	frontend::CompilerStack const* m_queriedCompilerStack = nullptr;
+
+	/// Guards everything accessed by both the analysis thread and the thread handling messages,
+	/// i.e. the file repository, the compiler stack and the members below.
+	/// Held while handling a message.
+	std::mutex m_mutex;
+	std::condition_variable m_analysisRequested;
+	std::condition_variable m_analysisFinished;
+	/// Incremented whenever the sources change. Analyses of older generations are discarded.
+	uint64_t m_requestedGeneration = 0;
+	/// Generation of the sources the last completed analysis was based on.
+	uint64_t m_analysedGeneration = 0;
+	std::chrono::steady_clock::time_point m_lastChange;
+	bool m_stopAnalysis = false;
+	/// Started last, so that all of the above is initialized when it runs.
+	std::thread m_analysisThread;
 };
 
 }
@@ -23,6 +23,7 @@
 #include <functional>
 #include <iosfwd>
 #include <map>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <string_view>
@@ -111,6 +112,8 @@ public:
 
 private:
 	TraceValue m_logTrace = TraceValue::Off;
+	/// Keeps messages sent from different threads from being interleaved.
+	std::mutex m_sendMutex;
 
 protected:
 	/// Reads from the transport and parses the headers until the beginning
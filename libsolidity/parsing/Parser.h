@@ -52,6 +52,9 @@ public:
 
 	/// Returns the maximal AST node ID assigned so far
 	int64_t maxID() const { return m_currentNodeID; }
+	/// Skips @a _count AST node IDs, so that they can be used by a tree that was not
+	/// created by this parser.
+	void reserveIDs(int64_t _count) { m_currentNodeID += _count; }
 private:
 	class ASTNodeFactory;
 
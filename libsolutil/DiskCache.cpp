@@ -0,0 +1,162 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolutil/DiskCache.h>
+
+#include <libsolutil/Keccak256.h>
+
+#include <algorithm>
+#include <ctime>
+#include <fstream>
+#include <iterator>
+#include <tuple>
+#include <vector>
+
+using namespace solidity;
+using namespace solidity::util;
+
+namespace fs = boost::filesystem;
+
+namespace
+{
+
+std::string const c_entryExtension = ".entry";
+
+}
+
+DiskCache::DiskCache(fs::path _directory, std::string _version, std::uintmax_t _maxSize):
+	m_directory(std::move(_directory)),
+	m_version(std::move(_version)),
+	m_maxSize(_maxSize)
+{
+	boost::system::error_code ignored;
+	fs::create_directories(m_directory, ignored);
+	evict();
+}
+
+std::optional<std::string> DiskCache::load(h256 const& _key) const
+{
+	fs::path const path = entryPath(_key);
+	std::ifstream file(path.string(), std::ios::binary);
+	if (!file)
+		return std::nullopt;
+
+	std::string content{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+	if (file.bad())
+		return std::nullopt;
+
+	// The header guards against hash collisions in file names and against foreign files.
+	std::string const header = entryHeader(_key);
+	if (content.compare(0, header.size(), header) != 0)
+		return std::nullopt;
+
+	// Mark the entry as recently used. Failure only affects the order of eviction.
+	boost::system::error_code ignored;
+	fs::last_write_time(path, std::time(nullptr), ignored);
+
+	return content.substr(header.size());
+}
+
+void DiskCache::store(h256 const& _key, std::string const& _value)
+{
+	fs::path const path = entryPath(_key);
+	fs::path const temporaryPath = m_directory / fs::unique_path("%%%%-%%%%-%%%%-%%%%.tmp");
+
+	{
+		std::ofstream file(temporaryPath.string(), std::ios::binary | std::ios::trunc);
+		if (!file)
+			return;
+		file << entryHeader(_key) << _value;
+		if (!file.flush())
+		{
+			file.close();
+			boost::system::error_code ignored;
+			fs::remove(temporaryPath, ignored);
+			return;
+		}
+	}
+
+	// Renaming is atomic, other processes see either the old entry or the complete new one.
+	boost::system::error_code error;
+	fs::rename(temporaryPath, path, error);
+	if (error)
+	{
+		fs::remove(temporaryPath, error);
+		return;
+	}
+
+	bool needsEviction = false;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_bytesWrittenSinceEviction += _value.size();
+		if (m_bytesWrittenSinceEviction > m_maxSize / 16)
+		{
+			m_bytesWrittenSinceEviction = 0;
+			needsEviction = true;
+		}
+	}
+	if (needsEviction)
+		evict();
+}
+
+fs::path DiskCache::entryPath(h256 const& _key) const
+{
+	return m_directory / (keccak256(_key.asBytes() + asBytes(m_version)).hex() + c_entryExtension);
+}
+
+std::string DiskCache::entryHeader(h256 const& _key) const
+{
+	return m_version + "\n" + _key.hex() + "\n";
+}
+
+void DiskCache::evict()
+{
+	std::vector<std::tuple<std::time_t, std::uintmax_t, fs::path>> entries;
+	std::uintmax_t totalSize = 0;
+
+	boost::system::error_code error;
+	for (fs::directory_iterator it(m_directory, error), end; !error && it != end; it.increment(error))
+	{
+		fs::path const& path = it->path();
+		if (path.extension() != c_entryExtension)
+			continue;
+
+		boost::system::error_code entryError;
+		std::uintmax_t size = fs::file_size(path, entryError);
+		std::time_t lastUsed = fs::last_write_time(path, entryError);
+		// Removed by another process in the meantime.
+		if (entryError)
+			continue;
+
+		entries.emplace_back(lastUsed, size, path);
+		totalSize += size;
+	}
+
+	if (totalSize <= m_maxSize)
+		return;
+
+	std::sort(entries.begin(), entries.end());
+	for (auto const& [lastUsed, size, path]: entries)
+	{
+		if (totalSize <= m_maxSize)
+			break;
+		boost::system::error_code ignored;
+		fs::remove(path, ignored);
+		totalSize -= size;
+	}
+}
@@ -0,0 +1,78 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Content-addressed cache of strings stored in a directory on disk.
+ */
+
+#pragma once
+
+#include <libsolutil/FixedHash.h>
+
+#include <boost/filesystem.hpp>
+
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+
+namespace solidity::util
+{
+
+/**
+ * Persistent cache mapping hashes to strings, stored as one file per entry in a directory.
+ *
+ * Entries are additionally keyed by a version string so that caches populated by different
+ * versions of the compiler can share a directory without interfering.
+ *
+ * The cache can be used concurrently from multiple threads and multiple processes. Entries are
+ * written to a temporary file first and then renamed, so readers never see partially written
+ * entries. Any entry that cannot be read is treated as missing. I/O errors are never reported.
+ *
+ * When the total size of the entries exceeds the given limit, the least recently used ones
+ * are removed.
+ */
+class DiskCache
+{
+public:
+	DiskCache(boost::filesystem::path _directory, std::string _version, std::uintmax_t _maxSize);
+
+	/// @returns the value stored under @a _key or nullopt if there is none.
+	std::optional<std::string> load(h256 const& _key) const;
+	/// Stores @a _value under @a _key, replacing any previous value.
+	void store(h256 const& _key, std::string const& _value);
+
+	boost::filesystem::path const& directory() const { return m_directory; }
+
+private:
+	boost::filesystem::path entryPath(h256 const& _key) const;
+	std::string entryHeader(h256 const& _key) const;
+	/// Removes least recently used entries until the size of the cache is below the limit.
+	void evict();
+
+	boost::filesystem::path m_directory;
+	std::string m_version;
+	std::uintmax_t m_maxSize = 0;
+
+	/// Guards @a m_bytesWrittenSinceEviction.
+	std::mutex m_mutex;
+	/// Number of bytes stored since the cache was last checked for its size. Used to avoid
+	/// scanning the whole directory after every write.
+	std::uintmax_t m_bytesWrittenSinceEviction = 0;
+};
+
+}
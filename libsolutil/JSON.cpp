@@ -23,6 +23,7 @@
 #include <libsolutil/JSON.h>
 
 #include <libsolutil/CommonData.h>
+#include <libsolutil/Exceptions.h>
 
 #include <boost/algorithm/string.hpp>
 
@@ -102,6 +103,10 @@ std::string escapeNewlinesAndTabsWithinStringLiterals(std::string const& _json)
 	return fixed.str();
 }
 
+/// Tag 55799 ("self-described CBOR") that jsonPrintBinary() puts in front of every document.
+/// Its first byte, 0xd9, never starts a JSON text.
+constexpr std::string_view c_selfDescribedCBOR{"\xd9\xd9\xf7", 3};
+
 } // end anonymous namespace
 
 Json removeNullMembers(Json _json)
@@ -138,14 +143,139 @@ std::string jsonPrint(Json const& _input, JsonFormat const& _format)
 	return dumped;
 }
 
+void JsonStreamWriter::beginObject()
+{
+	beginValue();
+	m_output << '{';
+	m_scopes.push_back({true, true, std::nullopt});
+}
+
+void JsonStreamWriter::beginArray()
+{
+	beginValue();
+	m_output << '[';
+	m_scopes.push_back({false, true, std::nullopt});
+}
+
+void JsonStreamWriter::endObject()
+{
+	endScope(true);
+}
+
+void JsonStreamWriter::endArray()
+{
+	endScope(false);
+}
+
+void JsonStreamWriter::key(std::string const& _key)
+{
+	assertThrow(!m_scopes.empty() && m_scopes.back().isObject && !m_keyWritten, Exception, "Unexpected JSON object key.");
+	Scope& scope = m_scopes.back();
+	assertThrow(!scope.lastKey || *scope.lastKey < _key, Exception, "JSON object keys have to be written in sorted order.");
+	std::string const keyText = Json(_key).dump(-1, ' ', true);
+
+	if (!scope.empty)
+		m_output << ',';
+	if (m_format.format == JsonFormat::Pretty)
+		m_output << '\n' << indentation(depth());
+	m_output << keyText << ((m_format.format == JsonFormat::Pretty) ? ": " : ":");
+
+	scope.empty = false;
+	scope.lastKey = _key;
+	m_keyWritten = true;
+}
+
+void JsonStreamWriter::value(Json const& _value)
+{
+	std::string const text = print(_value);
+	beginValue();
+	m_output << text;
+	m_finished = m_scopes.empty();
+}
+
+void JsonStreamWriter::member(std::string const& _key, Json const& _value)
+{
+	std::string const text = print(_value);
+	key(_key);
+	beginValue();
+	m_output << text;
+}
+
+void JsonStreamWriter::printedValue(std::string const& _text)
+{
+	beginValue();
+	m_output << _text;
+	m_finished = m_scopes.empty();
+}
+
+void JsonStreamWriter::beginValue()
+{
+	assertThrow(!m_finished, Exception, "JSON document already complete.");
+	if (m_scopes.empty())
+		return;
+
+	Scope& scope = m_scopes.back();
+	if (scope.isObject)
+	{
+		assertThrow(m_keyWritten, Exception, "JSON object member without key.");
+		m_keyWritten = false;
+		return;
+	}
+
+	if (!scope.empty)
+		m_output << ',';
+	if (m_format.format == JsonFormat::Pretty)
+		m_output << '\n' << indentation(depth());
+	scope.empty = false;
+}
+
+void JsonStreamWriter::endScope(bool _isObject)
+{
+	assertThrow(
+		!m_scopes.empty() && m_scopes.back().isObject == _isObject && !m_keyWritten,
+		Exception,
+		"Unbalanced JSON object or array."
+	);
+
+	if (!m_scopes.back().empty && m_format.format == JsonFormat::Pretty)
+		m_output << '\n' << indentation(depth() - 1);
+	m_output << (_isObject ? '}' : ']');
+	m_scopes.pop_back();
+	m_finished = m_scopes.empty();
+}
+
+std::string JsonStreamWriter::print(Json const& _value) const
+{
+	std::string text = jsonPrint(_value, m_format);
+	if (m_format.format == JsonFormat::Pretty && depth() > 0)
+		// String values cannot contain raw line breaks, so all of them belong to the layout.
+		boost::replace_all(text, "\n", "\n" + indentation(depth()));
+	return text;
+}
+
+std::string JsonStreamWriter::indentation(size_t _depth) const
+{
+	return std::string(_depth * m_format.indent, ' ');
+}
+
 bool jsonParseStrict(std::string const& _input, Json& _json, std::string* _errs /* = nullptr */)
+{
+	return jsonParseStrict(_input, _json, nullptr, _errs);
+}
+
+bool jsonParseStrict(
+	std::string const& _input,
+	Json& _json,
+	Json::parser_callback_t const& _callback,
+	std::string* _errs /* = nullptr */
+)
 {
 	try
 	{
 		_json = Json::parse(
 			// TODO: remove this in the next breaking release?
 			escapeNewlinesAndTabsWithinStringLiterals(_input),
-			/* callback */ nullptr,
+			_callback,
 			/* allow exceptions */ true,
 			/* ignore_comments */true
 		);
@@ -168,6 +298,45 @@ bool jsonParseStrict(std::string const& _input, Json& _json, std::string* _errs
 	}
 }
 
+std::string jsonPrintBinary(Json const& _input)
+{
+	std::string output{c_selfDescribedCBOR};
+	Json::to_cbor(_input, output);
+	return output;
+}
+
+bool isBinaryJson(std::string_view _input)
+{
+	return _input.substr(0, c_selfDescribedCBOR.size()) == c_selfDescribedCBOR;
+}
+
+bool jsonParseBinary(std::string const& _input, Json& _json, std::string* _errs /* = nullptr */)
+{
+	if (!isBinaryJson(_input))
+	{
+		if (_errs)
+			*_errs = "Input is not a self-described CBOR document.";
+		return false;
+	}
+	try
+	{
+		_json = Json::from_cbor(
+			_input.begin() + static_cast<std::ptrdiff_t>(c_selfDescribedCBOR.size()),
+			_input.end(),
+			true, // strict
+			true, // allow_exceptions
+			Json::cbor_tag_handler_t::error
+		);
+		return true;
+	}
+	catch (Json::exception const& e)
+	{
+		if (_errs)
+			*_errs = removeNlohmannInternalErrorIdentifier(e.what());
+		return false;
+	}
+}
+
 std::optional<Json> jsonValueByPath(Json const& _node, std::string_view _jsonPath)
 {
 	if (!_node.is_object() || _jsonPath.empty())
@@ -26,10 +26,12 @@
 #include <libsolutil/Assertions.h>
 #include <nlohmann/json.hpp>
 
+#include <ostream>
 #include <string>
 #include <string_view>
 #include <optional>
 #include <limits>
+#include <vector>
 
 namespace solidity
 {
@@ -71,6 +73,69 @@ std::string jsonCompactPrint(Json const& _input);
 /// Serialise the JSON object (@a _input) using specified format (@a _format)
 std::string jsonPrint(Json const& _input, JsonFormat const& _format);
 
+/// Serialises a JSON document piece by piece to an output stream, so that large documents never
+/// have to be kept in memory as a whole. The text is identical to what jsonPrint() produces for the
+/// complete document in the same format, provided that the members of each object are written in
+/// sorted order (which is enforced).
+class JsonStreamWriter
+{
+public:
+	/// @param _depth number of objects and arrays the written value is going to be nested in,
+	/// which determines its indentation (see printedValue()).
+	JsonStreamWriter(std::ostream& _output, JsonFormat const& _format, size_t _depth = 0):
+		m_output(_output),
+		m_format(_format),
+		m_baseDepth(_depth)
+	{}
+
+	/// Starts an object or an array as the next value.
+	void beginObject();
+	void beginArray();
+	/// Closes the innermost object or array.
+	void endObject();
+	void endArray();
+	/// Writes the key of the next member of the current object.
+	void key(std::string const& _key);
+	/// Writes a complete value.
+	void value(Json const& _value);
+	/// Writes a complete member of the current object. Nothing is written if serialising
+	/// @a _value fails.
+	void member(std::string const& _key, Json const& _value);
+	/// Writes a complete value that has been written by a writer with the same format, constructed
+	/// with the current depth of this writer. This allows parts of a document to be produced
+	/// separately and only be added once they are complete.
+	void printedValue(std::string const& _text);
+
+	/// @returns the number of objects and arrays that are currently open, including those the
+	/// written value is nested in.
+	size_t depth() const { return m_baseDepth + m_scopes.size(); }
+	/// @returns true if the top-level value has been written completely.
+	bool finished() const { return m_finished; }
+	JsonFormat const& format() const { return m_format; }
+
+private:
+	struct Scope
+	{
+		bool isObject = false;
+		bool empty = true;
+		std::optional<std::string> lastKey;
+	};
+
+	/// Writes whatever has to precede the next value in the current scope.
+	void beginValue();
+	void endScope(bool _isObject);
+	/// @returns @a _value serialised for the current nesting level.
+	std::string print(Json const& _value) const;
+	std::string indentation(size_t _depth) const;
+
+	std::ostream& m_output;
+	JsonFormat m_format;
+	size_t m_baseDepth = 0;
+	std::vector<Scope> m_scopes;
+	bool m_keyWritten = false;
+	bool m_finished = false;
+};
+
 /// Parse a JSON string (@a _input) with enabled strict-mode and writes resulting JSON object to (@a _json)
 /// \param _input JSON input string
 /// \param _json [out] resulting JSON object
@@ -78,6 +143,31 @@ std::string jsonPrint(Json const& _input, JsonFormat const& _format);
 /// \return \c true if the document was successfully parsed, \c false if an error occurred.
 bool jsonParseStrict(std::string const& _input, Json& _json, std::string* _errs = nullptr);
 
+/// Same as the above, but calls @a _callback for each parsing event, which can drop values from the
+/// resulting document (see nlohmann::json::parser_callback_t). This allows large documents to be
+/// processed piece by piece without keeping them in memory as a whole.
+bool jsonParseStrict(
+	std::string const& _input,
+	Json& _json,
+	Json::parser_callback_t const& _callback,
+	std::string* _errs = nullptr
+);
+
+/// Serialise the JSON value (@a _input) into CBOR (RFC 8949), a binary encoding of the same data.
+/// It is only a more compact encoding: it needs no quotes, separators or escapes, but repeated
+/// member names and strings are still stored every time they occur.
+/// The document starts with the self-described CBOR tag, which never starts a JSON text, so both
+/// can be accepted in the same place (see isBinaryJson()).
+std::string jsonPrintBinary(Json const& _input);
+
+/// @returns true if @a _input starts with the self-described CBOR tag written by jsonPrintBinary().
+bool isBinaryJson(std::string_view _input);
+
+/// Parse a document produced by jsonPrintBinary() (@a _input) and writes resulting JSON value to (@a _json)
+/// \param _errs [out] Formatted error messages
+/// \return \c true if the document was successfully parsed, \c false if it is malformed.
+bool jsonParseBinary(std::string const& _input, Json& _json, std::string* _errs = nullptr);
+
 /// Retrieves the value specified by @p _jsonPath by from a series of nested JSON dictionaries.
 /// @param _jsonPath A dot-separated series of dictionary keys.
 /// @param _node The node representing the start of the path.
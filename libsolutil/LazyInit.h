@@ -65,6 +65,12 @@ public:
 		_other.m_value.reset();
 	}
 
+	/// Drops the stored value, so that the next call to "init" computes it again.
+	void reset() const
+	{
+		m_value.reset();
+	}
+
 	template<typename F>
 	value_type& init(F&& _fun)
 	{
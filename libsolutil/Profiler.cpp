@@ -21,78 +21,364 @@
 #include <fmt/format.h>
 
 #include <algorithm>
+#include <atomic>
 #include <iostream>
-#include <vector>
+#include <mutex>
+#include <tuple>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
 
 using namespace std::chrono;
 using namespace solidity;
+using namespace solidity::util;
 
-#ifdef PROFILE_OPTIMIZER_STEPS
+namespace
+{
 
-util::Profiler::Probe::Probe(std::string _scopeName):
-	m_scopeName(std::move(_scopeName)),
-	m_startTime(steady_clock::now())
+/// Innermost current session of the thread.
+thread_local Profiler::Session* t_session = nullptr;
+/// Innermost active probe of the thread.
+thread_local Profiler::Probe* t_innermostProbe = nullptr;
+
+std::atomic<bool> g_countingAllocations{false};
+/// Total numbers of bytes allocated and freed by the thread.
+thread_local uint64_t t_allocatedBytes = 0;
+thread_local uint64_t t_freedBytes = 0;
+
+#if defined(__unix__) || defined(__APPLE__)
+bool constexpr c_peakMemoryKnown = true;
+#else
+bool constexpr c_peakMemoryKnown = false;
+#endif
+
+/// @returns the peak resident set size of the process in bytes, or zero if it is not known.
+uint64_t peakMemory()
+{
+#if defined(__unix__) || defined(__APPLE__)
+	rusage usage{};
+	if (getrusage(RUSAGE_SELF, &usage) != 0)
+		return 0;
+#if defined(__APPLE__)
+	return static_cast<uint64_t>(usage.ru_maxrss);
+#else
+	return static_cast<uint64_t>(usage.ru_maxrss) * 1024;
+#endif
+#else
+	return 0;
+#endif
+}
+
+/// Adds the memory metrics that are available to @a _json.
+template <typename T>
+void addMemoryMetrics(Json& _json, T const& _metrics)
+{
+	if (g_countingAllocations.load(std::memory_order_relaxed))
+	{
+		_json["allocatedBytes"] = _metrics.allocatedBytes;
+		_json["retainedBytes"] = _metrics.retainedBytes;
+	}
+	if (c_peakMemoryKnown)
+		_json["peakMemoryGrowth"] = _metrics.peakMemoryGrowth;
+}
+
+}
+
+void Profiler::enableAllocationCounting() noexcept
+{
+	g_countingAllocations = true;
+}
+
+bool Profiler::countsAllocations() noexcept
+{
+	return t_session;
+}
+
+void Profiler::recordAllocation(size_t _size) noexcept
+{
+	t_allocatedBytes += _size;
+}
+
+void Profiler::recordDeallocation(size_t _size) noexcept
 {
+	t_freedBytes += _size;
 }
 
-util::Profiler::Probe::~Probe()
+Profiler::Probe::Probe(std::string_view _category, std::string_view _name, std::string_view _subject):
+	m_session(t_session)
 {
+	if (!m_session)
+		return;
+
+	m_category = _category;
+	m_name = _name;
+	m_outer = t_innermostProbe;
+	if (!_subject.empty())
+		m_subject = _subject;
+	else if (m_outer)
+		m_subject = m_outer->m_subject;
+	for (Probe const* outer = m_outer; outer; outer = outer->m_outer)
+	{
+		if (outer->m_category == m_category && outer->m_name == m_name)
+			m_nested = true;
+		if (outer->m_subject == m_subject)
+			m_outermostOfSubject = false;
+	}
+	t_innermostProbe = this;
+	m_peakMemoryAtStart = peakMemory();
+	m_allocatedBytesAtStart = t_allocatedBytes;
+	m_freedBytesAtStart = t_freedBytes;
+	m_startTime = steady_clock::now();
+}
+
+Profiler::Probe::~Probe()
+{
+	if (!m_session)
+		return;
+
 	steady_clock::time_point endTime = steady_clock::now();
+	uint64_t allocatedBytes = t_allocatedBytes - m_allocatedBytesAtStart;
+	uint64_t freedBytes = t_freedBytes - m_freedBytesAtStart;
+	uint64_t peakMemoryAtEnd = peakMemory();
+	t_innermostProbe = m_outer;
+	if (m_outer)
+		m_outer->m_nestedDuration += endTime - m_startTime;
+
+	for (Session* session = m_session; session; session = session->m_outer)
+	{
+		steady_clock::time_point startTime = std::max(m_startTime, session->m_startTime);
+		microseconds duration = duration_cast<microseconds>(endTime - startTime);
+		microseconds selfDuration = std::min(duration, duration_cast<microseconds>(endTime - m_startTime - m_nestedDuration));
+
+		std::lock_guard<std::mutex> lock(session->m_mutex);
+		auto [thread, inserted] = session->m_threads.try_emplace(std::this_thread::get_id(), session->m_threads.size());
+		session->m_events.push_back(Session::Event{
+			m_category,
+			m_name,
+			m_subject,
+			startTime,
+			duration,
+			selfDuration,
+			thread->second,
+			m_nested,
+			m_outermostOfSubject,
+			allocatedBytes,
+			static_cast<int64_t>(allocatedBytes) - static_cast<int64_t>(freedBytes),
+			peakMemoryAtEnd - std::min(m_peakMemoryAtStart, peakMemoryAtEnd)
+		});
+	}
+}
+
+Profiler::Session::Scope::Scope(Session* _session):
+	m_previous(t_session)
+{
+	t_session = _session;
+}
+
+Profiler::Session::Scope::~Scope()
+{
+	t_session = m_previous;
+}
+
+Profiler::Session::Session():
+	m_outer(t_session),
+	m_startTime(steady_clock::now())
+{
+	t_session = this;
+}
 
-	auto [metricsIt, inserted] = Profiler::singleton().m_metrics.try_emplace(m_scopeName, Metrics{0us, 0});
-	metricsIt->second.durationInMicroseconds += duration_cast<microseconds>(endTime - m_startTime);
-	++metricsIt->second.callCount;
+Profiler::Session::~Session()
+{
+	t_session = m_outer;
+}
+
+Profiler::Session* Profiler::Session::current()
+{
+	return t_session;
 }
 
-util::Profiler::~Profiler()
+Json Profiler::Session::toJson() const
 {
-	outputPerformanceMetrics();
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	std::vector<Event const*> events;
+	for (Event const& event: m_events)
+		events.push_back(&event);
+	std::stable_sort(events.begin(), events.end(), [](Event const* _lhs, Event const* _rhs) {
+		return _lhs->startTime < _rhs->startTime;
+	});
+
+	Json traceEvents = Json::array();
+	for (Event const* event: events)
+	{
+		Json traceEvent{
+			{"name", event->name},
+			{"cat", event->category},
+			{"ph", "X"},
+			{"ts", duration_cast<microseconds>(event->startTime - m_startTime).count()},
+			{"dur", event->duration.count()},
+			{"pid", 0},
+			{"tid", event->thread}
+		};
+		if (!event->subject.empty())
+			traceEvent["args"]["subject"] = event->subject;
+		if (g_countingAllocations.load(std::memory_order_relaxed))
+		{
+			traceEvent["args"]["allocatedBytes"] = event->allocatedBytes;
+			traceEvent["args"]["retainedBytes"] = event->retainedBytes;
+		}
+		if (event->peakMemoryGrowth > 0)
+			traceEvent["args"]["peakMemoryGrowth"] = event->peakMemoryGrowth;
+		traceEvents.emplace_back(std::move(traceEvent));
+	}
+
+	Json summaryJson = Json::array();
+	for (Metrics const& metrics: summary())
+	{
+		Json metricsJson{
+			{"category", metrics.category},
+			{"name", metrics.name},
+			{"calls", metrics.callCount},
+			{"microseconds", metrics.duration.count()},
+			{"selfMicroseconds", metrics.selfDuration.count()}
+		};
+		addMemoryMetrics(metricsJson, metrics);
+		summaryJson.emplace_back(std::move(metricsJson));
+	}
+
+	Json subjectsJson = Json::array();
+	for (auto const& [subject, metrics]: subjectSummary())
+	{
+		Json metricsJson{
+			{"subject", subject},
+			{"microseconds", metrics.duration.count()}
+		};
+		addMemoryMetrics(metricsJson, metrics);
+		subjectsJson.emplace_back(std::move(metricsJson));
+	}
+
+	Json profile{
+		{"traceEvents", std::move(traceEvents)},
+		{"displayTimeUnit", "ms"},
+		{"summary", std::move(summaryJson)},
+		{"subjects", std::move(subjectsJson)}
+	};
+	if (c_peakMemoryKnown)
+		profile["peakMemory"] = peakMemory();
+	return profile;
 }
 
-util::Profiler& util::Profiler::singleton()
+void Profiler::Session::Metrics::add(Event const& _event)
 {
-	static Profiler profiler;
-	return profiler;
+	duration += _event.duration;
+	allocatedBytes += _event.allocatedBytes;
+	retainedBytes += _event.retainedBytes;
+	peakMemoryGrowth += _event.peakMemoryGrowth;
 }
 
-void util::Profiler::outputPerformanceMetrics()
+std::vector<Profiler::Session::Metrics> Profiler::Session::summary() const
 {
-	std::vector<std::pair<std::string, Metrics>> sortedMetrics(m_metrics.begin(), m_metrics.end());
-	std::sort(
+	std::map<std::pair<std::string, std::string>, Metrics> metricsByName;
+	for (Event const& event: m_events)
+	{
+		Metrics& metrics = metricsByName[{event.category, event.name}];
+		metrics.category = event.category;
+		metrics.name = event.name;
+		if (!event.nested)
+			metrics.add(event);
+		metrics.selfDuration += event.selfDuration;
+		++metrics.callCount;
+	}
+
+	std::vector<Metrics> sortedMetrics;
+	for (auto&& [key, metrics]: metricsByName)
+		sortedMetrics.push_back(std::move(metrics));
+	std::stable_sort(
 		sortedMetrics.begin(),
 		sortedMetrics.end(),
-		[](std::pair<std::string, Metrics> const& _lhs, std::pair<std::string, Metrics> const& _rhs) -> bool
+		[](Metrics const& _lhs, Metrics const& _rhs) { return _lhs.duration > _rhs.duration; }
+	);
+	return sortedMetrics;
+}
+
+std::map<std::string, Profiler::Session::Metrics> Profiler::Session::subjectSummary() const
+{
+	std::map<std::string, Metrics> metricsBySubject;
+	for (Event const& event: m_events)
+		if (!event.subject.empty() && event.outermostOfSubject)
 		{
-			return _lhs.second.durationInMicroseconds < _rhs.second.durationInMicroseconds;
+			Metrics& metrics = metricsBySubject[event.subject];
+			metrics.add(event);
+			++metrics.callCount;
 		}
+	return metricsBySubject;
+}
+
+std::string Profiler::Session::summaryTable() const
+{
+	std::vector<Metrics> sortedMetrics;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		sortedMetrics = summary();
+	}
+	std::stable_sort(
+		sortedMetrics.begin(),
+		sortedMetrics.end(),
+		[](Metrics const& _lhs, Metrics const& _rhs) { return _lhs.selfDuration > _rhs.selfDuration; }
 	);
 
-	std::chrono::microseconds totalDurationInMicroseconds = 0us;
+	// Only self times add up, the times including nested probes overlap.
+	microseconds totalSelfDurationInMicroseconds = 0us;
 	size_t totalCallCount = 0;
-	for (auto&& [scopeName, scopeMetrics]: sortedMetrics)
+	for (Metrics const& metrics: sortedMetrics)
 	{
-		totalDurationInMicroseconds += scopeMetrics.durationInMicroseconds;
-		totalCallCount += scopeMetrics.callCount;
+		totalSelfDurationInMicroseconds += metrics.selfDuration;
+		totalCallCount += metrics.callCount;
 	}
 
-	std::cerr << "PERFORMANCE METRICS FOR PROFILED SCOPES\n\n";
-	std::cerr << "| Time % | Time       | Calls   | Scope                          |\n";
-	std::cerr << "|-------:|-----------:|--------:|--------------------------------|\n";
+	std::string table = "PERFORMANCE METRICS FOR PROFILED SCOPES\n\n";
+	table += "| Self % | Self time  | Time       | Calls   | Scope                          |\n";
+	table += "|-------:|-----------:|-----------:|--------:|--------------------------------|\n";
 
-	double totalDurationInSeconds = duration_cast<duration<double>>(totalDurationInMicroseconds).count();
-	for (auto&& [scopeName, scopeMetrics]: sortedMetrics)
+	auto const seconds = [](microseconds _duration) { return duration_cast<duration<double>>(_duration).count(); };
+	double totalSelfDurationInSeconds = seconds(totalSelfDurationInMicroseconds);
+	for (Metrics const& metrics: sortedMetrics)
 	{
-		double durationInSeconds = duration_cast<duration<double>>(scopeMetrics.durationInMicroseconds).count();
-		double percentage = 100.0 * durationInSeconds / totalDurationInSeconds;
-		std::cerr << fmt::format(
-			"| {:5.1f}% | {:8.3f} s | {:7} | {:30} |\n",
+		double selfDurationInSeconds = seconds(metrics.selfDuration);
+		double percentage = totalSelfDurationInSeconds > 0 ? 100.0 * selfDurationInSeconds / totalSelfDurationInSeconds : 0.0;
+		table += fmt::format(
+			"| {:5.1f}% | {:8.3f} s | {:8.3f} s | {:7} | {:30} |\n",
 			percentage,
-			durationInSeconds,
-			scopeMetrics.callCount,
-			scopeName
+			selfDurationInSeconds,
+			seconds(metrics.duration),
+			metrics.callCount,
+			metrics.name
 		);
 	}
-	std::cerr << fmt::format("| {:5.1f}% | {:8.3f} s | {:7} | {:30} |\n", 100.0, totalDurationInSeconds, totalCallCount, "**TOTAL**");
+	table += fmt::format(
+		"| {:5.1f}% | {:8.3f} s | {:>10} | {:7} | {:30} |\n",
+		100.0,
+		totalSelfDurationInSeconds,
+		"",
+		totalCallCount,
+		"**TOTAL**"
+	);
+	return table;
+}
+
+#ifdef PROFILE_OPTIMIZER_STEPS
+
+namespace
+{
+
+/// Session covering the whole run of the main thread and the tasks it submits to thread pools.
+struct ProgramSession
+{
+	~ProgramSession() { std::cerr << session.summaryTable(); }
+	Profiler::Session session;
+} g_programSession;
+
 }
 
 #endif
@@ -18,64 +18,172 @@
 
 #pragma once
 
+#include <libsolutil/JSON.h>
+
 #include <chrono>
+#include <cstdint>
 #include <map>
-#include <optional>
+#include <mutex>
 #include <string>
-
-#ifdef PROFILE_OPTIMIZER_STEPS
-#define PROFILER_PROBE(_scopeName, _variable) solidity::util::Profiler::Probe _variable(_scopeName);
-#else
-#define PROFILER_PROBE(_scopeName, _variable) void(0);
-#endif
+#include <string_view>
+#include <thread>
+#include <vector>
 
 namespace solidity::util
 {
 
-#ifdef PROFILE_OPTIMIZER_STEPS
-
-/// Simpler profiler class that gathers metrics during program execution and prints them out on exit.
+/// Low-overhead instrumentation of the stages of the compilation.
 ///
 /// To gather metrics, create a Probe instance and let it live until the end of the scope.
-/// The probe will register its creation and destruction time and store the results in the profiler
-/// singleton.
+/// Probes only record anything while their thread has a current Session. Otherwise creating one
+/// costs no more than reading a thread-local pointer. A session is current for the thread that
+/// created it and for the tasks that thread submits to a ThreadPool, so concurrent compilations
+/// in different threads do not record each other's probes.
+///
+/// A probe can name its subject, e.g. the contract or the Yul object being processed. Probes that
+/// do not name one take it over from the innermost enclosing probe of the same thread.
+/// The time of probes nested in a probe of the same category and name, e.g. in recursive
+/// functions, is only counted once in the summary. The self time of a probe excludes the time of
+/// the probes nested in it on the same thread, so the self times of all probes never overlap.
 ///
-/// Use the PROFILER_PROBE macro to create probes conditionally, in a way that will not affect performance
-/// unless profiling is enabled at compilation time via PROFILE_OPTIMIZER_STEPS CMake option.
+/// Probes also measure the growth of the peak resident set size of the process and, if the program
+/// replaces the global allocation functions to report to recordAllocation and recordDeallocation,
+/// the number of bytes allocated and retained by their thread while they were active.
+/// Memory released by another thread than the one that allocated it is not subtracted from the
+/// retained bytes, so they do not show the memory kept by a stage or subject if its results are
+/// freed by another thread, as is common when compiling with a ThreadPool.
 ///
-/// Scopes are identified by the name supplied to the probe. Using the same name multiple times
-/// will result in metrics for those scopes being aggregated together as if they were the same scope.
+/// If the PROFILE_OPTIMIZER_STEPS CMake option is enabled, a session covers the whole run of the
+/// main thread and a summary is printed to standard error output on exit.
 class Profiler
 {
 public:
+	class Session;
+
+	/// Declares that the program reports all heap allocations to recordAllocation and recordDeallocation.
+	static void enableAllocationCounting() noexcept;
+	/// @returns true if the calling thread has a current session, i.e. if its allocations
+	/// have to be reported to recordAllocation and recordDeallocation.
+	static bool countsAllocations() noexcept;
+	static void recordAllocation(size_t _size) noexcept;
+	static void recordDeallocation(size_t _size) noexcept;
+
 	class Probe
 	{
 	public:
-		Probe(std::string _scopeName);
+		explicit Probe(std::string_view _category, std::string_view _name, std::string_view _subject = {});
 		~Probe();
 
+		Probe(Probe const&) = delete;
+		Probe& operator=(Probe const&) = delete;
+
 	private:
-		std::string m_scopeName;
+		/// Session current for the thread when the probe was created, nullptr if the probe is inactive.
+		Session* m_session = nullptr;
+		std::string m_category;
+		std::string m_name;
+		std::string m_subject;
+		/// Innermost enclosing active probe of the same thread.
+		Probe* m_outer = nullptr;
+		/// True if an enclosing probe has the same category and name.
+		bool m_nested = false;
+		/// True if no enclosing probe has the same subject.
+		bool m_outermostOfSubject = true;
 		std::chrono::steady_clock::time_point m_startTime;
+		/// Time spent in the probes directly nested in this one.
+		std::chrono::steady_clock::duration m_nestedDuration{0};
+		uint64_t m_allocatedBytesAtStart = 0;
+		uint64_t m_freedBytesAtStart = 0;
+		uint64_t m_peakMemoryAtStart = 0;
 	};
 
-	static Profiler& singleton();
-
-private:
-	~Profiler();
-
-	struct Metrics
+	/// Records the probes of the threads it is current for while it is alive.
+	class Session
 	{
-		std::chrono::microseconds durationInMicroseconds;
-		size_t callCount;
-	};
-
-	/// Summarizes gathered metric and prints a report to standard error output.
-	void outputPerformanceMetrics();
+	public:
+		/// Makes a session current for the calling thread for the lifetime of the scope.
+		/// ThreadPool uses this to run each task in the session of the thread that submitted it.
+		class Scope
+		{
+		public:
+			explicit Scope(Session* _session);
+			~Scope();
+
+			Scope(Scope const&) = delete;
+			Scope& operator=(Scope const&) = delete;
+
+		private:
+			Session* m_previous;
+		};
+
+		/// Makes the session current for the calling thread until it is destroyed, which has to
+		/// happen on the same thread and before any tasks started in the session finish.
+		/// Sessions of the same thread nest, probes are recorded in all of them.
+		Session();
+		~Session();
+
+		Session(Session const&) = delete;
+		Session& operator=(Session const&) = delete;
+
+		/// @returns the innermost session of the calling thread or nullptr.
+		static Session* current();
+
+		/// @returns the recorded probes in Chrome's trace event format, which can be viewed in
+		/// chrome://tracing or Perfetto, together with a summary of the time and memory spent per
+		/// probe name, sorted by decreasing time, and per subject.
+		Json toJson() const;
+		/// @returns the summary of the time spent per probe name as a table in Markdown format,
+		/// sorted by decreasing self time. The percentages refer to the self time of all probes.
+		std::string summaryTable() const;
 
-	std::map<std::string, Metrics> m_metrics;
+	private:
+		friend class Probe;
+
+		struct Event
+		{
+			std::string category;
+			std::string name;
+			std::string subject;
+			std::chrono::steady_clock::time_point startTime;
+			std::chrono::microseconds duration;
+			std::chrono::microseconds selfDuration;
+			size_t thread;
+			bool nested;
+			bool outermostOfSubject;
+			uint64_t allocatedBytes;
+			int64_t retainedBytes;
+			uint64_t peakMemoryGrowth;
+		};
+		struct Metrics
+		{
+			std::string category;
+			std::string name;
+			std::chrono::microseconds duration{0};
+			std::chrono::microseconds selfDuration{0};
+			size_t callCount = 0;
+			uint64_t allocatedBytes = 0;
+			int64_t retainedBytes = 0;
+			uint64_t peakMemoryGrowth = 0;
+
+			void add(Event const& _event);
+		};
+
+		/// @returns the metrics per probe name and category, sorted by decreasing time.
+		/// Requires the mutex to be locked.
+		std::vector<Metrics> summary() const;
+		/// @returns the metrics per subject, excluding probes nested in a probe of the same subject.
+		/// Requires the mutex to be locked.
+		std::map<std::string, Metrics> subjectSummary() const;
+
+		/// Session that was current for the thread before this one.
+		Session* m_outer;
+		std::chrono::steady_clock::time_point m_startTime;
+		/// Protects the events, which are recorded by all threads the session is current for.
+		mutable std::mutex m_mutex;
+		std::vector<Event> m_events;
+		/// Numbers of the threads in the order in which they finished their first probe.
+		std::map<std::thread::id, size_t> m_threads;
+	};
 };
 
-#endif
-
 }
@@ -0,0 +1,98 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolutil/ThreadPool.h>
+
+#include <libsolutil/Profiler.h>
+
+#include <algorithm>
+
+using namespace solidity::util;
+
+ThreadPool::ThreadPool(size_t _threadCount)
+{
+	size_t const threadCount = std::max<size_t>(_threadCount, 1);
+	m_workers.reserve(threadCount);
+	for (size_t i = 0; i < threadCount; ++i)
+		m_workers.emplace_back([this]() { work(); });
+}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_stopping = true;
+	}
+	m_condition.notify_all();
+	for (std::thread& worker: m_workers)
+		worker.join();
+}
+
+size_t ThreadPool::hardwareConcurrency()
+{
+	return std::max<size_t>(std::thread::hardware_concurrency(), 1);
+}
+
+size_t ThreadPool::maxWorkers()
+{
+	return 4 * hardwareConcurrency();
+}
+
+std::function<void()> ThreadPool::withCallerContext(std::function<void()> _task)
+{
+	Profiler::Session* session = Profiler::Session::current();
+	if (!session)
+		return _task;
+	return [session, task = std::move(_task)]() {
+		Profiler::Session::Scope scope(session);
+		task();
+	};
+}
+
+bool ThreadPool::runPendingTask()
+{
+	std::function<void()> task;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if (m_queue.empty())
+			return false;
+		task = std::move(m_queue.front());
+		m_queue.pop();
+	}
+	task();
+	return true;
+}
+
+void ThreadPool::work()
+{
+	while (true)
+	{
+		std::function<void()> task;
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_condition.wait(lock, [this]() { return m_stopping || !m_queue.empty(); });
+			// Drain the queue even when stopping so that no future is left without a value.
+			if (m_queue.empty())
+				return;
+			task = std::move(m_queue.front());
+			m_queue.pop();
+		}
+		// Exceptions never escape here. packaged_task stores them in the future.
+		task();
+	}
+}
@@ -0,0 +1,119 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Minimal fixed-size pool of worker threads.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace solidity::util
+{
+
+/**
+ * A fixed number of worker threads executing submitted tasks in the order of submission.
+ *
+ * The result of each task (or the exception it threw) is handed back through the future returned
+ * by @a submit(). The pool does not impose any order on task completion, so callers that need
+ * deterministic results must consume the futures in a deterministic order.
+ *
+ * Tasks may submit further tasks and wait for them, but only through @a wait(), which runs queued
+ * tasks on the waiting thread in the meantime. Blocking on a future directly from inside a task
+ * can deadlock once all workers are waiting.
+ *
+ * Tasks run in the profiler session that is current for the submitting thread (see Profiler::Session).
+ *
+ * The destructor waits for all tasks that were already submitted to finish.
+ */
+class ThreadPool
+{
+public:
+	/// Starts @a _threadCount worker threads. At least one thread is always started.
+	explicit ThreadPool(size_t _threadCount);
+	~ThreadPool();
+
+	ThreadPool(ThreadPool const&) = delete;
+	ThreadPool& operator=(ThreadPool const&) = delete;
+
+	/// Queues @a _task for execution on one of the worker threads.
+	/// @returns a future that becomes ready once the task has been executed.
+	template<typename Task>
+	std::future<std::invoke_result_t<std::decay_t<Task>>> submit(Task&& _task)
+	{
+		using Result = std::invoke_result_t<std::decay_t<Task>>;
+
+		// std::function requires a copyable target, hence the shared_ptr.
+		auto packagedTask = std::make_shared<std::packaged_task<Result()>>(std::forward<Task>(_task));
+		std::future<Result> result = packagedTask->get_future();
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_queue.emplace(withCallerContext([packagedTask]() { (*packagedTask)(); }));
+		}
+		m_condition.notify_one();
+		return result;
+	}
+
+	/// Waits until @a _future is ready, executing queued tasks on the calling thread in the meantime.
+	/// Safe to call both from inside and outside of the tasks of this pool.
+	template<typename Result>
+	void wait(std::future<Result> const& _future)
+	{
+		while (_future.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+			// Nothing left to help with. The task is being executed by another thread.
+			if (!runPendingTask())
+				_future.wait();
+	}
+
+	/// @returns the number of worker threads.
+	size_t size() const { return m_workers.size(); }
+
+	/// @returns the number of threads the hardware can run concurrently or 1 if that is unknown.
+	static size_t hardwareConcurrency();
+	/// @returns the largest number of worker threads the compiler uses, a small multiple of
+	/// hardwareConcurrency(). Larger requests are reduced to it, since more threads would only
+	/// compete for the same cores.
+	static size_t maxWorkers();
+
+private:
+	/// @returns @a _task wrapped so that it runs in the context of the calling thread.
+	static std::function<void()> withCallerContext(std::function<void()> _task);
+	void work();
+	/// Executes the oldest queued task, if any, on the calling thread.
+	/// @returns false if the queue was empty.
+	bool runPendingTask();
+
+	std::vector<std::thread> m_workers;
+	std::queue<std::function<void()>> m_queue;
+	std::mutex m_mutex;
+	std::condition_variable m_condition;
+	bool m_stopping = false;
+};
+
+}
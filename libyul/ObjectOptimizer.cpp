@@ -20,17 +20,23 @@
 
 #include <libyul/AsmAnalysisInfo.h>
 #include <libyul/AsmAnalysis.h>
+#include <libyul/AsmParser.h>
 #include <libyul/AsmPrinter.h>
 #include <libyul/AST.h>
 #include <libyul/Exceptions.h>
+#include <libyul/YulString.h>
 #include <libyul/backends/evm/EVMDialect.h>
 #include <libyul/backends/evm/EVMMetrics.h>
 #include <libyul/optimiser/ASTCopier.h>
 #include <libyul/optimiser/Suite.h>
 
+#include <liblangutil/CharStream.h>
 #include <liblangutil/DebugInfoSelection.h>
+#include <liblangutil/ErrorReporter.h>
 
+#include <libsolutil/DiskCache.h>
 #include <libsolutil/Keccak256.h>
+#include <libsolutil/ThreadPool.h>
 
 #include <boost/algorithm/string.hpp>
 
@@ -54,28 +60,48 @@ Dialect const& yul::languageToDialect(Language _language, EVMVersion _version, s
 	util::unreachable();
 }
 
-void ObjectOptimizer::optimize(Object& _object, Settings const& _settings)
+void ObjectOptimizer::optimize(Object& _object, Settings const& _settings, util::ThreadPool* _threadPool)
 {
 	yulAssert(_object.subId == std::numeric_limits<size_t>::max(), "Not a top-level object.");
 
-	optimize(_object, _settings, true /* _isCreation */);
+	optimize(_object, _settings, true /* _isCreation */, _threadPool);
 }
 
-void ObjectOptimizer::optimize(Object& _object, Settings const& _settings, bool _isCreation)
+void ObjectOptimizer::optimize(Object& _object, Settings const& _settings, bool _isCreation, util::ThreadPool* _threadPool)
 {
 	yulAssert(_object.code());
 	yulAssert(_object.debugData);
 
+	std::vector<Object*> subObjects;
 	for (auto& subNode: _object.subObjects)
 		if (auto subObject = dynamic_cast<Object*>(subNode.get()))
-		{
-			bool isCreation = !boost::ends_with(subObject->name, "_deployed");
-			optimize(
-				*subObject,
-				_settings,
-				isCreation
-			);
-		}
+			subObjects.push_back(subObject);
+
+	auto optimizeSubObject = [&](Object& _subObject) {
+		bool isCreation = !boost::ends_with(_subObject.name, "_deployed");
+		optimize(_subObject, _settings, isCreation, _threadPool);
+	};
+
+	// Optimization of an object only depends on the names of its sub-objects, not their code,
+	// so siblings can be optimized independently of each other.
+	if (_threadPool && subObjects.size() > 1)
+	{
+		YulStringRepository& yulStringRepository = YulStringRepository::instance();
+		std::vector<std::future<void>> optimizations;
+		for (Object* subObject: subObjects)
+			optimizations.push_back(_threadPool->submit([subObject, &optimizeSubObject, &yulStringRepository]() {
+				YulStringRepository::Scope yulStringScope(yulStringRepository);
+				optimizeSubObject(*subObject);
+			}));
+		// Wait for all optimizations before rethrowing, so that none of them outlives the object.
+		for (std::future<void> const& optimization: optimizations)
+			_threadPool->wait(optimization);
+		for (std::future<void>& optimization: optimizations)
+			optimization.get();
+	}
+	else
+		for (Object* subObject: subObjects)
+			optimizeSubObject(*subObject);
 
 	Dialect const& dialect = languageToDialect(_settings.language, _settings.evmVersion, _settings.eofVersion);
 	std::unique_ptr<GasMeter> meter;
@@ -83,11 +109,15 @@ void ObjectOptimizer::optimize(Object& _object, Settings const& _settings, bool
 		meter = std::make_unique<GasMeter>(*evmDialect, _isCreation, _settings.expectedExecutionsPerDeployment);
 
 	std::optional<h256> cacheKey = calculateCacheKey(_object.code()->root(), *_object.debugData, _settings, _isCreation);
-	if (cacheKey.has_value() && m_cachedObjects.count(*cacheKey) != 0)
-	{
-		overwriteWithOptimizedObject(*cacheKey, _object);
+	if (cacheKey.has_value() && overwriteWithOptimizedObject(*cacheKey, _object))
+		return;
+	if (
+		cacheKey.has_value() &&
+		m_diskCache &&
+		loadFromDiskCache(*cacheKey, *_object.debugData, dialect) &&
+		overwriteWithOptimizedObject(*cacheKey, _object)
+	)
 		return;
-	}
 
 	OptimiserSuite::run(
 		meter.get(),
@@ -96,25 +126,43 @@ void ObjectOptimizer::optimize(Object& _object, Settings const& _settings, bool
 		_settings.yulOptimiserSteps,
 		_settings.yulOptimiserCleanupSteps,
 		_isCreation ? std::nullopt : std::make_optional(_settings.expectedExecutionsPerDeployment),
-		{}
+		{},
+		_threadPool
 	);
 
 	if (cacheKey.has_value())
+	{
 		storeOptimizedObject(*cacheKey, _object, dialect);
+		if (m_diskCache)
+			m_diskCache->store(
+				*cacheKey,
+				AsmPrinter(dialect, _object.debugData->sourceNames, DebugInfoSelection::All())(_object.code()->root())
+			);
+	}
 }
 
 void ObjectOptimizer::storeOptimizedObject(util::h256 _cacheKey, Object const& _optimizedObject, Dialect const& _dialect)
 {
-	m_cachedObjects[_cacheKey] = CachedObject{
+	CachedObject cachedObject{
 		std::make_shared<Block>(ASTCopier{}.translate(_optimizedObject.code()->root())),
 		&_dialect,
 	};
+
+	// If another thread optimized the same object in the meantime, the results are identical.
+	std::lock_guard<std::mutex> lock(m_cacheMutex);
+	m_cachedObjects[_cacheKey] = std::move(cachedObject);
 }
 
-void ObjectOptimizer::overwriteWithOptimizedObject(util::h256 _cacheKey, Object& _object) const
+bool ObjectOptimizer::overwriteWithOptimizedObject(util::h256 _cacheKey, Object& _object) const
 {
-	yulAssert(m_cachedObjects.count(_cacheKey) != 0);
-	CachedObject const& cachedObject = m_cachedObjects.at(_cacheKey);
+	CachedObject cachedObject{};
+	{
+		std::lock_guard<std::mutex> lock(m_cacheMutex);
+		auto it = m_cachedObjects.find(_cacheKey);
+		if (it == m_cachedObjects.end())
+			return false;
+		cachedObject = it->second;
+	}
 
 	yulAssert(cachedObject.optimizedAST);
 	yulAssert(cachedObject.dialect);
@@ -131,6 +179,40 @@ void ObjectOptimizer::overwriteWithOptimizedObject(util::h256 _cacheKey, Object&
 	);
 
 	// NOTE: Source name index is included in the key so it must be identical. No need to store and restore it.
+	return true;
+}
+
+bool ObjectOptimizer::loadFromDiskCache(util::h256 _cacheKey, ObjectDebugData const& _debugData, Dialect const& _dialect)
+{
+	yulAssert(m_diskCache);
+	std::optional<std::string> source = m_diskCache->load(_cacheKey);
+	if (!source.has_value())
+		return false;
+
+	// Entries may have been written by another process so treat anything unexpected as a miss.
+	ErrorList errors;
+	ErrorReporter errorReporter(errors);
+	CharStream charStream(std::move(*source), "");
+	std::unique_ptr<AST> ast;
+	try
+	{
+		ast = Parser(errorReporter, _dialect, _debugData.sourceNames).parse(charStream);
+	}
+	catch (FatalError const&)
+	{
+		return false;
+	}
+	if (!ast || errorReporter.hasErrors())
+		return false;
+
+	CachedObject cachedObject{
+		std::make_shared<Block>(ASTCopier{}.translate(ast->root())),
+		&_dialect,
+	};
+
+	std::lock_guard<std::mutex> lock(m_cacheMutex);
+	m_cachedObjects.emplace(_cacheKey, std::move(cachedObject));
+	return true;
 }
 
 std::optional<h256> ObjectOptimizer::calculateCacheKey(
@@ -27,8 +27,15 @@
 
 #include <map>
 #include <memory>
+#include <mutex>
 #include <optional>
 
+namespace solidity::util
+{
+class DiskCache;
+class ThreadPool;
+}
+
 namespace solidity::yul
 {
 
@@ -48,6 +55,10 @@ Dialect const& languageToDialect(Language _language, langutil::EVMVersion _versi
 /// Caching is performed at the granularity of individual ASTs rather than whole object trees,
 /// which means that reuse is possible even within a single hierarchy, e.g. when creation and
 /// deployed objects have common dependencies.
+///
+/// The cache can be shared by optimizations running concurrently on multiple threads.
+/// Optionally, it can be backed by a persistent cache on disk, which makes it possible to reuse
+/// the results across compiler runs.
 class ObjectOptimizer
 {
 public:
@@ -68,10 +79,22 @@ public:
 	/// Recursively optimizes a Yul object with given settings, reusing cached ASTs where possible
 	/// or caching the result otherwise. The object is modified in-place.
 	/// Automatically accounts for the difference between creation and deployed objects.
+	/// @param _threadPool If given, sibling sub-objects are optimized concurrently, and so are
+	///     the functions of an object in steps that run on a selection of functions.
+	///     The result does not depend on it.
 	/// @warning Does not ensure that nativeLocations in the resulting AST match the optimized code.
-	void optimize(Object& _object, Settings const& _settings);
+	void optimize(Object& _object, Settings const& _settings, util::ThreadPool* _threadPool = nullptr);
+
+	/// Makes the cache look up optimized ASTs in @a _diskCache when they are not available in
+	/// memory and store newly optimized ones there.
+	/// The cache stores optimized code in its textual form, with full debug info.
+	void setDiskCache(std::shared_ptr<util::DiskCache> _diskCache) { m_diskCache = std::move(_diskCache); }
 
-	size_t size() const { return m_cachedObjects.size(); }
+	size_t size() const
+	{
+		std::lock_guard<std::mutex> lock(m_cacheMutex);
+		return m_cachedObjects.size();
+	}
 
 private:
 	struct CachedObject
@@ -80,10 +103,15 @@ private:
 		Dialect const* dialect;
 	};
 
-	void optimize(Object& _object, Settings const& _settings, bool _isCreation);
+	void optimize(Object& _object, Settings const& _settings, bool _isCreation, util::ThreadPool* _threadPool);
 
 	void storeOptimizedObject(util::h256 _cacheKey, Object const& _optimizedObject, Dialect const& _dialect);
-	void overwriteWithOptimizedObject(util::h256 _cacheKey, Object& _object) const;
+	/// Replaces the code of @a _object with the cached one.
+	/// @returns false if there is no cache entry for @a _cacheKey.
+	bool overwriteWithOptimizedObject(util::h256 _cacheKey, Object& _object) const;
+	/// Loads the entry for @a _cacheKey from the disk cache into memory.
+	/// @returns false if there is no such entry or it cannot be parsed.
+	bool loadFromDiskCache(util::h256 _cacheKey, ObjectDebugData const& _debugData, Dialect const& _dialect);
 
 	static std::optional<util::h256> calculateCacheKey(
 		Block const& _ast,
@@ -93,6 +121,9 @@ private:
 	);
 
 	std::map<util::h256, CachedObject> m_cachedObjects;
+	/// Guards @a m_cachedObjects. Never held while the optimizer is running.
+	mutable std::mutex m_cacheMutex;
+	std::shared_ptr<util::DiskCache> m_diskCache;
 };
 
 }
@@ -32,6 +32,7 @@
 #include <libevmasm/Assembly.h>
 #include <liblangutil/Scanner.h>
 #include <liblangutil/SourceReferenceFormatter.h>
+#include <libsolutil/Profiler.h>
 
 #include <boost/algorithm/string.hpp>
 
@@ -53,6 +54,7 @@ CharStream const& YulStack::charStream(std::string const& _sourceName) const
 bool YulStack::parse(std::string const& _sourceName, std::string const& _source)
 {
 	yulAssert(m_stackState == Empty);
+	util::Profiler::Probe probe{"parsing", "ObjectParser", _sourceName};
 	try
 	{
 		m_charStream = std::make_unique<CharStream>(_source, _sourceName);
@@ -136,7 +138,8 @@ void YulStack::optimize()
 				yulOptimiserSteps,
 				yulOptimiserCleanupSteps,
 				m_optimiserSettings.expectedExecutionsPerDeployment
-			}
+			},
+			m_threadPool
 		);
 
 		// Optimizer does not maintain correct native source locations in the AST.
@@ -153,6 +156,7 @@ bool YulStack::analyzeParsed()
 {
 	yulAssert(m_stackState >= Parsed);
 	yulAssert(m_parserResult, "");
+	util::Profiler::Probe probe{"analysis", "AsmAnalyzer"};
 	return analyzeParsed(*m_parserResult);
 }
 
@@ -193,7 +197,7 @@ bool YulStack::analyzeParsed(Object& _object)
 
 void YulStack::compileEVM(AbstractAssembly& _assembly, bool _optimize) const
 {
-	EVMObjectCompiler::compile(*m_parserResult, _assembly, _optimize);
+	EVMObjectCompiler::compile(*m_parserResult, _assembly, _optimize, m_threadPool);
 }
 
 void YulStack::reparse()
@@ -50,6 +50,11 @@ namespace solidity::langutil
 class Scanner;
 }
 
+namespace solidity::util
+{
+class ThreadPool;
+}
+
 namespace solidity::yul
 {
 class AbstractAssembly;
@@ -108,6 +113,10 @@ public:
 	/// @returns the char stream used during parsing
 	langutil::CharStream const& charStream(std::string const& _sourceName) const override;
 
+	/// Makes optimization and assembly process sibling sub-objects concurrently in @a _threadPool.
+	/// NOTE: Not owned by YulStack, the user must ensure that it is not destroyed before the stack is used.
+	void setThreadPool(util::ThreadPool* _threadPool) { m_threadPool = _threadPool; }
+
 	/// Runs parsing and analysis steps, returns false if input cannot be assembled.
 	/// Multiple calls overwrite the previous state.
 	bool parseAndAnalyze(std::string const& _sourceName, std::string const& _source);
@@ -181,6 +190,7 @@ private:
 	/// Necessary when code snippets are requested as a part of debug info. When null, code snippets are omitted.
 	/// NOTE: Not owned by YulStack, the user must ensure that it is not destroyed before the stack is.
 	langutil::CharStreamProvider const* m_soliditySourceProvider{};
+	util::ThreadPool* m_threadPool{};
 
 	std::unique_ptr<langutil::CharStream> m_charStream;
 
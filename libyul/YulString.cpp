@@ -0,0 +1,184 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libyul/YulString.h>
+
+#include <libyul/Exceptions.h>
+
+#include <boost/multiprecision/integer.hpp>
+
+#include <array>
+#include <atomic>
+#include <bitset>
+
+using namespace solidity;
+using namespace solidity::yul;
+
+namespace
+{
+
+constexpr size_t c_maxRepositories = 1u << 10;
+
+/// Repositories that are currently alive, indexed by the high bits of the IDs they hand out.
+/// Constant-initialized, so that it is usable during static initialization and destruction.
+std::array<std::atomic<YulStringRepository*>, c_maxRepositories> g_repositories{};
+std::bitset<c_maxRepositories> g_usedSlots;
+/// Number of generations started per slot.
+std::array<std::uint64_t, c_maxRepositories> g_generations{};
+std::mutex g_slotsMutex;
+
+thread_local YulStringRepository* t_currentRepository = nullptr;
+
+YulStringRepository& defaultRepository()
+{
+	static YulStringRepository repository;
+	return repository;
+}
+
+}
+
+YulStringRepository::Scope::Scope(YulStringRepository& _repository):
+	m_previous(t_currentRepository)
+{
+	t_currentRepository = &_repository;
+}
+
+YulStringRepository::Scope::~Scope()
+{
+	t_currentRepository = m_previous;
+}
+
+YulStringRepository::YulStringRepository()
+{
+	static_assert(c_maxRepositories == (size_t(1) << c_slotBits));
+
+	std::lock_guard<std::mutex> lock(g_slotsMutex);
+	size_t slot = 0;
+	while (slot < c_maxRepositories && g_usedSlots[slot])
+		++slot;
+	yulAssert(slot < c_maxRepositories, "Too many Yul string repositories alive at the same time.");
+	g_usedSlots[slot] = true;
+	m_idPrefix = std::uint64_t(slot) << (c_localIDBits + c_generationBits);
+	startGeneration();
+	g_repositories[slot].store(this, std::memory_order_release);
+}
+
+YulStringRepository::~YulStringRepository()
+{
+	{
+		std::lock_guard<std::mutex> lock(g_slotsMutex);
+		size_t slot = static_cast<size_t>(m_idPrefix >> (c_localIDBits + c_generationBits));
+		g_repositories[slot].store(nullptr, std::memory_order_release);
+		g_usedSlots[slot] = false;
+	}
+	for (auto& chunk: m_chunks)
+		delete[] chunk.load(std::memory_order_relaxed);
+}
+
+YulStringRepository& YulStringRepository::instance()
+{
+	if (t_currentRepository)
+		return *t_currentRepository;
+	return defaultRepository();
+}
+
+YulStringRepository::Handle YulStringRepository::stringToHandle(std::string_view const _string)
+{
+	if (_string.empty())
+		return { 0, emptyHash() };
+	std::uint64_t h = hash(_string);
+	std::lock_guard<std::mutex> lock(m_mutex);
+	auto range = m_hashToID.equal_range(h);
+	for (auto it = range.first; it != range.second; ++it)
+	{
+		auto [chunk, offset] = chunkAndOffset(localID(it->second));
+		if (m_chunks[chunk].load(std::memory_order_relaxed)[offset] == _string)
+			return Handle{it->second, h};
+	}
+
+	yulAssert(m_size + 1 < (std::uint64_t(1) << c_localIDBits), "Too many distinct Yul strings.");
+	auto [chunk, offset] = chunkAndOffset(m_size);
+	std::string* strings = m_chunks[chunk].load(std::memory_order_relaxed);
+	if (!strings)
+	{
+		strings = new std::string[c_firstChunkSize << chunk];
+		m_chunks[chunk].store(strings, std::memory_order_release);
+	}
+	strings[offset] = _string;
+	++m_size;
+	std::uint64_t id = m_idPrefix.load(std::memory_order_relaxed) | m_size;
+	m_hashToID.emplace_hint(range.second, std::make_pair(h, id));
+
+	return Handle{id, h};
+}
+
+std::string const& YulStringRepository::idToString(std::uint64_t _id)
+{
+	static std::string const emptyString;
+	if (_id == 0)
+		return emptyString;
+
+	YulStringRepository const* repository =
+		g_repositories[static_cast<size_t>(_id >> (c_localIDBits + c_generationBits))].load(std::memory_order_acquire);
+	yulAssert(
+		repository && (repository->m_idPrefix.load(std::memory_order_relaxed) >> c_localIDBits) == (_id >> c_localIDBits),
+		"YulString used after its repository was destroyed or cleared."
+	);
+
+	// The string was added before the ID was handed out, so it is visible to any thread that has the ID.
+	auto [chunk, offset] = chunkAndOffset(localID(_id));
+	return repository->m_chunks[chunk].load(std::memory_order_acquire)[offset];
+}
+
+std::pair<size_t, size_t> YulStringRepository::chunkAndOffset(size_t _localID)
+{
+	size_t chunk = static_cast<size_t>(boost::multiprecision::msb(_localID / c_firstChunkSize + 1));
+	return {chunk, _localID - c_firstChunkSize * ((size_t(1) << chunk) - 1)};
+}
+
+void YulStringRepository::startGeneration()
+{
+	size_t slot = static_cast<size_t>(m_idPrefix >> (c_localIDBits + c_generationBits));
+	std::uint64_t generation = g_generations[slot]++ & ((std::uint64_t(1) << c_generationBits) - 1);
+	m_idPrefix = (std::uint64_t(slot) << (c_localIDBits + c_generationBits)) | (generation << c_localIDBits);
+}
+
+void YulStringRepository::reset()
+{
+	for (auto const& cb: resetCallbacks())
+		cb();
+	defaultRepository().clear();
+}
+
+void YulStringRepository::clear()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	for (auto& chunk: m_chunks)
+		delete[] chunk.exchange(nullptr, std::memory_order_relaxed);
+	m_size = 0;
+	m_hashToID.clear();
+
+	std::lock_guard<std::mutex> slotsLock(g_slotsMutex);
+	startGeneration();
+}
+
+std::vector<std::function<void()>>& YulStringRepository::resetCallbacks()
+{
+	static std::vector<std::function<void()>> callbacks;
+	return callbacks;
+}
@@ -23,8 +23,12 @@
 
 #include <fmt/format.h>
 
+#include <array>
+#include <atomic>
+#include <cstdint>
 #include <unordered_map>
 #include <memory>
+#include <mutex>
 #include <vector>
 #include <string>
 #include <string_view>
@@ -37,37 +41,58 @@ namespace solidity::yul
 /// Owns the string data for all YulStrings, which can be referenced by a Handle.
 /// A Handle consists of an ID (that depends on the insertion order of YulStrings and is potentially
 /// non-deterministic) and a deterministic string hash.
+///
+/// There is a process-wide default repository, but a repository can also be owned by a single
+/// compilation and made current for the duration of a Scope. The ID of a string is unique across
+/// all repositories that are alive at the same time, so that a YulString can be resolved regardless
+/// of which repository is current. Strings are only equal if they come from the same repository,
+/// hence all YulStrings of a single AST have to be created with the same repository being current.
+///
+/// Repositories are safe to use from multiple threads concurrently.
 class YulStringRepository
 {
 public:
 	struct Handle
 	{
-		size_t id;
+		std::uint64_t id;
 		std::uint64_t hash;
 	};
 
-	static YulStringRepository& instance()
+	/// Makes a repository current on this thread for the lifetime of the scope.
+	/// Scopes can be nested.
+	class Scope
 	{
-		static YulStringRepository inst;
-		return inst;
-	}
+	public:
+		explicit Scope(YulStringRepository& _repository);
+		~Scope();
+		Scope(Scope const&) = delete;
+		Scope& operator=(Scope const&) = delete;
+
+	private:
+		YulStringRepository* m_previous = nullptr;
+	};
+
+	YulStringRepository();
+	~YulStringRepository();
+	YulStringRepository(YulStringRepository const&) = delete;
+	YulStringRepository& operator=(YulStringRepository const&) = delete;
+
+	/// @returns the repository new YulStrings are created in, i.e. the one of the innermost
+	/// Scope on this thread or the default repository if there is none.
+	static YulStringRepository& instance();
+
+	Handle stringToHandle(std::string_view _string);
+	/// @returns the string with the given ID. The ID may come from any repository
+	/// that is still alive, not only from the current one.
+	/// Does not lock, strings never move once they were added.
+	static std::string const& idToString(std::uint64_t _id);
 
-	Handle stringToHandle(std::string_view const _string)
+	/// @returns the number of distinct non-empty strings stored in the repository.
+	size_t size() const
 	{
-		if (_string.empty())
-			return { 0, emptyHash() };
-		std::uint64_t h = hash(_string);
-		auto range = m_hashToID.equal_range(h);
-		for (auto it = range.first; it != range.second; ++it)
-			if (*m_strings[it->second] == _string)
-				return Handle{it->second, h};
-		m_strings.emplace_back(std::make_shared<std::string>(_string));
-		size_t id = m_strings.size() - 1;
-		m_hashToID.emplace_hint(range.second, std::make_pair(h, id));
-
-		return Handle{id, h};
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return m_size;
 	}
-	std::string const& idToString(size_t _id) const { return *m_strings.at(_id); }
 
 	static std::uint64_t hash(std::string_view const v)
 	{
@@ -82,16 +107,11 @@ public:
 		return hash;
 	}
 	static constexpr std::uint64_t emptyHash() { return 14695981039346656037u; }
-	/// Clear the repository.
+	/// Clear the default repository.
 	/// Use with care - there cannot be any dangling YulString references.
 	/// If references need to be cleared manually, register the callback via
 	/// resetCallback.
-	static void reset()
-	{
-		for (auto const& cb: resetCallbacks())
-			cb();
-		instance() = YulStringRepository{};
-	}
+	static void reset();
 	/// Struct that registers a reset callback as a side-effect of its construction.
 	/// Useful as static local variable to register a reset callback once.
 	struct ResetCallback
@@ -103,20 +123,41 @@ public:
 	};
 
 private:
-	YulStringRepository() = default;
-	YulStringRepository(YulStringRepository const&) = delete;
-	YulStringRepository(YulStringRepository&&) = default;
-	YulStringRepository& operator=(YulStringRepository const& _rhs) = delete;
-	YulStringRepository& operator=(YulStringRepository&& _rhs) = default;
-
-	static std::vector<std::function<void()>>& resetCallbacks()
+	/// Number of low bits of an ID that identify the string within its repository.
+	static constexpr unsigned c_localIDBits = 40;
+	/// Number of bits above the local ID that tell apart repositories that used the same slot
+	/// one after another, and the contents of a repository before and after it was cleared.
+	static constexpr unsigned c_generationBits = 14;
+	/// The remaining high bits identify the slot of the repository.
+	static constexpr unsigned c_slotBits = 64 - c_localIDBits - c_generationBits;
+	/// Number of strings in the first chunk of storage. Each further chunk is twice as large
+	/// as the previous one, so that all local IDs fit into a fixed number of chunks.
+	static constexpr size_t c_firstChunkSize = 256;
+	static constexpr size_t c_chunkCount = c_localIDBits - 8 + 1;
+	static_assert(c_firstChunkSize == (size_t(1) << 8));
+
+	static size_t localID(std::uint64_t _id)
 	{
-		static std::vector<std::function<void()>> callbacks;
-		return callbacks;
+		// Local IDs start at 1, zero is reserved for the empty string.
+		return static_cast<size_t>((_id & ((std::uint64_t(1) << c_localIDBits) - 1)) - 1);
 	}
-
-	std::vector<std::shared_ptr<std::string>> m_strings = {std::make_shared<std::string>()};
-	std::unordered_multimap<std::uint64_t, size_t> m_hashToID = {{emptyHash(), 0}};
+	/// @returns the chunk containing the string with the given local ID and its position in it.
+	static std::pair<size_t, size_t> chunkAndOffset(size_t _localID);
+
+	void clear();
+	/// Sets the generation of the IDs handed out from now on. Requires the slots mutex.
+	void startGeneration();
+
+	static std::vector<std::function<void()>>& resetCallbacks();
+
+	/// High bits of all IDs handed out by this repository, i.e. its slot and generation.
+	std::atomic<std::uint64_t> m_idPrefix{0};
+	/// Storage of the strings. Chunks are allocated as needed, but never reallocated, so that
+	/// strings can be read without locking while others are added.
+	std::array<std::atomic<std::string*>, c_chunkCount> m_chunks{};
+	size_t m_size = 0;
+	std::unordered_multimap<std::uint64_t, std::uint64_t> m_hashToID;
+	mutable std::mutex m_mutex;
 };
 
 /// Wrapper around handles into the YulString repository.
@@ -153,7 +194,7 @@ public:
 	bool empty() const { return m_handle.id == 0; }
 	std::string const& str() const
 	{
-		return YulStringRepository::instance().idToString(m_handle.id);
+		return YulStringRepository::idToString(m_handle.id);
 	}
 
 	uint64_t hash() const { return m_handle.hash; }
@@ -29,6 +29,7 @@
 #include <liblangutil/EVMVersion.h>
 
 #include <map>
+#include <mutex>
 #include <set>
 
 namespace solidity::yul
@@ -126,6 +127,8 @@ protected:
 	std::unordered_map<std::string_view, BuiltinHandle> m_builtinFunctionsByName;
 	std::vector<std::optional<BuiltinFunctionForEVM>> m_functions;
 	std::array<std::unique_ptr<BuiltinFunctionForEVM>, verbatimIDOffset> mutable m_verbatimFunctions{};
+	/// Dialects are shared between compilations running concurrently and verbatim builtins are created on demand.
+	std::mutex mutable m_verbatimFunctionsMutex;
 	std::set<std::string, std::less<>> m_reserved;
 
 	std::optional<BuiltinHandle> m_discardFunction;
@@ -29,6 +29,10 @@
 
 #include <libyul/Object.h>
 #include <libyul/Exceptions.h>
+#include <libyul/YulString.h>
+
+#include <libsolutil/Profiler.h>
+#include <libsolutil/ThreadPool.h>
 
 #include <boost/algorithm/string.hpp>
 
@@ -37,10 +41,11 @@ using namespace solidity::yul;
 void EVMObjectCompiler::compile(
 	Object const& _object,
 	AbstractAssembly& _assembly,
-	bool _optimize
+	bool _optimize,
+	util::ThreadPool* _threadPool
 )
 {
-	EVMObjectCompiler compiler(_assembly);
+	EVMObjectCompiler compiler(_assembly, _threadPool);
 	compiler.run(_object, _optimize);
 }
 
@@ -54,6 +59,7 @@ void EVMObjectCompiler::run(Object const& _object, bool _optimize)
 	context.currentObject = &_object;
 
 
+	std::vector<std::pair<Object const*, std::shared_ptr<AbstractAssembly>>> subAssemblies;
 	for (auto const& subNode: _object.subObjects)
 		if (auto* subObject = dynamic_cast<Object*>(subNode.get()))
 		{
@@ -61,7 +67,7 @@ void EVMObjectCompiler::run(Object const& _object, bool _optimize)
 			auto subAssemblyAndID = m_assembly.createSubAssembly(isCreation, subObject->name);
 			context.subIDs[subObject->name] = subAssemblyAndID.second;
 			subObject->subId = subAssemblyAndID.second;
-			compile(*subObject, *subAssemblyAndID.first, _optimize);
+			subAssemblies.emplace_back(subObject, subAssemblyAndID.first);
 		}
 		else
 		{
@@ -73,6 +79,30 @@ void EVMObjectCompiler::run(Object const& _object, bool _optimize)
 				context.subIDs[data.name] = m_assembly.appendData(data.data);
 		}
 
+	// Sub-assemblies were created above so their IDs do not depend on the order of compilation.
+	if (m_threadPool && subAssemblies.size() > 1)
+	{
+		YulStringRepository& yulStringRepository = YulStringRepository::instance();
+		std::vector<std::future<void>> compilations;
+		for (auto const& [subObject, subAssembly]: subAssemblies)
+			compilations.push_back(m_threadPool->submit(
+				[subObject = subObject, subAssembly = subAssembly, _optimize, this, &yulStringRepository]() {
+					YulStringRepository::Scope yulStringScope(yulStringRepository);
+					compile(*subObject, *subAssembly, _optimize, m_threadPool);
+				}
+			));
+		// Wait for all compilations before rethrowing, so that none of them outlives the assembly.
+		// Exceptions are rethrown in the order of sub-objects, just like in sequential compilation.
+		for (std::future<void> const& compilation: compilations)
+			m_threadPool->wait(compilation);
+		for (std::future<void>& compilation: compilations)
+			compilation.get();
+	}
+	else
+		for (auto const& [subObject, subAssembly]: subAssemblies)
+			compile(*subObject, *subAssembly, _optimize, m_threadPool);
+
+	util::Profiler::Probe probe{"codegen", "EVMObjectCompiler", _object.name};
 	yulAssert(_object.analysisInfo, "No analysis info.");
 	yulAssert(_object.hasCode(), "No code.");
 	if (evmDialect->eofVersion().has_value())
@@ -24,6 +24,11 @@
 #include <optional>
 #include <cstdint>
 
+namespace solidity::util
+{
+class ThreadPool;
+}
+
 namespace solidity::yul
 {
 class Object;
@@ -33,17 +38,24 @@ class EVMDialect;
 class EVMObjectCompiler
 {
 public:
+	/// Compiles @a _object and its sub-objects into @a _assembly.
+	/// @param _threadPool If given, sibling sub-objects are compiled concurrently.
 	static void compile(
 		Object const& _object,
 		AbstractAssembly& _assembly,
-		bool _optimize
+		bool _optimize,
+		util::ThreadPool* _threadPool = nullptr
 	);
 private:
-	EVMObjectCompiler(AbstractAssembly& _assembly): m_assembly(_assembly) {}
+	EVMObjectCompiler(AbstractAssembly& _assembly, util::ThreadPool* _threadPool):
+		m_assembly(_assembly),
+		m_threadPool(_threadPool)
+	{}
 
 	void run(Object const& _object, bool _optimize);
 
 	AbstractAssembly& m_assembly;
+	util::ThreadPool* m_threadPool = nullptr;
 };
 
 }
@@ -25,6 +25,7 @@
 
 #include <libevmasm/Instruction.h>
 
+#include <libsolutil/Profiler.h>
 #include <libsolutil/Visitor.h>
 #include <libsolutil/cxx20.h>
 
@@ -48,8 +49,16 @@ std::vector<StackTooDeepError> OptimizedEVMCodeTransform::run(
 	UseNamedLabels _useNamedLabelsForFunctions
 )
 {
-	std::unique_ptr<CFG> dfg = ControlFlowGraphBuilder::build(_analysisInfo, _dialect, _block);
-	StackLayout stackLayout = StackLayoutGenerator::run(*dfg, !_dialect.eofVersion().has_value());
+	std::unique_ptr<CFG> dfg;
+	StackLayout stackLayout;
+	{
+		util::Profiler::Probe probe{"stackLayout", "ControlFlowGraphBuilder"};
+		dfg = ControlFlowGraphBuilder::build(_analysisInfo, _dialect, _block);
+	}
+	{
+		util::Profiler::Probe probe{"stackLayout", "StackLayoutGenerator"};
+		stackLayout = StackLayoutGenerator::run(*dfg, !_dialect.eofVersion().has_value());
+	}
 
 	if (_dialect.eofVersion().has_value())
 	{
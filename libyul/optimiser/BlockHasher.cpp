@@ -239,3 +239,108 @@ void ExpressionHasher::operator()(FunctionCall const& _funCall)
 	hashFunctionCall(_funCall);
 	ASTWalker::operator()(_funCall);
 }
+
+uint64_t StatementHasher::run(Statement const& _statement)
+{
+	StatementHasher statementHasher;
+	statementHasher.visit(_statement);
+	return statementHasher.m_hash;
+}
+
+void StatementHasher::operator()(Literal const& _literal)
+{
+	hashLiteral(_literal);
+	hash8(static_cast<uint8_t>(_literal.kind));
+}
+
+void StatementHasher::operator()(Identifier const& _identifier)
+{
+	hash64(compileTimeLiteralHash("Identifier"));
+	hashName(_identifier.name);
+}
+
+void StatementHasher::operator()(FunctionCall const& _funCall)
+{
+	hashFunctionCall(_funCall);
+	hash64(_funCall.arguments.size());
+	ASTWalker::operator()(_funCall);
+}
+
+void StatementHasher::operator()(ExpressionStatement const& _statement)
+{
+	hash64(compileTimeLiteralHash("ExpressionStatement"));
+	ASTWalker::operator()(_statement);
+}
+
+void StatementHasher::operator()(Assignment const& _assignment)
+{
+	hash64(compileTimeLiteralHash("Assignment"));
+	hash64(_assignment.variableNames.size());
+	ASTWalker::operator()(_assignment);
+}
+
+void StatementHasher::operator()(VariableDeclaration const& _varDecl)
+{
+	hash64(compileTimeLiteralHash("VariableDeclaration"));
+	hash64(_varDecl.variables.size());
+	for (auto const& var: _varDecl.variables)
+		hashName(var.name);
+	hash8(_varDecl.value != nullptr);
+	ASTWalker::operator()(_varDecl);
+}
+
+void StatementHasher::operator()(If const& _if)
+{
+	hash64(compileTimeLiteralHash("If"));
+	ASTWalker::operator()(_if);
+}
+
+void StatementHasher::operator()(Switch const& _switch)
+{
+	hash64(compileTimeLiteralHash("Switch"));
+	hash64(_switch.cases.size());
+	for (auto const& _case: _switch.cases)
+		hash8(_case.value != nullptr);
+	ASTWalker::operator()(_switch);
+}
+
+void StatementHasher::operator()(FunctionDefinition const& _funDef)
+{
+	hash64(compileTimeLiteralHash("FunctionDefinition"));
+	hashName(_funDef.name);
+	hash64(_funDef.parameters.size());
+	for (auto const& parameter: _funDef.parameters)
+		hashName(parameter.name);
+	hash64(_funDef.returnVariables.size());
+	for (auto const& returnVariable: _funDef.returnVariables)
+		hashName(returnVariable.name);
+	ASTWalker::operator()(_funDef);
+}
+
+void StatementHasher::operator()(ForLoop const& _loop)
+{
+	hash64(compileTimeLiteralHash("ForLoop"));
+	ASTWalker::operator()(_loop);
+}
+
+void StatementHasher::operator()(Break const&)
+{
+	hash64(compileTimeLiteralHash("Break"));
+}
+
+void StatementHasher::operator()(Continue const&)
+{
+	hash64(compileTimeLiteralHash("Continue"));
+}
+
+void StatementHasher::operator()(Leave const&)
+{
+	hash64(compileTimeLiteralHash("Leave"));
+}
+
+void StatementHasher::operator()(Block const& _block)
+{
+	hash64(compileTimeLiteralHash("Block"));
+	hash64(_block.statements.size());
+	ASTWalker::operator()(_block);
+}
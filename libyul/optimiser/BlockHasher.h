@@ -148,4 +148,36 @@ struct ExpressionHash
 	}
 };
 
+/**
+ * Computes hashes of statements that are likely different for syntactically different statements.
+ * Like the ExpressionHasher, it distinguishes identifiers by name, including the names of declared
+ * variables and functions, so a change of the hash indicates that the code was modified.
+ * Debug data is not taken into account.
+ */
+class StatementHasher: public ASTWalker, public ASTHasherBase
+{
+public:
+	static uint64_t run(Statement const& _statement);
+
+	using ASTWalker::operator();
+
+	void operator()(Literal const&) override;
+	void operator()(Identifier const&) override;
+	void operator()(FunctionCall const& _funCall) override;
+	void operator()(ExpressionStatement const& _statement) override;
+	void operator()(Assignment const& _assignment) override;
+	void operator()(VariableDeclaration const& _varDecl) override;
+	void operator()(If const& _if) override;
+	void operator()(Switch const& _switch) override;
+	void operator()(FunctionDefinition const&) override;
+	void operator()(ForLoop const&) override;
+	void operator()(Break const&) override;
+	void operator()(Continue const&) override;
+	void operator()(Leave const&) override;
+	void operator()(Block const& _block) override;
+
+private:
+	void hashName(YulName _name) { hash64(_name.hash()); }
+};
+
 }
@@ -0,0 +1,269 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libyul/optimiser/ChangeTracker.h>
+
+#include <libyul/optimiser/ASTWalker.h>
+#include <libyul/optimiser/BlockHasher.h>
+#include <libyul/optimiser/Metrics.h>
+#include <libyul/optimiser/Semantics.h>
+#include <libyul/AST.h>
+#include <libyul/Exceptions.h>
+
+#include <libsolutil/CommonData.h>
+
+#include <range/v3/view/map.hpp>
+
+#include <functional>
+
+using namespace solidity;
+using namespace solidity::yul;
+
+namespace
+{
+
+/// Combines the hashes of the statements outside of top-level functions and the names of the
+/// functions in the order they appear in.
+class OutlineHasher: public HasherBase
+{
+public:
+	void add(uint64_t _value) { hash64(_value); }
+	uint64_t hash() const { return m_hash; }
+};
+
+/// Collects the names of the user-defined functions called in the visited code.
+class CalleeCollector: public ASTWalker
+{
+public:
+	using ASTWalker::operator();
+	void operator()(FunctionCall const& _functionCall) override
+	{
+		if (auto const* identifier = std::get_if<Identifier>(&_functionCall.functionName))
+			callees.insert(identifier->name);
+		ASTWalker::operator()(_functionCall);
+	}
+
+	std::set<YulName> callees;
+};
+
+}
+
+ChangeTracker::ChangeTracker(Dialect const& _dialect, Block const& _ast):
+	m_dialect(_dialect)
+{
+	m_hashes = hashFunctions(_ast);
+}
+
+std::set<YulName> ChangeTracker::update(Block const& _ast)
+{
+	return replaceHashes(hashFunctions(_ast));
+}
+
+std::set<YulName> ChangeTracker::update(Block const& _ast, std::set<YulName> const& _modified)
+{
+	return replaceHashes(hashFunctions(_ast, &_modified));
+}
+
+std::set<YulName> ChangeTracker::update(
+	Block const& _ast,
+	std::string const& _functionLocalStep,
+	std::set<YulName> const& _functions
+)
+{
+	// The facts were determined for the code before the step ran, by functionsToRun().
+	FunctionLocalRun run{m_hashes, containsMSize(), {}};
+	std::map<YulName, uint64_t> hashes = hashFunctions(_ast, &_functions);
+	for (YulName name: hashes | ranges::views::keys)
+		yulAssert(run.hashes.count(name), "Function added by a function-local step.");
+	std::set<YulName> modified = replaceHashes(std::move(hashes));
+	for (YulName name: run.hashes | ranges::views::keys)
+		if (!modified.count(name))
+			run.unmodified.insert(name);
+	m_functionLocalRuns[_functionLocalStep] = std::move(run);
+	return modified;
+}
+
+bool ChangeTracker::unmodifiedBy(std::string const& _step) const
+{
+	auto it = m_unmodifiedBy.find(_step);
+	return it != m_unmodifiedBy.end() && it->second == m_version;
+}
+
+std::set<YulName> ChangeTracker::functionsToRun(std::string const& _step, Block const& _ast)
+{
+	updateFacts(_ast);
+
+	std::set<YulName> functions;
+	auto lastRun = m_functionLocalRuns.find(_step);
+	if (lastRun == m_functionLocalRuns.end() || lastRun->second.containsMSize != containsMSize())
+	{
+		for (YulName name: m_hashes | ranges::views::keys)
+			functions.insert(name);
+		return functions;
+	}
+
+	std::map<YulName, std::set<YulName>> callers;
+	for (auto const& [name, facts]: m_facts)
+		if (m_hashes.count(name))
+			for (YulName callee: facts.callees)
+				callers[callee].insert(name);
+
+	// Functions modified since the last run, along with all functions that call them,
+	// directly or indirectly.
+	std::vector<YulName> toVisit;
+	for (auto const& [name, hash]: m_hashes)
+		if (auto it = lastRun->second.hashes.find(name); it == lastRun->second.hashes.end() || it->second != hash)
+			toVisit.emplace_back(name);
+	while (!toVisit.empty())
+	{
+		YulName name = toVisit.back();
+		toVisit.pop_back();
+		if (functions.insert(name).second)
+			for (YulName caller: callers[name])
+				toVisit.emplace_back(caller);
+	}
+
+	for (YulName name: m_hashes | ranges::views::keys)
+		if (!lastRun->second.unmodified.count(name))
+			functions.insert(name);
+	return functions;
+}
+
+size_t ChangeTracker::codeSizeIncludingFunctions(Block const& _ast)
+{
+	auto sizeOf = [&](YulName _name, std::function<size_t()> const& _computeSize) -> size_t {
+		uint64_t hash = m_hashes.at(_name);
+		auto it = m_sizes.find(_name);
+		if (it == m_sizes.end() || it->second.first != hash)
+			it = m_sizes.insert_or_assign(_name, std::make_pair(hash, _computeSize())).first;
+		return it->second.second;
+	};
+
+	size_t size = 0;
+	for (Statement const& statement: _ast.statements)
+		if (auto const* function = std::get_if<FunctionDefinition>(&statement))
+			size += sizeOf(function->name, [&]() { return CodeSize::codeSizeIncludingFunctions(statement); });
+	size += sizeOf(YulName{}, [&]() {
+		size_t outlineSize = 0;
+		for (Statement const& statement: _ast.statements)
+			if (!std::holds_alternative<FunctionDefinition>(statement))
+				outlineSize += CodeSize::codeSizeIncludingFunctions(statement);
+		return outlineSize;
+	});
+	return size;
+}
+
+std::map<YulName, uint64_t> ChangeTracker::hashFunctions(Block const& _ast, std::set<YulName> const* _functions)
+{
+	auto const rehash = [&](YulName _name) { return !_functions || _functions->count(_name); };
+	bool const rehashOutline = rehash(YulName{});
+
+	std::map<YulName, uint64_t> hashes;
+	m_grouped = !_ast.statements.empty() && std::holds_alternative<Block>(_ast.statements.front());
+	OutlineHasher outlineHasher;
+	for (Statement const& statement: _ast.statements)
+		if (auto const* function = std::get_if<FunctionDefinition>(&statement))
+		{
+			if (rehash(function->name))
+				hashes[function->name] = StatementHasher::run(statement);
+			else
+			{
+				auto it = m_hashes.find(function->name);
+				yulAssert(it != m_hashes.end(), "Function added without modifying the code outside of functions.");
+				hashes[function->name] = it->second;
+			}
+			outlineHasher.add(function->name.hash());
+		}
+		else
+		{
+			if (&statement != &_ast.statements.front())
+				m_grouped = false;
+			if (rehashOutline)
+				outlineHasher.add(StatementHasher::run(statement));
+		}
+
+	if (rehashOutline)
+		hashes[YulName{}] = outlineHasher.hash();
+	else
+	{
+		yulAssert(hashes.size() + 1 == m_hashes.size(), "Function removed without modifying the code outside of functions.");
+		hashes[YulName{}] = m_hashes.at(YulName{});
+	}
+	return hashes;
+}
+
+std::set<YulName> ChangeTracker::replaceHashes(std::map<YulName, uint64_t> _hashes)
+{
+	std::set<YulName> modified;
+	for (auto const& [name, hash]: _hashes)
+		if (auto it = m_hashes.find(name); it == m_hashes.end() || it->second != hash)
+			modified.insert(name);
+	for (YulName name: m_hashes | ranges::views::keys)
+		if (!_hashes.count(name))
+			modified.insert(name);
+
+	if (!modified.empty())
+	{
+		++m_version;
+		m_hashes = std::move(_hashes);
+	}
+	return modified;
+}
+
+void ChangeTracker::updateFacts(Block const& _ast)
+{
+	auto outdated = [&](YulName _name) {
+		auto it = m_facts.find(_name);
+		return it == m_facts.end() || it->second.hash != m_hashes.at(_name);
+	};
+	auto addFacts = [&](FunctionFacts& _facts, Statement const& _statement) {
+		CalleeCollector collector;
+		collector.visit(_statement);
+		_facts.callees += collector.callees;
+		_facts.containsMSize = _facts.containsMSize || MSizeFinder::containsMSize(m_dialect, _statement);
+	};
+
+	bool const outlineOutdated = outdated(YulName{});
+	FunctionFacts outlineFacts{m_hashes.at(YulName{}), {}, false};
+	for (Statement const& statement: _ast.statements)
+		if (auto const* function = std::get_if<FunctionDefinition>(&statement))
+		{
+			if (outdated(function->name))
+			{
+				FunctionFacts facts{m_hashes.at(function->name), {}, false};
+				addFacts(facts, statement);
+				m_facts[function->name] = std::move(facts);
+			}
+		}
+		else if (outlineOutdated)
+			addFacts(outlineFacts, statement);
+	if (outlineOutdated)
+		m_facts[YulName{}] = std::move(outlineFacts);
+}
+
+bool ChangeTracker::containsMSize() const
+{
+	for (auto const& [name, hash]: m_hashes)
+	{
+		FunctionFacts const& facts = m_facts.at(name);
+		yulAssert(facts.hash == hash, "Outdated facts about function code.");
+		if (facts.containsMSize)
+			return true;
+	}
+	return false;
+}
@@ -0,0 +1,141 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Optimiser component that keeps track of which parts of the code were modified by optimiser steps.
+ */
+
+#pragma once
+
+#include <libyul/ASTForward.h>
+#include <libyul/YulName.h>
+
+#include <cstdint>
+#include <map>
+#include <set>
+#include <string>
+#include <utility>
+
+namespace solidity::yul
+{
+
+class Dialect;
+
+/**
+ * Keeps track of the top-level functions of a block that are modified by optimiser steps,
+ * by comparing hashes of their code (see StatementHasher) before and after each step.
+ * The code outside of top-level functions, together with the order of the functions,
+ * is tracked under the empty name.
+ *
+ * Code is considered unmodified if its 64-bit hash is unchanged. This relies on hashes of different
+ * code not colliding. With n distinct versions of a function, the chance of a collision is about
+ * n^2 / 2^65, which is negligible even for millions of versions. A collision would make the suite
+ * treat modified code as unmodified, i.e. skip steps on it or stop repeating a sequence too early.
+ *
+ * The OptimiserSuite uses this to skip steps that are known not to modify the code, to stop
+ * repeating a sequence as soon as it does not modify the code anymore and to run function-local
+ * steps only on functions they might modify (see OptimiserStep::isFunctionLocal).
+ */
+class ChangeTracker
+{
+public:
+	ChangeTracker(Dialect const& _dialect, Block const& _ast);
+
+	/// Compares @a _ast, which has to be the block this tracker was created for, to its state
+	/// at the last update.
+	/// @returns the names of the top-level functions that were modified, added or removed since then,
+	/// including the empty name if the code outside of top-level functions was modified.
+	std::set<YulName> update(Block const& _ast);
+	/// Same as @a update, but also records what the function-local @a _step, which just ran on
+	/// @a _functions, modified. Only the code of @a _functions is hashed again, since the step
+	/// cannot have modified any other code.
+	/// Requires @a functionsToRun to have been called for the code before the step ran.
+	std::set<YulName> update(
+		Block const& _ast,
+		std::string const& _functionLocalStep,
+		std::set<YulName> const& _functions
+	);
+	/// Same as @a update, but only hashes the code of @a _modified again, which a global step
+	/// reported to be all it modified (see OptimiserStep::runAndReportModified).
+	std::set<YulName> update(Block const& _ast, std::set<YulName> const& _modified);
+
+	/// @returns a number that is incremented whenever @a update finds a modification.
+	size_t version() const { return m_version; }
+
+	/// @returns true if the code is in the form established by the FunctionGrouper.
+	bool grouped() const { return m_grouped; }
+
+	/// Records that running @a _step on the current version of the code did not modify it.
+	void recordUnmodifiedBy(std::string const& _step) { m_unmodifiedBy[_step] = m_version; }
+	/// @returns true if running @a _step on the current version of the code is known not to modify it.
+	bool unmodifiedBy(std::string const& _step) const;
+
+	/// @returns the top-level functions the function-local @a _step has to run on, i.e. all except
+	/// those it did not modify the last time it ran, as long as neither they nor the functions they
+	/// call were modified since and the code still uses msize exactly if it did then.
+	/// Requires @a _ast to be in the state of the last update.
+	std::set<YulName> functionsToRun(std::string const& _step, Block const& _ast);
+
+	/// @returns the same as CodeSize::codeSizeIncludingFunctions(_ast), but only computes the sizes
+	/// of top-level functions that were modified since their size was last computed.
+	/// Requires @a _ast to be in the state of the last update.
+	size_t codeSizeIncludingFunctions(Block const& _ast);
+
+private:
+	/// Properties of the code of a top-level function that steps can depend on.
+	struct FunctionFacts
+	{
+		/// Hash of the code the facts were determined for.
+		uint64_t hash = 0;
+		std::set<YulName> callees;
+		bool containsMSize = false;
+	};
+
+	/// What is known about the last run of a function-local step.
+	struct FunctionLocalRun
+	{
+		/// Hashes of the functions the step ran on.
+		std::map<YulName, uint64_t> hashes;
+		bool containsMSize = false;
+		/// Functions the step did not modify.
+		std::set<YulName> unmodified;
+	};
+
+	/// @returns the hashes of the top-level functions of @a _ast. If @a _functions is given, only the
+	/// functions named in it are hashed and the hashes of the others are taken from the last update.
+	/// Functions can only be added or removed if @a _functions contains the empty name.
+	std::map<YulName, uint64_t> hashFunctions(Block const& _ast, std::set<YulName> const* _functions = nullptr);
+	/// Replaces the hashes of the last update by @a _hashes.
+	/// @returns the names of the functions whose hashes differ.
+	std::set<YulName> replaceHashes(std::map<YulName, uint64_t> _hashes);
+	/// Updates the facts of functions modified since they were determined.
+	void updateFacts(Block const& _ast);
+	/// @returns true if any function uses msize. Requires the facts to be up to date.
+	bool containsMSize() const;
+
+	Dialect const& m_dialect;
+	std::map<YulName, uint64_t> m_hashes;
+	bool m_grouped = false;
+	size_t m_version = 0;
+	std::map<std::string, size_t> m_unmodifiedBy;
+	std::map<std::string, FunctionLocalRun> m_functionLocalRuns;
+	std::map<YulName, FunctionFacts> m_facts;
+	/// Code size of each top-level function, along with the hash of the function it was computed for.
+	std::map<YulName, std::pair<uint64_t, size_t>> m_sizes;
+};
+
+}
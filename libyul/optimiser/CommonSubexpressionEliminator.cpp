@@ -25,6 +25,7 @@
 #include <libyul/optimiser/BlockHasher.h>
 #include <libyul/optimiser/CallGraphGenerator.h>
 #include <libyul/optimiser/Semantics.h>
+#include <libyul/optimiser/OptimizerUtilities.h>
 #include <libyul/SideEffects.h>
 #include <libyul/Exceptions.h>
 #include <libyul/AST.h>
@@ -44,6 +45,23 @@ void CommonSubexpressionEliminator::run(OptimiserStepContext& _context, Block& _
 	cse(_ast);
 }
 
+void CommonSubexpressionEliminator::run(
+	OptimiserStepContext& _context,
+	Block& _ast,
+	std::set<YulName> const& _functions
+)
+{
+	std::map<FunctionHandle, SideEffects> const functionSideEffects =
+		SideEffectsPropagator::sideEffects(_context.dialect, CallGraphGenerator::callGraph(_ast));
+	std::vector<std::vector<Statement*>> batches =
+		splitIntoBatches(selectFunctions(_ast, _functions), _context.threadPool);
+	forEachBatch(batches.size(), _context.threadPool, [&](size_t _batch) {
+		CommonSubexpressionEliminator cse{_context.dialect, functionSideEffects};
+		for (Statement* statement: batches[_batch])
+			cse.visit(*statement);
+	});
+}
+
 CommonSubexpressionEliminator::CommonSubexpressionEliminator(
 	Dialect const& _dialect,
 	std::map<FunctionHandle, SideEffects> _functionSideEffects
@@ -46,6 +46,8 @@ class CommonSubexpressionEliminator: public DataFlowAnalyzer
 public:
 	static constexpr char const* name{"CommonSubexpressionEliminator"};
 	static void run(OptimiserStepContext&, Block& _ast);
+	/// Runs the step only on the given top-level functions, see OptimiserStep.
+	static void run(OptimiserStepContext&, Block& _ast, std::set<YulName> const& _functions);
 
 	using DataFlowAnalyzer::operator();
 	void operator()(FunctionDefinition&) override;
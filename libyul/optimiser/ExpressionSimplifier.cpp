@@ -38,6 +38,17 @@ void ExpressionSimplifier::run(OptimiserStepContext& _context, Block& _ast)
 	ExpressionSimplifier{_context.dialect}(_ast);
 }
 
+void ExpressionSimplifier::run(OptimiserStepContext& _context, Block& _ast, std::set<YulName> const& _functions)
+{
+	std::vector<std::vector<Statement*>> batches =
+		splitIntoBatches(selectFunctions(_ast, _functions), _context.threadPool);
+	forEachBatch(batches.size(), _context.threadPool, [&](size_t _batch) {
+		ExpressionSimplifier simplifier{_context.dialect};
+		for (Statement* statement: batches[_batch])
+			simplifier.visit(*statement);
+	});
+}
+
 void ExpressionSimplifier::visit(Expression& _expression)
 {
 	ASTModifier::visit(_expression);
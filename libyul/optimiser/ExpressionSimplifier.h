@@ -46,8 +46,11 @@ class ExpressionSimplifier: public DataFlowAnalyzer
 public:
 	static constexpr char const* name{"ExpressionSimplifier"};
 	static void run(OptimiserStepContext&, Block& _ast);
+	/// Runs the step only on the given top-level functions, see OptimiserStep.
+	static void run(OptimiserStepContext&, Block& _ast, std::set<YulName> const& _functions);
 
 	using ASTModifier::operator();
+	using ASTModifier::visit;
 	void visit(Expression& _expression) override;
 
 private:
@@ -23,6 +23,7 @@
 #include <libyul/optimiser/ExpressionSplitter.h>
 
 #include <libyul/optimiser/OptimiserStep.h>
+#include <libyul/optimiser/OptimizerUtilities.h>
 
 #include <libyul/AST.h>
 #include <libyul/Dialect.h>
@@ -40,6 +41,14 @@ void ExpressionSplitter::run(OptimiserStepContext& _context, Block& _ast)
 	ExpressionSplitter{_context.dialect, _context.dispenser}(_ast);
 }
 
+void ExpressionSplitter::run(OptimiserStepContext& _context, Block& _ast, std::set<YulName> const& _functions)
+{
+	// The functions are not split concurrently, because the new variables are named by a shared dispenser.
+	ExpressionSplitter splitter{_context.dialect, _context.dispenser};
+	for (Statement* statement: selectFunctions(_ast, _functions))
+		splitter.visit(*statement);
+}
+
 void ExpressionSplitter::operator()(FunctionCall& _funCall)
 {
 	BuiltinFunction const* builtin = resolveBuiltinFunction(_funCall.functionName, m_dialect);
@@ -60,6 +60,8 @@ class ExpressionSplitter: public ASTModifier
 public:
 	static constexpr char const* name{"ExpressionSplitter"};
 	static void run(OptimiserStepContext&, Block& _ast);
+	/// Runs the step only on the given top-level functions, see OptimiserStep.
+	static void run(OptimiserStepContext&, Block& _ast, std::set<YulName> const& _functions);
 
 	void operator()(FunctionCall&) override;
 	void operator()(If&) override;
@@ -44,11 +44,12 @@
 using namespace solidity;
 using namespace solidity::yul;
 
-void FullInliner::run(OptimiserStepContext& _context, Block& _ast)
+std::set<YulName> FullInliner::runAndReportModified(OptimiserStepContext& _context, Block& _ast)
 {
 	FullInliner inliner{_ast, _context.dispenser, _context.dialect};
 	inliner.run(Pass::InlineTiny);
 	inliner.run(Pass::InlineRest);
+	return std::move(inliner.m_modifiedFunctions);
 }
 
 FullInliner::FullInliner(Block& _ast, NameDispenser& _dispenser, Dialect const& _dialect):
@@ -300,6 +301,7 @@ std::vector<Statement> InlineModifier::performInline(Statement& _statement, Func
 	assertThrow(!!function, OptimizerException, "Attempt to inline invalid function.");
 
 	m_driver.tentativelyUpdateCodeSize(function->name, m_currentFunction);
+	m_driver.recordInlining(m_currentFunction);
 
 	// helper function to create a new variable that is supposed to model
 	// an existing variable.
@@ -71,7 +71,9 @@ class FullInliner: public ASTModifier
 {
 public:
 	static constexpr char const* name{"FullInliner"};
-	static void run(OptimiserStepContext& _context, Block& _ast);
+	static void run(OptimiserStepContext& _context, Block& _ast) { runAndReportModified(_context, _ast); }
+	/// Runs the step and @returns the functions it inlined calls into, see OptimiserStep.
+	static std::set<YulName> runAndReportModified(OptimiserStepContext& _context, Block& _ast);
 
 	/// Inlining heuristic.
 	/// @param _callSite the name of the function in which the function call is located.
@@ -90,6 +92,9 @@ public:
 	/// should be determined after inlining is completed.
 	void tentativelyUpdateCodeSize(YulName _function, YulName _callSite);
 
+	/// Records that a function call in @a _callSite was inlined.
+	void recordInlining(YulName _callSite) { m_modifiedFunctions.insert(_callSite); }
+
 private:
 	enum Pass { InlineTiny, InlineRest };
 
@@ -120,6 +125,8 @@ private:
 	/// Variables that are constants (used for inlining heuristic)
 	std::set<YulName> m_constants;
 	std::map<YulName, size_t> m_functionSizes;
+	/// Top-level functions calls were inlined into, the empty name stands for the code outside of them.
+	std::set<YulName> m_modifiedFunctions;
 	NameDispenser& m_nameDispenser;
 	Dialect const& m_dialect;
 };
@@ -52,6 +52,25 @@ void LoadResolver::run(OptimiserStepContext& _context, Block& _ast)
 	}(_ast);
 }
 
+void LoadResolver::run(OptimiserStepContext& _context, Block& _ast, std::set<YulName> const& _functions)
+{
+	std::map<FunctionHandle, SideEffects> const functionSideEffects =
+		SideEffectsPropagator::sideEffects(_context.dialect, CallGraphGenerator::callGraph(_ast));
+	bool const containsMSize = MSizeFinder::containsMSize(_context.dialect, _ast);
+	std::vector<std::vector<Statement*>> batches =
+		splitIntoBatches(selectFunctions(_ast, _functions), _context.threadPool);
+	forEachBatch(batches.size(), _context.threadPool, [&](size_t _batch) {
+		LoadResolver loadResolver{
+			_context.dialect,
+			functionSideEffects,
+			containsMSize,
+			_context.expectedExecutionsPerDeployment
+		};
+		for (Statement* statement: batches[_batch])
+			loadResolver.visit(*statement);
+	});
+}
+
 void LoadResolver::visit(Expression& _e)
 {
 	DataFlowAnalyzer::visit(_e);
@@ -45,6 +45,8 @@ public:
 	static constexpr char const* name{"LoadResolver"};
 	/// Run the load resolver on the given complete AST.
 	static void run(OptimiserStepContext&, Block& _ast);
+	/// Runs the step only on the given top-level functions, see OptimiserStep.
+	static void run(OptimiserStepContext&, Block& _ast, std::set<YulName> const& _functions);
 
 private:
 	LoadResolver(
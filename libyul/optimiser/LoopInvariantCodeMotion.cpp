@@ -20,6 +20,7 @@
 
 #include <libyul/optimiser/CallGraphGenerator.h>
 #include <libyul/optimiser/NameCollector.h>
+#include <libyul/optimiser/OptimizerUtilities.h>
 #include <libyul/optimiser/Semantics.h>
 #include <libyul/optimiser/SSAValueTracker.h>
 #include <libyul/AST.h>
@@ -39,6 +40,25 @@ void LoopInvariantCodeMotion::run(OptimiserStepContext& _context, Block& _ast)
 	LoopInvariantCodeMotion{_context.dialect, ssaVars, functionSideEffects, containsMSize}(_ast);
 }
 
+void LoopInvariantCodeMotion::run(
+	OptimiserStepContext& _context,
+	Block& _ast,
+	std::set<YulName> const& _functions
+)
+{
+	std::map<FunctionHandle, SideEffects> functionSideEffects =
+		SideEffectsPropagator::sideEffects(_context.dialect, CallGraphGenerator::callGraph(_ast));
+	bool containsMSize = MSizeFinder::containsMSize(_context.dialect, _ast);
+	std::set<YulName> ssaVars = SSAValueTracker::ssaVariables(_ast);
+	std::vector<std::vector<Statement*>> batches =
+		splitIntoBatches(selectFunctions(_ast, _functions), _context.threadPool);
+	forEachBatch(batches.size(), _context.threadPool, [&](size_t _batch) {
+		LoopInvariantCodeMotion licm{_context.dialect, ssaVars, functionSideEffects, containsMSize};
+		for (Statement* statement: batches[_batch])
+			licm.visit(*statement);
+	});
+}
+
 void LoopInvariantCodeMotion::operator()(Block& _block)
 {
 	util::iterateReplacing(
@@ -42,6 +42,8 @@ class LoopInvariantCodeMotion: public ASTModifier
 public:
 	static constexpr char const* name{"LoopInvariantCodeMotion"};
 	static void run(OptimiserStepContext& _context, Block& _ast);
+	/// Runs the step only on the given top-level functions, see OptimiserStep.
+	static void run(OptimiserStepContext&, Block& _ast, std::set<YulName> const& _functions);
 
 	void operator()(Block& _block) override;
 
@@ -19,10 +19,17 @@
 #pragma once
 
 #include <libyul/Exceptions.h>
+#include <libyul/YulName.h>
 
 #include <optional>
 #include <string>
 #include <set>
+#include <utility>
+
+namespace solidity::util
+{
+class ThreadPool;
+}
 
 namespace solidity::yul
 {
@@ -38,6 +45,8 @@ struct OptimiserStepContext
 	std::set<YulName> const& reservedIdentifiers;
 	/// The value nullopt represents creation code
 	std::optional<size_t> expectedExecutionsPerDeployment;
+	/// If given, steps running on a selection of functions transform them concurrently.
+	util::ThreadPool* threadPool = nullptr;
 };
 
 
@@ -51,6 +60,19 @@ struct OptimiserStep
 	virtual ~OptimiserStep() = default;
 
 	virtual void run(OptimiserStepContext&, Block&) const = 0;
+	/// @returns true if the step can be run on a selection of top-level functions, because its effect
+	/// on a function only depends on the function itself, the functions it calls and whether the code
+	/// uses msize.
+	virtual bool isFunctionLocal() const = 0;
+	/// Runs the step only on the top-level functions of @a _ast named in @a _functions and, if they
+	/// include the empty name, on the code outside of functions. The functions are transformed
+	/// concurrently if the context provides a thread pool, with the same result as sequentially.
+	/// Requires the step to be function-local and @a _ast to be in the form established by the FunctionGrouper.
+	virtual void run(OptimiserStepContext&, Block& _ast, std::set<YulName> const& _functions) const = 0;
+	/// Runs the step on @a _ast and @returns the names of the top-level functions it modified or added,
+	/// including the empty name if it modified the code outside of top-level functions or added, removed
+	/// or reordered functions. @returns nullopt if the step does not keep track of what it modified.
+	virtual std::optional<std::set<YulName>> runAndReportModified(OptimiserStepContext&, Block& _ast) const = 0;
 	/// @returns non-nullopt if the step cannot be run, for example because it requires
 	/// an SMT solver to be loaded, but none is available. In that case, the string
 	/// contains a human-readable reason.
@@ -73,12 +95,62 @@ private:
 		static constexpr bool value = decltype(test<T>(0))::value;
 	};
 
+	template<typename T>
+	struct HasRunAndReportModifiedMethod
+	{
+	private:
+		template<typename U> static auto test(int) -> decltype(U::runAndReportModified(
+			std::declval<OptimiserStepContext&>(),
+			std::declval<Block&>()
+		), std::true_type());
+		template<typename> static std::false_type test(...);
+
+	public:
+		static constexpr bool value = decltype(test<T>(0))::value;
+	};
+
+	template<typename T>
+	struct HasFunctionLocalRunMethod
+	{
+	private:
+		template<typename U> static auto test(int) -> decltype(U::run(
+			std::declval<OptimiserStepContext&>(),
+			std::declval<Block&>(),
+			std::declval<std::set<YulName> const&>()
+		), std::true_type());
+		template<typename> static std::false_type test(...);
+
+	public:
+		static constexpr bool value = decltype(test<T>(0))::value;
+	};
+
 public:
 	OptimiserStepInstance(): OptimiserStep{Step::name} {}
 	void run(OptimiserStepContext& _context, Block& _ast) const override
 	{
 		Step::run(_context, _ast);
 	}
+	bool isFunctionLocal() const override
+	{
+		return HasFunctionLocalRunMethod<Step>::value;
+	}
+	void run(OptimiserStepContext& _context, Block& _ast, std::set<YulName> const& _functions) const override
+	{
+		if constexpr (HasFunctionLocalRunMethod<Step>::value)
+			Step::run(_context, _ast, _functions);
+		else
+			yulAssert(false, "Step " + name + " cannot run on a selection of functions.");
+	}
+	std::optional<std::set<YulName>> runAndReportModified(OptimiserStepContext& _context, Block& _ast) const override
+	{
+		if constexpr (HasRunAndReportModifiedMethod<Step>::value)
+			return Step::runAndReportModified(_context, _ast);
+		else
+		{
+			Step::run(_context, _ast);
+			return std::nullopt;
+		}
+	}
 	std::optional<std::string> invalidInCurrentEnvironment() const override
 	{
 		if constexpr (HasInvalidInCurrentEnvironmentMethod<Step>::value)
@@ -26,12 +26,16 @@
 #include <libyul/AST.h>
 #include <libyul/Dialect.h>
 #include <libyul/Utilities.h>
+#include <libyul/YulString.h>
 
 #include <liblangutil/Token.h>
 #include <libsolutil/CommonData.h>
+#include <libsolutil/ThreadPool.h>
 
 #include <range/v3/action/remove_if.hpp>
 
+#include <algorithm>
+
 using namespace solidity;
 using namespace solidity::langutil;
 using namespace solidity::util;
@@ -40,6 +44,10 @@ using namespace solidity::yul;
 namespace
 {
 
+/// Number of batches per thread, so that threads that got small functions can take over
+/// more of the remaining work.
+size_t constexpr c_batchesPerThread = 4;
+
 bool hasLeadingOrTrailingDot(std::string_view const _s)
 {
 	yulAssert(!_s.empty());
@@ -56,6 +64,62 @@ void yul::removeEmptyBlocks(Block& _block)
 	ranges::actions::remove_if(_block.statements, isEmptyBlock);
 }
 
+std::vector<Statement*> yul::selectFunctions(Block& _block, std::set<YulName> const& _functions)
+{
+	bool const selectOutline = _functions.count(YulName{});
+	std::vector<Statement*> statements;
+	for (Statement& statement: _block.statements)
+		if (auto const* function = std::get_if<FunctionDefinition>(&statement))
+		{
+			if (_functions.count(function->name))
+				statements.push_back(&statement);
+		}
+		else if (selectOutline)
+			statements.push_back(&statement);
+	return statements;
+}
+
+std::vector<std::vector<Statement*>> yul::splitIntoBatches(
+	std::vector<Statement*> _statements,
+	ThreadPool const* _threadPool
+)
+{
+	// The calling thread helps while waiting for the batches, hence the additional thread.
+	size_t const batchCount = _threadPool ?
+		std::min(_statements.size(), (_threadPool->size() + 1) * c_batchesPerThread) :
+		1;
+	if (batchCount <= 1)
+		return {std::move(_statements)};
+
+	std::vector<std::vector<Statement*>> batches(batchCount);
+	for (size_t i = 0; i < _statements.size(); ++i)
+		batches[i * batchCount / _statements.size()].push_back(_statements[i]);
+	return batches;
+}
+
+void yul::forEachBatch(size_t _batchCount, ThreadPool* _threadPool, std::function<void(size_t)> const& _visit)
+{
+	if (!_threadPool || _batchCount <= 1)
+	{
+		for (size_t batch = 0; batch < _batchCount; ++batch)
+			_visit(batch);
+		return;
+	}
+
+	YulStringRepository& yulStringRepository = YulStringRepository::instance();
+	std::vector<std::future<void>> visits;
+	for (size_t batch = 0; batch < _batchCount; ++batch)
+		visits.push_back(_threadPool->submit([batch, &_visit, &yulStringRepository]() {
+			YulStringRepository::Scope yulStringScope(yulStringRepository);
+			_visit(batch);
+		}));
+	// Wait for all batches before rethrowing, so that none of them outlives the code it modifies.
+	for (std::future<void> const& visit: visits)
+		_threadPool->wait(visit);
+	for (std::future<void>& visit: visits)
+		visit.get();
+}
+
 bool yul::isRestrictedIdentifier(Dialect const& _dialect, YulName const& _identifier)
 {
 	return _identifier.empty() || hasLeadingOrTrailingDot(_identifier.str()) || TokenTraits::isYulKeyword(_identifier.str()) || _dialect.reservedIdentifier(_identifier.str());
@@ -28,13 +28,21 @@
 #include <libyul/optimiser/ASTWalker.h>
 #include <liblangutil/EVMVersion.h>
 
+#include <functional>
 #include <optional>
+#include <set>
+#include <vector>
 
 namespace solidity::evmasm
 {
 enum class Instruction: uint8_t;
 }
 
+namespace solidity::util
+{
+class ThreadPool;
+}
+
 namespace solidity::yul
 {
 
@@ -43,6 +51,22 @@ namespace solidity::yul
 /// the canonical form.
 void removeEmptyBlocks(Block& _block);
 
+/// @returns the top-level statements of @a _block that belong to the functions named in @a _functions,
+/// i.e. their definitions and, if @a _functions contains the empty name, all statements that are not
+/// function definitions. Used by steps that can run on a selection of functions.
+std::vector<Statement*> selectFunctions(Block& _block, std::set<YulName> const& _functions);
+
+/// Splits @a _statements into batches of consecutive statements, several per thread of @a _threadPool,
+/// or into a single batch if no thread pool is given.
+std::vector<std::vector<Statement*>> splitIntoBatches(
+	std::vector<Statement*> _statements,
+	util::ThreadPool const* _threadPool
+);
+
+/// Calls @a _visit with the indices of @a _batchCount batches, concurrently in @a _threadPool if given.
+/// Returns once all calls finished and rethrows the exception of the first batch that failed, if any.
+void forEachBatch(size_t _batchCount, util::ThreadPool* _threadPool, std::function<void(size_t _batch)> const& _visit);
+
 /// Returns true if a given literal can not be used as an identifier.
 /// This includes Yul keywords and builtins of the given dialect.
 bool isRestrictedIdentifier(Dialect const& _dialect, YulName const& _identifier);
@@ -23,6 +23,7 @@
 #include <libyul/optimiser/Metrics.h>
 #include <libyul/optimiser/ASTCopier.h>
 #include <libyul/optimiser/NameCollector.h>
+#include <libyul/optimiser/OptimizerUtilities.h>
 #include <libyul/Exceptions.h>
 #include <libyul/AST.h>
 
@@ -31,19 +32,35 @@
 using namespace solidity;
 using namespace solidity::yul;
 
+void Rematerialiser::run(OptimiserStepContext& _context, Block& _ast, std::set<YulName> const& _functions)
+{
+	std::vector<std::vector<Statement*>> batches =
+		splitIntoBatches(selectFunctions(_ast, _functions), _context.threadPool);
+	forEachBatch(batches.size(), _context.threadPool, [&](size_t _batch) {
+		// Variables are only referenced within the function that declares them.
+		for (Statement* statement: batches[_batch])
+			Rematerialiser{_context.dialect, VariableReferencesCounter::countReferences(*statement)}.visit(*statement);
+	});
+}
+
 void Rematerialiser::run(Dialect const& _dialect, Block& _ast, std::set<YulName> _varsToAlwaysRematerialize, bool _onlySelectedVariables)
 {
-	Rematerialiser{_dialect, _ast, std::move(_varsToAlwaysRematerialize), _onlySelectedVariables}(_ast);
+	Rematerialiser{
+		_dialect,
+		VariableReferencesCounter::countReferences(_ast),
+		std::move(_varsToAlwaysRematerialize),
+		_onlySelectedVariables
+	}(_ast);
 }
 
 Rematerialiser::Rematerialiser(
 	Dialect const& _dialect,
-	Block& _ast,
+	std::map<YulName, size_t> _referenceCounts,
 	std::set<YulName> _varsToAlwaysRematerialize,
 	bool _onlySelectedVariables
 ):
 	DataFlowAnalyzer(_dialect, MemoryAndStorage::Ignore),
-	m_referenceCounts(VariableReferencesCounter::countReferences(_ast)),
+	m_referenceCounts(std::move(_referenceCounts)),
 	m_varsToAlwaysRematerialize(std::move(_varsToAlwaysRematerialize)),
 	m_onlySelectedVariables(_onlySelectedVariables)
 {
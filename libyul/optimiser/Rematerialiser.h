@@ -47,6 +47,9 @@ public:
 		Block& _ast
 	) { run(_context.dialect, _ast); }
 
+	/// Runs the step only on the given top-level functions, see OptimiserStep.
+	static void run(OptimiserStepContext& _context, Block& _ast, std::set<YulName> const& _functions);
+
 	static void run(
 		Dialect const& _dialect,
 		Block& _ast,
@@ -57,7 +60,7 @@ public:
 protected:
 	Rematerialiser(
 		Dialect const& _dialect,
-		Block& _ast,
+		std::map<YulName, size_t> _referenceCounts,
 		std::set<YulName> _varsToAlwaysRematerialize = {},
 		bool _onlySelectedVariables = false
 	);
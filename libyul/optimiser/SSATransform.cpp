@@ -24,6 +24,7 @@
 
 #include <libyul/optimiser/NameCollector.h>
 #include <libyul/optimiser/NameDispenser.h>
+#include <libyul/optimiser/OptimizerUtilities.h>
 #include <libyul/AST.h>
 
 #include <libsolutil/CommonData.h>
@@ -35,6 +36,106 @@ using namespace solidity::langutil;
 namespace
 {
 
+/**
+ * Source of the names of new SSA variables.
+ *
+ * Either hands out names from a NameDispenser directly or, while a batch of functions is
+ * transformed concurrently with others, placeholders that are replaced by names from the
+ * NameDispenser afterwards. The names are requested in the order in which a sequential
+ * transformation would have requested them, so the result does not depend on the batches.
+ */
+class NewNames
+{
+public:
+	explicit NewNames(NameDispenser& _dispenser): m_dispenser(&_dispenser) {}
+	/// Hands out placeholders that are unique among all batches.
+	explicit NewNames(size_t _batch): m_batch(_batch), m_requests(1) {}
+
+	YulName newName(YulName _hint);
+	/// Starts the next pass over the batch.
+	void nextPass();
+
+	/// @returns the names for the placeholders handed out in all @a _batches,
+	/// requested pass by pass and, within a pass, batch by batch from @a _dispenser.
+	static std::map<YulName, YulName> dispense(std::vector<NewNames> const& _batches, NameDispenser& _dispenser);
+
+private:
+	NameDispenser* m_dispenser = nullptr;
+	size_t m_batch = 0;
+	/// Hints and the placeholders handed out for them, for each pass.
+	std::vector<std::vector<std::pair<YulName, YulName>>> m_requests;
+};
+
+YulName NewNames::newName(YulName _hint)
+{
+	if (m_dispenser)
+		return m_dispenser->newName(_hint);
+
+	// Not a valid identifier, so it cannot clash with any name in the code.
+	YulName placeholder{
+		"@" + std::to_string(m_batch) + "." +
+		std::to_string(m_requests.size() - 1) + "." +
+		std::to_string(m_requests.back().size())
+	};
+	m_requests.back().emplace_back(_hint, placeholder);
+	return placeholder;
+}
+
+void NewNames::nextPass()
+{
+	if (!m_dispenser)
+		m_requests.emplace_back();
+}
+
+std::map<YulName, YulName> NewNames::dispense(std::vector<NewNames> const& _batches, NameDispenser& _dispenser)
+{
+	std::map<YulName, YulName> names;
+	for (size_t pass = 0; !_batches.empty() && pass < _batches.front().m_requests.size(); ++pass)
+		for (NewNames const& batch: _batches)
+		{
+			yulAssert(!batch.m_dispenser && batch.m_requests.size() == _batches.front().m_requests.size());
+			for (auto const& [hint, placeholder]: batch.m_requests[pass])
+				names[placeholder] = _dispenser.newName(hint);
+		}
+	return names;
+}
+
+/**
+ * Replaces the placeholders handed out by NewNames by the final names.
+ */
+class PlaceholderReplacer: public ASTModifier
+{
+public:
+	explicit PlaceholderReplacer(std::map<YulName, YulName> const& _names): m_names(_names) {}
+
+	using ASTModifier::operator();
+	void operator()(Identifier& _identifier) override;
+	void operator()(VariableDeclaration& _varDecl) override;
+
+private:
+	void replace(YulName& _name) const;
+
+	std::map<YulName, YulName> const& m_names;
+};
+
+void PlaceholderReplacer::operator()(Identifier& _identifier)
+{
+	replace(_identifier.name);
+}
+
+void PlaceholderReplacer::operator()(VariableDeclaration& _varDecl)
+{
+	for (NameWithDebugData& variable: _varDecl.variables)
+		replace(variable.name);
+	ASTModifier::operator()(_varDecl);
+}
+
+void PlaceholderReplacer::replace(YulName& _name) const
+{
+	if (auto name = m_names.find(_name); name != m_names.end())
+		_name = name->second;
+}
+
 /**
  * First step of SSA transform: Introduces new SSA variables for each assignment or
  * declaration of a variable to be replaced.
@@ -43,17 +144,17 @@ class IntroduceSSA: public ASTModifier
 {
 public:
 	explicit IntroduceSSA(
-		NameDispenser& _nameDispenser,
+		NewNames& _newNames,
 		std::set<YulName> const& _variablesToReplace
 	):
-		m_nameDispenser(_nameDispenser),
+		m_newNames(_newNames),
 		m_variablesToReplace(_variablesToReplace)
 	{ }
 
 	void operator()(Block& _block) override;
 
 private:
-	NameDispenser& m_nameDispenser;
+	NewNames& m_newNames;
 	std::set<YulName> const& m_variablesToReplace;
 };
 
@@ -86,7 +187,7 @@ void IntroduceSSA::operator()(Block& _block)
 				for (auto const& var: varDecl.variables)
 				{
 					YulName oldName = var.name;
-					YulName newName = m_nameDispenser.newName(oldName);
+					YulName newName = m_newNames.newName(oldName);
 					newVariables.emplace_back(NameWithDebugData{debugData, newName});
 					statements.emplace_back(VariableDeclaration{
 						debugData,
@@ -113,7 +214,7 @@ void IntroduceSSA::operator()(Block& _block)
 				for (auto const& var: assignment.variableNames)
 				{
 					YulName oldName = var.name;
-					YulName newName = m_nameDispenser.newName(oldName);
+					YulName newName = m_newNames.newName(oldName);
 					newVariables.emplace_back(NameWithDebugData{debugData, newName});
 					statements.emplace_back(Assignment{
 						debugData,
@@ -139,10 +240,10 @@ class IntroduceControlFlowSSA: public ASTModifier
 {
 public:
 	explicit IntroduceControlFlowSSA(
-		NameDispenser& _nameDispenser,
+		NewNames& _newNames,
 		std::set<YulName> const& _variablesToReplace
 	):
-		m_nameDispenser(_nameDispenser),
+		m_newNames(_newNames),
 		m_variablesToReplace(_variablesToReplace)
 	{ }
 
@@ -152,7 +253,7 @@ public:
 	void operator()(Block& _block) override;
 
 private:
-	NameDispenser& m_nameDispenser;
+	NewNames& m_newNames;
 	std::set<YulName> const& m_variablesToReplace;
 	/// Variables (that are to be replaced) currently in scope.
 	std::set<YulName> m_variablesInScope;
@@ -218,7 +319,7 @@ void IntroduceControlFlowSSA::operator()(Block& _block)
 			std::vector<Statement> toPrepend;
 			for (YulName toReassign: m_variablesToReassign)
 			{
-				YulName newName = m_nameDispenser.newName(toReassign);
+				YulName newName = m_newNames.newName(toReassign);
 				toPrepend.emplace_back(VariableDeclaration{
 					debugDataOf(_s),
 					{NameWithDebugData{debugDataOf(_s), newName}},
@@ -364,14 +465,58 @@ void PropagateValues::operator()(Block& _block)
 	m_clearAtEndOfBlock = std::move(clearAtParentBlock);
 }
 
+/// Runs the passes of the SSA transform on @a _statements.
+void transform(std::vector<Statement*> const& _statements, std::set<YulName> const& _variablesToReplace, NewNames& _newNames)
+{
+	// Each of the passes runs on all statements before the next, so that new names
+	// are requested in the same order as when running on the whole block.
+	IntroduceSSA introduceSSA{_newNames, _variablesToReplace};
+	for (Statement* statement: _statements)
+		introduceSSA.visit(*statement);
+	_newNames.nextPass();
+	IntroduceControlFlowSSA introduceControlFlowSSA{_newNames, _variablesToReplace};
+	for (Statement* statement: _statements)
+		introduceControlFlowSSA.visit(*statement);
+	PropagateValues propagateValues{_variablesToReplace};
+	for (Statement* statement: _statements)
+		propagateValues.visit(*statement);
+}
+
 }
 
 void SSATransform::run(OptimiserStepContext& _context, Block& _ast)
 {
 	std::set<YulName> assignedVariables = assignedVariableNames(_ast);
-	IntroduceSSA{_context.dispenser, assignedVariables}(_ast);
-	IntroduceControlFlowSSA{_context.dispenser, assignedVariables}(_ast);
+	NewNames newNames{_context.dispenser};
+	IntroduceSSA{newNames, assignedVariables}(_ast);
+	IntroduceControlFlowSSA{newNames, assignedVariables}(_ast);
 	PropagateValues{assignedVariables}(_ast);
 }
 
+void SSATransform::run(OptimiserStepContext& _context, Block& _ast, std::set<YulName> const& _functions)
+{
+	std::set<YulName> assignedVariables = assignedVariableNames(_ast);
+	std::vector<std::vector<Statement*>> batches =
+		splitIntoBatches(selectFunctions(_ast, _functions), _context.threadPool);
+	if (batches.size() <= 1)
+	{
+		NewNames newNames{_context.dispenser};
+		for (auto const& batch: batches)
+			transform(batch, assignedVariables, newNames);
+		return;
+	}
 
+	std::vector<NewNames> newNames;
+	for (size_t batch = 0; batch < batches.size(); ++batch)
+		newNames.emplace_back(batch);
+	forEachBatch(batches.size(), _context.threadPool, [&](size_t _batch) {
+		transform(batches[_batch], assignedVariables, newNames[_batch]);
+	});
+
+	std::map<YulName, YulName> const names = NewNames::dispense(newNames, _context.dispenser);
+	forEachBatch(batches.size(), _context.threadPool, [&](size_t _batch) {
+		PlaceholderReplacer replacer{names};
+		for (Statement* statement: batches[_batch])
+			replacer.visit(*statement);
+	});
+}
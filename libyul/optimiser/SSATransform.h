@@ -93,6 +93,8 @@ class SSATransform: public ASTModifier
 public:
 	static constexpr char const* name{"SSATransform"};
 	static void run(OptimiserStepContext& _context, Block& _ast);
+	/// Runs the step only on the given top-level functions, see OptimiserStep.
+	static void run(OptimiserStepContext&, Block& _ast, std::set<YulName> const& _functions);
 };
 
 }
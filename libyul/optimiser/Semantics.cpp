@@ -94,6 +94,13 @@ bool MSizeFinder::containsMSize(Dialect const& _dialect, Block const& _ast)
 	return finder.m_msizeFound;
 }
 
+bool MSizeFinder::containsMSize(Dialect const& _dialect, Statement const& _statement)
+{
+	MSizeFinder finder(_dialect);
+	finder.visit(_statement);
+	return finder.m_msizeFound;
+}
+
 bool MSizeFinder::containsMSize(Object const& _object)
 {
 	yulAssert(_object.dialect());
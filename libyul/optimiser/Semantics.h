@@ -149,6 +149,7 @@ class MSizeFinder: public ASTWalker
 {
 public:
 	static bool containsMSize(Dialect const& _dialect, Block const& _ast);
+	static bool containsMSize(Dialect const& _dialect, Statement const& _statement);
 	static bool containsMSize(Object const& _object);
 
 	using ASTWalker::operator();
@@ -25,6 +25,7 @@
 #include <libyul/optimiser/VarDeclInitializer.h>
 #include <libyul/optimiser/BlockFlattener.h>
 #include <libyul/optimiser/CallGraphGenerator.h>
+#include <libyul/optimiser/ChangeTracker.h>
 #include <libyul/optimiser/CircularReferencesPruner.h>
 #include <libyul/optimiser/ControlFlowSimplifier.h>
 #include <libyul/optimiser/ConditionalSimplifier.h>
@@ -95,9 +96,11 @@ void OptimiserSuite::run(
 	std::string_view _optimisationSequence,
 	std::string_view _optimisationCleanupSequence,
 	std::optional<size_t> _expectedExecutionsPerDeployment,
-	std::set<YulName> const& _externallyUsedIdentifiers
+	std::set<YulName> const& _externallyUsedIdentifiers,
+	util::ThreadPool* _threadPool
 )
 {
+	util::Profiler::Probe objectProbe{"yulOptimizer", "OptimiserSuite", _object.name};
 	yulAssert(_object.dialect());
 	auto const& dialect = *_object.dialect();
 	EVMDialect const* evmDialect = dynamic_cast<EVMDialect const*>(_object.dialect());
@@ -110,7 +113,7 @@ void OptimiserSuite::run(
 
 	Block astRoot;
 	{
-		PROFILER_PROBE("Disambiguator", probe);
+		util::Profiler::Probe probe{"yulOptimizer", "Disambiguator"};
 		astRoot = std::get<Block>(Disambiguator(
 			dialect,
 			*_object.analysisInfo,
@@ -119,7 +122,13 @@ void OptimiserSuite::run(
 	}
 
 	NameDispenser dispenser{dialect, astRoot, reservedIdentifiers};
-	OptimiserStepContext context{dialect, dispenser, reservedIdentifiers, _expectedExecutionsPerDeployment};
+	OptimiserStepContext context{
+		dialect,
+		dispenser,
+		reservedIdentifiers,
+		_expectedExecutionsPerDeployment,
+		_threadPool
+	};
 
 	OptimiserSuite suite(context, Debug::None);
 
@@ -138,7 +147,7 @@ void OptimiserSuite::run(
 	// message once we perform code generation.
 	if (!usesOptimizedCodeGenerator)
 	{
-		PROFILER_PROBE("StackCompressor", probe);
+		util::Profiler::Probe probe{"yulOptimizer", "StackCompressor"};
 		_object.setCode(std::make_shared<AST>(dialect, std::move(astRoot)));
 		astRoot = std::get<1>(StackCompressor::run(
 			_object,
@@ -158,13 +167,13 @@ void OptimiserSuite::run(
 	{
 		yulAssert(_meter, "");
 		{
-			PROFILER_PROBE("ConstantOptimiser", probe);
+			util::Profiler::Probe probe{"yulOptimizer", "ConstantOptimiser"};
 			ConstantOptimiser{*evmDialect, *_meter}(astRoot);
 		}
 		if (usesOptimizedCodeGenerator)
 		{
 			{
-				PROFILER_PROBE("StackCompressor", probe);
+				util::Profiler::Probe probe{"yulOptimizer", "StackCompressor"};
 				_object.setCode(std::make_shared<AST>(dialect, std::move(astRoot)));
 				astRoot = std::get<1>(StackCompressor::run(
 					_object,
@@ -174,14 +183,14 @@ void OptimiserSuite::run(
 			}
 			if (evmDialect->providesObjectAccess())
 			{
-				PROFILER_PROBE("StackLimitEvader", probe);
+				util::Profiler::Probe probe{"yulOptimizer", "StackLimitEvader"};
 				_object.setCode(std::make_shared<AST>(dialect, std::move(astRoot)));
 				astRoot = StackLimitEvader::run(suite.m_context, _object);
 			}
 		}
 		else if (evmDialect->providesObjectAccess() && _optimizeStackAllocation)
 		{
-			PROFILER_PROBE("StackLimitEvader", probe);
+			util::Profiler::Probe probe{"yulOptimizer", "StackLimitEvader"};
 			_object.setCode(std::make_shared<AST>(dialect, std::move(astRoot)));
 			astRoot = StackLimitEvader::run(suite.m_context, _object);
 		}
@@ -189,11 +198,11 @@ void OptimiserSuite::run(
 
 	dispenser.reset(astRoot);
 	{
-		PROFILER_PROBE("NameSimplifier", probe);
+		util::Profiler::Probe probe{"yulOptimizer", "NameSimplifier"};
 		NameSimplifier::run(suite.m_context, astRoot);
 	}
 	{
-		PROFILER_PROBE("VarNameCleaner", probe);
+		util::Profiler::Probe probe{"yulOptimizer", "VarNameCleaner"};
 		VarNameCleaner::run(suite.m_context, astRoot);
 	}
 
@@ -222,9 +231,9 @@ std::map<std::string, std::unique_ptr<OptimiserStep>> optimiserStepCollection()
 
 std::map<std::string, std::unique_ptr<OptimiserStep>> const& OptimiserSuite::allSteps()
 {
-	static std::map<std::string, std::unique_ptr<OptimiserStep>> instance;
-	if (instance.empty())
-		instance = optimiserStepCollection<
+	// NOTE: Initialized in a single statement to make the initialization thread-safe.
+	static std::map<std::string, std::unique_ptr<OptimiserStep>> const instance =
+		optimiserStepCollection<
 			BlockFlattener,
 			CircularReferencesPruner,
 			CommonSubexpressionEliminator,
@@ -370,6 +379,23 @@ bool OptimiserSuite::isEmptyOptimizerSequence(std::string const& _sequence)
 }
 
 void OptimiserSuite::runSequence(std::string_view _stepAbbreviations, Block& _ast, bool _repeatUntilStable)
+{
+	ChangeTracker changes(m_context.dialect, _ast);
+	runSequence(_stepAbbreviations, _ast, _repeatUntilStable, changes);
+}
+
+void OptimiserSuite::runSequence(std::vector<std::string> const& _steps, Block& _ast)
+{
+	ChangeTracker changes(m_context.dialect, _ast);
+	runSequence(_steps, _ast, changes);
+}
+
+bool OptimiserSuite::runSequence(
+	std::string_view _stepAbbreviations,
+	Block& _ast,
+	bool _repeatUntilStable,
+	ChangeTracker& _changes
+)
 {
 	validateSequence(_stepAbbreviations);
 
@@ -440,43 +466,81 @@ void OptimiserSuite::runSequence(std::string_view _stepAbbreviations, Block& _as
 	}
 
 	// NOTE: If _repeatUntilStable is false, the value will not be used so do not calculate it.
-	size_t codeSize = (_repeatUntilStable ? CodeSize::codeSizeIncludingFunctions(_ast) : 0);
+	size_t codeSize = (_repeatUntilStable ? _changes.codeSizeIncludingFunctions(_ast) : 0);
 
+	bool modified = false;
 	for (size_t round = 0; round < MaxRounds; ++round)
 	{
+		bool modifiedInRound = false;
 		for (auto const& [subsequence, repeat]: subsequences)
 		{
 			if (repeat)
-				runSequence(subsequence, _ast, true);
+				modifiedInRound |= runSequence(subsequence, _ast, true, _changes);
 			else
-				runSequence(abbreviationsToSteps(subsequence), _ast);
+				modifiedInRound |= runSequence(abbreviationsToSteps(subsequence), _ast, _changes);
 		}
+		modified |= modifiedInRound;
 
-		if (!_repeatUntilStable)
+		// Code that was not modified also has the same size.
+		if (!_repeatUntilStable || !modifiedInRound)
 			break;
 
-		size_t newSize = CodeSize::codeSizeIncludingFunctions(_ast);
+		size_t newSize = _changes.codeSizeIncludingFunctions(_ast);
 		if (newSize == codeSize)
 			break;
 		codeSize = newSize;
 	}
+	return modified;
 }
 
-void OptimiserSuite::runSequence(std::vector<std::string> const& _steps, Block& _ast)
+bool OptimiserSuite::runSequence(std::vector<std::string> const& _steps, Block& _ast, ChangeTracker& _changes)
 {
 	std::unique_ptr<Block> copy;
 	if (m_debug == Debug::PrintChanges)
 		copy = std::make_unique<Block>(std::get<Block>(ASTCopier{}(_ast)));
+	bool modified = false;
 	for (std::string const& step: _steps)
 	{
+		// Steps only depend on the code they run on, so they do not modify code they did not modify before.
+		if (_changes.unmodifiedBy(step))
+			continue;
+
+		OptimiserStep const& optimiserStep = *allSteps().at(step);
+		// Function-local steps only run on the functions they might modify.
+		std::optional<std::set<YulName>> functions;
+		if (optimiserStep.isFunctionLocal() && _changes.grouped())
+		{
+			functions = _changes.functionsToRun(step, _ast);
+			if (functions->empty())
+			{
+				_changes.recordUnmodifiedBy(step);
+				continue;
+			}
+		}
+
 		if (m_debug == Debug::PrintStep)
 			std::cout << "Running " << step << std::endl;
 
+		std::optional<std::set<YulName>> reported;
 		{
-			PROFILER_PROBE(step, probe);
-			allSteps().at(step)->run(m_context, _ast);
+			util::Profiler::Probe probe{"yulOptimizer", step};
+			if (functions)
+				optimiserStep.run(m_context, _ast, *functions);
+			else
+				reported = optimiserStep.runAndReportModified(m_context, _ast);
 		}
 
+		// Only the code a step ran on or reported to have modified is hashed again.
+		// Other steps may modify any part of the code, so all of it is hashed again after them.
+		std::set<YulName> const changed =
+			functions ? _changes.update(_ast, step, *functions) :
+			reported ? _changes.update(_ast, *reported) :
+			_changes.update(_ast);
+		if (changed.empty())
+			_changes.recordUnmodifiedBy(step);
+		else
+			modified = true;
+
 		if (m_debug == Debug::PrintChanges)
 		{
 			// TODO should add switch to also compare variable names!
@@ -490,4 +554,5 @@ void OptimiserSuite::runSequence(std::vector<std::string> const& _steps, Block&
 			}
 		}
 	}
+	return modified;
 }
@@ -32,10 +32,16 @@
 #include <string_view>
 #include <memory>
 
+namespace solidity::util
+{
+class ThreadPool;
+}
+
 namespace solidity::yul
 {
 
 struct AsmAnalysisInfo;
+class ChangeTracker;
 class Dialect;
 class GasMeter;
 class Object;
@@ -62,6 +68,8 @@ public:
 	OptimiserSuite(OptimiserStepContext& _context, Debug _debug = Debug::None): m_context(_context), m_debug(_debug) {}
 
 	/// The value nullopt for `_expectedExecutionsPerDeployment` represents creation code.
+	/// @param _threadPool If given, steps that run on a selection of functions transform
+	///     them concurrently. The result does not depend on it.
 	static void run(
 		GasMeter const* _meter,
 		Object& _object,
@@ -69,7 +77,8 @@ public:
 		std::string_view _optimisationSequence,
 		std::string_view _optimisationCleanupSequence,
 		std::optional<size_t> _expectedExecutionsPerDeployment,
-		std::set<YulName> const& _externallyUsedIdentifiers = {}
+		std::set<YulName> const& _externallyUsedIdentifiers = {},
+		util::ThreadPool* _threadPool = nullptr
 	);
 
 	/// Ensures that specified sequence of step abbreviations is well-formed and can be executed.
@@ -80,7 +89,11 @@ public:
 	static bool isEmptyOptimizerSequence(std::string const& _sequence);
 
 
+	/// Runs the given steps on @a _ast. Steps that are known not to modify the code because they
+	/// already ran on the same code without modifying it are skipped.
 	void runSequence(std::vector<std::string> const& _steps, Block& _ast);
+	/// Runs the steps given by abbreviations on @a _ast. Bracketed subsequences are repeated until
+	/// they do not modify the code or its size anymore, but at most MaxRounds times.
 	void runSequence(std::string_view _stepAbbreviations, Block& _ast, bool _repeatUntilStable = false);
 
 	static std::map<std::string, std::unique_ptr<OptimiserStep>> const& allSteps();
@@ -88,6 +101,11 @@ public:
 	static std::map<char, std::string> const& stepAbbreviationToNameMap();
 
 private:
+	/// Versions of @a runSequence that keep track of the modifications of @a _ast in @a _changes.
+	/// @returns true if any of the steps modified the code.
+	bool runSequence(std::vector<std::string> const& _steps, Block& _ast, ChangeTracker& _changes);
+	bool runSequence(std::string_view _stepAbbreviations, Block& _ast, bool _repeatUntilStable, ChangeTracker& _changes);
+
 	OptimiserStepContext& m_context;
 	Debug m_debug;
 };
@@ -53,6 +53,26 @@ void UnusedAssignEliminator::run(OptimiserStepContext& _context, Block& _ast)
 	remover(_ast);
 }
 
+void UnusedAssignEliminator::run(OptimiserStepContext& _context, Block& _ast, std::set<YulName> const& _functions)
+{
+	std::map<YulName, ControlFlowSideEffects> const controlFlowSideEffects =
+		ControlFlowSideEffectsCollector{_context.dialect, _ast}.functionSideEffectsNamed();
+	std::vector<std::vector<Statement*>> batches =
+		splitIntoBatches(selectFunctions(_ast, _functions), _context.threadPool);
+	forEachBatch(batches.size(), _context.threadPool, [&](size_t _batch) {
+		UnusedAssignEliminator uae{_context.dialect, controlFlowSideEffects};
+		for (Statement* statement: batches[_batch])
+			uae.visit(*statement);
+
+		uae.m_storesToRemove += uae.m_allStores - uae.m_usedStores;
+
+		std::set<Statement const*> toRemove{uae.m_storesToRemove.begin(), uae.m_storesToRemove.end()};
+		StatementRemover remover{toRemove};
+		for (Statement* statement: batches[_batch])
+			remover.visit(*statement);
+	});
+}
+
 void UnusedAssignEliminator::operator()(Identifier const& _identifier)
 {
 	markUsed(_identifier.name);
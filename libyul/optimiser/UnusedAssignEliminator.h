@@ -118,6 +118,8 @@ class UnusedAssignEliminator: public UnusedStoreBase<YulName>
 public:
 	static constexpr char const* name{"UnusedAssignEliminator"};
 	static void run(OptimiserStepContext&, Block& _ast);
+	/// Runs the step only on the given top-level functions, see OptimiserStep.
+	static void run(OptimiserStepContext&, Block& _ast, std::set<YulName> const& _functions);
 
 	explicit UnusedAssignEliminator(
 		Dialect const& _dialect,
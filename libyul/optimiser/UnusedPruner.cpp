@@ -30,13 +30,19 @@
 #include <libyul/Dialect.h>
 #include <libyul/SideEffects.h>
 
+#include <libsolutil/Common.h>
+
 using namespace solidity;
 using namespace solidity::yul;
 
-void UnusedPruner::run(OptimiserStepContext& _context, Block& _ast)
+std::set<YulName> UnusedPruner::runAndReportModified(OptimiserStepContext& _context, Block& _ast)
 {
-	UnusedPruner::runUntilStabilisedOnFullAST(_context.dialect, _ast, _context.reservedIdentifiers);
+	std::set<YulName> modified;
+	UnusedPruner::runUntilStabilisedOnFullAST(_context.dialect, _ast, _context.reservedIdentifiers, &modified);
+	if (!FunctionGrouper::alreadyGrouped(_ast))
+		modified.insert(YulName{});
 	FunctionGrouper::run(_context, _ast);
+	return modified;
 }
 
 UnusedPruner::UnusedPruner(
@@ -44,11 +50,13 @@ UnusedPruner::UnusedPruner(
 	Block& _ast,
 	bool _allowMSizeOptimization,
 	std::map<FunctionHandle, SideEffects> const* _functionSideEffects,
-	std::set<YulName> const& _externallyUsedFunctions
+	std::set<YulName> const& _externallyUsedFunctions,
+	std::set<YulName>* _modifiedFunctions
 ):
 	m_dialect(_dialect),
 	m_allowMSizeOptimization(_allowMSizeOptimization),
-	m_functionSideEffects(_functionSideEffects)
+	m_functionSideEffects(_functionSideEffects),
+	m_modifiedFunctions(_modifiedFunctions)
 {
 	m_references = ReferencesCounter::countReferences(_ast);
 	for (auto const& f: _externallyUsedFunctions)
@@ -57,6 +65,7 @@ UnusedPruner::UnusedPruner(
 
 void UnusedPruner::operator()(Block& _block)
 {
+	bool modified = false;
 	for (auto&& statement: _block.statements)
 		if (std::holds_alternative<FunctionDefinition>(statement))
 		{
@@ -92,11 +101,14 @@ void UnusedPruner::operator()(Block& _block)
 					statement = Block{std::move(varDecl.debugData), {}};
 				}
 				else if (varDecl.variables.size() == 1 && m_dialect.discardFunctionHandle())
+				{
 					statement = ExpressionStatement{varDecl.debugData, FunctionCall{
 						varDecl.debugData,
 						BuiltinName{varDecl.debugData, *m_dialect.discardFunctionHandle()},
 						{*std::move(varDecl.value)}
 					}};
+					modified = true;
+				}
 			}
 		}
 		else if (std::holds_alternative<ExpressionStatement>(statement))
@@ -112,17 +124,32 @@ void UnusedPruner::operator()(Block& _block)
 			}
 		}
 
+	// All other modifications replace statements by empty blocks, which are removed here.
+	size_t const statementCount = _block.statements.size();
 	removeEmptyBlocks(_block);
+	if (m_modifiedFunctions && (modified || _block.statements.size() != statementCount))
+		m_modifiedFunctions->insert(m_currentFunction);
 
+	ScopedSaveAndRestore blockDepth(m_blockDepth, m_blockDepth + 1);
 	ASTModifier::operator()(_block);
 }
 
+void UnusedPruner::operator()(FunctionDefinition& _function)
+{
+	ScopedSaveAndRestore currentFunction(
+		m_currentFunction,
+		m_blockDepth == 1 ? _function.name : YulName{m_currentFunction}
+	);
+	ASTModifier::operator()(_function);
+}
+
 void UnusedPruner::runUntilStabilised(
 	Dialect const& _dialect,
 	Block& _ast,
 	bool _allowMSizeOptimization,
 	std::map<FunctionHandle, SideEffects> const* _functionSideEffects,
-	std::set<YulName> const& _externallyUsedFunctions
+	std::set<YulName> const& _externallyUsedFunctions,
+	std::set<YulName>* _modifiedFunctions
 )
 {
 	while (true)
@@ -132,7 +159,8 @@ void UnusedPruner::runUntilStabilised(
 			_ast,
 			_allowMSizeOptimization,
 			_functionSideEffects,
-			_externallyUsedFunctions
+			_externallyUsedFunctions,
+			_modifiedFunctions
 		);
 		pruner(_ast);
 		if (!pruner.shouldRunAgain())
@@ -143,13 +171,21 @@ void UnusedPruner::runUntilStabilised(
 void UnusedPruner::runUntilStabilisedOnFullAST(
 	Dialect const& _dialect,
 	Block& _ast,
-	std::set<YulName> const& _externallyUsedFunctions
+	std::set<YulName> const& _externallyUsedFunctions,
+	std::set<YulName>* _modifiedFunctions
 )
 {
 	std::map<FunctionHandle, SideEffects> functionSideEffects =
 		SideEffectsPropagator::sideEffects(_dialect, CallGraphGenerator::callGraph(_ast));
 	bool allowMSizeOptimization = !MSizeFinder::containsMSize(_dialect, _ast);
-	runUntilStabilised(_dialect, _ast, allowMSizeOptimization, &functionSideEffects, _externallyUsedFunctions);
+	runUntilStabilised(
+		_dialect,
+		_ast,
+		allowMSizeOptimization,
+		&functionSideEffects,
+		_externallyUsedFunctions,
+		_modifiedFunctions
+	);
 }
 
 bool UnusedPruner::used(YulName _name) const
@@ -50,21 +50,27 @@ class UnusedPruner: public ASTModifier
 {
 public:
 	static constexpr char const* name{"UnusedPruner"};
-	static void run(OptimiserStepContext& _context, Block& _ast);
+	static void run(OptimiserStepContext& _context, Block& _ast) { runAndReportModified(_context, _ast); }
+	/// Runs the step and @returns the top-level functions it modified, see OptimiserStep.
+	static std::set<YulName> runAndReportModified(OptimiserStepContext& _context, Block& _ast);
 
 	using ASTModifier::operator();
 	void operator()(Block& _block) override;
+	void operator()(FunctionDefinition& _function) override;
 
 	// @returns true iff the code changed in the previous run.
 	bool shouldRunAgain() const { return m_shouldRunAgain; }
 
 	// Run the pruner until the code does not change anymore.
+	// If @a _modifiedFunctions is given, the names of the modified top-level functions are added to it,
+	// with the empty name standing for the code outside of them.
 	static void runUntilStabilised(
 		Dialect const& _dialect,
 		Block& _ast,
 		bool _allowMSizeOptimization,
 		std::map<FunctionHandle, SideEffects> const* _functionSideEffects = nullptr,
-		std::set<YulName> const& _externallyUsedFunctions = {}
+		std::set<YulName> const& _externallyUsedFunctions = {},
+		std::set<YulName>* _modifiedFunctions = nullptr
 	);
 
 	/// Run the pruner until the code does not change anymore.
@@ -74,7 +80,8 @@ public:
 	static void runUntilStabilisedOnFullAST(
 		Dialect const& _dialect,
 		Block& _ast,
-		std::set<YulName> const& _externallyUsedFunctions = {}
+		std::set<YulName> const& _externallyUsedFunctions = {},
+		std::set<YulName>* _modifiedFunctions = nullptr
 	);
 
 private:
@@ -83,7 +90,8 @@ private:
 		Block& _ast,
 		bool _allowMSizeOptimization,
 		std::map<FunctionHandle, SideEffects> const* _functionSideEffects = nullptr,
-		std::set<YulName> const& _externallyUsedFunctions = {}
+		std::set<YulName> const& _externallyUsedFunctions = {},
+		std::set<YulName>* _modifiedFunctions = nullptr
 	);
 
 	bool used(YulName _name) const;
@@ -94,6 +102,11 @@ private:
 	std::map<FunctionHandle, SideEffects> const* m_functionSideEffects = nullptr;
 	bool m_shouldRunAgain = false;
 	std::map<FunctionHandle, size_t> m_references;
+	std::set<YulName>* m_modifiedFunctions = nullptr;
+	/// The top-level function the visited code belongs to, empty outside of top-level functions.
+	YulName m_currentFunction;
+	/// Number of blocks the visited code is nested in.
+	size_t m_blockDepth = 0;
 };
 
 }
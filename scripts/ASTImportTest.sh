@@ -119,6 +119,8 @@ function test_ast_import_export_equivalence
     local export_command=("$SOLC" --combined-json ast --pretty-json --json-indent 4 "${input_files[@]}")
     local import_command=("$SOLC" --import-ast --combined-json ast --pretty-json --json-indent 4 expected.json)
     local import_via_standard_json_command=("$SOLC" --combined-json ast --pretty-json --json-indent 4 --standard-json standard_json_input.json)
+    local export_binary_command=("$SOLC" --ast-binary --overwrite --output-dir binary_ast "${input_files[@]}")
+    local import_binary_command=("$SOLC" --import-ast --combined-json ast --pretty-json --json-indent 4 binary_ast/combined_ast.bin)
 
     # export ast - save ast json as expected result (silently)
     if ! "${export_command[@]}" > expected.json 2> stderr_export.txt
@@ -150,6 +152,22 @@ function test_ast_import_export_equivalence
         return 1
     fi
 
+    # export ast in the binary format (silently)
+    if ! "${export_binary_command[@]}" > stdout_export.txt 2> stderr_export.txt
+    then
+        print_stderr_stdout "ERROR: AST reimport failed (binary export) for input file ${sol_file}." ./stderr_export.txt ./stdout_export.txt
+        print_used_commands "$(pwd)" "${export_binary_command[*]}" "${import_binary_command[*]}"
+        return 1
+    fi
+
+    # (re)import binary ast - and export it again as obtained result (silently)
+    if ! "${import_binary_command[@]}" > obtained_binary.json 2> stderr_import.txt
+    then
+        print_stderr_stdout "ERROR: AST reimport failed (binary import) for input file ${sol_file}." ./stderr_import.txt ./obtained_binary.json
+        print_used_commands "$(pwd)" "${export_binary_command[*]}" "${import_binary_command[*]}"
+        return 1
+    fi
+
     jq .sources expected.json > expected_standard_json.json
     jq .sources obtained_standard_json.json >  obtained_standard_json_.json
     jq 'walk(if type == "object" and has("ast") then .AST = .ast | del(.ast) else . end)' < obtained_standard_json_.json > obtained_standard_json.json
@@ -157,7 +175,7 @@ function test_ast_import_export_equivalence
     mv obtained_standard_json_.json obtained_standard_json.json
 
     # compare expected and obtained ASTs
-    if ! diff_files expected.json obtained.json || ! diff_files expected_standard_json.json obtained_standard_json.json
+    if ! diff_files expected.json obtained.json || ! diff_files expected.json obtained_binary.json || ! diff_files expected_standard_json.json obtained_standard_json.json
     then
         printError "ERROR: AST reimport failed for ${sol_file}"
         if (( EXIT_ON_ERROR == 1 ))
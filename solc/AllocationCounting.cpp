@@ -0,0 +1,104 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Replacements of the global allocation functions that report the allocated memory to the
+ * profiler, so that the profile shows the memory allocated in each stage of the compilation.
+ * The array and nothrow variants of the standard library call the functions replaced here.
+ * The allocations are only reported by threads that have a current profiler session, so that
+ * compilations without profiling do not pay for looking up the size of each allocation.
+ */
+
+#include <libsolutil/Profiler.h>
+
+#if defined(__GLIBC__)
+
+#include <malloc.h>
+
+#include <cstdlib>
+#include <new>
+
+using namespace solidity::util;
+
+namespace
+{
+
+void* allocate(std::size_t _size, std::size_t _alignment)
+{
+	std::size_t const size = _size > 0 ? _size : 1;
+	while (true)
+	{
+		void* pointer = _alignment > alignof(std::max_align_t) ?
+			std::aligned_alloc(_alignment, (size + _alignment - 1) / _alignment * _alignment) :
+			std::malloc(size);
+		if (pointer)
+		{
+			if (Profiler::countsAllocations())
+				Profiler::recordAllocation(malloc_usable_size(pointer));
+			return pointer;
+		}
+		std::new_handler handler = std::get_new_handler();
+		if (!handler)
+			throw std::bad_alloc();
+		handler();
+	}
+}
+
+void deallocate(void* _pointer) noexcept
+{
+	if (!_pointer)
+		return;
+	if (Profiler::countsAllocations())
+		Profiler::recordDeallocation(malloc_usable_size(_pointer));
+	std::free(_pointer);
+}
+
+[[maybe_unused]] bool const g_allocationCountingEnabled = (Profiler::enableAllocationCounting(), true);
+
+}
+
+void* operator new(std::size_t _size)
+{
+	return allocate(_size, 0);
+}
+
+void* operator new(std::size_t _size, std::align_val_t _alignment)
+{
+	return allocate(_size, static_cast<std::size_t>(_alignment));
+}
+
+void operator delete(void* _pointer) noexcept
+{
+	deallocate(_pointer);
+}
+
+void operator delete(void* _pointer, std::align_val_t) noexcept
+{
+	deallocate(_pointer);
+}
+
+void operator delete(void* _pointer, std::size_t) noexcept
+{
+	deallocate(_pointer);
+}
+
+void operator delete(void* _pointer, std::size_t, std::align_val_t) noexcept
+{
+	deallocate(_pointer);
+}
+
+#endif
@@ -54,6 +54,7 @@
 #include <libsolutil/CommonData.h>
 #include <libsolutil/CommonIO.h>
 #include <libsolutil/JSON.h>
+#include <libsolutil/Profiler.h>
 
 #include <algorithm>
 #include <fstream>
@@ -64,6 +65,7 @@
 #include <boost/filesystem.hpp>
 #include <boost/filesystem/operations.hpp>
 #include <boost/algorithm/string.hpp>
+#include <boost/exception/diagnostic_information.hpp>
 
 #ifdef _WIN32 // windows
 	#include <io.h>
@@ -138,6 +140,12 @@ static std::string const g_strStorageLayout = "storage-layout";
 static std::string const g_strTransientStorageLayout = "transient-storage-layout";
 static std::string const g_strVersion = "version";
 
+/// Estimated size above which the least recently stored ASTs are dropped in server mode.
+static size_t const g_serverParsedSourceCacheBudget = 512 * 1024 * 1024;
+/// Number of optimized Yul objects above which the server starts with an empty cache again,
+/// so that the names interned by them are released.
+static size_t const g_serverMaxCachedYulObjects = 4096;
+
 static bool needsHumanTargetedStdout(CommandLineOptions const& _options)
 {
 	if (_options.compiler.estimateGas)
@@ -653,43 +661,110 @@ void CommandLineInterface::readInputFiles()
 
 	if (
 		m_options.input.mode != InputMode::LanguageServer &&
+		m_options.input.mode != InputMode::Server &&
 		m_fileReader.sourceUnits().empty() &&
 		!m_standardJsonInput.has_value()
 	)
 		solThrow(CommandLineValidationError, "All specified input files either do not exist or are not regular files.");
 }
 
-std::map<std::string, Json> CommandLineInterface::parseAstFromInput()
+void CommandLineInterface::importASTsFromInput()
 {
 	solAssert(m_options.input.mode == InputMode::CompilerWithASTImport);
 
-	std::map<std::string, Json> sourceJsons;
-	std::map<std::string, std::string> tmpSources;
-
-	for (SourceCode const& sourceCode: m_fileReader.sourceUnits() | ranges::views::values)
+	// Each input is parsed twice, first only to find the sources and then to import their ASTs one
+	// by one, so that the JSON of all the ASTs never has to be in memory at the same time.
+	// The first pass skips everything below the keys of the sources.
+	// Inputs in the binary format (see --ast-binary) can only be decoded as a whole. They are
+	// decoded once, in the first pass, and kept until their ASTs are imported.
+	std::map<std::string, std::string> astKeys;
+	std::set<std::string> sourceNames;
+	std::map<std::string, Json> binaryInputs;
+	for (auto const& [inputName, sourceCode]: m_fileReader.sourceUnits())
 	{
-		Json ast;
-		astAssert(jsonParseStrict(sourceCode, ast), "Input file could not be parsed to JSON");
-		astAssert(ast.contains("sources"), "Invalid Format for import-JSON: Must have 'sources'-object");
+		Json parsed;
+		Json& input = isBinaryJson(sourceCode) ? binaryInputs[inputName] : parsed;
+		std::vector<std::string> path;
+		std::map<std::string, std::set<std::string>> sourceKeys;
+		auto const findSources = [&](int _depth, Json::parse_event_t _event, Json& _parsed) {
+			if (_event != Json::parse_event_t::key)
+				return true;
+			path.resize(static_cast<size_t>(_depth) - 1);
+			path.emplace_back(_parsed.get<std::string>());
+			if (path.size() == 3 && path[0] == "sources")
+				sourceKeys[path[1]].insert(path[2]);
+			return path.size() < 3 && path[0] == "sources";
+		};
+		if (isBinaryJson(sourceCode))
+		{
+			astAssert(jsonParseBinary(sourceCode, input), "Input file could not be parsed as binary JSON");
+			if (input.contains("sources") && input["sources"].is_object())
+				for (auto const& [sourceName, source]: input["sources"].items())
+					if (source.is_object())
+						for (auto it = source.begin(); it != source.end(); ++it)
+							sourceKeys[sourceName].insert(it.key());
+		}
+		else
+			astAssert(jsonParseStrict(sourceCode, input, findSources), "Input file could not be parsed to JSON");
+		astAssert(input.contains("sources") && input["sources"].is_object(), "Invalid Format for import-JSON: Must have 'sources'-object");
 
-		for (auto const& [src, value]: ast["sources"].items())
+		for (auto const& src: input["sources"].items())
 		{
-			std::string astKey = value.contains("ast") ? "ast" : "AST";
+			std::string astKey = sourceKeys[src.key()].count("ast") ? "ast" : "AST";
 
-			astAssert(ast["sources"][src].contains(astKey), "astkey is not member");
-			astAssert(ast["sources"][src][astKey]["nodeType"].get<std::string>() == "SourceUnit",  "Top-level node should be a 'SourceUnit'");
-			astAssert(sourceJsons.count(src) == 0, "All sources must have unique names");
-			sourceJsons.emplace(src, std::move(value[astKey]));
-			tmpSources[src] = util::jsonCompactPrint(ast);
+			astAssert(sourceKeys[src.key()].count(astKey), "astkey is not member");
+			astAssert(astKeys.count(src.key()) == 0, "All sources must have unique names");
+			astKeys[src.key()] = astKey;
+			sourceNames.insert(src.key());
 		}
 	}
 
-	m_fileReader.setSourceUnits(tmpSources);
+	std::map<std::string, std::string> tmpSources;
+	m_compiler->importASTs(sourceNames, [&](auto const& _importAST) {
+		auto const importSource = [&](std::string const& _sourceName, Json const& _ast) {
+			astAssert(_ast.value("nodeType", std::string{}) == "SourceUnit",  "Top-level node should be a 'SourceUnit'");
+			_importAST(_sourceName, _ast);
+			tmpSources[_sourceName] = util::jsonCompactPrint(_ast);
+		};
+
+		for (auto const& [inputName, sourceCode]: m_fileReader.sourceUnits())
+		{
+			if (binaryInputs.count(inputName))
+			{
+				Json input = std::move(binaryInputs.at(inputName));
+				binaryInputs.erase(inputName);
+				for (auto& [sourceName, source]: input["sources"].items())
+				{
+					importSource(sourceName, source[astKeys.at(sourceName)]);
+					source = nullptr;
+				}
+				continue;
+			}
 
-	return sourceJsons;
+			Json input;
+			std::vector<std::string> path;
+			auto const importSources = [&](int _depth, Json::parse_event_t _event, Json& _parsed) {
+				if (_event == Json::parse_event_t::key)
+				{
+					path.resize(static_cast<size_t>(_depth) - 1);
+					path.emplace_back(_parsed.get<std::string>());
+					return path[0] == "sources" && (path.size() != 3 || path[2] == astKeys.at(path[1]));
+				}
+				if (_event != Json::parse_event_t::object_end || _depth != 3)
+					return true;
+
+				importSource(path[1], _parsed);
+				// Drop the AST from the document.
+				return false;
+			};
+			astAssert(jsonParseStrict(sourceCode, input, importSources), "Input file could not be parsed to JSON");
+		}
+	});
+
+	m_fileReader.setSourceUnits(tmpSources);
 }
 
-void CommandLineInterface::createFile(std::string const& _fileName, std::string const& _data)
+void CommandLineInterface::createFile(std::string const& _fileName, std::string const& _data, bool _binary)
 {
 	namespace fs = boost::filesystem;
 
@@ -704,7 +779,7 @@ void CommandLineInterface::createFile(std::string const& _fileName, std::string
 	if (fs::exists(pathName) && !m_options.output.overwriteFiles)
 		solThrow(CommandLineOutputError, "Refusing to overwrite existing file \"" + pathName + "\" (use --overwrite to force).");
 
-	std::ofstream outFile(pathName);
+	std::ofstream outFile(pathName, _binary ? std::ios::out | std::ios::binary : std::ios::out);
 	outFile << _data;
 	if (!outFile)
 		solThrow(CommandLineOutputError, "Could not write to file \"" + pathName + "\".");
@@ -723,7 +798,13 @@ bool CommandLineInterface::run(int _argc, char const* const* _argv)
 			return false;
 
 		readInputFiles();
+
+		std::optional<util::Profiler::Session> profilerSession;
+		if (m_options.output.profileFile.has_value())
+			profilerSession.emplace();
 		processInput();
+		if (profilerSession.has_value())
+			writeProfile(*profilerSession);
 		return true;
 	}
 	catch (CommandLineError const& _exception)
@@ -784,6 +865,8 @@ void CommandLineInterface::processInput()
 			"Support for EVM versions older than constantinople is deprecated and will be removed in the future."
 		);
 
+	m_solverCommand.setSessionMode(m_options.modelChecker.solverSessions);
+
 	switch (m_options.input.mode)
 	{
 	case InputMode::Help:
@@ -800,10 +883,14 @@ void CommandLineInterface::processInput()
 		solAssert(m_standardJsonInput.has_value());
 
 		StandardCompiler compiler(m_universalCallback.callback(), m_options.formatting.json);
-		sout() << compiler.compile(std::move(m_standardJsonInput.value())) << std::endl;
+		compiler.compile(m_standardJsonInput.value(), sout());
+		sout() << std::endl;
 		m_standardJsonInput.reset();
 		break;
 	}
+	case InputMode::Server:
+		serveStandardJson();
+		break;
 	case InputMode::LanguageServer:
 		serveLSP();
 		break;
@@ -890,6 +977,8 @@ void CommandLineInterface::compile()
 		m_compiler->setRemappings(m_options.input.remappings);
 		m_compiler->setLibraries(m_options.linker.libraries);
 		m_compiler->setViaIR(m_options.output.viaIR);
+		m_compiler->setParallelism(m_options.output.jobs);
+		m_compiler->setDiscardIntermediateArtifacts(m_options.output.discardIntermediateArtifacts);
 		m_compiler->setEVMVersion(m_options.output.evmVersion);
 		m_compiler->setEOFVersion(m_options.output.eofVersion);
 		m_compiler->setRevertStringBehaviour(m_options.output.revertStrings);
@@ -928,12 +1017,14 @@ void CommandLineInterface::compile()
 		m_compiler->selectContracts({{"", {{"", pipelineConfig}}}});
 
 		m_compiler->setOptimiserSettings(m_options.optimiserSettings());
+		if (m_options.optimizer.cacheDirectory.has_value())
+			m_compiler->setOptimizerCacheDirectory(*m_options.optimizer.cacheDirectory, m_options.optimizer.cacheMaxSize);
 
 		if (m_options.input.mode == InputMode::CompilerWithASTImport)
 		{
 			try
 			{
-				m_compiler->importASTs(parseAstFromInput());
+				importASTsFromInput();
 
 				if (!m_compiler->analyze())
 				{
@@ -1089,6 +1180,25 @@ void CommandLineInterface::handleAst()
 {
 	solAssert(CompilerInputModes.count(m_options.input.mode) == 1);
 
+	if (m_options.compiler.outputs.astBinary)
+	{
+		solAssert(!m_options.output.dir.empty());
+
+		// Same document as the "sources" of --combined-json ast, which --import-ast accepts.
+		Json sources = Json::object();
+		for (auto const& sourceCode: m_fileReader.sourceUnits())
+		{
+			sources[sourceCode.first]["AST"] = ASTJsonExporter(
+				m_compiler->state(),
+				m_compiler->sourceIndices()
+			).toJson(m_compiler->ast(sourceCode.first));
+			sources[sourceCode.first]["id"] = m_compiler->sourceIndices().at(sourceCode.first);
+		}
+		Json output;
+		output[g_strSources] = std::move(sources);
+		createFile("combined_ast.bin", jsonPrintBinary(removeNullMembers(std::move(output))), true /* binary */);
+	}
+
 	if (!m_options.compiler.outputs.astCompactJson)
 		return;
 
@@ -1119,6 +1229,49 @@ void CommandLineInterface::handleAst()
 	}
 }
 
+void CommandLineInterface::serveStandardJson()
+{
+	solAssert(m_options.input.mode == InputMode::Server);
+
+	// These caches only save work and never change the outputs, so all inputs share them.
+	auto parsedSourceCache = std::make_shared<ParsedSourceCache>(g_serverParsedSourceCacheBudget);
+	std::shared_ptr<yul::YulStringRepository> yulStringRepository;
+	std::shared_ptr<yul::ObjectOptimizer> objectOptimizer;
+
+	std::string input;
+	while (std::getline(m_sin, input))
+	{
+		if (input.find_first_not_of(" \t\r") == std::string::npos)
+			continue;
+
+		if (!objectOptimizer || objectOptimizer->size() > g_serverMaxCachedYulObjects)
+		{
+			objectOptimizer.reset();
+			yulStringRepository = std::make_shared<yul::YulStringRepository>();
+			objectOptimizer = std::make_shared<yul::ObjectOptimizer>();
+		}
+
+		// Outputs are separated by newlines, so they are always printed in compact form.
+		StandardCompiler compiler(m_universalCallback.callback());
+		compiler.setParsedSourceCache(parsedSourceCache);
+		compiler.shareYulOptimizerCache(yulStringRepository, objectOptimizer);
+		try
+		{
+			compiler.compile(input, sout());
+		}
+		catch (...)
+		{
+			// Only happens if the output has already been completed without reporting the error.
+			// The remaining inputs are still compiled.
+			serr() << "Internal error while writing the output: " << boost::current_exception_diagnostic_information() << std::endl;
+		}
+		sout() << std::endl;
+
+		// Files requested via the import callback may change before the next input.
+		m_fileReader.setSourceUnits({});
+	}
+}
+
 void CommandLineInterface::serveLSP()
 {
 	lsp::StdioTransport transport;
@@ -1209,6 +1362,17 @@ void CommandLineInterface::writeLinkedFiles()
 	sout() << "Linking completed." << std::endl;
 }
 
+void CommandLineInterface::writeProfile(util::Profiler::Session const& _session)
+{
+	solAssert(m_options.output.profileFile.has_value());
+
+	std::string const pathName = m_options.output.profileFile->string();
+	std::ofstream outFile(pathName);
+	outFile << util::jsonPrint(_session.toJson(), m_options.formatting.json) << std::endl;
+	if (!outFile)
+		solThrow(CommandLineOutputError, "Could not write to file \"" + pathName + "\".");
+}
+
 std::string CommandLineInterface::libraryPlaceholderHint(std::string const& _libraryName)
 {
 	return "// " + evmasm::LinkerObject::libraryPlaceholder(_libraryName) + " -> " + _libraryName;
@@ -1357,9 +1521,10 @@ void CommandLineInterface::outputCompilationResults()
 	// do we need AST output?
 	handleAst();
 
-	CompilerOutputs astOutputSelection;
-	astOutputSelection.astCompactJson = true;
-	if (m_options.compiler.outputs != CompilerOutputs() && m_options.compiler.outputs != astOutputSelection)
+	CompilerOutputs nonASTOutputSelection = m_options.compiler.outputs;
+	nonASTOutputSelection.astCompactJson = false;
+	nonASTOutputSelection.astBinary = false;
+	if (nonASTOutputSelection != CompilerOutputs())
 	{
 		// Currently AST is the only output allowed with --stop-after parsing. For all of the others
 		// we can safely assume that full compilation was performed and successful.
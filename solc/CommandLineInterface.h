@@ -33,8 +33,11 @@
 #include <libsolidity/interface/UniversalCallback.h>
 #include <libyul/YulStack.h>
 
+#include <libsolutil/Profiler.h>
+
 #include <iostream>
 #include <memory>
+#include <optional>
 #include <string>
 
 namespace solidity::frontend
@@ -87,9 +90,13 @@ private:
 	void printLicense();
 	void compile();
 	void assembleFromEVMAssemblyJSON();
+	/// Compiles Standard JSON inputs read from standard input line by line.
+	void serveStandardJson();
 	void serveLSP();
 	void link();
 	void writeLinkedFiles();
+	/// Writes the measurements of @a _session to the file given by --profile-json.
+	void writeProfile(util::Profiler::Session const& _session);
 	/// @returns the ``// <identifier> -> name`` hint for library placeholders.
 	static std::string libraryPlaceholderHint(std::string const& _libraryName);
 	/// @returns the full object with library placeholder hints in hex.
@@ -119,15 +126,16 @@ private:
 	void handleTransientStorageLayout(std::string const& _contract);
 
 	/// Tries to read @ m_sourceCodes as a JSONs holding ASTs
-	/// such that they can be imported into the compiler  (importASTs())
+	/// and imports them into the compiler (importASTs())
 	/// (produced by --combined-json ast <file.sol>
 	/// or standard-json output
-	std::map<std::string, Json> parseAstFromInput();
+	void importASTsFromInput();
 
 	/// Create a file in the given directory
 	/// @arg _fileName the name of the file
 	/// @arg _data to be written
-	void createFile(std::string const& _fileName, std::string const& _data);
+	/// @arg _binary whether to write @a _data without converting line endings
+	void createFile(std::string const& _fileName, std::string const& _data, bool _binary = false);
 
 	/// Create a json file in the given directory
 	/// @arg _fileName the name of the file (the extension will be replaced with .json)
@@ -24,6 +24,8 @@
 
 #include <liblangutil/EVMVersion.h>
 
+#include <libsolutil/ThreadPool.h>
+
 #include <boost/algorithm/string.hpp>
 
 #include <range/v3/view/transform.hpp>
@@ -55,6 +57,8 @@ static std::string const g_strHelp = "help";
 static std::string const g_strImportAst = "import-ast";
 static std::string const g_strImportEvmAssemblerJson = "import-asm-json";
 static std::string const g_strInputFile = "input-file";
+static std::string const g_strJobs = "jobs";
+static std::string const g_strDiscardIntermediateArtifacts = "discard-intermediate-artifacts";
 static std::string const g_strYul = "yul";
 static std::string const g_strYulDialect = "yul-dialect";
 static std::string const g_strDebugInfo = "debug-info";
@@ -73,10 +77,14 @@ static std::string const g_strModelCheckerEngine = "model-checker-engine";
 static std::string const g_strModelCheckerExtCalls = "model-checker-ext-calls";
 static std::string const g_strModelCheckerInvariants = "model-checker-invariants";
 static std::string const g_strModelCheckerPrintQuery = "model-checker-print-query";
+static std::string const g_strModelCheckerRaceCrossCheckTime = "model-checker-race-cross-check-time";
+static std::string const g_strModelCheckerRaceSolvers = "model-checker-race-solvers";
 static std::string const g_strModelCheckerShowProvedSafe = "model-checker-show-proved-safe";
 static std::string const g_strModelCheckerShowUnproved = "model-checker-show-unproved";
+static std::string const g_strModelCheckerShowSolverStatistics = "model-checker-show-solver-statistics";
 static std::string const g_strModelCheckerShowUnsupported = "model-checker-show-unsupported";
 static std::string const g_strModelCheckerSolvers = "model-checker-solvers";
+static std::string const g_strModelCheckerSolverSessions = "model-checker-solver-sessions";
 static std::string const g_strModelCheckerTargets = "model-checker-targets";
 static std::string const g_strModelCheckerTimeout = "model-checker-timeout";
 static std::string const g_strModelCheckerBMCLoopIterations = "model-checker-bmc-loop-iterations";
@@ -87,8 +95,11 @@ static std::string const g_strOptimize = "optimize";
 static std::string const g_strOptimizeRuns = "optimize-runs";
 static std::string const g_strOptimizeYul = "optimize-yul";
 static std::string const g_strYulOptimizations = "yul-optimizations";
+static std::string const g_strOptimizerCacheDir = "optimizer-cache-dir";
+static std::string const g_strOptimizerCacheSize = "optimizer-cache-size";
 static std::string const g_strOutputDir = "output-dir";
 static std::string const g_strOverwrite = "overwrite";
+static std::string const g_strProfileJson = "profile-json";
 static std::string const g_strRevertStrings = "revert-strings";
 static std::string const g_strStopAfter = "stop-after";
 static std::string const g_strParsing = "parsing";
@@ -102,6 +113,7 @@ static std::set<std::string> const g_revertStringsArgs
 	revertStringsToString(RevertStrings::VerboseDebug)
 };
 
+static std::string const g_strServer = "server";
 static std::string const g_strSources = "sources";
 static std::string const g_strSourceList = "sourceList";
 static std::string const g_strStandardJSON = "standard-json";
@@ -143,6 +155,7 @@ static std::map<InputMode, std::string> const g_inputModeName = {
 	{InputMode::CompilerWithASTImport, "compiler (AST import)"},
 	{InputMode::Assembler, "assembler"},
 	{InputMode::StandardJson, "standard JSON"},
+	{InputMode::Server, "compile server"},
 	{InputMode::Linker, "linker"},
 	{InputMode::LanguageServer, "language server (LSP)"},
 	{InputMode::EVMAssemblerJSON, "EVM assembler (JSON format)"},
@@ -235,10 +248,13 @@ bool CommandLineOptions::operator==(CommandLineOptions const& _other) const noex
 		output.overwriteFiles == _other.output.overwriteFiles &&
 		output.evmVersion == _other.output.evmVersion &&
 		output.viaIR == _other.output.viaIR &&
+		output.jobs == _other.output.jobs &&
+		output.discardIntermediateArtifacts == _other.output.discardIntermediateArtifacts &&
 		output.revertStrings == _other.output.revertStrings &&
 		output.debugInfoSelection == _other.output.debugInfoSelection &&
 		output.stopAfter == _other.output.stopAfter &&
 		output.eofVersion == _other.output.eofVersion &&
+		output.profileFile == _other.output.profileFile &&
 		input.mode == _other.input.mode &&
 		assembly.targetMachine == _other.assembly.targetMachine &&
 		assembly.inputLanguage == _other.assembly.inputLanguage &&
@@ -256,8 +272,11 @@ bool CommandLineOptions::operator==(CommandLineOptions const& _other) const noex
 		optimizer.optimizeYul == _other.optimizer.optimizeYul &&
 		optimizer.expectedExecutionsPerDeployment == _other.optimizer.expectedExecutionsPerDeployment &&
 		optimizer.yulSteps == _other.optimizer.yulSteps &&
+		optimizer.cacheDirectory == _other.optimizer.cacheDirectory &&
+		optimizer.cacheMaxSize == _other.optimizer.cacheMaxSize &&
 		modelChecker.initialize == _other.modelChecker.initialize &&
-		modelChecker.settings == _other.modelChecker.settings;
+		modelChecker.settings == _other.modelChecker.settings &&
+		modelChecker.solverSessions == _other.modelChecker.solverSessions;
 }
 
 OptimiserSettings CommandLineOptions::optimiserSettings() const
@@ -312,10 +331,11 @@ void CommandLineParser::parseInputPathsAndRemappings()
 				if (!remapping.has_value())
 					solThrow(CommandLineValidationError, "Invalid remapping: \"" + positionalArg + "\".");
 
-				if (m_options.input.mode == InputMode::StandardJson)
+				if (m_options.input.mode == InputMode::StandardJson || m_options.input.mode == InputMode::Server)
 					solThrow(
 						CommandLineValidationError,
-						"Import remappings are not accepted on the command line in Standard JSON mode.\n"
+						"Import remappings are not accepted on the command line in " +
+						(m_options.input.mode == InputMode::Server ? "--" + g_strServer : std::string("Standard JSON")) + " mode.\n"
 						"Please put them under 'settings.remappings' in the JSON input."
 					);
 
@@ -339,7 +359,16 @@ void CommandLineParser::parseInputPathsAndRemappings()
 				m_options.input.paths.insert(positionalArg);
 		}
 
-	if (m_options.input.mode == InputMode::StandardJson)
+	if (m_options.input.mode == InputMode::Server)
+	{
+		if (!m_options.input.paths.empty() || m_options.input.addStdin)
+			solThrow(
+				CommandLineValidationError,
+				"Input files are not accepted in --" + g_strServer + " mode.\n"
+				"Please send the Standard JSON inputs on standard input instead."
+			);
+	}
+	else if (m_options.input.mode == InputMode::StandardJson)
 	{
 		if (m_options.input.paths.size() > 1 || (m_options.input.paths.size() == 1 && m_options.input.addStdin))
 			solThrow(
@@ -497,6 +526,7 @@ void CommandLineParser::parseOutputSelection()
 		case InputMode::Assembler:
 			return util::contains(assemblerModeOutputs, _outputName);
 		case InputMode::StandardJson:
+		case InputMode::Server:
 		case InputMode::Linker:
 			return false;
 		}
@@ -641,6 +671,18 @@ General Information)").c_str(),
 			g_strViaIR.c_str(),
 			"Turn on compilation mode via the IR."
 		)
+		(
+			g_strJobs.c_str(),
+			po::value<std::string>()->value_name("n"),
+			"Number of threads used to parse and check the sources and to optimize and assemble the IR of "
+			"independent contracts when compiling via the IR. Output does not depend on this setting. "
+			"Values above four times the number of hardware threads are reduced to that."
+		)
+		(
+			g_strDiscardIntermediateArtifacts.c_str(),
+			"Free the IR of each contract during the compilation as soon as it is no longer needed for the "
+			"requested outputs, to reduce the memory usage when compiling many contracts via the IR."
+		)
 		(
 			g_strRevertStrings.c_str(),
 			po::value<std::string>()->value_name(util::joinHumanReadable(g_revertStringsArgs, ",")),
@@ -658,6 +700,13 @@ General Information)").c_str(),
 			po::value<std::string>()->value_name("stage"),
 			"Stop execution after the given compiler stage. Valid options: \"parsing\"."
 		)
+		(
+			g_strProfileJson.c_str(),
+			po::value<std::string>()->value_name("path"),
+			"Measure the time spent in the stages of the compilation and write it to the given file in "
+			"the trace event format, which can be viewed in chrome://tracing or Perfetto, together with "
+			"a summary per stage."
+		)
 	;
 	desc.add(outputOptions);
 
@@ -668,6 +717,12 @@ General Information)").c_str(),
 			"Switch to Standard JSON input / output mode, ignoring all options. "
 			"It reads from standard input, if no input file was given, otherwise it reads from the provided input file. The result will be written to standard output."
 		)
+		(
+			g_strServer.c_str(),
+			("Switch to compile server mode. Like --" + g_strStandardJSON + ", but reads one Standard JSON input per line "
+			"from standard input until it is closed and writes the output for each of them on a single line to standard output. "
+			"Parsed sources and optimized Yul code are reused across inputs, without affecting the outputs.").c_str()
+		)
 		(
 			g_strLink.c_str(),
 			("Switch to linker mode, ignoring all options apart from --" + g_strLibraries + " "
@@ -755,6 +810,11 @@ General Information)").c_str(),
 	po::options_description outputComponents("Output Components");
 	outputComponents.add_options()
 		(CompilerOutputs::componentName(&CompilerOutputs::astCompactJson).c_str(), "AST of all source files in a compact JSON format.")
+		(
+			CompilerOutputs::componentName(&CompilerOutputs::astBinary).c_str(),
+			"AST of all source files in CBOR, a compact binary encoding of JSON, as a single file in the output directory "
+			"that can be passed to --import-ast."
+		)
 		(CompilerOutputs::componentName(&CompilerOutputs::asm_).c_str(), "EVM assembly of the contracts.")
 		(CompilerOutputs::componentName(&CompilerOutputs::asmJson).c_str(), "EVM assembly of the contracts in JSON format.")
 		(CompilerOutputs::componentName(&CompilerOutputs::opcodes).c_str(), "Opcodes of the contracts.")
@@ -839,6 +899,18 @@ General Information)").c_str(),
 			po::value<std::string>()->value_name("steps"),
 			"Forces Yul optimizer to use the specified sequence of optimization steps instead of the built-in one."
 		)
+		(
+			g_strOptimizerCacheDir.c_str(),
+			po::value<std::string>()->value_name("path"),
+			("Store the results of the Yul optimizer in the given directory and reuse them in subsequent "
+			"compilations. The directory can be shared by multiple concurrently running compiler processes. "
+			"Least recently used entries are removed when the cache grows beyond the size set by --" + g_strOptimizerCacheSize + ".").c_str()
+		)
+		(
+			g_strOptimizerCacheSize.c_str(),
+			po::value<uint64_t>()->value_name("MiB")->default_value(CompilerStack::defaultOptimizerCacheMaxSize / (1024 * 1024)),
+			("Size in MiB above which least recently used entries are removed from the directory given in --" + g_strOptimizerCacheDir + ".").c_str()
+		)
 	;
 	desc.add(optimizerOptions);
 
@@ -878,10 +950,26 @@ General Information)").c_str(),
 			g_strModelCheckerPrintQuery.c_str(),
 			"Print the queries created by the SMTChecker in the SMTLIB2 format."
 		)
+		(
+			g_strModelCheckerRaceCrossCheckTime.c_str(),
+			po::value<unsigned>()->value_name("ms"),
+			"When racing the BMC solvers, give the remaining solvers this many milliseconds to confirm "
+			"the first answer before they are cancelled. By default they are cancelled immediately."
+		)
+		(
+			g_strModelCheckerRaceSolvers.c_str(),
+			"Run the solvers selected for the BMC engine concurrently and use the first conclusive answer, "
+			"instead of querying them one after the other."
+		)
 		(
 			g_strModelCheckerShowProvedSafe.c_str(),
 			"Show all targets that were proved safe separately."
 		)
+		(
+			g_strModelCheckerShowSolverStatistics.c_str(),
+			"When racing the BMC solvers, report how often each solver answered first and how often it "
+			"was cancelled. The numbers depend on the timing of the solvers."
+		)
 		(
 			g_strModelCheckerShowUnproved.c_str(),
 			"Show all unproved targets separately."
@@ -895,6 +983,11 @@ General Information)").c_str(),
 			po::value<std::string>()->value_name("cvc5,eld,z3,smtlib2")->default_value("z3"),
 			"Select model checker solvers."
 		)
+		(
+			g_strModelCheckerSolverSessions.c_str(),
+			"Keep z3 and cvc5 running between queries and only send them the part of each query "
+			"that differs from the previous one, instead of starting a new process for every query."
+		)
 		(
 			g_strModelCheckerTargets.c_str(),
 			po::value<std::string>()->value_name("default,all,constantCondition,underflow,overflow,divByZero,balance,assert,popEmptyArray,outOfBounds")->default_value("default"),
@@ -966,6 +1059,7 @@ void CommandLineParser::processArgs()
 		g_strLicense,
 		g_strVersion,
 		g_strStandardJSON,
+		g_strServer,
 		g_strLink,
 		g_strAssemble,
 		g_strStrictAssembly,
@@ -982,6 +1076,8 @@ void CommandLineParser::processArgs()
 		m_options.input.mode = InputMode::Version;
 	else if (m_args.count(g_strStandardJSON) > 0)
 		m_options.input.mode = InputMode::StandardJson;
+	else if (m_args.count(g_strServer) > 0)
+		m_options.input.mode = InputMode::Server;
 	else if (m_args.count(g_strLSP))
 		m_options.input.mode = InputMode::LanguageServer;
 	else if (m_args.count(g_strAssemble) > 0 || m_args.count(g_strStrictAssembly) > 0)
@@ -1013,6 +1109,17 @@ void CommandLineParser::processArgs()
 		// TODO: This should eventually contain all options.
 		{g_strExperimentalViaIR, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strViaIR, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
+		{g_strJobs, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
+		{g_strDiscardIntermediateArtifacts, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
+		{g_strOptimizerCacheDir, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
+		{g_strOptimizerCacheSize, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
+		{g_strProfileJson, {
+			InputMode::Compiler,
+			InputMode::CompilerWithASTImport,
+			InputMode::Assembler,
+			InputMode::EVMAssemblerJSON,
+			InputMode::StandardJson
+		}},
 		{g_strMetadataLiteral, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strNoCBORMetadata, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strMetadataHash, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
@@ -1021,10 +1128,14 @@ void CommandLineParser::processArgs()
 		{g_strModelCheckerEngine, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strModelCheckerInvariants, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strModelCheckerPrintQuery, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
+		{g_strModelCheckerRaceCrossCheckTime, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
+		{g_strModelCheckerRaceSolvers, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strModelCheckerShowProvedSafe, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strModelCheckerShowUnproved, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
+		{g_strModelCheckerShowSolverStatistics, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strModelCheckerShowUnsupported, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strModelCheckerSolvers, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
+		{g_strModelCheckerSolverSessions, {InputMode::Compiler, InputMode::CompilerWithASTImport, InputMode::StandardJson, InputMode::Server}},
 		{g_strModelCheckerTimeout, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strModelCheckerBMCLoopIterations, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strModelCheckerContracts, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
@@ -1055,7 +1166,10 @@ void CommandLineParser::processArgs()
 	checkMutuallyExclusive({g_strStopAfter, g_strGas});
 
 	for (std::string const& option: CompilerOutputs::componentMap() | ranges::views::keys)
-		if (option != CompilerOutputs::componentName(&CompilerOutputs::astCompactJson))
+		if (
+			option != CompilerOutputs::componentName(&CompilerOutputs::astCompactJson) &&
+			option != CompilerOutputs::componentName(&CompilerOutputs::astBinary)
+		)
 			checkMutuallyExclusive({g_strStopAfter, option});
 
 	if (m_options.input.mode == InputMode::EVMAssemblerJSON)
@@ -1151,6 +1265,19 @@ void CommandLineParser::processArgs()
 
 	m_options.output.overwriteFiles = (m_args.count(g_strOverwrite) > 0);
 
+	if (m_args.count(g_strProfileJson))
+	{
+		m_options.output.profileFile = m_args.at(g_strProfileJson).as<std::string>();
+		if (m_options.output.profileFile->empty())
+			solThrow(CommandLineValidationError, "--" + g_strProfileJson + " cannot be empty.");
+	}
+
+	if (m_options.input.mode == InputMode::Server && (m_args.count(g_strPrettyJson) > 0 || !m_args[g_strJsonIndent].defaulted()))
+		solThrow(
+			CommandLineValidationError,
+			"Options --" + g_strPrettyJson + " and --" + g_strJsonIndent + " are not supported in --" + g_strServer + " mode, "
+			"because outputs are separated by newlines."
+		);
 	if (m_args.count(g_strPrettyJson) > 0)
 	{
 		m_options.formatting.json.format = util::JsonFormat::Pretty;
@@ -1163,6 +1290,12 @@ void CommandLineParser::processArgs()
 
 	parseOutputSelection();
 
+	if (m_options.compiler.outputs.astBinary && m_options.output.dir.empty())
+		solThrow(
+			CommandLineValidationError,
+			"Option --" + CompilerOutputs::componentName(&CompilerOutputs::astBinary) + " requires --" + g_strOutputDir + "."
+		);
+
 	m_options.compiler.estimateGas = (m_args.count(g_strGas) > 0);
 
 	if (m_args.count(g_strBasePath))
@@ -1205,7 +1338,11 @@ void CommandLineParser::processArgs()
 
 	parseInputPathsAndRemappings();
 
-	if (m_options.input.mode == InputMode::StandardJson)
+	// Also applies to the solver calls made while processing Standard JSON input.
+	if (m_args.count(g_strModelCheckerSolverSessions))
+		m_options.modelChecker.solverSessions = true;
+
+	if (m_options.input.mode == InputMode::StandardJson || m_options.input.mode == InputMode::Server)
 		return;
 
 	if (m_args.count(g_strLibraries))
@@ -1247,6 +1384,25 @@ void CommandLineParser::processArgs()
 	if (!m_args[g_strOptimizeRuns].defaulted())
 		m_options.optimizer.expectedExecutionsPerDeployment = m_args.at(g_strOptimizeRuns).as<unsigned>();
 
+	if (m_args.count(g_strOptimizerCacheDir))
+	{
+		m_options.optimizer.cacheDirectory = m_args.at(g_strOptimizerCacheDir).as<std::string>();
+		if (m_options.optimizer.cacheDirectory->empty())
+			solThrow(CommandLineValidationError, "--" + g_strOptimizerCacheDir + " cannot be empty.");
+	}
+	if (!m_args[g_strOptimizerCacheSize].defaulted())
+	{
+		if (!m_options.optimizer.cacheDirectory.has_value())
+			solThrow(
+				CommandLineValidationError,
+				"Option --" + g_strOptimizerCacheSize + " requires --" + g_strOptimizerCacheDir + "."
+			);
+		uint64_t sizeInMiB = m_args.at(g_strOptimizerCacheSize).as<uint64_t>();
+		if (sizeInMiB == 0 || sizeInMiB > std::numeric_limits<std::uintmax_t>::max() / (1024 * 1024))
+			solThrow(CommandLineValidationError, "Invalid value for --" + g_strOptimizerCacheSize + ": " + std::to_string(sizeInMiB));
+		m_options.optimizer.cacheMaxSize = sizeInMiB * 1024 * 1024;
+	}
+
 	if (m_args.count(g_strYulOptimizations))
 	{
 		OptimiserSettings optimiserSettings = m_options.optimiserSettings();
@@ -1421,6 +1577,29 @@ void CommandLineParser::processArgs()
 		m_options.modelChecker.settings.printQuery = true;
 	}
 
+	if (m_args.count(g_strModelCheckerRaceSolvers))
+		m_options.modelChecker.settings.raceSolvers = true;
+
+	if (m_args.count(g_strModelCheckerRaceCrossCheckTime))
+	{
+		if (!m_options.modelChecker.settings.raceSolvers)
+			solThrow(
+				CommandLineValidationError,
+				"--" + g_strModelCheckerRaceCrossCheckTime + " requires --" + g_strModelCheckerRaceSolvers + "."
+			);
+		m_options.modelChecker.settings.raceCrossCheckTime = m_args[g_strModelCheckerRaceCrossCheckTime].as<unsigned>();
+	}
+
+	if (m_args.count(g_strModelCheckerShowSolverStatistics))
+	{
+		if (!m_options.modelChecker.settings.raceSolvers)
+			solThrow(
+				CommandLineValidationError,
+				"--" + g_strModelCheckerShowSolverStatistics + " requires --" + g_strModelCheckerRaceSolvers + "."
+			);
+		m_options.modelChecker.settings.showSolverStatistics = true;
+	}
+
 	if (m_args.count(g_strModelCheckerTargets))
 	{
 		std::string targetsStr = m_args[g_strModelCheckerTargets].as<std::string>();
@@ -1447,7 +1626,10 @@ void CommandLineParser::processArgs()
 		m_args.count(g_strModelCheckerEngine) ||
 		m_args.count(g_strModelCheckerExtCalls) ||
 		m_args.count(g_strModelCheckerInvariants) ||
+		m_args.count(g_strModelCheckerRaceCrossCheckTime) ||
+		m_args.count(g_strModelCheckerRaceSolvers) ||
 		m_args.count(g_strModelCheckerShowProvedSafe) ||
+		m_args.count(g_strModelCheckerShowSolverStatistics) ||
 		m_args.count(g_strModelCheckerShowUnproved) ||
 		m_args.count(g_strModelCheckerShowUnsupported) ||
 		m_args.count(g_strModelCheckerSolvers) ||
@@ -1455,6 +1637,23 @@ void CommandLineParser::processArgs()
 		m_args.count(g_strModelCheckerTimeout);
 	m_options.output.viaIR = (m_args.count(g_strExperimentalViaIR) > 0 || m_args.count(g_strViaIR) > 0);
 
+	if (m_args.count(g_strJobs))
+	{
+		// Not parsed as an unsigned value, which would turn negative numbers into huge ones.
+		std::string const& value = m_args[g_strJobs].as<std::string>();
+		if (value.empty() || !std::all_of(value.begin(), value.end(), [](char _c) { return '0' <= _c && _c <= '9'; }))
+			solThrow(CommandLineValidationError, "--" + g_strJobs + " must be a positive integer.");
+		std::string const jobs = boost::trim_left_copy_if(value, boost::is_any_of("0"));
+		if (jobs.empty())
+			solThrow(CommandLineValidationError, "--" + g_strJobs + " must be at least 1.");
+		size_t const maxJobs = util::ThreadPool::maxWorkers();
+		if (jobs.size() > std::to_string(maxJobs).size())
+			m_options.output.jobs = maxJobs;
+		else
+			m_options.output.jobs = std::min<size_t>(std::stoull(jobs), maxJobs);
+	}
+	m_options.output.discardIntermediateArtifacts = (m_args.count(g_strDiscardIntermediateArtifacts) > 0);
+
 	solAssert(
 		m_options.input.mode == InputMode::Compiler ||
 		m_options.input.mode == InputMode::CompilerWithASTImport ||
@@ -54,6 +54,7 @@ enum class InputMode
 	Compiler,
 	CompilerWithASTImport,
 	StandardJson,
+	Server,
 	Linker,
 	Assembler,
 	LanguageServer,
@@ -71,6 +72,7 @@ struct CompilerOutputs
 	{
 		static std::map<std::string, bool CompilerOutputs::*> const components = {
 			{"ast-compact-json", &CompilerOutputs::astCompactJson},
+			{"ast-binary", &CompilerOutputs::astBinary},
 			{"asm", &CompilerOutputs::asm_},
 			{"asm-json", &CompilerOutputs::asmJson},
 			{"opcodes", &CompilerOutputs::opcodes},
@@ -93,6 +95,7 @@ struct CompilerOutputs
 	}
 
 	bool astCompactJson = false;
+	bool astBinary = false;
 	bool asm_ = false;
 	bool asmJson = false;
 	bool opcodes = false;
@@ -190,10 +193,13 @@ struct CommandLineOptions
 		bool overwriteFiles = false;
 		langutil::EVMVersion evmVersion;
 		bool viaIR = false;
+		size_t jobs = 1;
+		bool discardIntermediateArtifacts = false;
 		RevertStrings revertStrings = RevertStrings::Default;
 		std::optional<langutil::DebugInfoSelection> debugInfoSelection;
 		CompilerStack::State stopAfter = CompilerStack::State::CompilationSuccessful;
 		std::optional<uint8_t> eofVersion;
+		std::optional<boost::filesystem::path> profileFile;
 	} output;
 
 	struct
@@ -234,12 +240,17 @@ struct CommandLineOptions
 		bool optimizeYul = false;
 		std::optional<unsigned> expectedExecutionsPerDeployment;
 		std::optional<std::string> yulSteps;
+		std::optional<boost::filesystem::path> cacheDirectory;
+		std::uintmax_t cacheMaxSize = CompilerStack::defaultOptimizerCacheMaxSize;
 	} optimizer;
 
 	struct
 	{
 		bool initialize = false;
 		ModelCheckerSettings settings;
+		/// Keep solver processes running between queries. Not part of @a settings because
+		/// it only concerns how solver binaries are called by this process.
+		bool solverSessions = false;
 	} modelChecker;
 };
 
@@ -0,0 +1,96 @@
+#!/usr/bin/env bash
+
+#------------------------------------------------------------------------------
+# Bash script to measure the time and memory needed to import ASTs.
+#
+# Exports the ASTs of the benchmark contracts with --combined-json ast and imports
+# them again with --import-ast. If a reference compiler is given, e.g. a release
+# that still parses the whole input into memory before importing it, its results
+# are shown next to the ones of the compiler under test.
+# ------------------------------------------------------------------------------
+# This file is part of solidity.
+#
+# solidity is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# solidity is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with solidity.  If not, see <http://www.gnu.org/licenses/>
+#
+# (c) 2024 solidity contributors.
+#------------------------------------------------------------------------------
+
+set -euo pipefail
+
+REPO_ROOT=$(cd "$(dirname "$0")/../../" && pwd)
+SOLIDITY_BUILD_DIR=${SOLIDITY_BUILD_DIR:-${REPO_ROOT}/build}
+
+# shellcheck source=scripts/common.sh
+source "${REPO_ROOT}/scripts/common.sh"
+# shellcheck source=scripts/common_cmdline.sh
+source "${REPO_ROOT}/scripts/common_cmdline.sh"
+
+(( $# <= 2 )) || fail "Too many arguments. Usage: ast-import.sh [<solc-path> [<reference-solc-path>]]"
+
+solc="${1:-${SOLIDITY_BUILD_DIR}/solc/solc}"
+reference_solc="${2:-}"
+command_available "$solc" --version
+[[ $reference_solc == "" ]] || command_available "$reference_solc" --version
+command_available "$(type -P time)" --version
+
+output_dir=$(mktemp -d -t solc-ast-import-benchmark-XXXXXX)
+
+function cleanup() {
+    rm -r "${output_dir}"
+    exit
+}
+
+trap cleanup SIGINT SIGTERM
+
+function benchmark_import {
+    local compiler_name="$1"
+    local compiler="$2"
+    local ast_file="$3"
+    local time_file="${output_dir}/time-and-status-${compiler_name}.txt"
+
+    gnu_time_to_json_file "$time_file" \
+        "$compiler" --import-ast --combined-json ast "$ast_file" \
+        > /dev/null \
+        2>> "${output_dir}/benchmark-warn-err.txt" || true
+
+    printf '| %-20s | %9s | %8d KiB | %6.2f s | %9d MiB | %9d |\n' \
+        '`'"$input_file"'`' \
+        "$compiler_name" \
+        "$(( $(wc -c < "$ast_file") / 1024 ))" \
+        "$(jq '(.user + .sys) * 100 | round / 100' "$time_file")" \
+        "$(jq '.mem / 1024 | round' "$time_file")" \
+        "$(jq '.exit' "$time_file")"
+}
+
+benchmarks=("verifier.sol" "OptimizorClub.sol" "chains.sol")
+
+echo "|         File         | Compiler  |   AST size   |   Time   | Memory (peak) | Exit code |"
+echo "|----------------------|-----------|-------------:|---------:|--------------:|----------:|"
+
+for input_file in "${benchmarks[@]}"
+do
+    ast_file="${output_dir}/${input_file}.json"
+    "$solc" --combined-json ast "${REPO_ROOT}/test/benchmarks/${input_file}" > "$ast_file"
+
+    benchmark_import current "$solc" "$ast_file"
+    [[ $reference_solc == "" ]] || benchmark_import reference "$reference_solc" "$ast_file"
+done
+
+echo
+echo "======================================================="
+echo "Warnings and errors generated during run:"
+echo "======================================================="
+echo "$(< "${output_dir}/benchmark-warn-err.txt")"
+
+cleanup
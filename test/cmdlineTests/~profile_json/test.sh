@@ -0,0 +1,40 @@
+#!/usr/bin/env bash
+set -euo pipefail
+
+# shellcheck source=scripts/common.sh
+source "${REPO_ROOT}/scripts/common.sh"
+
+SOLTMPDIR=$(mktemp -d -t "cmdline-test-profile-json-XXXXXX")
+cd "$SOLTMPDIR"
+
+cat > input.sol <<'SOL'
+// SPDX-License-Identifier: GPL-3.0
+pragma solidity >=0.0;
+contract C {
+    function f(uint x) public pure returns (uint) { return x * 2; }
+}
+contract D {
+    function g() public returns (address) { return address(new C()); }
+}
+SOL
+
+# The profile is written to its own file and does not change the regular output.
+msg_on_error --no-stderr "$SOLC" input.sol --bin --via-ir --optimize --jobs 2 --profile-json profile.json > output
+msg_on_error --no-stderr "$SOLC" input.sol --bin --via-ir --optimize --jobs 2 > expected_output
+diff_files expected_output output
+
+function check_profile
+{
+    local filter="$1"
+    jq --exit-status "$filter" profile.json > /dev/null || \
+        fail "The profile does not satisfy ${filter}:"$'\n'"$(cat profile.json)"
+}
+
+check_profile '.traceEvents | length > 0'
+check_profile '[.traceEvents[] | select(.ph != "X" or .dur < 0)] | length == 0'
+check_profile '[.traceEvents[] | .name] | contains(["Parser", "TypeChecker", "IRGenerator", "OptimiserSuite"])'
+check_profile '[.summary[] | select(.selfMicroseconds > .microseconds)] | length == 0'
+check_profile '[.subjects[] | .subject] | contains(["input.sol:C", "input.sol:D"])'
+
+cd - > /dev/null
+rm -r "$SOLTMPDIR"
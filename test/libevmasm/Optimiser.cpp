@@ -35,6 +35,7 @@
 
 #include <range/v3/algorithm/any_of.hpp>
 
+#include <random>
 #include <string>
 #include <tuple>
 #include <memory>
@@ -1136,6 +1137,101 @@ BOOST_AUTO_TEST_CASE(peephole_pop_calldatasize)
 	BOOST_CHECK(items.empty());
 }
 
+BOOST_AUTO_TEST_CASE(peephole_revisits_window_before_rewrite)
+{
+	// The rewrite of the last two items in the first pass enables a rewrite
+	// spanning the whole window in the second one.
+	AssemblyItems items{
+		u256(7),
+		u256(0),
+		Instruction::SSTORE,
+		Instruction::STOP,
+		AssemblyItem(Tag, 2),
+		u256(0),
+		Instruction::SSTORE,
+		Instruction::CALLVALUE,
+		Instruction::STOP
+	};
+	AssemblyItems expectation{
+		u256(7),
+		AssemblyItem(Tag, 2),
+		u256(0),
+		Instruction::SSTORE,
+		Instruction::STOP
+	};
+	PeepholeOptimiser peepOpt(items, solidity::test::CommonOptions::get().evmVersion());
+	BOOST_REQUIRE(peepOpt.optimise());
+	BOOST_CHECK_EQUAL(items.size(), 8u);
+	BOOST_REQUIRE(peepOpt.optimise());
+	BOOST_CHECK(!peepOpt.optimise());
+	BOOST_CHECK_EQUAL_COLLECTIONS(
+		items.begin(), items.end(),
+		expectation.begin(), expectation.end()
+	);
+}
+
+BOOST_AUTO_TEST_CASE(peephole_revisiting_rewritten_windows_matches_full_passes)
+{
+	// The optimiser only revisits the windows around the rewrites of its previous pass.
+	// A new optimiser examines all windows in its first pass, so running a new one in each
+	// pass has to produce the same items after every pass.
+	AssemblyItems const pool{
+		u256(0),
+		u256(1),
+		u256(2),
+		Instruction::POP,
+		Instruction::DUP1,
+		Instruction::DUP2,
+		Instruction::SWAP1,
+		Instruction::SWAP2,
+		Instruction::ADD,
+		Instruction::SUB,
+		Instruction::LT,
+		Instruction::GT,
+		Instruction::EQ,
+		Instruction::AND,
+		Instruction::ISZERO,
+		Instruction::CALLDATASIZE,
+		Instruction::CALLVALUE,
+		Instruction::SSTORE,
+		Instruction::JUMP,
+		Instruction::JUMPI,
+		Instruction::STOP,
+		Instruction::RETURN,
+		Instruction::REVERT,
+		AssemblyItem(Tag, 1),
+		AssemblyItem(Tag, 2),
+		AssemblyItem(PushTag, 1),
+		AssemblyItem(PushTag, 2)
+	};
+	langutil::EVMVersion const evmVersion = solidity::test::CommonOptions::get().evmVersion();
+	std::mt19937 random(1);
+	std::uniform_int_distribution<size_t> length(0, 40);
+	std::uniform_int_distribution<size_t> choice(0, pool.size() - 1);
+	for (size_t run = 0; run < 2000; ++run)
+	{
+		AssemblyItems items;
+		for (size_t i = length(random); i > 0; --i)
+			items.push_back(pool[choice(random)]);
+		AssemblyItems fullPassItems = items;
+
+		BOOST_TEST_CONTEXT("run " << run)
+		{
+			PeepholeOptimiser peepOpt(items, evmVersion);
+			bool optimised = true;
+			while (optimised)
+			{
+				optimised = peepOpt.optimise();
+				BOOST_REQUIRE_EQUAL(PeepholeOptimiser(fullPassItems, evmVersion).optimise(), optimised);
+				BOOST_REQUIRE_EQUAL_COLLECTIONS(
+					items.begin(), items.end(),
+					fullPassItems.begin(), fullPassItems.end()
+				);
+			}
+		}
+	}
+}
+
 BOOST_AUTO_TEST_CASE(peephole_commutative_swap1)
 {
 	std::vector<Instruction> ops{
@@ -251,6 +251,16 @@ bool ASTJSONTest::runTest(
 	{
 		std::ostringstream result;
 		ASTJsonExporter(_compiler.state(), _sourceIndices).print(result, _compiler.ast(m_sources[i].first), JsonFormat{ JsonFormat::Pretty });
+		Json const astJson = ASTJsonExporter(_compiler.state(), _sourceIndices).toJson(_compiler.ast(m_sources[i].first));
+		soltestAssert(
+			result.str() == jsonPrint(astJson, JsonFormat{ JsonFormat::Pretty }),
+			"Streamed AST JSON differs from the one built in memory."
+		);
+		Json astFromBinary;
+		soltestAssert(
+			jsonParseBinary(jsonPrintBinary(astJson), astFromBinary) && astFromBinary == astJson,
+			"AST does not survive a round trip through the binary format."
+		);
 		_variant.result += result.str();
 		if (i != m_sources.size() - 1)
 			_variant.result += ",";
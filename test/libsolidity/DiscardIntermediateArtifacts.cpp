@@ -0,0 +1,158 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for freeing the IR of contracts during the compilation once it is no longer needed.
+ */
+
+#include <libsolidity/interface/CompilerStack.h>
+#include <libsolidity/interface/StandardCompiler.h>
+
+#include <liblangutil/SourceReferenceFormatter.h>
+
+#include <libsolutil/JSON.h>
+
+#include <test/Common.h>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace solidity::langutil;
+using namespace solidity::util;
+
+namespace solidity::frontend::test
+{
+
+namespace
+{
+
+std::string const c_dependentContracts = R"(
+	// SPDX-License-Identifier: GPL-3.0
+	pragma solidity >=0.0;
+	contract C {
+		uint public y;
+		constructor(uint _y) { y = _y * 2; }
+	}
+	contract B {
+		C public c;
+		constructor(uint _x) { c = new C(_x + 1); }
+		function g() public view returns (uint) { return c.y() + type(C).creationCode.length; }
+	}
+	contract A {
+		function f(uint x) public returns (uint) { return new B(x).g(); }
+	}
+)";
+
+/// @returns the bytecode of all contracts in @a _sources and the IR that the compiler kept.
+std::map<std::string, std::string> compile(StringMap const& _sources, bool _discardIntermediateArtifacts)
+{
+	CompilerStack compiler;
+	compiler.setEVMVersion(solidity::test::CommonOptions::get().evmVersion());
+	compiler.setOptimiserSettings(true);
+	compiler.setViaIR(true);
+	compiler.setDiscardIntermediateArtifacts(_discardIntermediateArtifacts);
+	compiler.setSources(_sources);
+	BOOST_REQUIRE_MESSAGE(
+		compiler.compile(),
+		SourceReferenceFormatter::formatErrorInformation(compiler.errors(), compiler)
+	);
+
+	std::map<std::string, std::string> outputs;
+	for (std::string const& contract: compiler.contractNames())
+	{
+		outputs[contract + ":bytecode"] = compiler.object(contract).toHex();
+		outputs[contract + ":runtimeBytecode"] = compiler.runtimeObject(contract).toHex();
+		outputs[contract + ":ir"] = compiler.yulIR(contract).value_or("");
+		outputs[contract + ":irOptimized"] = compiler.yulIROptimized(contract).value_or("");
+	}
+	return outputs;
+}
+
+/// @returns the Standard JSON output of compiling @a _source via the IR with @a _outputSelection.
+Json compileStandardJSON(std::string const& _source, Json const& _outputSelection, bool _discardIntermediateArtifacts)
+{
+	Json input;
+	input["language"] = "Solidity";
+	input["sources"]["a.sol"]["content"] = _source;
+	input["settings"]["viaIR"] = true;
+	input["settings"]["optimizer"]["enabled"] = true;
+	input["settings"]["outputSelection"] = _outputSelection;
+	input["settings"]["discardIntermediateArtifacts"] = _discardIntermediateArtifacts;
+
+	StandardCompiler compiler;
+	Json output = compiler.compile(input);
+	BOOST_REQUIRE_MESSAGE(!output.contains("errors"), jsonPrettyPrint(output));
+	return output;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(DiscardIntermediateArtifacts)
+
+BOOST_AUTO_TEST_CASE(dependencies_created_with_new)
+{
+	StringMap const sources{{"a.sol", c_dependentContracts}};
+
+	std::map<std::string, std::string> const kept = compile(sources, false);
+	std::map<std::string, std::string> const discarded = compile(sources, true);
+	BOOST_REQUIRE_EQUAL(discarded.size(), kept.size());
+	for (std::string const contract: {"a.sol:A", "a.sol:B", "a.sol:C"})
+	{
+		BOOST_TEST_CONTEXT(contract)
+		{
+			BOOST_CHECK(!kept.at(contract + ":ir").empty());
+			BOOST_CHECK(!kept.at(contract + ":irOptimized").empty());
+			BOOST_CHECK_EQUAL(discarded.at(contract + ":ir"), "");
+			BOOST_CHECK_EQUAL(discarded.at(contract + ":irOptimized"), "");
+			BOOST_CHECK_EQUAL(discarded.at(contract + ":bytecode"), kept.at(contract + ":bytecode"));
+			BOOST_CHECK_EQUAL(discarded.at(contract + ":runtimeBytecode"), kept.at(contract + ":runtimeBytecode"));
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE(ir_requested_for_one_contract)
+{
+	Json outputSelection;
+	BOOST_REQUIRE(jsonParseStrict(R"({
+		"a.sol": {
+			"*": ["evm.bytecode.object"],
+			"B": ["ir", "irAst", "irOptimized", "irOptimizedAst", "yulCFGJson"]
+		}
+	})", outputSelection));
+
+	Json const kept = compileStandardJSON(c_dependentContracts, outputSelection, false);
+	Json const discarded = compileStandardJSON(c_dependentContracts, outputSelection, true);
+	BOOST_CHECK_EQUAL(jsonPrettyPrint(discarded), jsonPrettyPrint(kept));
+
+	Json const& contractB = discarded.at("contracts").at("a.sol").at("B");
+	for (std::string const output: {"ir", "irOptimized"})
+		BOOST_CHECK(!contractB.at(output).get<std::string>().empty());
+	for (std::string const output: {"irAst", "irOptimizedAst", "yulCFGJson"})
+		BOOST_CHECK(contractB.at(output).is_object() && !contractB.at(output).empty());
+	for (std::string const contract: {"A", "C"})
+	{
+		BOOST_TEST_CONTEXT(contract)
+		{
+			Json const& contractData = discarded.at("contracts").at("a.sol").at(contract);
+			BOOST_CHECK(!contractData.contains("ir"));
+			BOOST_CHECK(!contractData.at("evm").at("bytecode").at("object").get<std::string>().empty());
+		}
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -178,6 +178,32 @@ BOOST_AUTO_TEST_CASE(with_callback)
 	BOOST_CHECK(containsError(result, "ParserError", "Source \"notfound.sol\" not found: Callback not supported."));
 }
 
+BOOST_AUTO_TEST_CASE(parsed_source_cache)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"sources": {
+			"fileA": {
+				"content": "contract A { function f() public pure returns (uint) { return 1; } }"
+			}
+		},
+		"settings": {
+			"outputSelection": {
+				"fileA": { "": [ "ast" ] }
+			}
+		}
+	}
+	)";
+	Json const uncached = compile(input);
+
+	solidity_set_parsed_source_cache(1024 * 1024);
+	// The second compilation takes the source from the cache.
+	BOOST_CHECK(compile(input) == uncached);
+	BOOST_CHECK(compile(input) == uncached);
+	solidity_set_parsed_source_cache(0);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // end namespaces
@@ -0,0 +1,111 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests checking that the optimized IR output describes the code the compiler assembled.
+ */
+
+#include <libsolidity/interface/CompilerStack.h>
+#include <libsolidity/codegen/ir/Common.h>
+
+#include <libyul/YulStack.h>
+
+#include <libevmasm/Assembly.h>
+
+#include <liblangutil/SourceReferenceFormatter.h>
+
+#include <test/Common.h>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace solidity::langutil;
+
+namespace solidity::frontend::test
+{
+
+BOOST_AUTO_TEST_SUITE(OptimizedIROutput)
+
+BOOST_AUTO_TEST_CASE(same_assembly_as_reparsed_output)
+{
+	StringMap const sources{
+		{"a.sol", R"(
+			// SPDX-License-Identifier: GPL-3.0
+			pragma solidity >=0.0;
+			contract C {
+				uint[] public values;
+				event Pushed(uint);
+				function push(uint _x) public returns (uint) {
+					values.push(_x * 3);
+					emit Pushed(_x);
+					return values.length;
+				}
+			}
+			contract D {
+				function f() public returns (uint) {
+					C c = new C();
+					return c.push(42) + abi.decode(abi.encode(c), (uint160)) % 7;
+				}
+			}
+		)"},
+	};
+
+	for (bool optimize: {false, true})
+	{
+		CompilerStack compiler;
+		compiler.setEVMVersion(solidity::test::CommonOptions::get().evmVersion());
+		compiler.setOptimiserSettings(optimize);
+		compiler.setViaIR(true);
+		compiler.setSources(sources);
+		BOOST_REQUIRE_MESSAGE(
+			compiler.compile(),
+			SourceReferenceFormatter::formatErrorInformation(compiler.errors(), compiler)
+		);
+
+		for (std::string const& contractName: compiler.contractNames())
+		{
+			// Assembling the printed optimized IR is what the compiler did before it kept the optimized AST.
+			std::optional<std::string> const& irOptimized = compiler.yulIROptimized(contractName);
+			BOOST_REQUIRE(irOptimized.has_value());
+			yul::YulStack reparsedStack(
+				solidity::test::CommonOptions::get().evmVersion(),
+				std::nullopt,
+				yul::YulStack::Language::StrictAssembly,
+				optimize ? OptimiserSettings::standard() : OptimiserSettings::minimal(),
+				DebugInfoSelection::Default(),
+				&compiler
+			);
+			BOOST_REQUIRE(reparsedStack.parseAndAnalyze("", *irOptimized));
+			auto [assembly, runtimeAssembly] = reparsedStack.assembleEVMWithDeployed(
+				IRNames::deployedObject(compiler.contractDefinition(contractName))
+			);
+			BOOST_REQUIRE(assembly && runtimeAssembly);
+
+			BOOST_TEST_CONTEXT(contractName << (optimize ? " optimized" : ""))
+			{
+				BOOST_CHECK_EQUAL(compiler.assemblyString(contractName), assembly->assemblyString(DebugInfoSelection::Default()));
+				BOOST_CHECK_EQUAL(
+					util::toHex(compiler.runtimeObject(contractName).bytecode),
+					util::toHex(runtimeAssembly->assemble().bytecode)
+				);
+			}
+		}
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -0,0 +1,129 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for reusing Yul optimizer results stored on disk by an earlier compilation.
+ */
+
+#include <libsolidity/interface/CompilerStack.h>
+
+#include <liblangutil/SourceReferenceFormatter.h>
+
+#include <libsolutil/TemporaryDirectory.h>
+
+#include <test/Common.h>
+
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+
+using namespace solidity::langutil;
+
+namespace fs = boost::filesystem;
+
+namespace solidity::frontend::test
+{
+
+namespace
+{
+
+/// @returns the bytecode and the optimized IR of all contracts in @a _sources.
+std::map<std::string, std::string> compile(StringMap const& _sources, std::optional<fs::path> const& _cacheDirectory)
+{
+	CompilerStack compiler;
+	compiler.setEVMVersion(solidity::test::CommonOptions::get().evmVersion());
+	compiler.setOptimiserSettings(true);
+	compiler.setViaIR(true);
+	if (_cacheDirectory)
+		compiler.setOptimizerCacheDirectory(*_cacheDirectory);
+	compiler.setSources(_sources);
+	BOOST_REQUIRE_MESSAGE(
+		compiler.compile(),
+		SourceReferenceFormatter::formatErrorInformation(compiler.errors(), compiler)
+	);
+
+	std::map<std::string, std::string> outputs;
+	for (std::string const& contract: compiler.contractNames())
+	{
+		outputs[contract + ":bytecode"] = compiler.object(contract).toHex();
+		outputs[contract + ":runtimeBytecode"] = compiler.runtimeObject(contract).toHex();
+		outputs[contract + ":irOptimized"] = compiler.yulIROptimized(contract).value_or("");
+	}
+	return outputs;
+}
+
+std::vector<fs::path> cacheEntries(fs::path const& _directory)
+{
+	std::vector<fs::path> entries;
+	for (fs::directory_iterator it(_directory), end; it != end; ++it)
+		if (it->path().extension() == ".entry")
+			entries.push_back(it->path());
+	return entries;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(OptimizerDiskCache)
+
+BOOST_AUTO_TEST_CASE(hits_give_same_output)
+{
+	StringMap const sources{
+		{"a.sol", R"(
+			// SPDX-License-Identifier: GPL-3.0
+			pragma solidity >=0.0;
+			contract C {
+				mapping(address => uint) balances;
+				function deposit() public payable { balances[msg.sender] += msg.value; }
+				function withdraw(uint _amount) public {
+					require(balances[msg.sender] >= _amount, "Insufficient balance");
+					balances[msg.sender] -= _amount;
+					payable(msg.sender).transfer(_amount);
+				}
+			}
+			contract D {
+				function f() public returns (C) { return new C(); }
+			}
+		)"},
+	};
+
+	util::TemporaryDirectory tempDir("optimizer-disk-cache-test");
+	fs::path const cacheDirectory = tempDir.path() / "cache";
+
+	std::map<std::string, std::string> const uncached = compile(sources, std::nullopt);
+	BOOST_CHECK(compile(sources, cacheDirectory) == uncached);
+	std::vector<fs::path> const entries = cacheEntries(cacheDirectory);
+	BOOST_REQUIRE(!entries.empty());
+
+	// Entries are only written after a miss, by renaming a new file over the old one. A second
+	// link to each entry thus shows whether the next compilation took all results from the cache.
+	for (fs::path const& entry: entries)
+		fs::create_hard_link(entry, fs::path(entry).replace_extension(".link"));
+
+	std::map<std::string, std::string> const cached = compile(sources, cacheDirectory);
+	BOOST_REQUIRE_EQUAL(cached.size(), uncached.size());
+	for (auto const& [name, output]: uncached)
+	{
+		BOOST_TEST_CONTEXT(name)
+			BOOST_CHECK_EQUAL(cached.at(name), output);
+	}
+	BOOST_CHECK_EQUAL(cacheEntries(cacheDirectory).size(), entries.size());
+	for (fs::path const& entry: entries)
+		BOOST_CHECK_EQUAL(fs::hard_link_count(entry), 2);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
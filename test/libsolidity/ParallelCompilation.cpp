@@ -0,0 +1,115 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for optimizing and assembling the IR of contracts concurrently.
+ */
+
+#include <libsolidity/interface/CompilerStack.h>
+
+#include <liblangutil/SourceReferenceFormatter.h>
+
+#include <test/Common.h>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace solidity::langutil;
+
+namespace solidity::frontend::test
+{
+
+namespace
+{
+
+/// @returns all outputs of the compilation of @a _sources via the IR, keyed by contract and output name.
+std::map<std::string, std::string> compile(StringMap const& _sources, size_t _parallelism)
+{
+	CompilerStack compiler;
+	compiler.setEVMVersion(solidity::test::CommonOptions::get().evmVersion());
+	compiler.setOptimiserSettings(true);
+	compiler.setViaIR(true);
+	compiler.setParallelism(_parallelism);
+	compiler.setSources(_sources);
+
+	std::map<std::string, std::string> outputs;
+	bool successful = compiler.compile();
+	outputs["errors"] = SourceReferenceFormatter::formatErrorInformation(compiler.errors(), compiler);
+	BOOST_REQUIRE(successful);
+	for (std::string const& contract: compiler.contractNames())
+	{
+		outputs[contract + ":bytecode"] = compiler.object(contract).toHex();
+		outputs[contract + ":runtimeBytecode"] = compiler.runtimeObject(contract).toHex();
+		outputs[contract + ":assembly"] = compiler.assemblyString(contract, _sources);
+		outputs[contract + ":metadata"] = compiler.metadata(contract);
+		outputs[contract + ":ir"] = compiler.yulIR(contract).value_or("");
+		outputs[contract + ":irOptimized"] = compiler.yulIROptimized(contract).value_or("");
+	}
+	return outputs;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(ParallelCompilation)
+
+BOOST_AUTO_TEST_CASE(same_outputs_as_sequential)
+{
+	StringMap const sources{
+		{"a.sol", R"(
+			// SPDX-License-Identifier: GPL-3.0
+			pragma solidity >=0.0;
+			import "b.sol";
+			contract A {
+				function f(uint x) public returns (address) {
+					B b = new B(x);
+					return address(new C{salt: bytes32(x)}(b.g()));
+				}
+			}
+			contract D is A {
+				function h() public pure returns (string memory) { return "unused"; }
+			}
+		)"},
+		{"b.sol", R"(
+			// SPDX-License-Identifier: GPL-3.0
+			pragma solidity >=0.0;
+			contract C {
+				uint public y;
+				constructor(uint _y) { y = _y * 2; }
+			}
+			contract B {
+				uint x;
+				constructor(uint _x) { x = _x; }
+				function g() public returns (uint) { C c = new C(x); return c.y() + type(C).creationCode.length; }
+			}
+			abstract contract E { function e() public virtual; }
+			interface I { function i() external; }
+			library L { function l(uint a) public pure returns (uint) { return a + 1; } }
+		)"},
+	};
+
+	std::map<std::string, std::string> const sequential = compile(sources, 1);
+	std::map<std::string, std::string> const parallel = compile(sources, 4);
+	BOOST_REQUIRE_EQUAL(parallel.size(), sequential.size());
+	for (auto const& [name, output]: sequential)
+	{
+		BOOST_TEST_CONTEXT(name)
+			BOOST_CHECK_EQUAL(parallel.at(name), output);
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -0,0 +1,142 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for parsing and checking sources concurrently.
+ */
+
+#include <libsolidity/interface/CompilerStack.h>
+#include <libsolidity/ast/ASTJsonExporter.h>
+
+#include <liblangutil/SourceReferenceFormatter.h>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace solidity::langutil;
+
+namespace solidity::frontend::test
+{
+
+namespace
+{
+
+struct AnalysisResult
+{
+	bool successful = false;
+	std::string messages;
+	std::map<std::string, Json> asts;
+};
+
+AnalysisResult analyze(
+	StringMap const& _sources,
+	size_t _parallelism,
+	std::shared_ptr<ParsedSourceCache> _cache = nullptr
+)
+{
+	CompilerStack compiler;
+	compiler.setParallelism(_parallelism);
+	if (_cache)
+		compiler.setParsedSourceCache(std::move(_cache));
+	compiler.setSources(_sources);
+
+	AnalysisResult result;
+	result.successful = compiler.parseAndAnalyze();
+	result.messages = SourceReferenceFormatter::formatErrorInformation(compiler.errors(), compiler);
+	if (compiler.state() >= CompilerStack::State::Parsed)
+		for (std::string const& sourceName: compiler.sourceNames())
+			result.asts[sourceName] = ASTJsonExporter(compiler.state()).toJson(compiler.ast(sourceName));
+	return result;
+}
+
+void checkSameAsSequential(StringMap const& _sources, std::shared_ptr<ParsedSourceCache> _cache = nullptr)
+{
+	AnalysisResult const sequential = analyze(_sources, 1);
+	AnalysisResult const parallel = analyze(_sources, 4, std::move(_cache));
+	BOOST_CHECK_EQUAL(parallel.successful, sequential.successful);
+	BOOST_CHECK_EQUAL(parallel.messages, sequential.messages);
+	BOOST_CHECK(parallel.asts == sequential.asts);
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(ParallelParsing)
+
+BOOST_AUTO_TEST_CASE(same_ids_and_messages_as_sequential)
+{
+	StringMap const sources{
+		{"a.sol", "pragma solidity >=0.0;\nimport \"c.sol\";\ncontract A is C { function f() public pure returns (uint) { return g() + 1; } }"},
+		{"b.sol", "// SPDX-License-Identifier: GPL-3.0\npragma solidity >=0.0;\nimport \"a.sol\";\n/// @title B\ncontract B is A { function h() public pure { assembly { let x := 1 } } }"},
+		{"c.sol", "// SPDX-License-Identifier: GPL-3.0\npragma solidity >=0.0;\ncontract C { function g() internal pure returns (uint) { return 2; } }"},
+	};
+	checkSameAsSequential(sources);
+
+	// The first source cannot be cached, because the parser reports a missing license for it.
+	auto cache = std::make_shared<ParsedSourceCache>();
+	analyze(sources, 1, cache);
+	BOOST_CHECK_EQUAL(cache->size(), 2);
+	checkSameAsSequential(sources, cache);
+}
+
+BOOST_AUTO_TEST_CASE(parser_errors)
+{
+	checkSameAsSequential({
+		{"a.sol", "contract A { function f() { } "},
+		{"b.sol", "contract B { uint x = ; }"},
+		{"c.sol", "contract C {}"},
+	});
+}
+
+BOOST_AUTO_TEST_CASE(message_limits)
+{
+	// Each source lacks a license identifier, which exceeds the limit on warnings.
+	StringMap sources;
+	for (size_t i = 0; i < 300; ++i)
+		sources["s" + std::to_string(i) + ".sol"] = "pragma solidity >=0.0;\ncontract C" + std::to_string(i) + " {}";
+	checkSameAsSequential(sources);
+}
+
+BOOST_AUTO_TEST_CASE(syntax_and_docstring_errors)
+{
+	checkSameAsSequential({
+		{"a.sol", "pragma solidity >=0.0;\ncontract A { function f() public { continue; } }"},
+		{"b.sol", "// SPDX-License-Identifier: GPL-3.0\npragma solidity >=0.0;\n/// @author\ncontract B { /// @return x\nfunction f() public {} }"},
+		{"c.sol", "// SPDX-License-Identifier: GPL-3.0\ncontract C { function f() public { assembly { msize() } } }"},
+	});
+}
+
+BOOST_AUTO_TEST_CASE(error_limit_in_checks)
+{
+	std::string const loopless = "function f() public { continue; }";
+
+	// The limit on errors is reached by the errors of many sources together.
+	StringMap sources;
+	for (size_t i = 0; i < 300; ++i)
+		sources["s" + std::to_string(i) + ".sol"] = "contract C" + std::to_string(i) + " { " + loopless + " }";
+	checkSameAsSequential(sources);
+
+	// The limit on errors is reached within a single source, with and without errors before it.
+	std::string manyErrors = "contract D {";
+	for (size_t i = 0; i < 300; ++i)
+		manyErrors += " function f" + std::to_string(i) + "() public { continue; }";
+	manyErrors += " }";
+	checkSameAsSequential({{"a.sol", manyErrors}, {"b.sol", "contract B {}"}});
+	checkSameAsSequential({{"a.sol", "contract A { " + loopless + " }"}, {"b.sol", manyErrors}});
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -0,0 +1,201 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for reusing parsed source units across compilations.
+ */
+
+#include <libsolidity/interface/CompilerStack.h>
+#include <libsolidity/interface/ParsedSourceCache.h>
+#include <libsolidity/ast/ASTJsonExporter.h>
+
+#include <libsolutil/Keccak256.h>
+
+#include <boost/test/unit_test.hpp>
+
+namespace solidity::frontend::test
+{
+
+namespace
+{
+
+struct CompilationResult
+{
+	std::map<std::string, Json> asts;
+	std::map<std::string, SourceUnit const*> trees;
+};
+
+CompilationResult analyze(StringMap const& _sources, std::shared_ptr<ParsedSourceCache> _cache = nullptr)
+{
+	CompilerStack compiler;
+	if (_cache)
+		compiler.setParsedSourceCache(std::move(_cache));
+	compiler.setSources(_sources);
+	BOOST_REQUIRE(compiler.parseAndAnalyze());
+
+	CompilationResult result;
+	for (std::string const& sourceName: compiler.sourceNames())
+	{
+		result.asts[sourceName] = ASTJsonExporter(compiler.state()).toJson(compiler.ast(sourceName));
+		result.trees[sourceName] = &compiler.ast(sourceName);
+	}
+	return result;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(ParsedSourceCacheTest)
+
+BOOST_AUTO_TEST_CASE(reuse_unchanged_sources)
+{
+	StringMap sources{
+		{"a.sol", "// SPDX-License-Identifier: GPL-3.0\npragma solidity >=0.0;\nimport \"b.sol\";\ncontract A is B { function f() public pure returns (uint) { return g() + 1; } }"},
+		{"b.sol", "// SPDX-License-Identifier: GPL-3.0\npragma solidity >=0.0;\ncontract B { function g() internal pure returns (uint) { return 2; } }"},
+	};
+	auto cache = std::make_shared<ParsedSourceCache>();
+
+	CompilationResult first = analyze(sources, cache);
+	BOOST_CHECK(first.asts == analyze(sources).asts);
+	BOOST_CHECK_EQUAL(cache->size(), 2);
+
+	CompilationResult second = analyze(sources, cache);
+	BOOST_CHECK(second.asts == first.asts);
+	BOOST_CHECK(second.trees == first.trees);
+	BOOST_CHECK_EQUAL(cache->size(), 2);
+
+	// The first source becomes shorter, so the IDs of the reused second source have to be relocated.
+	sources["a.sol"] = "// SPDX-License-Identifier: GPL-3.0\npragma solidity >=0.0;\nimport \"b.sol\";\ncontract A is B {}";
+	CompilationResult third = analyze(sources, cache);
+	BOOST_CHECK(third.asts == analyze(sources).asts);
+	BOOST_CHECK(third.trees.at("a.sol") != first.trees.at("a.sol"));
+	BOOST_CHECK(third.trees.at("b.sol") == first.trees.at("b.sol"));
+	// The previous version of the first source is still in the cache.
+	BOOST_CHECK_EQUAL(cache->size(), 3);
+}
+
+BOOST_AUTO_TEST_CASE(single_version_per_source)
+{
+	std::string const firstVersion = "// SPDX-License-Identifier: GPL-3.0\npragma solidity >=0.0;\ncontract A { uint x; }";
+	std::string const secondVersion = "// SPDX-License-Identifier: GPL-3.0\npragma solidity >=0.0;\ncontract A { uint y; }";
+	auto key = [](std::string const& _content) {
+		return ParsedSourceCache::Key{"a.sol", util::keccak256(_content), langutil::EVMVersion{}, std::nullopt};
+	};
+
+	StringMap sources{
+		{"a.sol", firstVersion},
+		{"b.sol", "// SPDX-License-Identifier: GPL-3.0\npragma solidity >=0.0;\ncontract B {}"},
+	};
+	auto cache = std::make_shared<ParsedSourceCache>(std::numeric_limits<size_t>::max(), true);
+	CompilationResult first = analyze(sources, cache);
+	BOOST_CHECK(cache->contains(key(firstVersion)));
+	BOOST_CHECK_EQUAL(cache->size(), 2);
+
+	// Storing the new version of the first source drops the previous one.
+	sources["a.sol"] = secondVersion;
+	CompilationResult second = analyze(sources, cache);
+	BOOST_CHECK(second.trees.at("b.sol") == first.trees.at("b.sol"));
+	BOOST_CHECK(!cache->contains(key(firstVersion)));
+	BOOST_CHECK(cache->contains(key(secondVersion)));
+	BOOST_CHECK_EQUAL(cache->size(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(sources_with_messages_are_not_cached)
+{
+	auto cache = std::make_shared<ParsedSourceCache>();
+	analyze(
+		{
+			{"clean.sol", "// SPDX-License-Identifier: GPL-3.0\npragma solidity >=0.0;\ncontract C {}"},
+			{"warning.sol", "pragma solidity >=0.0;\ncontract D {}"},
+		},
+		cache
+	);
+	BOOST_CHECK_EQUAL(cache->size(), 1);
+	cache->clear();
+
+	{
+		CompilerStack compiler;
+		compiler.setParsedSourceCache(cache);
+		compiler.setSources({{"error.sol", "contract {"}});
+		BOOST_CHECK(!compiler.parseAndAnalyze());
+	}
+	BOOST_CHECK_EQUAL(cache->size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(sources_with_inline_assembly)
+{
+	StringMap const sources{{"a.sol", R"(
+		// SPDX-License-Identifier: GPL-3.0
+		pragma solidity >=0.0;
+		contract A {
+			function f(uint x) public pure returns (uint r) {
+				assembly {
+					function g(a) -> b { b := add(a, 1) }
+					let y := g(x)
+					r := mul(y, 2)
+				}
+			}
+		}
+	)"}};
+	auto bytecode = [&](std::shared_ptr<ParsedSourceCache> _cache) {
+		CompilerStack compiler;
+		if (_cache)
+			compiler.setParsedSourceCache(std::move(_cache));
+		compiler.setSources(sources);
+		BOOST_REQUIRE(compiler.compile());
+		return compiler.object("a.sol:A").toHex();
+	};
+	auto cache = std::make_shared<ParsedSourceCache>();
+
+	// The compilation that parsed the source, and with it the strings of its Yul names, is gone
+	// when the tree is reused.
+	CompilationResult first = analyze(sources, cache);
+	BOOST_CHECK_EQUAL(cache->size(), 1);
+	CompilationResult second = analyze(sources, cache);
+	BOOST_CHECK(second.trees == first.trees);
+	BOOST_CHECK(second.asts == analyze(sources).asts);
+	BOOST_CHECK_EQUAL(bytecode(cache), bytecode(nullptr));
+	BOOST_CHECK_EQUAL(cache->size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(memory_budget)
+{
+	StringMap const first{{"a.sol", "// SPDX-License-Identifier: GPL-3.0\npragma solidity >=0.0;\ncontract A { uint x; }"}};
+	StringMap const second{{"b.sol", "// SPDX-License-Identifier: GPL-3.0\npragma solidity >=0.0;\ncontract B { uint y; }"}};
+
+	auto unbounded = std::make_shared<ParsedSourceCache>();
+	analyze(first, unbounded);
+	size_t const treeSize = unbounded->memoryUsage();
+	BOOST_REQUIRE(treeSize > 0);
+
+	// Only one of the trees fits, so the one stored first is dropped.
+	auto cache = std::make_shared<ParsedSourceCache>(treeSize + treeSize / 2);
+	analyze(first, cache);
+	CompilationResult secondResult = analyze(second, cache);
+	BOOST_CHECK_EQUAL(cache->size(), 1);
+	BOOST_CHECK_EQUAL(cache->memoryUsage(), treeSize);
+	BOOST_CHECK(analyze(second, cache).trees == secondResult.trees);
+
+	// Trees that exceed the budget on their own are not stored at all.
+	auto tiny = std::make_shared<ParsedSourceCache>(treeSize - 1);
+	analyze(first, tiny);
+	BOOST_CHECK_EQUAL(tiny->size(), 0);
+	BOOST_CHECK_EQUAL(tiny->memoryUsage(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
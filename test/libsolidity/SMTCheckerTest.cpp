@@ -65,6 +65,22 @@ SMTCheckerTest::SMTCheckerTest(std::string const& _filename):
 	else
 		BOOST_THROW_EXCEPTION(std::runtime_error("Invalid SMT \"show unsupported\" choice."));
 
+	auto const& raceSolvers = m_reader.stringSetting("SMTRaceSolvers", "no");
+	if (raceSolvers == "no")
+		m_modelCheckerSettings.raceSolvers = false;
+	else if (raceSolvers == "yes")
+		m_modelCheckerSettings.raceSolvers = true;
+	else
+		BOOST_THROW_EXCEPTION(std::runtime_error("Invalid SMT \"race solvers\" choice."));
+
+	auto const& showSolverStatistics = m_reader.stringSetting("SMTShowSolverStatistics", "no");
+	if (showSolverStatistics == "no")
+		m_modelCheckerSettings.showSolverStatistics = false;
+	else if (showSolverStatistics == "yes" && m_modelCheckerSettings.raceSolvers)
+		m_modelCheckerSettings.showSolverStatistics = true;
+	else
+		BOOST_THROW_EXCEPTION(std::runtime_error("Invalid SMT \"show solver statistics\" choice."));
+
 	m_modelCheckerSettings.solvers = smtutil::SMTSolverChoice::None();
 	auto const& choice = m_reader.stringSetting("SMTSolvers", "z3");
 	if (choice == "none")
@@ -0,0 +1,167 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for combining the answers of the solvers of an SMT portfolio.
+ */
+
+#include <libsmtutil/SMTPortfolio.h>
+#include <libsmtutil/CancellationToken.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <future>
+
+using namespace solidity::smtutil;
+
+namespace solidity::frontend::test
+{
+
+namespace
+{
+
+/// Solver giving a fixed answer, optionally only once its query has been cancelled.
+class FakeSolver: public BMCSolverInterface
+{
+public:
+	FakeSolver(CheckResult _result, std::string _value, bool _waitForCancellation = false):
+		m_result(_result),
+		m_value(std::move(_value)),
+		m_waitForCancellation(_waitForCancellation)
+	{}
+
+	void reset() override {}
+	void push() override {}
+	void pop() override {}
+	void declareVariable(std::string const&, SortPointer const&) override {}
+	void addAssertion(Expression const&) override {}
+
+	std::pair<CheckResult, std::vector<std::string>> check(std::vector<Expression> const&) override
+	{
+		if (m_waitForCancellation)
+		{
+			CancellationToken* token = CancellationToken::current();
+			if (!token)
+				return {CheckResult::ERROR, {}};
+			std::promise<void> cancelled;
+			size_t const callback = token->addCallback([&]() { cancelled.set_value(); });
+			cancelled.get_future().wait();
+			token->removeCallback(callback);
+			m_cancelled = true;
+		}
+		return {m_result, {m_value}};
+	}
+
+	bool cancelled() const { return m_cancelled; }
+
+private:
+	CheckResult m_result;
+	std::string m_value;
+	bool m_waitForCancellation;
+	std::atomic<bool> m_cancelled = false;
+};
+
+using Solvers = std::vector<std::unique_ptr<BMCSolverInterface>>;
+
+std::pair<CheckResult, std::vector<std::string>> check(
+	std::vector<std::pair<CheckResult, std::string>> const& _answers,
+	bool _race
+)
+{
+	Solvers solvers;
+	for (auto const& [result, value]: _answers)
+		solvers.emplace_back(std::make_unique<FakeSolver>(result, value));
+	SMTPortfolio portfolio(std::move(solvers), std::nullopt, _race, std::chrono::minutes(10));
+	return portfolio.check({});
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(SMTPortfolioTest)
+
+BOOST_AUTO_TEST_CASE(combine_answers)
+{
+	using Values = std::vector<std::string>;
+	for (bool race: {false, true})
+	{
+		BOOST_TEST_CONTEXT((race ? "racing" : "sequential"))
+		{
+			auto result = check({{CheckResult::UNKNOWN, "a"}, {CheckResult::UNSATISFIABLE, "b"}, {CheckResult::ERROR, "c"}}, race);
+			BOOST_CHECK(result.first == CheckResult::UNSATISFIABLE);
+			BOOST_CHECK(result.second == Values{"b"});
+
+			result = check({{CheckResult::SATISFIABLE, "a"}, {CheckResult::SATISFIABLE, "b"}}, race);
+			BOOST_CHECK(result.first == CheckResult::SATISFIABLE);
+			BOOST_CHECK(result.second == Values{"a"});
+
+			BOOST_CHECK(check({{CheckResult::SATISFIABLE, "a"}, {CheckResult::UNSATISFIABLE, "b"}}, race).first == CheckResult::CONFLICTING);
+			BOOST_CHECK(check({{CheckResult::ERROR, "a"}, {CheckResult::UNKNOWN, "b"}}, race).first == CheckResult::UNKNOWN);
+			BOOST_CHECK(check({{CheckResult::ERROR, "a"}, {CheckResult::ERROR, "b"}}, race).first == CheckResult::ERROR);
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE(first_answer_wins)
+{
+	Solvers solvers;
+	solvers.emplace_back(std::make_unique<FakeSolver>(CheckResult::UNKNOWN, "slow", true));
+	solvers.emplace_back(std::make_unique<FakeSolver>(CheckResult::UNSATISFIABLE, "fast"));
+	auto const& slow = dynamic_cast<FakeSolver const&>(*solvers[0]);
+	SMTPortfolio portfolio(std::move(solvers), std::nullopt, true);
+
+	auto const [result, values] = portfolio.check({});
+	BOOST_CHECK(result == CheckResult::UNSATISFIABLE);
+	BOOST_CHECK(values == std::vector<std::string>{"fast"});
+	// The loser only returns once its token was cancelled.
+	BOOST_CHECK(slow.cancelled());
+	BOOST_CHECK_EQUAL(portfolio.statistics()[0].cancellations, 1);
+	BOOST_CHECK_EQUAL(portfolio.statistics()[0].firstAnswers, 0);
+	BOOST_CHECK_EQUAL(portfolio.statistics()[1].cancellations, 0);
+	BOOST_CHECK_EQUAL(portfolio.statistics()[1].firstAnswers, 1);
+}
+
+BOOST_AUTO_TEST_CASE(first_answer_in_sequence)
+{
+	Solvers solvers;
+	solvers.emplace_back(std::make_unique<FakeSolver>(CheckResult::UNKNOWN, "a"));
+	solvers.emplace_back(std::make_unique<FakeSolver>(CheckResult::SATISFIABLE, "b"));
+	solvers.emplace_back(std::make_unique<FakeSolver>(CheckResult::SATISFIABLE, "c"));
+	SMTPortfolio portfolio(std::move(solvers), std::nullopt);
+
+	BOOST_CHECK(portfolio.check({}).first == CheckResult::SATISFIABLE);
+	BOOST_CHECK_EQUAL(portfolio.statistics()[0].firstAnswers, 0);
+	BOOST_CHECK_EQUAL(portfolio.statistics()[1].firstAnswers, 1);
+	BOOST_CHECK_EQUAL(portfolio.statistics()[2].firstAnswers, 0);
+	for (SMTPortfolio::SolverStatistics const& statistics: portfolio.statistics())
+		BOOST_CHECK_EQUAL(statistics.queries, 1);
+}
+
+BOOST_AUTO_TEST_CASE(keep_answer_given_on_cancellation)
+{
+	Solvers solvers;
+	solvers.emplace_back(std::make_unique<FakeSolver>(CheckResult::SATISFIABLE, "fast"));
+	solvers.emplace_back(std::make_unique<FakeSolver>(CheckResult::UNSATISFIABLE, "late", true));
+	SMTPortfolio portfolio(std::move(solvers), std::nullopt, true);
+
+	BOOST_CHECK(portfolio.check({}).first == CheckResult::CONFLICTING);
+	BOOST_CHECK_EQUAL(portfolio.statistics()[1].cancellations, 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
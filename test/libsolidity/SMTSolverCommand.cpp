@@ -0,0 +1,111 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the input sent to SMT solver processes kept running between queries.
+ */
+
+#include <libsolidity/interface/SMTSolverCommand.h>
+
+#include <boost/test/unit_test.hpp>
+
+namespace solidity::frontend::test
+{
+
+BOOST_AUTO_TEST_SUITE(SMTSolverSessionStateTest)
+
+BOOST_AUTO_TEST_CASE(split_commands)
+{
+	std::string const script =
+		"(set-logic ALL)\n"
+		"; a comment (with an unbalanced parenthesis\n"
+		"(declare-fun |sym(bol| () String)\n"
+		"(assert (= |sym(bol| \"str(ing\"\")\"))  ; another one )\n"
+		"(check-sat";
+	std::vector<std::string> const expectation{
+		"(set-logic ALL)",
+		"(declare-fun |sym(bol| () String)",
+		"(assert (= |sym(bol| \"str(ing\"\")\"))",
+		"(check-sat",
+	};
+	BOOST_CHECK(SMTSolverSessionState::splitCommands(script) == expectation);
+	BOOST_CHECK(SMTSolverSessionState::splitCommands("; only a comment (") == std::vector<std::string>{});
+}
+
+BOOST_AUTO_TEST_CASE(reuse_frames)
+{
+	SMTSolverSessionState state;
+	BOOST_CHECK_EQUAL(
+		state.input("(set-logic ALL)\n(declare-fun x () Int)\n(assert (> x 0))\n(check-sat)\n"),
+		"(reset)\n(set-logic ALL)\n(push 1)\n(declare-fun x () Int)\n(assert (> x 0))\n(check-sat)\n"
+	);
+	// Extending the previous query only pushes the new assertion.
+	BOOST_CHECK_EQUAL(
+		state.input("(set-logic ALL)\n(declare-fun x () Int)\n(assert (> x 0))\n(assert (< x 5))\n(check-sat)\n"),
+		"(push 1)\n(assert (< x 5))\n(check-sat)\n"
+	);
+	// Replacing the last assertion pops only its frame.
+	BOOST_CHECK_EQUAL(
+		state.input("(set-logic ALL)\n(declare-fun x () Int)\n(assert (> x 0))\n(assert (= x 3))\n(check-sat)\n(get-value (x))\n"),
+		"(pop 1)\n(push 1)\n(assert (= x 3))\n(check-sat)\n(get-value (x))\n"
+	);
+	// Diverging inside of the first frame splits it at the first differing command.
+	BOOST_CHECK_EQUAL(
+		state.input("(set-logic ALL)\n(declare-fun x () Int)\n(assert (> x 1))\n(check-sat)\n"),
+		"(pop 1)\n(pop 1)\n(push 1)\n(declare-fun x () Int)\n(push 1)\n(assert (> x 1))\n(check-sat)\n"
+	);
+	BOOST_CHECK_EQUAL(
+		state.input("(set-logic ALL)\n(declare-fun x () Int)\n(assert (> x 2))\n(check-sat)\n"),
+		"(pop 1)\n(push 1)\n(assert (> x 2))\n(check-sat)\n"
+	);
+	BOOST_CHECK_EQUAL(
+		state.input("(set-logic ALL)\n(declare-fun y () Int)\n(check-sat)\n"),
+		"(pop 1)\n(pop 1)\n(push 1)\n(declare-fun y () Int)\n(check-sat)\n"
+	);
+}
+
+BOOST_AUTO_TEST_CASE(reset_on_preamble_change)
+{
+	SMTSolverSessionState state;
+	state.input("(set-logic ALL)\n(declare-fun x () Int)\n(check-sat)\n");
+	BOOST_CHECK_EQUAL(
+		state.input("(set-option :produce-models true)\n(set-logic ALL)\n(declare-fun x () Int)\n(check-sat)\n"),
+		"(reset)\n(set-option :produce-models true)\n(set-logic ALL)\n(push 1)\n(declare-fun x () Int)\n(check-sat)\n"
+	);
+}
+
+BOOST_AUTO_TEST_CASE(horn_queries_sent_in_full)
+{
+	SMTSolverSessionState state;
+	std::string const query =
+		"(set-logic HORN)\n"
+		"(declare-fun P (Int) Bool)\n"
+		"(assert (forall ((x Int)) (P x)))\n"
+		"(check-sat)\n";
+	for (size_t i = 0; i < 2; ++i)
+		BOOST_CHECK_EQUAL(state.input(query), "(reset)\n" + query);
+
+	// Leaving Horn mode does not reuse anything loaded before.
+	BOOST_CHECK_EQUAL(
+		state.input("(set-logic ALL)\n(declare-fun P (Int) Bool)\n(check-sat)\n"),
+		"(reset)\n(set-logic ALL)\n(push 1)\n(declare-fun P (Int) Bool)\n(check-sat)\n"
+	);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -33,6 +33,7 @@
 
 #include <algorithm>
 #include <set>
+#include <sstream>
 
 using namespace solidity::evmasm;
 using namespace std::string_literals;
@@ -1782,6 +1783,166 @@ BOOST_AUTO_TEST_CASE(source_location_of_bare_block)
 	BOOST_REQUIRE(sourceMap.find(sourceRef) != std::string::npos);
 }
 
+BOOST_AUTO_TEST_CASE(streamed_output)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"sources": {
+			"a.sol": {
+				"content": "contract A { function f() public {} } contract B {}"
+			},
+			"a": {
+				"content": "import \"a.sol\"; contract C is A { uint x; }"
+			},
+			"b.sol": {
+				"content": "interface I {}"
+			}
+		},
+		"settings": {
+			"outputSelection": {
+				"*": {
+					"": ["ast"],
+					"*": ["abi", "storageLayout", "evm.bytecode.object", "evm.deployedBytecode.sourceMap"]
+				},
+				"b.sol": {
+					"*": ["evm.assembly"]
+				}
+			}
+		}
+	}
+	)";
+
+	for (util::JsonFormat format: {util::JsonFormat{util::JsonFormat::Compact}, util::JsonFormat{util::JsonFormat::Pretty, 4}})
+		for (std::string const& source: {std::string(input), std::string("{\"language\": \"Solidity\", \"sources\": {\"x.sol\": {\"content\": \"contract\"}}}"), std::string("{")})
+		{
+			solidity::frontend::StandardCompiler compiler({}, format);
+			std::string expected = compiler.compile(source);
+
+			std::ostringstream streamed;
+			compiler.compile(source, streamed);
+			BOOST_CHECK_EQUAL(streamed.str(), expected);
+		}
+}
+
+BOOST_AUTO_TEST_CASE(streamed_output_on_internal_error)
+{
+	// The contract and the warnings are written before the AST, which cannot be exported because its
+	// documentation is not valid UTF-8. Sources given via their content are always valid UTF-8.
+	ReadCallback::Callback readFile = [](std::string const&, std::string const&) {
+		return ReadCallback::Result{true, "/// \xff\ncontract C {}"};
+	};
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"sources": {
+			"a.sol": {"urls": ["a.sol"]},
+			"b.sol": {"content": "contract B {}"}
+		},
+		"settings": {
+			"outputSelection": {"*": {"": ["ast"], "*": ["abi"]}}
+		}
+	}
+	)";
+
+	for (util::JsonFormat format: {util::JsonFormat{util::JsonFormat::Compact}, util::JsonFormat{util::JsonFormat::Pretty, 4}})
+	{
+		solidity::frontend::StandardCompiler compiler(readFile, format);
+		std::ostringstream streamed;
+		// The failure cannot be reported in the output anymore, but the output is still completed.
+		BOOST_CHECK_THROW(compiler.compile(input, streamed), std::exception);
+
+		Json output;
+		BOOST_REQUIRE(util::jsonParseStrict(streamed.str(), output));
+		BOOST_CHECK(output["contracts"]["a.sol"]["C"]["abi"] == Json::array());
+		BOOST_REQUIRE(!output["errors"].empty());
+		for (Json const& error: output["errors"])
+			BOOST_CHECK(error["severity"] == "warning");
+		BOOST_CHECK(output["sources"] == Json::object());
+	}
+}
+
+BOOST_AUTO_TEST_CASE(profile)
+{
+	auto const input = [](std::string const& _profile) {
+		return R"(
+		{
+			"language": "Solidity",
+			"sources": {
+				"a.sol": {"content": "contract C { function f() public {} } contract D { C c = new C(); }"}
+			},
+			"settings": {
+				"profile": )" + _profile + R"(,
+				"outputSelection": {"*": {"*": ["evm.bytecode.object"]}}
+			}
+		}
+		)";
+	};
+
+	Json result = compile(input("false"));
+	BOOST_CHECK(containsAtMostWarnings(result));
+	BOOST_CHECK(!result.contains("profile"));
+
+	result = compile(input("true"));
+	BOOST_CHECK(containsAtMostWarnings(result));
+	BOOST_REQUIRE(result["profile"].is_object());
+	Json const& profile = result["profile"];
+	std::set<std::string> stages;
+	for (Json const& event: profile["traceEvents"])
+		stages.insert(event["name"].get<std::string>());
+	BOOST_CHECK(stages.count("TypeChecker"));
+	BOOST_CHECK(stages.count("Compiler"));
+	for (Json const& metrics: profile["summary"])
+		BOOST_CHECK(metrics["selfMicroseconds"].get<int64_t>() <= metrics["microseconds"].get<int64_t>());
+	std::set<std::string> subjects;
+	for (Json const& metrics: profile["subjects"])
+		subjects.insert(metrics["subject"].get<std::string>());
+	BOOST_CHECK(subjects.count("a.sol:C") && subjects.count("a.sol:D"));
+
+	// The profile is also part of the streamed output.
+	solidity::frontend::StandardCompiler compiler;
+	std::ostringstream streamed;
+	compiler.compile(input("true"), streamed);
+	Json streamedResult;
+	BOOST_REQUIRE(util::jsonParseStrict(streamed.str(), streamedResult));
+	BOOST_CHECK(streamedResult["profile"]["traceEvents"].size() > 0);
+	BOOST_CHECK(streamedResult.contains("contracts"));
+
+	result = compile(input("1"));
+	BOOST_CHECK(containsError(result, "JSONError", "\"settings.profile\" must be a Boolean."));
+}
+
+BOOST_AUTO_TEST_CASE(parallelism)
+{
+	auto const input = [](std::string const& _parallelism) {
+		return R"(
+		{
+			"language": "Solidity",
+			"sources": {
+				"a.sol": {"content": "contract C { function f() public {} } contract D { C c = new C(); }"}
+			},
+			"settings": {
+				"parallelism": )" + _parallelism + R"(,
+				"viaIR": true,
+				"outputSelection": {"*": {"*": ["evm.bytecode.object"]}}
+			}
+		}
+		)";
+	};
+
+	Json const sequential = compile(input("1"));
+	BOOST_CHECK(containsAtMostWarnings(sequential));
+	// Reduced to the maximum number of threads instead of starting this many.
+	BOOST_CHECK(compile(input("18446744073709551615")) == sequential);
+
+	for (std::string const parallelism: {"0", "-1", "2.5", "\"2\""})
+		BOOST_CHECK(containsError(
+			compile(input(parallelism)),
+			"JSONError",
+			"\"settings.parallelism\" must be a positive integer."
+		));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // end namespaces
@@ -0,0 +1,13 @@
+contract C {
+	function f(uint x) public pure {
+		assert(x > 0);
+	}
+}
+// ====
+// SMTEngine: bmc
+// SMTRaceSolvers: yes
+// SMTShowSolverStatistics: yes
+// SMTSolvers: z3
+// ----
+// Warning 4661: (49-62): BMC: Assertion violation happens here.
+// Info 4163: BMC: Solver statistics: z3: 1 queries, 1 answered first, 0 cancelled.
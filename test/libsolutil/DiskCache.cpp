@@ -0,0 +1,104 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolutil/DiskCache.h>
+
+#include <libsolutil/Keccak256.h>
+#include <libsolutil/TemporaryDirectory.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <fstream>
+
+namespace fs = boost::filesystem;
+
+namespace solidity::util::test
+{
+
+namespace
+{
+
+size_t countEntries(fs::path const& _directory)
+{
+	size_t count = 0;
+	for (fs::directory_iterator it(_directory), end; it != end; ++it)
+		if (it->path().extension() == ".entry")
+			++count;
+	return count;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(DiskCacheTest, *boost::unit_test::label("nooptions"))
+
+BOOST_AUTO_TEST_CASE(store_and_load)
+{
+	TemporaryDirectory tempDir("diskcache-test");
+	DiskCache cache(tempDir.path() / "cache", "1.0", 1024 * 1024);
+
+	BOOST_CHECK(!cache.load(keccak256("a")).has_value());
+	cache.store(keccak256("a"), "value a");
+	cache.store(keccak256("b"), "");
+	BOOST_CHECK(cache.load(keccak256("a")) == std::optional<std::string>("value a"));
+	BOOST_CHECK(cache.load(keccak256("b")) == std::optional<std::string>(""));
+
+	cache.store(keccak256("a"), "new value a");
+	BOOST_CHECK(cache.load(keccak256("a")) == std::optional<std::string>("new value a"));
+}
+
+BOOST_AUTO_TEST_CASE(persistent_across_instances)
+{
+	TemporaryDirectory tempDir("diskcache-test");
+	DiskCache(tempDir.path(), "1.0", 1024 * 1024).store(keccak256("a"), "value a");
+
+	BOOST_CHECK(DiskCache(tempDir.path(), "1.0", 1024 * 1024).load(keccak256("a")) == std::optional<std::string>("value a"));
+	BOOST_CHECK(!DiskCache(tempDir.path(), "2.0", 1024 * 1024).load(keccak256("a")).has_value());
+}
+
+BOOST_AUTO_TEST_CASE(corrupted_entries_are_ignored)
+{
+	TemporaryDirectory tempDir("diskcache-test");
+	DiskCache cache(tempDir.path(), "1.0", 1024 * 1024);
+	cache.store(keccak256("a"), "value a");
+	BOOST_REQUIRE_EQUAL(countEntries(tempDir.path()), 1);
+
+	for (fs::directory_iterator it(tempDir.path()), end; it != end; ++it)
+		std::ofstream(it->path().string(), std::ios::trunc) << "garbage";
+
+	BOOST_CHECK(!cache.load(keccak256("a")).has_value());
+}
+
+BOOST_AUTO_TEST_CASE(size_limit)
+{
+	TemporaryDirectory tempDir("diskcache-test");
+	std::string const value(100, 'x');
+	{
+		DiskCache cache(tempDir.path(), "1.0", 1024 * 1024);
+		for (size_t i = 0; i < 20; ++i)
+			cache.store(keccak256(std::to_string(i)), value);
+	}
+	BOOST_CHECK_EQUAL(countEntries(tempDir.path()), 20);
+
+	// The limit is enforced when the cache is opened.
+	DiskCache cache(tempDir.path(), "1.0", 1000);
+	BOOST_CHECK_LT(countEntries(tempDir.path()), 10);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -26,6 +26,8 @@
 
 #include <boost/test/unit_test.hpp>
 
+#include <sstream>
+
 
 namespace solidity::util::test
 {
@@ -117,6 +119,48 @@ BOOST_AUTO_TEST_CASE(json_compact_print)
 	BOOST_CHECK(R"({"1":1,"2":"2","3":{"3.1":"3.1","3.2":2},"4":"\u0911 \u0912 \u0913 \u0914 \u0915 \u0916","5":"\u0010","6":"\u4e2d"})" == jsonCompactPrint(json));
 }
 
+BOOST_AUTO_TEST_CASE(json_stream_writer)
+{
+	Json json = {
+		{"a", {{"b", Json::array()}, {"c", {1, "x\ny", Json::object()}}}},
+		{"d", Json::object()},
+		{"e", "\u00e9"}
+	};
+
+	for (JsonFormat format: {JsonFormat{JsonFormat::Compact}, JsonFormat{JsonFormat::Pretty}, JsonFormat{JsonFormat::Pretty, 4}})
+	{
+		std::ostringstream output;
+		JsonStreamWriter writer(output, format);
+		writer.beginObject();
+		writer.key("a");
+		writer.beginObject();
+		writer.member("b", Json::array());
+		writer.key("c");
+		// Values can be written separately and only be added once they are complete.
+		std::ostringstream part;
+		JsonStreamWriter partWriter(part, format, writer.depth());
+		partWriter.beginArray();
+		partWriter.value(1);
+		partWriter.value("x\ny");
+		partWriter.beginObject();
+		partWriter.endObject();
+		partWriter.endArray();
+		BOOST_CHECK(partWriter.finished());
+		writer.printedValue(part.str());
+		writer.endObject();
+		BOOST_CHECK_THROW(writer.key("a"), Exception);
+		writer.key("d");
+		writer.beginObject();
+		writer.endObject();
+		writer.member("e", "\u00e9");
+		BOOST_CHECK(!writer.finished());
+		writer.endObject();
+
+		BOOST_CHECK(writer.finished());
+		BOOST_CHECK_EQUAL(output.str(), jsonPrint(json, format));
+	}
+}
+
 BOOST_AUTO_TEST_CASE(parse_json_strict)
 {
 	// In this test we check conformance against JSON.parse (https://tc39.es/ecma262/multipage/structured-data.html#sec-json.parse)
@@ -166,6 +210,85 @@ BOOST_AUTO_TEST_CASE(parse_json_strict)
 	BOOST_CHECK(json[0] == "\xF0\x9F\x98\x8A");
 }
 
+BOOST_AUTO_TEST_CASE(parse_json_strict_with_callback)
+{
+	std::string const input = R"({"a": {"x": {"y": 1}, "z": [2]}, "b": {"x": {"y": 3}}, "c": 4})";
+
+	Json json;
+	std::vector<Json> objects;
+	BOOST_REQUIRE(jsonParseStrict(input, json, [&](int _depth, Json::parse_event_t _event, Json& _parsed) {
+		if (_event == Json::parse_event_t::key)
+			return _parsed != "c";
+		if (_event == Json::parse_event_t::object_end && _depth == 2)
+		{
+			objects.emplace_back(std::move(_parsed));
+			return false;
+		}
+		return true;
+	}));
+
+	BOOST_CHECK_EQUAL(json, Json::parse(R"({"a": {"z": [2]}, "b": {}})"));
+	BOOST_REQUIRE_EQUAL(objects.size(), 2);
+	BOOST_CHECK_EQUAL(objects[0], Json::parse(R"({"y": 1})"));
+	BOOST_CHECK_EQUAL(objects[1], Json::parse(R"({"y": 3})"));
+
+	std::string errors;
+	BOOST_CHECK(!jsonParseStrict("{\"a\": ", json, [](int, Json::parse_event_t, Json&) { return true; }, &errors));
+	BOOST_CHECK(!errors.empty());
+}
+
+BOOST_AUTO_TEST_CASE(json_binary)
+{
+	std::string const input = R"({
+		"nodes": [
+			{"name": "x", "nodeType": "VariableDeclaration", "id": 1, "src": "0:1:0"},
+			{"name": "y", "nodeType": "VariableDeclaration", "id": 200, "src": "2:1:0", "value": null}
+		],
+		"flags": [true, false],
+		"numbers": [0, -1, -9223372036854775808, 18446744073709551615, 1.5, -0.25],
+		"strings": ["", "name", "\u0000\n\u00e9"]
+	})";
+	Json json;
+	BOOST_REQUIRE(jsonParseStrict(input, json));
+
+	std::string const binary = jsonPrintBinary(json);
+	BOOST_CHECK(isBinaryJson(binary));
+	BOOST_CHECK(!isBinaryJson(jsonCompactPrint(json)));
+	BOOST_CHECK(binary.size() < jsonCompactPrint(json).size());
+	BOOST_CHECK_EQUAL(binary.substr(3), asString(Json::to_cbor(json)));
+
+	Json parsed;
+	std::string errors;
+	BOOST_REQUIRE(jsonParseBinary(binary, parsed, &errors));
+	BOOST_CHECK(errors.empty());
+	BOOST_CHECK_EQUAL(parsed, json);
+	BOOST_CHECK_EQUAL(jsonCompactPrint(parsed), jsonCompactPrint(json));
+
+	for (Json const& value: {Json(nullptr), Json(42), Json("abc"), Json::array(), Json::object()})
+	{
+		BOOST_REQUIRE(jsonParseBinary(jsonPrintBinary(value), parsed));
+		BOOST_CHECK_EQUAL(parsed, value);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(parse_json_binary_malformed)
+{
+	std::string const binary = jsonPrintBinary(Json::parse(R"({"a": ["b", 1], "c": "b"})"));
+
+	Json json;
+	std::string errors;
+	for (size_t length = 0; length < binary.size(); ++length)
+	{
+		BOOST_CHECK(!jsonParseBinary(binary.substr(0, length), json, &errors));
+		BOOST_CHECK(!errors.empty());
+	}
+	BOOST_CHECK(!jsonParseBinary(binary + '\0', json));
+	BOOST_CHECK(!jsonParseBinary(R"({"a": 1})", json, &errors));
+	BOOST_CHECK_EQUAL(errors, "Input is not a self-described CBOR document.");
+	// The self-described tag is only expected at the start and no other tags are accepted.
+	BOOST_CHECK(!jsonParseBinary(binary.substr(0, 3) + binary, json));
+}
+
 BOOST_AUTO_TEST_CASE(json_isOfType)
 {
 	Json json;
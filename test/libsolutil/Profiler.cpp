@@ -0,0 +1,200 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolutil/Profiler.h>
+#include <libsolutil/ThreadPool.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <thread>
+
+namespace solidity::util::test
+{
+
+namespace
+{
+
+/// @returns the trace events of @a _profile with the given name.
+std::vector<Json> eventsNamed(Json const& _profile, std::string const& _name)
+{
+	std::vector<Json> events;
+	for (Json const& event: _profile["traceEvents"])
+		if (event["name"] == _name)
+			events.push_back(event);
+	return events;
+}
+
+/// @returns the summary entry of @a _profile with the given name.
+Json summaryOf(Json const& _profile, std::string const& _name)
+{
+	for (Json const& metrics: _profile["summary"])
+		if (metrics["name"] == _name)
+			return metrics;
+	return {};
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(ProfilerTests, *boost::unit_test::label("nooptions"))
+
+BOOST_AUTO_TEST_CASE(nothing_recorded_without_session)
+{
+	{
+		Profiler::Probe probe{"test", "before"};
+	}
+	Profiler::Session session;
+	Json profile = session.toJson();
+	BOOST_CHECK(profile["traceEvents"].empty());
+	BOOST_CHECK(profile["summary"].empty());
+}
+
+BOOST_AUTO_TEST_CASE(subject_is_inherited)
+{
+	Profiler::Session session;
+	{
+		Profiler::Probe outer{"test", "outer", "C"};
+		{
+			Profiler::Probe inner{"test", "inner"};
+		}
+		{
+			Profiler::Probe other{"test", "other", "D"};
+		}
+	}
+	Json profile = session.toJson();
+	BOOST_REQUIRE_EQUAL(profile["traceEvents"].size(), 3);
+	BOOST_CHECK_EQUAL(eventsNamed(profile, "outer").at(0)["args"]["subject"], "C");
+	BOOST_CHECK_EQUAL(eventsNamed(profile, "inner").at(0)["args"]["subject"], "C");
+	BOOST_CHECK_EQUAL(eventsNamed(profile, "other").at(0)["args"]["subject"], "D");
+	for (Json const& event: profile["traceEvents"])
+	{
+		BOOST_CHECK_EQUAL(event["cat"], "test");
+		BOOST_CHECK_EQUAL(event["ph"], "X");
+		BOOST_CHECK_EQUAL(event["tid"], 0);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(nested_probes_of_same_name_counted_once)
+{
+	Profiler::Session session;
+	{
+		Profiler::Probe outer{"test", "recursive"};
+		Profiler::Probe inner{"test", "recursive"};
+		std::this_thread::sleep_for(std::chrono::milliseconds(2));
+	}
+	Json profile = session.toJson();
+	std::vector<Json> events = eventsNamed(profile, "recursive");
+	BOOST_REQUIRE_EQUAL(events.size(), 2);
+	Json metrics = summaryOf(profile, "recursive");
+	BOOST_CHECK_EQUAL(metrics["calls"], 2);
+	BOOST_CHECK_EQUAL(metrics["microseconds"], events.at(0)["dur"]);
+}
+
+BOOST_AUTO_TEST_CASE(subject_summary)
+{
+	Profiler::Session session;
+	{
+		Profiler::Probe outer{"test", "outer", "C"};
+		{
+			Profiler::Probe inner{"test", "inner"};
+			Profiler::Probe other{"test", "other", "D"};
+			Profiler::Probe innermost{"test", "innermost", "C"};
+		}
+	}
+	Json profile = session.toJson();
+	BOOST_REQUIRE_EQUAL(profile["subjects"].size(), 2);
+	Json const& c = profile["subjects"][0];
+	Json const& d = profile["subjects"][1];
+	BOOST_CHECK_EQUAL(c["subject"], "C");
+	BOOST_CHECK_EQUAL(c["microseconds"], eventsNamed(profile, "outer").at(0)["dur"]);
+	BOOST_CHECK_EQUAL(d["subject"], "D");
+	BOOST_CHECK_EQUAL(d["microseconds"], eventsNamed(profile, "other").at(0)["dur"]);
+}
+
+BOOST_AUTO_TEST_CASE(self_time)
+{
+	Profiler::Session session;
+	{
+		Profiler::Probe outer{"test", "outer"};
+		std::this_thread::sleep_for(std::chrono::milliseconds(2));
+		Profiler::Probe inner{"test", "inner"};
+		std::this_thread::sleep_for(std::chrono::milliseconds(2));
+	}
+	Json profile = session.toJson();
+	int64_t const outerTime = eventsNamed(profile, "outer").at(0)["dur"].get<int64_t>();
+	int64_t const innerTime = eventsNamed(profile, "inner").at(0)["dur"].get<int64_t>();
+	BOOST_CHECK_EQUAL(summaryOf(profile, "inner")["selfMicroseconds"], innerTime);
+	int64_t const outerSelfTime = summaryOf(profile, "outer")["selfMicroseconds"].get<int64_t>();
+	// Durations are rounded down to microseconds separately.
+	BOOST_CHECK(outerSelfTime >= outerTime - innerTime - 1 && outerSelfTime <= outerTime - innerTime + 1);
+	BOOST_CHECK(session.summaryTable().find("| 100.0% |") != std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(probes_of_pool_tasks)
+{
+	Profiler::Session session;
+	{
+		ThreadPool pool(1);
+		// Not ThreadPool::wait(), which could run the task on this thread.
+		pool.submit([]() { Profiler::Probe probe{"test", "task"}; }).get();
+	}
+	{
+		Profiler::Probe probe{"test", "main"};
+	}
+	Json profile = session.toJson();
+	BOOST_CHECK_EQUAL(eventsNamed(profile, "task").at(0)["tid"], 0);
+	BOOST_CHECK_EQUAL(eventsNamed(profile, "main").at(0)["tid"], 1);
+	BOOST_CHECK(!eventsNamed(profile, "task").at(0).contains("args"));
+}
+
+BOOST_AUTO_TEST_CASE(sessions_of_other_threads)
+{
+	Profiler::Session session;
+	Json otherProfile;
+	std::thread thread([&]() {
+		{
+			Profiler::Probe probe{"test", "withoutSession"};
+		}
+		Profiler::Session otherSession;
+		{
+			Profiler::Probe probe{"test", "otherSession"};
+		}
+		otherProfile = otherSession.toJson();
+	});
+	thread.join();
+	BOOST_CHECK(session.toJson()["traceEvents"].empty());
+	BOOST_CHECK_EQUAL(otherProfile["traceEvents"].size(), 1);
+	BOOST_CHECK_EQUAL(eventsNamed(otherProfile, "otherSession").size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(nested_sessions)
+{
+	Profiler::Session outerSession;
+	{
+		Profiler::Session innerSession;
+		Profiler::Probe probe{"test", "inner"};
+	}
+	{
+		Profiler::Probe probe{"test", "outer"};
+	}
+	BOOST_CHECK_EQUAL(outerSession.toJson()["traceEvents"].size(), 2);
+	BOOST_CHECK(Profiler::Session::current() == &outerSession);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
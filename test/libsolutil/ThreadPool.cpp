@@ -0,0 +1,96 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolutil/ThreadPool.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <functional>
+#include <stdexcept>
+#include <vector>
+
+namespace solidity::util::test
+{
+
+BOOST_AUTO_TEST_SUITE(ThreadPoolTests, *boost::unit_test::label("nooptions"))
+
+BOOST_AUTO_TEST_CASE(at_least_one_worker)
+{
+	BOOST_CHECK_EQUAL(ThreadPool(0).size(), 1);
+	BOOST_CHECK_EQUAL(ThreadPool(3).size(), 3);
+}
+
+BOOST_AUTO_TEST_CASE(results_are_returned_through_futures)
+{
+	ThreadPool pool(4);
+	std::vector<std::future<size_t>> results;
+	for (size_t i = 0; i < 100; ++i)
+		results.push_back(pool.submit([i]() { return i * i; }));
+
+	for (size_t i = 0; i < 100; ++i)
+		BOOST_CHECK_EQUAL(results[i].get(), i * i);
+}
+
+BOOST_AUTO_TEST_CASE(exceptions_are_returned_through_futures)
+{
+	ThreadPool pool(2);
+	std::future<int> result = pool.submit([]() -> int { throw std::runtime_error("failure"); });
+	BOOST_CHECK_THROW(result.get(), std::runtime_error);
+
+	// The worker that executed the failing task must still be usable.
+	BOOST_CHECK_EQUAL(pool.submit([]() { return 42; }).get(), 42);
+}
+
+BOOST_AUTO_TEST_CASE(destructor_waits_for_queued_tasks)
+{
+	std::atomic<size_t> executed = 0;
+	{
+		ThreadPool pool(2);
+		for (size_t i = 0; i < 50; ++i)
+			pool.submit([&]() { ++executed; });
+	}
+	BOOST_CHECK_EQUAL(executed, 50);
+}
+
+BOOST_AUTO_TEST_CASE(nested_tasks_do_not_deadlock)
+{
+	ThreadPool pool(2);
+	std::function<size_t(size_t)> countLeaves = [&](size_t _depth) -> size_t {
+		if (_depth == 0)
+			return 1;
+		std::vector<std::future<size_t>> children;
+		for (size_t i = 0; i < 3; ++i)
+			children.push_back(pool.submit([&, _depth]() { return countLeaves(_depth - 1); }));
+		size_t leaves = 0;
+		for (std::future<size_t>& child: children)
+		{
+			pool.wait(child);
+			leaves += child.get();
+		}
+		return leaves;
+	};
+
+	std::future<size_t> result = pool.submit([&]() { return countLeaves(5); });
+	pool.wait(result);
+	BOOST_CHECK_EQUAL(result.get(), 243);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
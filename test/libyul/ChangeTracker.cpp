@@ -0,0 +1,258 @@
+/*
+    This file is part of solidity.
+
+    solidity is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    solidity is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Unit tests for tracking the modifications of code by optimiser steps.
+ */
+
+#include <test/Common.h>
+#include <test/libyul/Common.h>
+
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/optimiser/ChangeTracker.h>
+#include <libyul/optimiser/FullInliner.h>
+#include <libyul/optimiser/Metrics.h>
+#include <libyul/optimiser/NameDispenser.h>
+#include <libyul/optimiser/OptimiserStep.h>
+#include <libyul/optimiser/UnusedPruner.h>
+#include <libyul/AST.h>
+
+#include <boost/test/unit_test.hpp>
+
+namespace solidity::yul::test
+{
+
+namespace
+{
+
+std::string const c_code = R"({
+	sstore(0, f(1))
+	function f(a) -> b { b := add(a, 1) }
+	function g(c) { sstore(c, c) }
+})";
+
+Dialect const& evmDialect()
+{
+	return EVMDialect::strictAssemblyForEVMObjects(
+		solidity::test::CommonOptions::get().evmVersion(),
+		solidity::test::CommonOptions::get().eofVersion()
+	);
+}
+
+std::set<YulName> modifications(std::string const& _code)
+{
+	ChangeTracker changes(evmDialect(), disambiguate(c_code));
+	return changes.update(disambiguate(_code));
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(YulChangeTracker)
+
+BOOST_AUTO_TEST_CASE(unmodified)
+{
+	Block const ast = disambiguate(c_code);
+	ChangeTracker changes(evmDialect(), ast);
+	changes.recordUnmodifiedBy("step");
+	BOOST_CHECK(changes.update(ast).empty());
+	BOOST_CHECK_EQUAL(changes.version(), 0);
+	BOOST_CHECK(changes.unmodifiedBy("step"));
+	BOOST_CHECK(!changes.unmodifiedBy("otherStep"));
+}
+
+BOOST_AUTO_TEST_CASE(modified_functions)
+{
+	BOOST_CHECK(modifications(R"({
+		sstore(0, f(1))
+		function f(a) -> b { b := add(a, 2) }
+		function g(c) { sstore(c, c) }
+	})") == std::set<YulName>{"f"_yulname});
+	BOOST_CHECK(modifications(R"({
+		sstore(0, f(1))
+		function f(a) -> b { b := add(a, 1) }
+		function g(d) { sstore(d, d) }
+	})") == std::set<YulName>{"g"_yulname});
+	BOOST_CHECK(modifications(R"({
+		sstore(0, f(1))
+		function f(a) -> b { b := add(a, 1) }
+	})") == (std::set<YulName>{YulName{}, "g"_yulname}));
+}
+
+BOOST_AUTO_TEST_CASE(modified_outline)
+{
+	BOOST_CHECK(modifications(R"({
+		sstore(1, f(1))
+		function f(a) -> b { b := add(a, 1) }
+		function g(c) { sstore(c, c) }
+	})") == std::set<YulName>{YulName{}});
+	// The order of functions is tracked as part of the code outside of functions.
+	BOOST_CHECK(modifications(R"({
+		sstore(0, f(1))
+		function g(c) { sstore(c, c) }
+		function f(a) -> b { b := add(a, 1) }
+	})") == std::set<YulName>{YulName{}});
+}
+
+BOOST_AUTO_TEST_CASE(versions)
+{
+	Block const ast = disambiguate(c_code);
+	Block const modifiedAST = disambiguate("{ sstore(0, 0) }");
+	ChangeTracker changes(evmDialect(), ast);
+	changes.recordUnmodifiedBy("step");
+	BOOST_CHECK(!changes.update(modifiedAST).empty());
+	BOOST_CHECK_EQUAL(changes.version(), 1);
+	BOOST_CHECK(!changes.unmodifiedBy("step"));
+	BOOST_CHECK(!changes.update(ast).empty());
+	BOOST_CHECK_EQUAL(changes.version(), 2);
+	BOOST_CHECK(!changes.unmodifiedBy("step"));
+}
+
+BOOST_AUTO_TEST_CASE(code_size)
+{
+	Block const ast = disambiguate(c_code);
+	Block const modifiedAST = disambiguate(R"({
+		sstore(0, f(1))
+		function f(a) -> b { b := add(a, add(a, 1)) }
+		function g(c) { sstore(c, c) }
+	})");
+	ChangeTracker changes(evmDialect(), ast);
+	BOOST_CHECK_EQUAL(changes.codeSizeIncludingFunctions(ast), CodeSize::codeSizeIncludingFunctions(ast));
+	changes.update(modifiedAST);
+	BOOST_CHECK_EQUAL(changes.codeSizeIncludingFunctions(modifiedAST), CodeSize::codeSizeIncludingFunctions(modifiedAST));
+	BOOST_CHECK(CodeSize::codeSizeIncludingFunctions(modifiedAST) != CodeSize::codeSizeIncludingFunctions(ast));
+}
+
+BOOST_AUTO_TEST_CASE(functions_to_run)
+{
+	std::string const code = R"({
+		{ sstore(0, f(1)) }
+		function f(a) -> b { b := g(a) }
+		function g(c) -> d { d := add(c, 1) }
+		function h() { sstore(1, 2) }
+	})";
+	Block const ast = disambiguate(code);
+	std::set<YulName> const allFunctions{YulName{}, "f"_yulname, "g"_yulname, "h"_yulname};
+
+	ChangeTracker changes(evmDialect(), ast);
+	BOOST_CHECK(changes.grouped());
+	std::set<YulName> functions = changes.functionsToRun("step", ast);
+	BOOST_CHECK(functions == allFunctions);
+	BOOST_CHECK(changes.update(ast, "step", functions).empty());
+	BOOST_CHECK(changes.functionsToRun("step", ast).empty());
+	BOOST_CHECK(changes.functionsToRun("otherStep", ast) == allFunctions);
+
+	// Callers of modified functions have to run again, directly or indirectly.
+	Block const modifiedAST = disambiguate(std::string(code).replace(code.find("add(c, 1)"), 9, "add(c, 2)"));
+	BOOST_CHECK(changes.update(modifiedAST) == std::set<YulName>{"g"_yulname});
+	functions = changes.functionsToRun("step", modifiedAST);
+	BOOST_CHECK(functions == (std::set<YulName>{YulName{}, "f"_yulname, "g"_yulname}));
+
+	// Functions modified by the step itself have to run again.
+	BOOST_CHECK(changes.update(ast, "step", functions) == std::set<YulName>{"g"_yulname});
+	functions = changes.functionsToRun("step", ast);
+	BOOST_CHECK(functions == (std::set<YulName>{YulName{}, "f"_yulname, "g"_yulname}));
+
+	// A change in the use of msize affects all functions.
+	BOOST_CHECK(changes.update(ast, "step", functions).empty());
+	Block const msizeAST = disambiguate(std::string(code).replace(code.find("sstore(1, 2)"), 12, "sstore(1, msize())"));
+	BOOST_CHECK(changes.update(msizeAST) == std::set<YulName>{"h"_yulname});
+	BOOST_CHECK(changes.functionsToRun("step", msizeAST) == allFunctions);
+}
+
+BOOST_AUTO_TEST_CASE(function_local_update)
+{
+	std::string const code = R"({
+		{ sstore(0, f(1)) }
+		function f(a) -> b { b := add(a, 1) }
+		function g(c) { sstore(c, c) }
+	})";
+	Block const ast = disambiguate(code);
+	Block const modifiedAST = disambiguate(R"({
+		{ sstore(1, f(1)) }
+		function f(a) -> b { b := add(a, 2) }
+		function g(d) { sstore(d, d) }
+	})");
+
+	// Only the code the step ran on is hashed again, since it cannot have modified anything else.
+	ChangeTracker changes(evmDialect(), ast);
+	changes.functionsToRun("step", ast);
+	BOOST_CHECK(changes.update(modifiedAST, "step", {"f"_yulname}) == std::set<YulName>{"f"_yulname});
+	BOOST_CHECK(changes.update(modifiedAST) == (std::set<YulName>{YulName{}, "g"_yulname}));
+}
+
+BOOST_AUTO_TEST_CASE(reported_update)
+{
+	Block const ast = disambiguate(R"({
+		{ sstore(0, f(1)) }
+		function f(a) -> b { b := add(a, 1) }
+		function g(c) { sstore(c, c) }
+	})");
+	Block const modifiedAST = disambiguate(R"({
+		{ sstore(1, f(1)) }
+		function f(a) -> b { b := add(a, 2) }
+	})");
+
+	// Only the reported code is hashed again, removed functions are detected nevertheless.
+	ChangeTracker changes(evmDialect(), ast);
+	BOOST_CHECK(changes.update(modifiedAST, std::set<YulName>{YulName{}}) == (std::set<YulName>{YulName{}, "g"_yulname}));
+	BOOST_CHECK(changes.update(modifiedAST) == std::set<YulName>{"f"_yulname});
+}
+
+BOOST_AUTO_TEST_CASE(modifications_reported_by_steps)
+{
+	auto check = [](std::string const& _step, auto _runAndReportModified) {
+		BOOST_TEST_CONTEXT(_step)
+		{
+			Block ast = disambiguate(R"({
+				{ sstore(0, f(1)) let x := g(2) }
+				function f(a) -> b { b := add(a, 1) }
+				function g(c) -> d { let unused := mload(c) d := h(c) }
+				function h(e) -> r { r := e }
+				function k() { sstore(1, 1) }
+			})");
+			ChangeTracker changes(evmDialect(), ast);
+			NameDispenser dispenser{evmDialect(), ast};
+			std::set<YulName> const reserved;
+			OptimiserStepContext context{evmDialect(), dispenser, reserved, 0};
+			std::set<YulName> const reported = _runAndReportModified(context, ast);
+
+			// All code the step modified has to be hashed again.
+			std::set<YulName> const modified = changes.update(ast);
+			BOOST_CHECK(!modified.empty());
+			std::set<YulName> functions{YulName{}};
+			for (Statement const& statement: ast.statements)
+				if (auto const* function = std::get_if<FunctionDefinition>(&statement))
+					functions.insert(function->name);
+			for (YulName name: modified)
+				BOOST_CHECK_MESSAGE(
+					reported.count(functions.count(name) ? name : YulName{}),
+					"Unreported modification of " + (name.empty() ? "code outside of functions" : name.str())
+				);
+		}
+	};
+	check("FullInliner", FullInliner::runAndReportModified);
+	check("UnusedPruner", UnusedPruner::runAndReportModified);
+}
+
+BOOST_AUTO_TEST_CASE(not_grouped)
+{
+	BOOST_CHECK(!ChangeTracker(evmDialect(), disambiguate(c_code)).grouped());
+	BOOST_CHECK(!ChangeTracker(evmDialect(), disambiguate("{ { } { } }")).grouped());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -0,0 +1,133 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for running optimiser steps on the functions of an object and on sibling
+ * sub-objects concurrently.
+ */
+
+#include <test/libyul/Common.h>
+
+#include <libyul/YulStack.h>
+
+#include <libsolutil/ThreadPool.h>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace solidity::frontend;
+
+namespace solidity::yul::test
+{
+
+namespace
+{
+
+std::string optimise(std::string const& _source, util::ThreadPool* _threadPool)
+{
+	YulStack yulStack = parseYul(_source, "", OptimiserSettings::full());
+	BOOST_REQUIRE(!yulStack.hasErrors());
+	yulStack.setThreadPool(_threadPool);
+	yulStack.optimize();
+	return yulStack.print();
+}
+
+/// @returns the optimized code and the bytecode of the object in @a _source.
+std::pair<std::string, std::string> optimiseAndAssemble(std::string const& _source, util::ThreadPool* _threadPool)
+{
+	YulStack yulStack = parseYul(_source, "", OptimiserSettings::full());
+	BOOST_REQUIRE(!yulStack.hasErrors());
+	yulStack.setThreadPool(_threadPool);
+	yulStack.optimize();
+	std::string optimized = yulStack.print();
+	MachineAssemblyObject object = yulStack.assemble(YulStack::Machine::EVM);
+	BOOST_REQUIRE(object.bytecode);
+	return {optimized, object.bytecode->toHex()};
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(YulParallelOptimiser)
+
+BOOST_AUTO_TEST_CASE(same_code_as_sequential)
+{
+	// Functions that are called from several places and introduce new variables in the SSA transform.
+	std::string calls;
+	std::string functions;
+	for (size_t i = 0; i < 40; ++i)
+	{
+		std::string const name = "f" + std::to_string(i);
+		std::string const index = std::to_string(i);
+		calls += "sstore(" + index + ", " + name + "(calldataload(" + index + ")))\n";
+		calls += "sstore(add(" + index + ", 100), " + name + "(calldatasize()))\n";
+		functions +=
+			"function " + name + "(a) -> r {\n"
+			"let x := add(a, " + index + ")\n"
+			"for { let j := 0 } lt(j, a) { j := add(j, 1) } { x := mul(x, calldataload(j)) mstore(j, x) }\n"
+			"if gt(x, " + index + ") { x := sub(x, mload(x)) }\n"
+			"r := add(mload(x), keccak256(0, 32))\n"
+			"}\n";
+	}
+	std::string const source = "{\n" + calls + functions + "}\n";
+
+	std::string const sequential = optimise(source, nullptr);
+	for (size_t const threads: {size_t{1}, size_t{4}})
+	{
+		util::ThreadPool threadPool(threads);
+		BOOST_CHECK_EQUAL(optimise(source, &threadPool), sequential);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(sibling_objects_same_code_as_sequential)
+{
+	// Sibling sub-objects, some of them identical so that they share entries of the optimizer cache,
+	// with nested sub-objects and references to each other's sizes.
+	std::string subObjects;
+	std::string references;
+	for (size_t i = 0; i < 12; ++i)
+	{
+		std::string const name = "S" + std::to_string(i);
+		std::string const value = std::to_string(i % 3);
+		references += "sstore(" + std::to_string(i) + ", add(datasize(\"" + name + "\"), dataoffset(\"" + name + "\")))\n";
+		subObjects +=
+			"object \"" + name + "\" {\n"
+			"code {\n"
+			"function f(a) -> r { for { let j := 0 } lt(j, a) { j := add(j, 1) } { r := add(r, mload(mul(j, " + value + "))) } }\n"
+			"let x := f(calldataload(" + value + "))\n"
+			"if gt(x, " + value + ") { sstore(x, keccak256(0, 32)) }\n"
+			"datacopy(0, dataoffset(\"" + name + "_deployed\"), datasize(\"" + name + "_deployed\"))\n"
+			"return(0, datasize(\"" + name + "_deployed\"))\n"
+			"}\n"
+			"object \"" + name + "_deployed\" {\n"
+			"code { let y := add(calldataload(0), " + value + ") mstore(y, mload(y)) sstore(0, mload(0)) }\n"
+			"}\n"
+			"}\n";
+	}
+	std::string const source = "object \"root\" {\ncode {\n" + references + "}\n" + subObjects + "}\n";
+
+	auto const sequential = optimiseAndAssemble(source, nullptr);
+	for (size_t const threads: {size_t{1}, size_t{4}})
+	{
+		util::ThreadPool threadPool(threads);
+		auto const parallel = optimiseAndAssemble(source, &threadPool);
+		BOOST_CHECK_EQUAL(parallel.first, sequential.first);
+		BOOST_CHECK_EQUAL(parallel.second, sequential.second);
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
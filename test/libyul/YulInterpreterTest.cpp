@@ -20,6 +20,7 @@
 
 #include <test/libyul/Common.h>
 
+#include <test/tools/yulInterpreter/CompiledInterpreter.h>
 #include <test/tools/yulInterpreter/Interpreter.h>
 
 #include <test/Common.h>
@@ -31,6 +32,9 @@
 #include <liblangutil/DebugInfoSelection.h>
 #include <liblangutil/ErrorReporter.h>
 
+#include <libsolutil/AnsiColorized.h>
+#include <libsolutil/StringUtils.h>
+
 #include <boost/test/unit_test.hpp>
 #include <boost/algorithm/string.hpp>
 
@@ -63,12 +67,25 @@ TestCase::TestResult YulInterpreterTest::run(std::ostream& _stream, std::string
 		return TestResult::FatalError;
 	}
 
-	m_obtainedResult = interpret(yulStack.parserResult());
+	m_obtainedResult = interpret(yulStack.parserResult(), /*compiled=*/ false);
+
+	TestResult result = checkResult(_stream, _linePrefix, _formatted);
+	if (result != TestResult::Success)
+		return result;
 
-	return checkResult(_stream, _linePrefix, _formatted);
+	// Both execution engines have to agree on every test.
+	std::string compiledResult = interpret(yulStack.parserResult(), /*compiled=*/ true);
+	if (compiledResult != m_obtainedResult)
+	{
+		AnsiColorized(_stream, _formatted, {formatting::BOLD, formatting::RED}) <<
+			_linePrefix << "Result of the compiled interpreter differs:" << std::endl;
+		printPrefixed(_stream, compiledResult, _linePrefix + "  ");
+		return TestResult::Failure;
+	}
+	return TestResult::Success;
 }
 
-std::string YulInterpreterTest::interpret(std::shared_ptr<Object const> const& _object)
+std::string YulInterpreterTest::interpret(std::shared_ptr<Object const> const& _object, bool _compiled)
 {
 	solAssert(_object && _object->hasCode());
 
@@ -78,13 +95,22 @@ std::string YulInterpreterTest::interpret(std::shared_ptr<Object const> const& _
 	state.maxExprNesting = 64;
 	try
 	{
-		Interpreter::run(
-			state,
-			*_object->dialect(),
-			_object->code()->root(),
-			/*disableExternalCalls=*/ !m_simulateExternalCallsToSelf,
-			/*disableMemoryTracing=*/ false
-		);
+		if (_compiled)
+			CompiledInterpreter::run(
+				state,
+				*_object->dialect(),
+				_object->code()->root(),
+				/*disableExternalCalls=*/ !m_simulateExternalCallsToSelf,
+				/*disableMemoryTracing=*/ false
+			);
+		else
+			Interpreter::run(
+				state,
+				*_object->dialect(),
+				_object->code()->root(),
+				/*disableExternalCalls=*/ !m_simulateExternalCallsToSelf,
+				/*disableMemoryTracing=*/ false
+			);
 	}
 	catch (InterpreterTerminatedGeneric const&)
 	{
@@ -41,7 +41,9 @@ public:
 	TestResult run(std::ostream& _stream, std::string const& _linePrefix = "", bool const _formatted = false) override;
 
 private:
-	std::string interpret(std::shared_ptr<Object const> const& _object);
+	/// Runs the code of @a _object and returns its trace and final state.
+	/// Uses @a CompiledInterpreter if @a _compiled is true, @a Interpreter otherwise.
+	std::string interpret(std::shared_ptr<Object const> const& _object, bool _compiled);
 
 	bool m_simulateExternalCallsToSelf = false;
 };
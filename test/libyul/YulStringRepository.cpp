@@ -0,0 +1,96 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for scoped Yul string repositories.
+ */
+
+#include <libyul/YulString.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <thread>
+
+namespace solidity::yul::test
+{
+
+BOOST_AUTO_TEST_SUITE(YulStringRepositoryTest, *boost::unit_test::label("nooptions"))
+
+BOOST_AUTO_TEST_CASE(scope_selects_repository)
+{
+	YulStringRepository repository;
+	YulString outside("x");
+	{
+		YulStringRepository::Scope scope(repository);
+		BOOST_CHECK(&YulStringRepository::instance() == &repository);
+		YulString inside("x");
+		BOOST_CHECK(inside == YulString("x"));
+		BOOST_CHECK(inside != outside);
+		BOOST_CHECK_EQUAL(inside.str(), outside.str());
+		BOOST_CHECK_EQUAL(inside.hash(), outside.hash());
+	}
+	BOOST_CHECK(&YulStringRepository::instance() != &repository);
+	BOOST_CHECK(outside == YulString("x"));
+	BOOST_CHECK_EQUAL(repository.size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(empty_string_is_shared)
+{
+	YulStringRepository repository;
+	YulStringRepository::Scope scope(repository);
+	BOOST_CHECK(YulString("").empty());
+	BOOST_CHECK(YulString("") == YulString());
+	BOOST_CHECK_EQUAL(repository.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(strings_resolve_on_other_threads)
+{
+	YulStringRepository repository;
+	YulString name;
+	{
+		YulStringRepository::Scope scope(repository);
+		name = YulString("abc");
+	}
+
+	std::string resolved;
+	std::thread([&]() { resolved = name.str(); }).join();
+	BOOST_CHECK_EQUAL(resolved, "abc");
+}
+
+BOOST_AUTO_TEST_CASE(concurrent_interning)
+{
+	YulStringRepository repository;
+	std::vector<std::thread> threads;
+	std::vector<YulString> names(8);
+	for (size_t i = 0; i < names.size(); ++i)
+		threads.emplace_back([&, i]() {
+			YulStringRepository::Scope scope(repository);
+			for (size_t j = 0; j < 100; ++j)
+				YulString("name_" + std::to_string(j));
+			names[i] = YulString("name_0");
+		});
+	for (std::thread& thread: threads)
+		thread.join();
+
+	BOOST_CHECK_EQUAL(repository.size(), 100);
+	for (YulString const& name: names)
+		BOOST_CHECK(name == names.front());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -1721,6 +1721,129 @@ class SolidityLSPTestSuite: # {{{
         self.expect_diagnostic(diagnostics[0], code=6321, marker=markers["@unusedReturnVariable"])
         self.expect_diagnostic(diagnostics[1], code=2072, marker=markers["@unusedContractVariable"])
 
+    def change_document(self, solc: JsonRpcProcess, uri: str, text: str) -> None:
+        solc.send_message(
+            'textDocument/didChange',
+            {
+                'textDocument': { 'uri': uri },
+                'contentChanges': [ { 'text': text } ]
+            }
+        )
+
+    def test_background_analysis_coalesces_changes(self, solc: JsonRpcProcess) -> None:
+        self.setup_lsp(solc)
+        TEST_NAME = 'publish_diagnostics_1'
+        uri = self.get_test_file_uri(TEST_NAME, "goto")
+        self.open_file_and_wait_for_diagnostics(solc, TEST_NAME, "goto")
+        content = self.get_test_file_contents(TEST_NAME, "goto")
+
+        # Changes in quick succession are analysed together, once the last one arrived.
+        for count in range(1, 4):
+            unused = "".join(f" uint unused{i};" for i in range(count))
+            self.change_document(solc, uri, content.replace("uint unused;", "uint unused;" + unused))
+        published_diagnostics = self.wait_for_diagnostics(solc)
+        self.expect_equal(len(published_diagnostics), 1, "One published_diagnostics message")
+        self.expect_equal(len(published_diagnostics[0]['diagnostics']), 6, "Diagnostics of the last change")
+
+        # Nothing else is published in the meantime, so the next message is the response.
+        response = solc.call_method(
+            'textDocument/hover',
+            {
+                'textDocument': { 'uri': uri },
+                'position': { 'line': 17, 'character': 30 }
+            }
+        )
+        self.expect_true('method' not in response, "No diagnostics published for intermediate changes")
+
+    def test_background_analysis_discards_superseded_sources(self, solc: JsonRpcProcess) -> None:
+        self.setup_lsp(solc)
+        uri = self.get_test_file_uri('superseded_analysis')
+        def content(body: str) -> str:
+            return "// SPDX-License-Identifier: UNLICENSED\npragma solidity >=0.8.0;\ncontract C {\n" + body + "}\n"
+
+        solc.send_message(
+            'textDocument/didOpen',
+            {
+                'textDocument': {
+                    'uri': uri,
+                    'languageId': 'Solidity',
+                    'version': 1,
+                    'text': content("")
+                }
+            }
+        )
+        published_diagnostics = self.wait_for_diagnostics(solc)
+        self.expect_equal(len(published_diagnostics), 1, "One published_diagnostics message")
+        self.expect_empty_diagnostics(published_diagnostics)
+
+        # Whether the analysis of the first change is superseded, coalesced with the second one
+        # or completed before it arrives depends on timing. Only the final state is deterministic:
+        # nothing of the first change may be published after the diagnostics of the second one.
+        self.change_document(solc, uri, content("    function g() public { uint unused; }\n"))
+        self.change_document(solc, uri, content(""))
+
+        # Renaming waits for the analysis of the current sources, so every diagnostic
+        # is published before the response.
+        solc.send_message(
+            'textDocument/rename',
+            {
+                'textDocument': { 'uri': uri },
+                'position': { 'line': 2, 'character': 9 },
+                'newName': 'D'
+            }
+        )
+        published_diagnostics = []
+        while True:
+            message = solc.receive_message()
+            assert message is not None # This can happen if the server aborts early.
+            if 'method' not in message:
+                break
+            if message['method'] == 'textDocument/publishDiagnostics':
+                published_diagnostics.append(message['params'])
+        self.expect_true('error' not in message, "Rename succeeds on the current sources")
+        self.expect_true(len(published_diagnostics) > 0, "Diagnostics published for the changes")
+        self.expect_empty_diagnostics(published_diagnostics[-1:])
+
+    def test_queries_answered_from_last_successful_analysis(self, solc: JsonRpcProcess) -> None:
+        self.setup_lsp(solc)
+        TEST_NAME = 'publish_diagnostics_1'
+        uri = self.get_test_file_uri(TEST_NAME, "goto")
+        self.open_file_and_wait_for_diagnostics(solc, TEST_NAME, "goto")
+        content = self.get_test_file_contents(TEST_NAME, "goto")
+        definition_params = {
+            'textDocument': { 'uri': uri },
+            'position': { 'line': 17, 'character': 30 } # new MyContract()
+        }
+        expected_definition = solc.call_method('textDocument/definition', definition_params)['result']
+        self.expect_equal(len(expected_definition), 1, "Definition of MyContract")
+
+        # Queries do not wait for the analysis of changes to documents it already includes.
+        self.change_document(solc, uri, content.replace("uint unused;", "uint unused; uint more;"))
+        response = solc.call_method('textDocument/definition', definition_params)
+        self.expect_equal(response['result'], expected_definition, "Definition from the previous analysis")
+        published_diagnostics = self.wait_for_diagnostics(solc)
+        self.expect_equal(len(published_diagnostics[0]['diagnostics']), 4, "Diagnostics of the change")
+
+        # The last successful analysis keeps answering queries while the sources contain errors.
+        self.change_document(solc, uri, content + "contract {")
+        published_diagnostics = self.wait_for_diagnostics(solc)
+        diagnostics = published_diagnostics[0]['diagnostics']
+        self.expect_equal(len(diagnostics), 1, "Only the syntax error is reported")
+        self.expect_equal(diagnostics[0]['severity'], 1, "Syntax error") # Error
+        response = solc.call_method('textDocument/definition', definition_params)
+        self.expect_equal(response['result'], expected_definition, "Definition from the last successful analysis")
+
+        # Renaming would have to be based on the current sources.
+        response = solc.call_method(
+            'textDocument/rename',
+            {
+                'textDocument': { 'uri': uri },
+                'position': { 'line': 3, 'character': 12 },
+                'newName': 'Renamed'
+            }
+        )
+        self.expect_true('error' in response, "Renaming fails while the sources contain errors")
+
     def test_textDocument_didChange_delete_line_and_close(self, solc: JsonRpcProcess) -> None:
         # Reuse this test to prepare and ensure it is as expected
         self.test_textDocument_didOpen_with_relative_import(solc)
@@ -153,6 +153,7 @@ BOOST_AUTO_TEST_CASE(multiple_input_modes)
 		"--license",
 		"--version",
 		"--standard-json",
+		"--server",
 		"--link",
 		"--assemble",
 		"--strict-assembly",
@@ -161,7 +162,7 @@ BOOST_AUTO_TEST_CASE(multiple_input_modes)
 	};
 	std::string expectedMessage =
 		"The following options are mutually exclusive: "
-		"--help, --license, --version, --standard-json, --link, --assemble, --strict-assembly, --import-ast, --lsp, --import-asm-json. "
+		"--help, --license, --version, --standard-json, --server, --link, --assemble, --strict-assembly, --import-ast, --lsp, --import-asm-json. "
 		"Select at most one.";
 
 	for (auto const& mode1: inputModeOptions)
@@ -442,6 +443,49 @@ BOOST_AUTO_TEST_CASE(standard_json_remapping)
 	);
 }
 
+BOOST_AUTO_TEST_CASE(server_outputs_match_standard_json)
+{
+	std::string const input =
+		R"({"language": "Solidity", "sources": {"A.sol": {"content": "contract A { function f() public pure returns (uint) { return 1; } }"}}, )"
+		R"("settings": {"viaIR": true, "optimizer": {"enabled": true}, "outputSelection": {"*": {"*": ["evm.bytecode.object"], "": ["ast"]}}}})";
+
+	OptionsReaderAndMessages standardJson = runCLI({"solc", "--standard-json"}, input);
+	BOOST_REQUIRE(standardJson.success);
+
+	// The second input reuses the parsed source and the optimized code of the first one.
+	OptionsReaderAndMessages server = runCLI({"solc", "--server"}, input + "\n\n" + input + "\n");
+	BOOST_TEST(server.success);
+	BOOST_TEST(server.stderrContent == "");
+	BOOST_TEST(server.options.input.mode == InputMode::Server);
+	BOOST_TEST(server.stdoutContent == standardJson.stdoutContent + standardJson.stdoutContent);
+}
+
+BOOST_AUTO_TEST_CASE(server_input_file)
+{
+	std::string expectedMessage =
+		"Input files are not accepted in --server mode.\n"
+		"Please send the Standard JSON inputs on standard input instead.";
+
+	BOOST_CHECK_EXCEPTION(
+		parseCommandLineAndReadInputFiles({"solc", "--server", "input.json"}),
+		CommandLineValidationError,
+		[&](auto const& _exception) { BOOST_TEST(_exception.what() == expectedMessage); return true; }
+	);
+}
+
+BOOST_AUTO_TEST_CASE(server_remapping)
+{
+	std::string expectedMessage =
+		"Import remappings are not accepted on the command line in --server mode.\n"
+		"Please put them under 'settings.remappings' in the JSON input.";
+
+	BOOST_CHECK_EXCEPTION(
+		parseCommandLineAndReadInputFiles({"solc", "--server", "a=b"}),
+		CommandLineValidationError,
+		[&](auto const& _exception) { BOOST_TEST(_exception.what() == expectedMessage); return true; }
+	);
+}
+
 BOOST_AUTO_TEST_CASE(cli_paths_to_source_unit_names_no_base_path)
 {
 	TemporaryDirectory tempDirCurrent(TEST_CASE_NAME);
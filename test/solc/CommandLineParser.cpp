@@ -27,6 +27,7 @@
 #include <test/libsolidity/util/SoltestErrors.h>
 
 #include <libsolutil/CommonData.h>
+#include <libsolutil/ThreadPool.h>
 #include <liblangutil/EVMVersion.h>
 #include <libsmtutil/SolverInterface.h>
 #include <libsolidity/interface/Version.h>
@@ -120,8 +121,11 @@ BOOST_AUTO_TEST_CASE(cli_mode_options)
 			"--evm-version=spuriousDragon",
 			"--via-ir",
 			"--experimental-via-ir",
+			"--jobs=4",
+			"--discard-intermediate-artifacts",
 			"--revert-strings=strip",
 			"--debug-info=location",
+			"--profile-json=/tmp/profile.json",
 			"--pretty-json",
 			"--json-indent=7",
 			"--no-color",
@@ -129,7 +133,7 @@ BOOST_AUTO_TEST_CASE(cli_mode_options)
 			"--libraries="
 				"dir1/file1.sol:L=0x1234567890123456789012345678901234567890,"
 				"dir2/file2.sol:L=0x1111122222333334444455555666667777788888",
-			"--ast-compact-json", "--asm", "--asm-json", "--opcodes", "--bin", "--bin-runtime", "--abi",
+			"--ast-compact-json", "--ast-binary", "--asm", "--asm-json", "--opcodes", "--bin", "--bin-runtime", "--abi",
 			"--ir", "--ir-ast-json", "--ir-optimized", "--ir-optimized-ast-json", "--hashes", "--userdoc", "--devdoc", "--metadata",
 			"--yul-cfg-json",
 			"--storage-layout", "--transient-storage-layout",
@@ -143,16 +147,22 @@ BOOST_AUTO_TEST_CASE(cli_mode_options)
 			"--optimize-yul",
 			"--optimize-runs=1000",
 			"--yul-optimizations=agf",
+			"--optimizer-cache-dir=/tmp/optimizer-cache",
+			"--optimizer-cache-size=64",
 			"--model-checker-bmc-loop-iterations=2",
 			"--model-checker-contracts=contract1.yul:A,contract2.yul:B",
 			"--model-checker-div-mod-no-slacks",
 			"--model-checker-engine=bmc",
 			"--model-checker-ext-calls=trusted",
 			"--model-checker-invariants=contract,reentrancy",
+			"--model-checker-race-cross-check-time=100",
+			"--model-checker-race-solvers",
 			"--model-checker-show-proved-safe",
+			"--model-checker-show-solver-statistics",
 			"--model-checker-show-unproved",
 			"--model-checker-show-unsupported",
 			"--model-checker-solvers=z3,smtlib2",
+			"--model-checker-solver-sessions",
 			"--model-checker-targets=underflow,divByZero",
 			"--model-checker-timeout=5"
 		};
@@ -181,8 +191,11 @@ BOOST_AUTO_TEST_CASE(cli_mode_options)
 		expectedOptions.output.overwriteFiles = true;
 		expectedOptions.output.evmVersion = EVMVersion::spuriousDragon();
 		expectedOptions.output.viaIR = true;
+		expectedOptions.output.jobs = 4;
+		expectedOptions.output.discardIntermediateArtifacts = true;
 		expectedOptions.output.revertStrings = RevertStrings::Strip;
 		expectedOptions.output.debugInfoSelection = DebugInfoSelection::fromString("location");
+		expectedOptions.output.profileFile = "/tmp/profile.json";
 		expectedOptions.formatting.json = JsonFormat{JsonFormat::Pretty, 7};
 		expectedOptions.linker.libraries = {
 			{"dir1/file1.sol:L", h160("1234567890123456789012345678901234567890")},
@@ -194,7 +207,7 @@ BOOST_AUTO_TEST_CASE(cli_mode_options)
 			true, true, true, true, true,
 			true, true, true, true, true,
 			true, true, true, true, true,
-			true, true, true,
+			true, true, true, true,
 		};
 		expectedOptions.compiler.estimateGas = true;
 		expectedOptions.compiler.combinedJsonRequests = {
@@ -209,6 +222,8 @@ BOOST_AUTO_TEST_CASE(cli_mode_options)
 		expectedOptions.optimizer.optimizeYul = true;
 		expectedOptions.optimizer.expectedExecutionsPerDeployment = 1000;
 		expectedOptions.optimizer.yulSteps = "agf";
+		expectedOptions.optimizer.cacheDirectory = "/tmp/optimizer-cache";
+		expectedOptions.optimizer.cacheMaxSize = 64 * 1024 * 1024;
 
 		expectedOptions.modelChecker.initialize = true;
 		expectedOptions.modelChecker.settings = {
@@ -219,6 +234,9 @@ BOOST_AUTO_TEST_CASE(cli_mode_options)
 			{ModelCheckerExtCalls::Mode::TRUSTED},
 			{{InvariantType::Contract, InvariantType::Reentrancy}},
 			false, // --model-checker-print-query
+			100,
+			true,
+			true,
 			true,
 			true,
 			true,
@@ -226,6 +244,7 @@ BOOST_AUTO_TEST_CASE(cli_mode_options)
 			{{VerificationTargetType::Underflow, VerificationTargetType::DivByZero}},
 			5,
 		};
+		expectedOptions.modelChecker.solverSessions = true;
 
 		CommandLineOptions parsedOptions = parseCommandLine(commandLine);
 
@@ -260,6 +279,47 @@ BOOST_AUTO_TEST_CASE(no_import_callback)
 	}
 }
 
+BOOST_AUTO_TEST_CASE(ast_binary_requires_output_dir)
+{
+	BOOST_TEST(parseCommandLine({"solc", "--ast-binary", "--output-dir=/tmp/out", "contract.sol"}).compiler.outputs.astBinary);
+	BOOST_TEST(parseCommandLine({"solc", "--import-ast", "--ast-binary", "--output-dir=/tmp/out", "ast.json"}).compiler.outputs.astBinary);
+
+	std::string const expectedErrorMessage = "Option --ast-binary requires --output-dir.";
+	auto hasCorrectMessage = [&](CommandLineValidationError const& _exception) { return _exception.what() == expectedErrorMessage; };
+	BOOST_CHECK_EXCEPTION(parseCommandLine({"solc", "--ast-binary", "contract.sol"}), CommandLineValidationError, hasCorrectMessage);
+}
+
+BOOST_AUTO_TEST_CASE(optimizer_cache_size_requires_directory)
+{
+	std::string const expectedErrorMessage = "Option --optimizer-cache-size requires --optimizer-cache-dir.";
+	auto hasCorrectMessage = [&](CommandLineValidationError const& _exception) { return _exception.what() == expectedErrorMessage; };
+	BOOST_CHECK_EXCEPTION(parseCommandLine({"solc", "--optimizer-cache-size=64", "contract.sol"}), CommandLineValidationError, hasCorrectMessage);
+	BOOST_CHECK_THROW(parseCommandLine({"solc", "--optimizer-cache-dir=/tmp", "--optimizer-cache-size=0", "contract.sol"}), CommandLineValidationError);
+}
+
+BOOST_AUTO_TEST_CASE(jobs_bounds)
+{
+	size_t const maxJobs = util::ThreadPool::maxWorkers();
+	BOOST_TEST(parseCommandLine({"solc", "--jobs=01", "contract.sol"}).output.jobs == 1);
+	BOOST_TEST(parseCommandLine({"solc", "--jobs=" + std::to_string(maxJobs), "contract.sol"}).output.jobs == maxJobs);
+	BOOST_TEST(parseCommandLine({"solc", "--jobs=" + std::to_string(maxJobs + 1), "contract.sol"}).output.jobs == maxJobs);
+	BOOST_TEST(parseCommandLine({"solc", "--jobs=4294967295", "contract.sol"}).output.jobs == maxJobs);
+	BOOST_TEST(parseCommandLine({"solc", "--jobs=100000000000000000000000", "contract.sol"}).output.jobs == maxJobs);
+
+	for (std::string const jobs: {"-1", "-0", "+2", "2x", "1.5"})
+	{
+		std::string const expectedErrorMessage = "--jobs must be a positive integer.";
+		auto hasCorrectMessage = [&](CommandLineValidationError const& _exception) { return _exception.what() == expectedErrorMessage; };
+		BOOST_CHECK_EXCEPTION(parseCommandLine({"solc", "--jobs=" + jobs, "contract.sol"}), CommandLineValidationError, hasCorrectMessage);
+	}
+	for (std::string const jobs: {"0", "000"})
+	{
+		std::string const expectedErrorMessage = "--jobs must be at least 1.";
+		auto hasCorrectMessage = [&](CommandLineValidationError const& _exception) { return _exception.what() == expectedErrorMessage; };
+		BOOST_CHECK_EXCEPTION(parseCommandLine({"solc", "--jobs=" + jobs, "contract.sol"}), CommandLineValidationError, hasCorrectMessage);
+	}
+}
+
 BOOST_AUTO_TEST_CASE(via_ir_options)
 {
 	BOOST_TEST(!parseCommandLine({"solc", "contract.sol"}).output.viaIR);
@@ -382,6 +442,7 @@ BOOST_AUTO_TEST_CASE(standard_json_mode_options)
 		"--overwrite",                     // Accepted but has no effect in Standard JSON mode
 		"--evm-version=spuriousDragon",    // Ignored in Standard JSON mode
 		"--revert-strings=strip",          // Accepted but has no effect in Standard JSON mode
+		"--profile-json=/tmp/profile.json",
 		"--pretty-json",
 		"--json-indent=1",
 		"--no-color",                      // Accepted but has no effect in Standard JSON mode
@@ -404,6 +465,7 @@ BOOST_AUTO_TEST_CASE(standard_json_mode_options)
 	expectedOptions.output.dir = "/tmp/out";
 	expectedOptions.output.overwriteFiles = true;
 	expectedOptions.output.revertStrings = RevertStrings::Strip;
+	expectedOptions.output.profileFile = "/tmp/profile.json";
 	expectedOptions.formatting.json = JsonFormat {JsonFormat::Pretty, 1};
 	expectedOptions.formatting.coloredOutput = false;
 	expectedOptions.formatting.withErrorIds = true;
@@ -423,6 +485,11 @@ BOOST_AUTO_TEST_CASE(invalid_options_input_modes_combinations)
 		// TODO: This should eventually contain all options.
 		{"--experimental-via-ir", {"--assemble", "--strict-assembly", "--standard-json", "--link"}},
 		{"--via-ir", {"--assemble", "--strict-assembly", "--standard-json", "--link"}},
+		{"--jobs=2", {"--assemble", "--strict-assembly", "--standard-json", "--link"}},
+		{"--discard-intermediate-artifacts", {"--assemble", "--strict-assembly", "--standard-json", "--link"}},
+		{"--optimizer-cache-dir=/tmp", {"--assemble", "--strict-assembly", "--standard-json", "--link"}},
+		{"--optimizer-cache-size=64", {"--assemble", "--strict-assembly", "--standard-json", "--link"}},
+		{"--profile-json=/tmp/profile.json", {"--link"}},
 		{"--metadata-literal", {"--assemble", "--strict-assembly", "--standard-json", "--link"}},
 		{"--metadata-hash=swarm", {"--assemble", "--strict-assembly", "--standard-json", "--link"}},
 		{"--model-checker-show-proved-safe", {"--assemble", "--strict-assembly", "--standard-json", "--link"}},
@@ -431,7 +498,10 @@ BOOST_AUTO_TEST_CASE(invalid_options_input_modes_combinations)
 		{"--model-checker-div-mod-no-slacks", {"--assemble", "--strict-assembly", "--standard-json", "--link"}},
 		{"--model-checker-engine=bmc", {"--assemble", "--strict-assembly", "--standard-json", "--link"}},
 		{"--model-checker-invariants=contract,reentrancy", {"--assemble", "--strict-assembly", "--standard-json", "--link"}},
+		{"--model-checker-race-solvers", {"--assemble", "--strict-assembly", "--standard-json", "--link"}},
+		{"--model-checker-show-solver-statistics", {"--assemble", "--strict-assembly", "--standard-json", "--link"}},
 		{"--model-checker-solvers=z3,smtlib2", {"--assemble", "--strict-assembly", "--standard-json", "--link"}},
+		{"--model-checker-solver-sessions", {"--assemble", "--strict-assembly", "--link"}},
 		{"--model-checker-timeout=5", {"--assemble", "--strict-assembly", "--standard-json", "--link"}},
 		{"--model-checker-contracts=contract1.yul:A,contract2.yul:B", {"--assemble", "--strict-assembly", "--standard-json", "--link"}},
 		{"--model-checker-targets=underflow,divByZero", {"--assemble", "--strict-assembly", "--standard-json", "--link"}}
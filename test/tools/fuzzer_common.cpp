@@ -100,7 +100,10 @@ void FuzzerUtil::testCompiler(
 			frontend::ModelCheckerExtCalls{},
 			frontend::ModelCheckerInvariants::All(),
 			/*printQuery=*/false,
+			/*raceCrossCheckTime=*/0,
+			/*raceSolvers=*/false,
 			/*showProvedSafe=*/false,
+			/*showSolverStatistics=*/false,
 			/*showUnproved=*/false,
 			/*showUnsupported=*/false,
 			smtutil::SMTSolverChoice::All(),
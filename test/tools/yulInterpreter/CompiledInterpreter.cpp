@@ -0,0 +1,728 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Yul interpreter that lowers the AST before executing it.
+ */
+
+#include <test/tools/yulInterpreter/CompiledInterpreter.h>
+
+#include <test/tools/yulInterpreter/EVMInstructionInterpreter.h>
+#include <test/tools/yulInterpreter/Interpreter.h>
+
+#include <libyul/AST.h>
+#include <libyul/Dialect.h>
+#include <libyul/Exceptions.h>
+#include <libyul/Utilities.h>
+#include <libyul/backends/evm/EVMDialect.h>
+
+#include <libevmasm/Instruction.h>
+
+#include <liblangutil/EVMVersion.h>
+
+#include <map>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <variant>
+#include <vector>
+
+using namespace solidity;
+using namespace solidity::yul;
+using namespace solidity::yul::test;
+
+namespace
+{
+
+/// Values of the variables of a function call, indexed by slot.
+using Frame = std::vector<u256>;
+
+struct LoweredExpression
+{
+	enum class Kind
+	{
+		Literal,
+		/// Literal argument of a builtin, which is not evaluated as an expression.
+		LiteralArgument,
+		Variable,
+		BuiltinCall,
+		FunctionCall
+	};
+
+	Kind kind = Kind::Literal;
+	u256 value;
+	size_t slot = 0;
+	size_t function = 0;
+	BuiltinFunctionForEVM const* builtin = nullptr;
+	/// Original call, which builtins with literal arguments inspect.
+	FunctionCall const* call = nullptr;
+	std::vector<LoweredExpression> arguments;
+};
+
+struct LoweredStatement;
+
+struct LoweredBlock
+{
+	std::vector<LoweredStatement> statements;
+};
+
+struct LoweredStatement
+{
+	enum class Kind
+	{
+		Expression,
+		/// Assignment or variable declaration.
+		Assignment,
+		If,
+		Switch,
+		ForLoop,
+		Block,
+		Break,
+		Continue,
+		Leave,
+		FunctionDefinition
+	};
+
+	Kind kind = Kind::FunctionDefinition;
+	/// Evaluated expression, assigned value, condition or switch expression.
+	/// Null for variable declarations without value, which assign zero.
+	std::unique_ptr<LoweredExpression> expression;
+	/// Slots of the assigned variables.
+	std::vector<size_t> slots;
+	/// Values of the switch cases, null for the default case.
+	std::vector<std::unique_ptr<LoweredExpression>> caseValues;
+	/// Body of an if statement or a block, bodies of the switch cases or pre, body and post of a for loop.
+	std::vector<LoweredBlock> blocks;
+	/// Whether the body and post of a for loop are empty.
+	bool emptyLoop = false;
+};
+
+struct LoweredFunction
+{
+	/// Parameters occupy the first slots of the frame, followed by the return variables.
+	size_t numParameters = 0;
+	size_t numReturnVariables = 0;
+	size_t numSlots = 0;
+	LoweredBlock body;
+};
+
+struct LoweredProgram
+{
+	langutil::EVMVersion evmVersion;
+	LoweredFunction root;
+	std::vector<LoweredFunction> functions;
+};
+
+/**
+ * Resolves all names of the AST and lowers it into the above structures.
+ */
+class Lowering
+{
+public:
+	Lowering(Dialect const& _dialect, LoweredProgram& _program):
+		m_dialect(_dialect),
+		m_program(_program)
+	{}
+
+	void lowerRoot(Block const& _block)
+	{
+		m_program.root.body = lowerBlock(_block);
+		m_program.root.numSlots = m_numSlots;
+	}
+
+	LoweredStatement operator()(ExpressionStatement const& _statement)
+	{
+		LoweredStatement lowered;
+		lowered.kind = LoweredStatement::Kind::Expression;
+		lowered.expression = lower(_statement.expression);
+		return lowered;
+	}
+
+	LoweredStatement operator()(Assignment const& _assignment)
+	{
+		yulAssert(_assignment.value);
+		LoweredStatement lowered;
+		lowered.kind = LoweredStatement::Kind::Assignment;
+		lowered.expression = lower(*_assignment.value);
+		for (Identifier const& variable: _assignment.variableNames)
+			lowered.slots.push_back(variableSlot(variable.name));
+		return lowered;
+	}
+
+	LoweredStatement operator()(VariableDeclaration const& _declaration)
+	{
+		LoweredStatement lowered;
+		lowered.kind = LoweredStatement::Kind::Assignment;
+		if (_declaration.value)
+			lowered.expression = lower(*_declaration.value);
+		for (NameWithDebugData const& variable: _declaration.variables)
+			lowered.slots.push_back(declareVariable(variable.name));
+		return lowered;
+	}
+
+	LoweredStatement operator()(If const& _if)
+	{
+		yulAssert(_if.condition);
+		LoweredStatement lowered;
+		lowered.kind = LoweredStatement::Kind::If;
+		lowered.expression = lower(*_if.condition);
+		lowered.blocks.emplace_back(lowerBlock(_if.body));
+		return lowered;
+	}
+
+	LoweredStatement operator()(Switch const& _switch)
+	{
+		yulAssert(_switch.expression);
+		yulAssert(!_switch.cases.empty());
+		LoweredStatement lowered;
+		lowered.kind = LoweredStatement::Kind::Switch;
+		lowered.expression = lower(*_switch.expression);
+		for (Case const& switchCase: _switch.cases)
+		{
+			lowered.caseValues.emplace_back(
+				switchCase.value ?
+				std::make_unique<LoweredExpression>((*this)(*switchCase.value)) :
+				nullptr
+			);
+			lowered.blocks.emplace_back(lowerBlock(switchCase.body));
+		}
+		return lowered;
+	}
+
+	LoweredStatement operator()(FunctionDefinition const&)
+	{
+		return {};
+	}
+
+	LoweredStatement operator()(ForLoop const& _forLoop)
+	{
+		yulAssert(_forLoop.condition);
+		LoweredStatement lowered;
+		lowered.kind = LoweredStatement::Kind::ForLoop;
+
+		// The scope of the pre block extends over the whole loop.
+		m_variableScopes.emplace_back();
+		m_functionScopes.emplace_back();
+		LoweredBlock pre;
+		for (Statement const& statement: _forLoop.pre.statements)
+			pre.statements.emplace_back(std::visit(*this, statement));
+		lowered.expression = lower(*_forLoop.condition);
+		lowered.blocks.emplace_back(std::move(pre));
+		lowered.blocks.emplace_back(lowerBlock(_forLoop.body));
+		lowered.blocks.emplace_back(lowerBlock(_forLoop.post));
+		m_functionScopes.pop_back();
+		m_variableScopes.pop_back();
+
+		lowered.emptyLoop = _forLoop.body.statements.empty() && _forLoop.post.statements.empty();
+		return lowered;
+	}
+
+	LoweredStatement operator()(Break const&)
+	{
+		LoweredStatement lowered;
+		lowered.kind = LoweredStatement::Kind::Break;
+		return lowered;
+	}
+
+	LoweredStatement operator()(Continue const&)
+	{
+		LoweredStatement lowered;
+		lowered.kind = LoweredStatement::Kind::Continue;
+		return lowered;
+	}
+
+	LoweredStatement operator()(Leave const&)
+	{
+		LoweredStatement lowered;
+		lowered.kind = LoweredStatement::Kind::Leave;
+		return lowered;
+	}
+
+	LoweredStatement operator()(Block const& _block)
+	{
+		LoweredStatement lowered;
+		lowered.kind = LoweredStatement::Kind::Block;
+		lowered.blocks.emplace_back(lowerBlock(_block));
+		return lowered;
+	}
+
+	LoweredExpression operator()(Literal const& _literal)
+	{
+		LoweredExpression lowered;
+		lowered.kind = LoweredExpression::Kind::Literal;
+		lowered.value = _literal.value.value();
+		return lowered;
+	}
+
+	LoweredExpression operator()(Identifier const& _identifier)
+	{
+		LoweredExpression lowered;
+		lowered.kind = LoweredExpression::Kind::Variable;
+		lowered.slot = variableSlot(_identifier.name);
+		return lowered;
+	}
+
+	LoweredExpression operator()(FunctionCall const& _call)
+	{
+		LoweredExpression lowered;
+		lowered.call = &_call;
+
+		std::vector<std::optional<LiteralKind>> const* literalArguments = nullptr;
+		if (BuiltinFunction const* builtin = resolveBuiltinFunction(_call.functionName, m_dialect))
+			if (!builtin->literalArguments.empty())
+				literalArguments = &builtin->literalArguments;
+		for (size_t i = 0; i < _call.arguments.size(); ++i)
+			if (literalArguments && literalArguments->at(i))
+			{
+				Literal const& literal = std::get<Literal>(_call.arguments[i]);
+				LoweredExpression& argument = lowered.arguments.emplace_back();
+				argument.kind = LoweredExpression::Kind::LiteralArgument;
+				if (literal.value.unlimited())
+				{
+					yulAssert(literal.kind == LiteralKind::String);
+					argument.value = 0xdeadbeef;
+				}
+				else
+					argument.value = literal.value.value();
+			}
+			else
+				lowered.arguments.emplace_back(std::visit(*this, _call.arguments[i]));
+
+		if (EVMDialect const* dialect = dynamic_cast<EVMDialect const*>(&m_dialect))
+			if (BuiltinFunctionForEVM const* builtin = resolveBuiltinFunctionForEVM(_call.functionName, *dialect))
+			{
+				lowered.kind = LoweredExpression::Kind::BuiltinCall;
+				lowered.builtin = builtin;
+				return lowered;
+			}
+
+		yulAssert(!isBuiltinFunctionCall(_call));
+		lowered.kind = LoweredExpression::Kind::FunctionCall;
+		lowered.function = function(std::get<Identifier>(_call.functionName).name);
+		return lowered;
+	}
+
+private:
+	std::unique_ptr<LoweredExpression> lower(Expression const& _expression)
+	{
+		return std::make_unique<LoweredExpression>(std::visit(*this, _expression));
+	}
+
+	LoweredBlock lowerBlock(Block const& _block)
+	{
+		m_variableScopes.emplace_back();
+		m_functionScopes.emplace_back();
+
+		// Functions are visible in the whole block they are defined in.
+		for (Statement const& statement: _block.statements)
+			if (auto const* function = std::get_if<FunctionDefinition>(&statement))
+			{
+				m_functionScopes.back()[function->name] = m_program.functions.size();
+				m_program.functions.emplace_back();
+			}
+		for (Statement const& statement: _block.statements)
+			if (auto const* function = std::get_if<FunctionDefinition>(&statement))
+				lowerFunction(*function, m_functionScopes.back().at(function->name));
+
+		LoweredBlock lowered;
+		for (Statement const& statement: _block.statements)
+			lowered.statements.emplace_back(std::visit(*this, statement));
+
+		m_functionScopes.pop_back();
+		m_variableScopes.pop_back();
+		return lowered;
+	}
+
+	void lowerFunction(FunctionDefinition const& _function, size_t _index)
+	{
+		// Variables of the enclosing scopes are not accessible inside of the function.
+		auto outerVariableScopes = std::exchange(m_variableScopes, {});
+		size_t const outerNumSlots = std::exchange(m_numSlots, 0);
+
+		LoweredFunction lowered;
+		lowered.numParameters = _function.parameters.size();
+		lowered.numReturnVariables = _function.returnVariables.size();
+		m_variableScopes.emplace_back();
+		for (NameWithDebugData const& parameter: _function.parameters)
+			declareVariable(parameter.name);
+		for (NameWithDebugData const& returnVariable: _function.returnVariables)
+			declareVariable(returnVariable.name);
+		lowered.body = lowerBlock(_function.body);
+		lowered.numSlots = m_numSlots;
+		m_program.functions[_index] = std::move(lowered);
+
+		m_variableScopes = std::move(outerVariableScopes);
+		m_numSlots = outerNumSlots;
+	}
+
+	size_t declareVariable(YulName _name)
+	{
+		size_t const slot = m_numSlots++;
+		m_variableScopes.back()[_name] = slot;
+		return slot;
+	}
+
+	size_t variableSlot(YulName _name) const
+	{
+		for (auto scope = m_variableScopes.rbegin(); scope != m_variableScopes.rend(); ++scope)
+			if (auto slot = scope->find(_name); slot != scope->end())
+				return slot->second;
+		yulAssert(false, "Variable not found.");
+	}
+
+	size_t function(YulName _name) const
+	{
+		for (auto scope = m_functionScopes.rbegin(); scope != m_functionScopes.rend(); ++scope)
+			if (auto function = scope->find(_name); function != scope->end())
+				return function->second;
+		yulAssert(false, "Function not found.");
+	}
+
+	Dialect const& m_dialect;
+	LoweredProgram& m_program;
+	/// Slots of the variables visible in the current function, innermost scope last.
+	std::vector<std::map<YulName, size_t>> m_variableScopes;
+	/// Indices of the visible functions, innermost scope last.
+	std::vector<std::map<YulName, size_t>> m_functionScopes;
+	/// Number of slots allocated for the current function so far.
+	size_t m_numSlots = 0;
+};
+
+/**
+ * Executes a lowered program with the same semantics as @a Interpreter and @a ExpressionEvaluator,
+ * including the points at which steps and expression nesting are counted.
+ */
+class Executor
+{
+public:
+	Executor(
+		LoweredProgram const& _program,
+		InterpreterState& _state,
+		bool _disableExternalCalls,
+		bool _disableMemoryTrace
+	):
+		m_program(_program),
+		m_state(_state),
+		m_disableExternalCalls(_disableExternalCalls),
+		m_disableMemoryTrace(_disableMemoryTrace)
+	{}
+
+	void run()
+	{
+		Frame frame(m_program.root.numSlots);
+		execute(m_program.root.body, frame);
+	}
+
+private:
+	void execute(LoweredBlock const& _block, Frame& _frame)
+	{
+		for (LoweredStatement const& statement: _block.statements)
+		{
+			incrementStep();
+			execute(statement, _frame);
+			if (m_state.controlFlowState != ControlFlowState::Default)
+				break;
+		}
+	}
+
+	void execute(LoweredStatement const& _statement, Frame& _frame);
+
+	/// Evaluates an expression of a statement, which has to have exactly one value.
+	u256 evaluate(LoweredExpression const& _expression, Frame& _frame)
+	{
+		// Every statement-level expression is evaluated with its own nesting counter.
+		size_t nesting = 0;
+		return evaluate(_expression, _frame, nesting);
+	}
+
+	/// Evaluates an expression of a statement.
+	std::vector<u256> evaluateMulti(LoweredExpression const& _expression, Frame& _frame)
+	{
+		size_t nesting = 0;
+		if (
+			_expression.kind == LoweredExpression::Kind::BuiltinCall ||
+			_expression.kind == LoweredExpression::Kind::FunctionCall
+		)
+			return call(_expression, _frame, nesting);
+		return {evaluate(_expression, _frame, nesting)};
+	}
+
+	u256 evaluate(LoweredExpression const& _expression, Frame& _frame, size_t& _nesting);
+	std::vector<u256> call(LoweredExpression const& _call, Frame& _frame, size_t& _nesting);
+	void runExternalCall(evmasm::Instruction _instruction, std::vector<u256> const& _arguments);
+
+	void incrementStep()
+	{
+		m_state.numSteps++;
+		if (m_state.maxSteps > 0 && m_state.numSteps >= m_state.maxSteps)
+		{
+			m_state.trace.emplace_back("Interpreter execution step limit reached.");
+			BOOST_THROW_EXCEPTION(StepLimitReached());
+		}
+	}
+
+	void incrementNesting(size_t& _nesting)
+	{
+		_nesting++;
+		if (m_state.maxExprNesting > 0 && _nesting > m_state.maxExprNesting)
+		{
+			m_state.trace.emplace_back("Maximum expression nesting level reached.");
+			BOOST_THROW_EXCEPTION(ExpressionNestingLimitReached());
+		}
+	}
+
+	LoweredProgram const& m_program;
+	InterpreterState& m_state;
+	bool m_disableExternalCalls;
+	bool m_disableMemoryTrace;
+};
+
+void Executor::execute(LoweredStatement const& _statement, Frame& _frame)
+{
+	switch (_statement.kind)
+	{
+	case LoweredStatement::Kind::Expression:
+		evaluateMulti(*_statement.expression, _frame);
+		break;
+	case LoweredStatement::Kind::Assignment:
+		if (_statement.expression)
+		{
+			std::vector<u256> values = evaluateMulti(*_statement.expression, _frame);
+			yulAssert(values.size() == _statement.slots.size());
+			for (size_t i = 0; i < values.size(); ++i)
+				_frame[_statement.slots[i]] = values[i];
+		}
+		else
+			for (size_t slot: _statement.slots)
+				_frame[slot] = 0;
+		break;
+	case LoweredStatement::Kind::If:
+		if (evaluate(*_statement.expression, _frame) != 0)
+			execute(_statement.blocks.front(), _frame);
+		break;
+	case LoweredStatement::Kind::Switch:
+	{
+		u256 const value = evaluate(*_statement.expression, _frame);
+		for (size_t i = 0; i < _statement.blocks.size(); ++i)
+			// Default case has to be last.
+			if (!_statement.caseValues[i] || evaluate(*_statement.caseValues[i], _frame) == value)
+			{
+				execute(_statement.blocks[i], _frame);
+				break;
+			}
+		break;
+	}
+	case LoweredStatement::Kind::ForLoop:
+	{
+		LoweredBlock const& pre = _statement.blocks[0];
+		LoweredBlock const& body = _statement.blocks[1];
+		LoweredBlock const& post = _statement.blocks[2];
+		for (LoweredStatement const& statement: pre.statements)
+		{
+			execute(statement, _frame);
+			if (m_state.controlFlowState == ControlFlowState::Leave)
+				return;
+		}
+		while (evaluate(*_statement.expression, _frame) != 0)
+		{
+			// Increment step for each loop iteration for loops with
+			// an empty body and post blocks to prevent a deadlock.
+			if (_statement.emptyLoop)
+				incrementStep();
+
+			m_state.controlFlowState = ControlFlowState::Default;
+			execute(body, _frame);
+			if (m_state.controlFlowState == ControlFlowState::Break || m_state.controlFlowState == ControlFlowState::Leave)
+				break;
+
+			m_state.controlFlowState = ControlFlowState::Default;
+			execute(post, _frame);
+			if (m_state.controlFlowState == ControlFlowState::Leave)
+				break;
+		}
+		if (m_state.controlFlowState != ControlFlowState::Leave)
+			m_state.controlFlowState = ControlFlowState::Default;
+		break;
+	}
+	case LoweredStatement::Kind::Block:
+		execute(_statement.blocks.front(), _frame);
+		break;
+	case LoweredStatement::Kind::Break:
+		m_state.controlFlowState = ControlFlowState::Break;
+		break;
+	case LoweredStatement::Kind::Continue:
+		m_state.controlFlowState = ControlFlowState::Continue;
+		break;
+	case LoweredStatement::Kind::Leave:
+		m_state.controlFlowState = ControlFlowState::Leave;
+		break;
+	case LoweredStatement::Kind::FunctionDefinition:
+		break;
+	}
+}
+
+u256 Executor::evaluate(LoweredExpression const& _expression, Frame& _frame, size_t& _nesting)
+{
+	switch (_expression.kind)
+	{
+	case LoweredExpression::Kind::Literal:
+		incrementNesting(_nesting);
+		return _expression.value;
+	case LoweredExpression::Kind::LiteralArgument:
+		return _expression.value;
+	case LoweredExpression::Kind::Variable:
+		incrementNesting(_nesting);
+		return _frame[_expression.slot];
+	case LoweredExpression::Kind::BuiltinCall:
+	case LoweredExpression::Kind::FunctionCall:
+	{
+		std::vector<u256> values = call(_expression, _frame, _nesting);
+		yulAssert(values.size() == 1);
+		return values.front();
+	}
+	}
+	util::unreachable();
+}
+
+std::vector<u256> Executor::call(LoweredExpression const& _call, Frame& _frame, size_t& _nesting)
+{
+	incrementNesting(_nesting);
+	/// Function arguments are evaluated in reverse.
+	std::vector<u256> arguments(_call.arguments.size());
+	for (size_t i = arguments.size(); i > 0; --i)
+		arguments[i - 1] = evaluate(_call.arguments[i - 1], _frame, _nesting);
+
+	if (_call.kind == LoweredExpression::Kind::BuiltinCall)
+	{
+		EVMInstructionInterpreter interpreter(m_program.evmVersion, m_state, m_disableMemoryTrace);
+		u256 const value = interpreter.evalBuiltin(*_call.builtin, _call.call->arguments, arguments);
+		if (
+			!m_disableExternalCalls &&
+			_call.builtin->instruction &&
+			evmasm::isCallInstruction(*_call.builtin->instruction)
+		)
+			runExternalCall(*_call.builtin->instruction, arguments);
+		return {value};
+	}
+
+	LoweredFunction const& function = m_program.functions[_call.function];
+	yulAssert(arguments.size() == function.numParameters);
+	Frame frame(function.numSlots);
+	std::move(arguments.begin(), arguments.end(), frame.begin());
+
+	m_state.controlFlowState = ControlFlowState::Default;
+	execute(function.body, frame);
+	m_state.controlFlowState = ControlFlowState::Default;
+
+	auto returnVariables = frame.begin() + static_cast<ptrdiff_t>(function.numParameters);
+	return {returnVariables, returnVariables + static_cast<ptrdiff_t>(function.numReturnVariables)};
+}
+
+void Executor::runExternalCall(evmasm::Instruction _instruction, std::vector<u256> const& _arguments)
+{
+	u256 memOutOffset = 0;
+	u256 memOutSize = 0;
+	u256 callvalue = 0;
+	u256 memInOffset = 0;
+	u256 memInSize = 0;
+
+	// Setup memOut* values
+	if (
+		_instruction == evmasm::Instruction::CALL ||
+		_instruction == evmasm::Instruction::CALLCODE
+	)
+	{
+		memOutOffset = _arguments[5];
+		memOutSize = _arguments[6];
+		callvalue = _arguments[2];
+		memInOffset = _arguments[3];
+		memInSize = _arguments[4];
+	}
+	else if (
+		_instruction == evmasm::Instruction::DELEGATECALL ||
+		_instruction == evmasm::Instruction::STATICCALL
+	)
+	{
+		memOutOffset = _arguments[4];
+		memOutSize = _arguments[5];
+		memInOffset = _arguments[2];
+		memInSize = _arguments[3];
+	}
+	else
+		yulAssert(false);
+
+	// Don't execute external call if it isn't our own address
+	if (_arguments[1] != util::h160::Arith(m_state.address))
+		return;
+
+	InterpreterState calleeState;
+	calleeState.calldata = m_state.readMemory(memInOffset, memInSize);
+	calleeState.callvalue = callvalue;
+	calleeState.numInstance = m_state.numInstance + 1;
+
+	yulAssert(calleeState.numInstance < 1024, "Detected more than 1024 recursive calls, aborting...");
+
+	try
+	{
+		Executor{m_program, calleeState, m_disableExternalCalls, m_disableMemoryTrace}.run();
+	}
+	catch (ExplicitlyTerminatedWithReturn const&)
+	{
+		// Copy return data to our memory
+		copyZeroExtended(
+			m_state.memory,
+			calleeState.returndata,
+			memOutOffset.convert_to<size_t>(),
+			0,
+			memOutSize.convert_to<size_t>()
+		);
+		m_state.returndata = calleeState.returndata;
+	}
+}
+
+}
+
+struct CompiledInterpreter::Program: LoweredProgram
+{
+};
+
+CompiledInterpreter::CompiledInterpreter(Dialect const& _dialect, Block const& _ast)
+{
+	auto program = std::make_unique<Program>();
+	if (EVMDialect const* dialect = dynamic_cast<EVMDialect const*>(&_dialect))
+		program->evmVersion = dialect->evmVersion();
+	Lowering{_dialect, *program}.lowerRoot(_ast);
+	m_program = std::move(program);
+}
+
+CompiledInterpreter::~CompiledInterpreter() = default;
+
+void CompiledInterpreter::run(InterpreterState& _state, bool _disableExternalCalls, bool _disableMemoryTracing) const
+{
+	Executor{*m_program, _state, _disableExternalCalls, _disableMemoryTracing}.run();
+}
+
+void CompiledInterpreter::run(
+	InterpreterState& _state,
+	Dialect const& _dialect,
+	Block const& _ast,
+	bool _disableExternalCalls,
+	bool _disableMemoryTracing
+)
+{
+	CompiledInterpreter{_dialect, _ast}.run(_state, _disableExternalCalls, _disableMemoryTracing);
+}
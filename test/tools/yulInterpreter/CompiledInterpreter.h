@@ -0,0 +1,70 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Yul interpreter that lowers the AST before executing it.
+ */
+
+#pragma once
+
+#include <memory>
+
+namespace solidity::yul
+{
+class Dialect;
+struct Block;
+}
+
+namespace solidity::yul::test
+{
+
+struct InterpreterState;
+
+/**
+ * Alternative execution engine producing exactly the same trace and state as @a Interpreter.
+ *
+ * Instead of walking the AST and looking up variables and functions by name on every access,
+ * the AST is lowered once into a tree in which variables are indices into a flat array of
+ * values per function call and calls refer to their callee directly.
+ * The lowered program can be executed any number of times.
+ */
+class CompiledInterpreter
+{
+public:
+	/// Lowers @a _ast, which has to be the root of a successfully analyzed Yul AST.
+	CompiledInterpreter(Dialect const& _dialect, Block const& _ast);
+	~CompiledInterpreter();
+
+	/// Executes the lowered program. Has the same effect on @a _state as @a Interpreter::run().
+	void run(InterpreterState& _state, bool _disableExternalCalls, bool _disableMemoryTracing) const;
+
+	/// Lowers and executes @a _ast. Drop-in replacement for @a Interpreter::run().
+	static void run(
+		InterpreterState& _state,
+		Dialect const& _dialect,
+		Block const& _ast,
+		bool _disableExternalCalls,
+		bool _disableMemoryTracing
+	);
+
+private:
+	struct Program;
+
+	std::unique_ptr<Program const> m_program;
+};
+
+}
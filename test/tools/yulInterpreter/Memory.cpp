@@ -0,0 +1,93 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Memory of the Yul interpreter.
+ */
+
+#include <test/tools/yulInterpreter/Memory.h>
+
+#include <algorithm>
+
+using namespace solidity;
+using namespace solidity::yul::test;
+
+template <typename Visitor>
+void Memory::forEachPage(u256 const& _offset, size_t _size, Visitor&& _visitor)
+{
+	u256 offset = _offset;
+	size_t done = 0;
+	while (done < _size)
+	{
+		size_t const offsetInPage = static_cast<size_t>(offset % pageSize);
+		size_t const chunkSize = std::min(_size - done, pageSize - offsetInPage);
+		_visitor(u256(offset / pageSize), offsetInPage, done, chunkSize);
+		// Wraps around at 2**256.
+		offset += chunkSize;
+		done += chunkSize;
+	}
+}
+
+uint8_t Memory::read(u256 const& _offset) const
+{
+	auto page = m_pages.find(_offset / pageSize);
+	if (page == m_pages.end())
+		return 0;
+	return page->second[static_cast<size_t>(_offset % pageSize)];
+}
+
+bytes Memory::read(u256 const& _offset, size_t _size) const
+{
+	bytes data(_size, uint8_t(0));
+	forEachPage(_offset, _size, [&](u256 const& _pageIndex, size_t _offsetInPage, size_t _offsetInData, size_t _chunkSize) {
+		auto page = m_pages.find(_pageIndex);
+		if (page != m_pages.end())
+			std::copy_n(
+				page->second.begin() + static_cast<ptrdiff_t>(_offsetInPage),
+				_chunkSize,
+				data.begin() + static_cast<ptrdiff_t>(_offsetInData)
+			);
+	});
+	return data;
+}
+
+void Memory::write(u256 const& _offset, uint8_t _value)
+{
+	m_pages[_offset / pageSize][static_cast<size_t>(_offset % pageSize)] = _value;
+}
+
+void Memory::write(u256 const& _offset, bytesConstRef _data)
+{
+	forEachPage(_offset, _data.size(), [&](u256 const& _pageIndex, size_t _offsetInPage, size_t _offsetInData, size_t _chunkSize) {
+		// Newly allocated pages are value-initialized, i.e. filled with zeros.
+		Page& page = m_pages[_pageIndex];
+		std::copy_n(
+			_data.begin() + static_cast<ptrdiff_t>(_offsetInData),
+			_chunkSize,
+			page.begin() + static_cast<ptrdiff_t>(_offsetInPage)
+		);
+	});
+}
+
+void Memory::clear(u256 const& _offset, size_t _size)
+{
+	forEachPage(_offset, _size, [&](u256 const& _pageIndex, size_t _offsetInPage, size_t, size_t _chunkSize) {
+		auto page = m_pages.find(_pageIndex);
+		if (page != m_pages.end())
+			std::fill_n(page->second.begin() + static_cast<ptrdiff_t>(_offsetInPage), _chunkSize, uint8_t(0));
+	});
+}
@@ -0,0 +1,72 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Memory of the Yul interpreter.
+ */
+
+#pragma once
+
+#include <libsolutil/Common.h>
+#include <libsolutil/Numeric.h>
+
+#include <array>
+#include <map>
+
+namespace solidity::yul::test
+{
+
+/**
+ * Sparse byte-addressable memory spanning the whole 256-bit address space.
+ *
+ * Bytes are stored in fixed-size pages, which are allocated when they are first written to.
+ * Bytes outside of allocated pages read as zero. Accesses wrap around at 2**256.
+ */
+class Memory
+{
+public:
+	static constexpr size_t pageSize = 0x1000;
+	using Page = std::array<uint8_t, pageSize>;
+
+	/// @returns the byte at @a _offset.
+	uint8_t read(u256 const& _offset) const;
+	/// @returns @a _size consecutive bytes starting at @a _offset.
+	bytes read(u256 const& _offset, size_t _size) const;
+
+	/// Sets the byte at @a _offset to @a _value.
+	void write(u256 const& _offset, uint8_t _value);
+	/// Copies @a _data to the memory starting at @a _offset.
+	void write(u256 const& _offset, bytesConstRef _data);
+	/// Sets @a _size consecutive bytes starting at @a _offset to zero.
+	/// Does not allocate any pages.
+	void clear(u256 const& _offset, size_t _size);
+
+	/// @returns the allocated pages keyed by their index, i.e. the offset of their first byte
+	/// divided by @a pageSize.
+	std::map<u256, Page> const& pages() const { return m_pages; }
+
+private:
+	/// Calls @a _visitor with the index of each page touched by the range of @a _size bytes
+	/// starting at @a _offset, the offset of the range within that page, the offset within the
+	/// range and the number of bytes in that page.
+	template <typename Visitor>
+	static void forEachPage(u256 const& _offset, size_t _size, Visitor&& _visitor);
+
+	std::map<u256, Page> m_pages;
+};
+
+}
@@ -19,6 +19,7 @@
  * Yul interpreter.
  */
 
+#include <test/tools/yulInterpreter/CompiledInterpreter.h>
 #include <test/tools/yulInterpreter/Interpreter.h>
 #include <test/tools/yulInterpreter/Inspector.h>
 
@@ -75,7 +76,7 @@ std::pair<std::shared_ptr<AST const>, std::shared_ptr<AsmAnalysisInfo>> parse(st
 	}
 }
 
-void interpret(std::string const& _source, bool _inspect, bool _disableExternalCalls)
+void interpret(std::string const& _source, bool _inspect, bool _compiled, bool _disableExternalCalls)
 {
 	std::shared_ptr<AST const> ast;
 	std::shared_ptr<AsmAnalysisInfo> analysisInfo;
@@ -92,6 +93,8 @@ void interpret(std::string const& _source, bool _inspect, bool _disableExternalC
 		if (_inspect)
 			InspectedInterpreter::run(std::make_shared<Inspector>(_source, state), state, dialect, ast->root(), _disableExternalCalls, /*disableMemoryTracing=*/false);
 
+		else if (_compiled)
+			CompiledInterpreter::run(state, dialect, ast->root(), _disableExternalCalls, /*disableMemoryTracing=*/false);
 		else
 			Interpreter::run(state, dialect, ast->root(), _disableExternalCalls, /*disableMemoryTracing=*/false);
 	}
@@ -118,6 +121,7 @@ Allowed options)",
 		("help", "Show this help screen.")
 		("enable-external-calls", "Enable external calls")
 		("interactive", "Run interactive")
+		("compiled", "Lower the code before running it. Faster for long-running code, cannot be combined with --interactive.")
 		("input-file", po::value<std::vector<std::string>>(), "input file");
 	po::positional_options_description filesPositions;
 	filesPositions.add("input-file", -1);
@@ -137,6 +141,11 @@ Allowed options)",
 
 	if (arguments.count("help"))
 		std::cout << options;
+	else if (arguments.count("interactive") && arguments.count("compiled"))
+	{
+		std::cerr << "Options --interactive and --compiled cannot be used together." << std::endl;
+		return 1;
+	}
 	else
 	{
 		std::string input;
@@ -161,7 +170,12 @@ Allowed options)",
 		else
 			input = readUntilEnd(std::cin);
 
-		interpret(input, arguments.count("interactive"), !arguments.count("enable-external-calls"));
+		interpret(
+			input,
+			arguments.count("interactive"),
+			arguments.count("compiled"),
+			!arguments.count("enable-external-calls")
+		);
 	}
 
 	return 0;